@@ -1,77 +1,168 @@
 ﻿
 #include "base/bundle.hpp"
 
+#include <algorithm>
 #include <functional>
-#include <list>
+#include <memory>
+#include <thread>
 
-#include "base/map_util.hpp"
 #include "base/status.hpp"
 
 namespace principia {
 namespace base {
 
+namespace {
+
+int PoolSize() {
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+}  // namespace
+
+Bundle::Bundle(int const max_concurrency)
+    : state_(std::make_shared<State>(max_concurrency)) {
+  CHECK_LT(0, max_concurrency);
+}
+
 void Bundle::Add(Task task) {
-  absl::MutexLock l(&lock_);
   CHECK(!joining_);
-  ++number_of_active_workers_;
-  workers_.emplace_back(&Bundle::Toil, this, std::move(task));
+  bool must_toil;
+  {
+    absl::MutexLock l(&state_->lock);
+    state_->pending.push_back(std::move(task));
+    // There is no point in having more calls to |Toil| than threads in the
+    // pool.
+    must_toil =
+        state_->toiling < std::min(state_->max_concurrency, PoolSize());
+    if (must_toil) {
+      ++state_->toiling;
+    }
+  }
+  if (must_toil) {
+    pool().Add([state = state_]() { Toil(state); });
+  }
 }
 
 Status Bundle::Join() {
   joining_ = true;
-  all_done_.WaitForNotification();
-  JoinAll();
-  absl::ReaderMutexLock status_lock(&status_lock_);
-  return status_;
+  absl::MutexLock l(&state_->lock);
+  // Help with the pending tasks, as the threads of the pool may all be busy,
+  // e.g., executing the tasks of the bundle in which we are nested.
+  for (;;) {
+    auto const can_execute_or_done = [this]() {
+      state_->lock.AssertReaderHeld();
+      return state_->CanExecute() ||
+             (state_->pending.empty() && state_->executing == 0);
+    };
+    state_->lock.Await(absl::Condition(&can_execute_or_done));
+    if (!state_->CanExecute()) {
+      break;
+    }
+    state_->Execute();
+  }
+  return state_->status;
 }
 
-Status Bundle::JoinWithin(std::chrono::steady_clock::duration Δt) {
+Status Bundle::JoinWithin(std::chrono::steady_clock::duration const Δt) {
   joining_ = true;
-  if (!all_done_.WaitForNotificationWithTimeout(absl::FromChrono(Δt))) {
-    absl::MutexLock l(&status_lock_);
-    status_ = Status(Error::DEADLINE_EXCEEDED, "bundle deadline exceeded");
-  }
-  JoinAll();
-  absl::ReaderMutexLock status_lock(&status_lock_);
-  return status_;
+  return JoinWithDeadline(absl::Now() + absl::FromChrono(Δt));
 }
 
-Status Bundle::JoinBefore(std::chrono::system_clock::time_point t) {
+Status Bundle::JoinBefore(std::chrono::system_clock::time_point const t) {
   joining_ = true;
-  if (!all_done_.WaitForNotificationWithDeadline(absl::FromChrono(t))) {
-    absl::MutexLock l(&status_lock_);
-    status_ = Status(Error::DEADLINE_EXCEEDED, "bundle deadline exceeded");
-  }
-  JoinAll();
-  absl::ReaderMutexLock status_lock(&status_lock_);
-  return status_;
+  return JoinWithDeadline(absl::FromChrono(t));
 }
 
-void Bundle::Toil(Task const& task) {
-  Status const status = task();
+bool Bundle::cancelled() const {
+  return state_->Cancelled();
+}
 
-  // Avoid locking if the task succeeded: it cannot affect the overall status.
-  if (!status.ok()) {
-    absl::MutexLock l(&status_lock_);
-    status_.Update(status);
-  }
+Bundle::State::State(int const max_concurrency)
+    : max_concurrency(max_concurrency) {}
 
-  // No locking, so as to avoid contention during joining.  Note that if
-  // |joining_| is true we know that |number_of_active_workers_| cannot
-  // increase.  Reading |number_of_active_workers_| independently from the
-  // decrement would be incorrect as we must ensure that exactly one thread sees
-  // that counter dropping to zero.
-  int const number_of_active_workers = --number_of_active_workers_;
-  if (joining_ && number_of_active_workers == 0) {
-    all_done_.Notify();
+void Bundle::State::Execute() {
+  Task const task = std::move(pending.front());
+  pending.pop_front();
+  ++executing;
+
+  // Execute the task without holding the |lock| as it might take some time.
+  lock.Unlock();
+  Status const task_status = task();
+  lock.Lock();
+
+  status.Update(task_status);
+  --executing;
+}
+
+bool Bundle::State::CanExecute() const {
+  return !Cancelled() && !pending.empty() && executing < max_concurrency;
+}
+
+bool Bundle::State::Cancelled() const {
+  return cancelled ||
+         absl::ToUnixNanos(absl::Now()) >= deadline_in_unix_nanos;
+}
+
+void Bundle::Toil(std::shared_ptr<State> const& state) {
+  absl::MutexLock l(&state->lock);
+  // If the limit on concurrency is reached, this is because a joining thread
+  // is helping; it will take care of the remaining tasks.
+  while (state->CanExecute()) {
+    state->Execute();
   }
+  --state->toiling;
+}
+
+void Bundle::Cancel() {
+  state_->cancelled = true;
+  absl::MutexLock l(&state_->lock);
+  state_->pending.clear();
+  state_->status =
+      Status(Error::DEADLINE_EXCEEDED, "bundle deadline exceeded");
+  // The executing tasks may refer to objects owned by the caller, so we must
+  // wait until they are done.
+  auto const done = [this]() {
+    state_->lock.AssertReaderHeld();
+    return state_->executing == 0;
+  };
+  state_->lock.Await(absl::Condition(&done));
 }
 
-void Bundle::JoinAll() {
-  absl::ReaderMutexLock l(&lock_);
-  for (auto& worker : workers_) {
-    worker.join();
+Status Bundle::JoinWithDeadline(absl::Time const deadline) {
+  state_->deadline_in_unix_nanos = absl::ToUnixNanos(deadline);
+  {
+    absl::MutexLock l(&state_->lock);
+    // Help with the pending tasks as in |Join|, until the deadline expires.
+    for (;;) {
+      auto const can_execute_or_done = [this]() {
+        state_->lock.AssertReaderHeld();
+        return state_->CanExecute() ||
+               (state_->pending.empty() && state_->executing == 0);
+      };
+      if (!state_->lock.AwaitWithDeadline(
+              absl::Condition(&can_execute_or_done), deadline)) {
+        break;
+      }
+      if (state_->pending.empty() && state_->executing == 0) {
+        return state_->status;
+      }
+      // The deadline may have expired since the condition was evaluated.
+      if (!state_->CanExecute()) {
+        break;
+      }
+      state_->Execute();
+    }
   }
+  Cancel();
+  absl::ReaderMutexLock l(&state_->lock);
+  return state_->status;
+}
+
+ThreadPool<void>& Bundle::pool() {
+  // Never destroyed, so that the pool remains usable during the destruction of
+  // static objects.
+  static auto* const pool = new ThreadPool<void>(PoolSize());
+  return *pool;
 }
 
 }  // namespace base
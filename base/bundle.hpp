@@ -1,65 +1,112 @@
 ﻿
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <functional>
-#include <list>
-#include <optional>
-#include <thread>
-#include <vector>
+#include <limits>
+#include <memory>
 
 #include "absl/base/thread_annotations.h"
-#include "absl/synchronization/notification.h"
 #include "absl/synchronization/mutex.h"
 #include "base/status.hpp"
+#include "base/thread_pool.hpp"
 
 namespace principia {
 namespace base {
 
-// A bundle manages a number of threads that execute independently.  A thread is
-// created for each call to |Add|.  When one of the |Join*| is called, no more
-// calls to |Add| are allowed, and |Join*| returns the first error status (if
-// any) produced by the tasks.
+// A bundle manages a number of tasks that execute independently.  The tasks are
+// run on a pool of threads shared by all bundles, whose size is that of the
+// hardware concurrency, so that adding many tasks does not oversubscribe the
+// machine.  When one of the |Join*| is called, no more calls to |Add| are
+// allowed, and |Join*| returns the first error status (if any) produced by the
+// tasks.
 class Bundle final {
  public:
   using Task = std::function<Status()>;
 
+  // At most |max_concurrency| tasks of this bundle execute at any given time.
+  explicit Bundle(
+      int max_concurrency = std::numeric_limits<int>::max());
+
   // If a |task| returns an erroneous |Status|, |Join| returns that status.
-  void Add(Task task) LOCKS_EXCLUDED(lock_);
+  void Add(Task task);
 
-  // Returns the first non-OK status encountered, or OK.  All worker threads are
-  // joined; no calls to member functions may follow this call.
-  Status Join() LOCKS_EXCLUDED(lock_, status_lock_);
+  // Returns the first non-OK status encountered, or OK.  The calling thread
+  // helps executing the tasks that have not started yet, so it is safe to join
+  // a bundle from within a task of another bundle.  No calls to member
+  // functions may follow this call.
+  Status Join();
   // Same as above, but returns |Error::DEADLINE_EXCEEDED| if it fails to
-  // complete within the given interval.
-  Status JoinWithin(std::chrono::steady_clock::duration Δt)
-      LOCKS_EXCLUDED(lock_, status_lock_);
+  // complete within the given interval.  The calling thread helps executing the
+  // tasks that have not started until the deadline.  The tasks that have not
+  // started at the deadline are cancelled; this function still waits for the
+  // tasks that are executing, including one started by the calling thread,
+  // which may poll |cancelled| to return early.
+  Status JoinWithin(std::chrono::steady_clock::duration Δt);
   // Same as above with absolute time.
-  Status JoinBefore(std::chrono::system_clock::time_point t)
-      LOCKS_EXCLUDED(lock_, status_lock_);
+  Status JoinBefore(std::chrono::system_clock::time_point t);
+
+  // True if the deadline of a |Join*| has expired.  May be called by the tasks.
+  bool cancelled() const;
 
  private:
-  // Run on a separate thread to execute task and record its status.
-  void Toil(Task const& task) LOCKS_EXCLUDED(lock_, status_lock_);
+  // The part of the bundle that is shared with the pool.  The pool may start
+  // executing a call to |Toil| after the bundle has been destroyed, so this
+  // must outlive the bundle.
+  struct State {
+    explicit State(int max_concurrency);
+
+    // Pops a task from |pending| and executes it, recording its status.
+    void Execute() EXCLUSIVE_LOCKS_REQUIRED(lock);
+
+    // True if a task may start executing.
+    bool CanExecute() const SHARED_LOCKS_REQUIRED(lock);
+
+    // True if the bundle was cancelled or if its deadline has expired.
+    bool Cancelled() const;
+
+    int const max_concurrency;
 
-  void JoinAll() LOCKS_EXCLUDED(lock_);
+    mutable absl::Mutex lock;
+    std::deque<Task> pending GUARDED_BY(lock);
+    // The number of tasks currently executing.
+    int executing GUARDED_BY(lock) = 0;
+    // The number of calls to |Toil| that have been added to the pool and have
+    // not returned yet.
+    int toiling GUARDED_BY(lock) = 0;
+    Status status GUARDED_BY(lock);
 
-  absl::Mutex status_lock_;
-  Status status_ GUARDED_BY(status_lock_);
+    std::atomic_bool cancelled = false;
+    // The deadline of |JoinWithDeadline|, in nanoseconds since the Unix epoch.
+    // It is checked by |Cancelled| so that the tasks, including those executed
+    // by the joining thread, observe its expiry before |Cancel| is called.
+    std::atomic<std::int64_t> deadline_in_unix_nanos =
+        std::numeric_limits<std::int64_t>::max();
+  };
 
-  absl::Mutex lock_;
+  // Run on the pool to execute the pending tasks of |state| until there are
+  // none left.
+  static void Toil(std::shared_ptr<State> const& state)
+      LOCKS_EXCLUDED(state->lock);
+
+  // Cancels the tasks that have not started and waits for the ones that are
+  // executing.
+  void Cancel() LOCKS_EXCLUDED(state_->lock);
+
+  Status JoinWithDeadline(absl::Time deadline) LOCKS_EXCLUDED(state_->lock);
+
+  static ThreadPool<void>& pool();
+
+  std::shared_ptr<State> const state_;
 
   // Whether |Join| has been called.  When set to true, |Add| should not be
   // called.
   std::atomic_bool joining_ = false;
-  absl::Notification all_done_;
-
-  // The number of workers currently executing.  Can only be incremented when
-  // |joining_| is false.
-  std::atomic_int number_of_active_workers_ = 0;
-  std::list<std::thread> workers_ GUARDED_BY(lock_);
 
   static_assert(std::atomic_bool::is_always_lock_free, "bool not lock-free");
-  static_assert(std::atomic_int::is_always_lock_free, "int not lock-free");
 };
 
 }  // namespace base
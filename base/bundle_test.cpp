@@ -1,9 +1,12 @@
 ﻿
 #include "base/bundle.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <thread>
 #include <vector>
 
+#include "absl/synchronization/mutex.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "testing_utilities/matchers.hpp"
@@ -87,5 +90,116 @@ TEST_F(BundleTest, Deadline) {
   EXPECT_THAT(status.message(), Eq("bundle deadline exceeded"));
 }
 
+TEST_F(BundleTest, Error) {
+  for (int i = 0; i < workers; ++i) {
+    bundle_.Add([i]() {
+      return i == 3 ? Status(Error::OUT_OF_RANGE, "three") : Status::OK;
+    });
+  }
+  auto const status = bundle_.Join();
+  EXPECT_THAT(status.error(), Eq(Error::OUT_OF_RANGE));
+  EXPECT_THAT(status.message(), Eq("three"));
+}
+
+// Many more tasks than threads in the pool.
+TEST_F(BundleTest, ManyTasks) {
+  constexpr int tasks = 10'000;
+  std::atomic_int count = 0;
+  for (int i = 0; i < tasks; ++i) {
+    bundle_.Add([&count]() {
+      ++count;
+      return Status::OK;
+    });
+  }
+  EXPECT_OK(bundle_.Join());
+  EXPECT_THAT(count, Eq(tasks));
+}
+
+TEST_F(BundleTest, MaxConcurrency) {
+  constexpr int max_concurrency = 2;
+  Bundle bundle(max_concurrency);
+  absl::Mutex lock;
+  int executing = 0;
+  int max_executing = 0;
+  for (int i = 0; i < 4 * workers; ++i) {
+    bundle.Add([&lock, &executing, &max_executing]() {
+      absl::MutexLock l(&lock);
+      ++executing;
+      max_executing = std::max(max_executing, executing);
+      // The first tasks wait until |max_concurrency| of them are executing, so
+      // that the limit is reached irrespective of the timing of the threads.
+      // Any task started beyond the limit meanwhile would be counted.
+      auto const limit_reached = [&lock, &max_executing]() {
+        lock.AssertReaderHeld();
+        return max_executing >= max_concurrency;
+      };
+      lock.Await(absl::Condition(&limit_reached));
+      --executing;
+      return Status::OK;
+    });
+  }
+  EXPECT_OK(bundle.Join());
+  EXPECT_THAT(max_executing, Eq(max_concurrency));
+}
+
+// Joining bundles from the tasks of another bundle must not deadlock, even if
+// the outer tasks occupy all the threads of the pool.
+TEST_F(BundleTest, Nested) {
+  int const outer_tasks = 2 * std::thread::hardware_concurrency();
+  std::atomic_int count = 0;
+  for (int i = 0; i < outer_tasks; ++i) {
+    bundle_.Add([&count]() {
+      Bundle inner;
+      for (int j = 0; j < workers; ++j) {
+        inner.Add([&count]() {
+          ++count;
+          return Status::OK;
+        });
+      }
+      return inner.Join();
+    });
+  }
+  EXPECT_OK(bundle_.Join());
+  EXPECT_THAT(count, Eq(outer_tasks * workers));
+}
+
+// Same as above, but the inner bundles are joined with a deadline.
+TEST_F(BundleTest, NestedWithDeadline) {
+  int const outer_tasks = 2 * std::thread::hardware_concurrency();
+  std::atomic_int count = 0;
+  for (int i = 0; i < outer_tasks; ++i) {
+    bundle_.Add([&count]() {
+      Bundle inner;
+      for (int j = 0; j < workers; ++j) {
+        inner.Add([&count]() {
+          ++count;
+          return Status::OK;
+        });
+      }
+      return inner.JoinWithin(1h);
+    });
+  }
+  EXPECT_OK(bundle_.Join());
+  EXPECT_THAT(count, Eq(outer_tasks * workers));
+}
+
+TEST_F(BundleTest, Cancellation) {
+  Bundle bundle(/*max_concurrency=*/1);
+  std::atomic_int started = 0;
+  for (int i = 0; i < workers; ++i) {
+    bundle.Add([&bundle, &started]() {
+      ++started;
+      while (!bundle.cancelled()) {
+        std::this_thread::sleep_for(1ms);
+      }
+      return Status::CANCELLED;
+    });
+  }
+  auto const status = bundle.JoinWithin(10ms);
+  EXPECT_THAT(status.error(), Eq(Error::DEADLINE_EXCEEDED));
+  // The tasks that had not started were dropped.
+  EXPECT_THAT(started, Eq(1));
+}
+
 }  // namespace base
 }  // namespace principia
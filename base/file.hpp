@@ -13,11 +13,16 @@ class OFStream {
  public:
   OFStream();
   explicit OFStream(std::filesystem::path const& path);
+  // Use |std::ios::app| as the |mode| to append to an existing file.
+  OFStream(std::filesystem::path const& path, std::ios::openmode mode);
   ~OFStream();
 
   OFStream& operator=(OFStream&& other);
   OFStream& operator<<(std::string const& s);
 
+  // Writes the buffered data to the file.
+  void Flush();
+
  private:
   std::ofstream stream_;
 };
@@ -15,7 +15,11 @@ namespace internal_file {
 
 inline OFStream::OFStream() {}
 
-inline OFStream::OFStream(std::filesystem::path const& path) {
+inline OFStream::OFStream(std::filesystem::path const& path)
+    : OFStream(path, std::ios::out) {}
+
+inline OFStream::OFStream(std::filesystem::path const& path,
+                          std::ios::openmode const mode) {
 #if PRINCIPIA_COMPILER_MSVC
   CHECK(path.has_filename()) << path;
   // Don't use |remove_filename| here as it leaves a trailing \.  See
@@ -28,7 +32,7 @@ inline OFStream::OFStream(std::filesystem::path const& path) {
         << directory << " " << e << " " << e.message();
   }
 #endif
-  stream_.open(path);
+  stream_.open(path, mode);
   CHECK(stream_.good()) << path;
 }
 
@@ -48,6 +52,11 @@ inline OFStream&  OFStream::operator<<(std::string const& s) {
   return *this;
 }
 
+inline void OFStream::Flush() {
+  CHECK(stream_.good());
+  stream_.flush();
+}
+
 }  // namespace internal_file
 }  // namespace base
 }  // namespace principia
@@ -159,6 +159,17 @@ inline void noreturn() { std::exit(0); }
 #  error "What compiler is this?"
 #endif
 
+// Used at the beginning of a block to prevent the compiler from contracting a
+// multiplication and an addition into an FMA, which would make the results
+// depend on the platform.  Where the compiler doesn't let us turn contraction
+// off, the code must round each product in a statement of its own, which
+// prevents contraction when it is restricted to expressions.
+#if PRINCIPIA_COMPILER_CLANG || PRINCIPIA_COMPILER_CLANG_CL
+#  define PRINCIPIA_NO_FP_CONTRACT _Pragma("clang fp contract(off)")
+#else
+#  define PRINCIPIA_NO_FP_CONTRACT
+#endif
+
 // We assume that the processor is at least a Prescott since we only support
 // 64-bit architectures.
 #define PRINCIPIA_USE_SSE3_INTRINSICS !_DEBUG
@@ -17,6 +17,7 @@
 #include "base/serialization.hpp"
 #include "gipfeli/gipfeli.h"
 #include "gmock/gmock.h"
+#include "google/protobuf/arena.h"
 #include "serialization/physics.pb.h"
 #include "testing_utilities/matchers.hpp"
 
@@ -307,6 +308,40 @@ TEST_F(PushDeserializerTest, SerializationDeserialization) {
       /*deserializer_compressor=*/google::compression::NewGipfeliCompressor());
 }
 
+// Check that messages owned by an arena may be serialized and deserialized, as
+// is done for the plugin.
+TEST_F(PushDeserializerTest, Arena) {
+  google::protobuf::Arena arena;
+  auto const written_trajectory =
+      google::protobuf::Arena::CreateMessage<DiscreteTrajectory>(&arena);
+  written_trajectory->CopyFrom(*BuildTrajectory());
+  auto const read_trajectory =
+      google::protobuf::Arena::CreateMessage<DiscreteTrajectory>(&arena);
+  int const byte_size = written_trajectory->ByteSize();
+  auto storage = std::make_unique<std::uint8_t[]>(byte_size);
+  std::uint8_t* data = &storage[0];
+
+  pull_serializer_->Start(written_trajectory);
+  push_deserializer_->Start(read_trajectory,
+                            PushDeserializerTest::CheckSerialization);
+  for (;;) {
+    Array<std::uint8_t> const bytes = pull_serializer_->Pull();
+    std::memcpy(data, bytes.data, static_cast<std::size_t>(bytes.size));
+    push_deserializer_->Push(Array<std::uint8_t>(data, bytes.size), nullptr);
+    data = &data[bytes.size];
+    if (bytes.size == 0) {
+      break;
+    }
+  }
+
+  // Destroying the deserializer waits until deserialization is done.
+  pull_serializer_.reset();
+  push_deserializer_.reset();
+  EXPECT_EQ(&arena, read_trajectory->GetArena());
+  EXPECT_EQ(&arena, read_trajectory->mutable_timeline(0)->GetArena());
+  EXPECT_THAT(*read_trajectory, EqualsProto(*written_trajectory));
+}
+
 // Check that deserialization fails if we stomp on one extra byte.
 TEST_F(PushDeserializerDeathTest, Stomp) {
   EXPECT_DEATH({
@@ -0,0 +1,62 @@
+﻿
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "base/not_null.hpp"
+
+namespace principia {
+namespace base {
+namespace internal_xor_compression {
+
+// Lossless compression of a stream of doubles for which the client is able to
+// make good predictions.  Each value is stored as the exclusive or of its bits
+// with those of its prediction, of which only the low-order nonzero bytes are
+// kept.  The number of bytes kept is stored in a nibble, and the nibbles of two
+// consecutive values share a byte which precedes their payloads.
+// The decompressor must be given the same predictions as the compressor, so
+// the predictions must only depend on the values already (de)compressed and
+// must be computed reproducibly.
+class XorCompressor final {
+ public:
+  // The compressed values are appended to |bytes|.
+  explicit XorCompressor(not_null<std::string*> bytes);
+
+  void Append(double predicted, double actual);
+
+ private:
+  not_null<std::string*> const bytes_;
+  // The index in |*bytes_| of the byte whose high nibble is not yet used.
+  std::optional<std::size_t> pending_header_;
+};
+
+class XorDecompressor final {
+ public:
+  // |bytes| must outlive this object.
+  explicit XorDecompressor(std::string const& bytes);
+
+  // True if all the bytes have been consumed.  Since a group of two values
+  // always uses at least one byte, this is a reliable end-of-stream indicator
+  // at the boundaries of groups of at least two values.
+  bool exhausted() const;
+
+  double Next(double predicted);
+
+ private:
+  std::string const& bytes_;
+  std::size_t position_ = 0;
+  // The high nibble of the last header read, if not yet used.
+  std::optional<int> pending_significant_bytes_;
+};
+
+}  // namespace internal_xor_compression
+
+using internal_xor_compression::XorCompressor;
+using internal_xor_compression::XorDecompressor;
+
+}  // namespace base
+}  // namespace principia
+
+#include "base/xor_compression_body.hpp"
@@ -0,0 +1,81 @@
+﻿
+#pragma once
+
+#include "base/xor_compression.hpp"
+
+#include <cstring>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace internal_xor_compression {
+
+inline std::uint64_t Bits(double const value) {
+  std::uint64_t result;
+  std::memcpy(&result, &value, sizeof(result));
+  return result;
+}
+
+inline double FromBits(std::uint64_t const bits) {
+  double result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+inline XorCompressor::XorCompressor(not_null<std::string*> const bytes)
+    : bytes_(bytes) {}
+
+inline void XorCompressor::Append(double const predicted,
+                                  double const actual) {
+  std::uint64_t const residual = Bits(predicted) ^ Bits(actual);
+  int significant_bytes = 0;
+  for (std::uint64_t r = residual; r != 0; r >>= 8) {
+    ++significant_bytes;
+  }
+  if (pending_header_.has_value()) {
+    char& header = (*bytes_)[*pending_header_];
+    header = static_cast<char>(static_cast<std::uint8_t>(header) |
+                               (significant_bytes << 4));
+    pending_header_.reset();
+  } else {
+    pending_header_ = bytes_->size();
+    bytes_->push_back(static_cast<char>(significant_bytes));
+  }
+  for (int i = 0; i < significant_bytes; ++i) {
+    bytes_->push_back(static_cast<char>((residual >> (8 * i)) & 0xFF));
+  }
+}
+
+inline XorDecompressor::XorDecompressor(std::string const& bytes)
+    : bytes_(bytes) {}
+
+inline bool XorDecompressor::exhausted() const {
+  return position_ == bytes_.size();
+}
+
+inline double XorDecompressor::Next(double const predicted) {
+  int significant_bytes;
+  if (pending_significant_bytes_.has_value()) {
+    significant_bytes = *pending_significant_bytes_;
+    pending_significant_bytes_.reset();
+  } else {
+    CHECK_LT(position_, bytes_.size());
+    auto const header = static_cast<std::uint8_t>(bytes_[position_++]);
+    significant_bytes = header & 0x0F;
+    pending_significant_bytes_ = header >> 4;
+  }
+  CHECK_LE(significant_bytes, 8);
+  CHECK_LE(position_ + significant_bytes, bytes_.size());
+  std::uint64_t residual = 0;
+  for (int i = 0; i < significant_bytes; ++i) {
+    residual |=
+        static_cast<std::uint64_t>(
+            static_cast<std::uint8_t>(bytes_[position_++])) << (8 * i);
+  }
+  return FromBits(Bits(predicted) ^ residual);
+}
+
+}  // namespace internal_xor_compression
+}  // namespace base
+}  // namespace principia
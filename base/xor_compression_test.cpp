@@ -0,0 +1,93 @@
+﻿
+#include "base/xor_compression.hpp"
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+class XorCompressionTest : public testing::Test {
+ protected:
+  // Compresses and decompresses |values| using for each value the predictions
+  // |predict(previous value)|, checks that the round trip is lossless and
+  // returns the number of compressed bytes.
+  template<typename Predict>
+  std::size_t RoundTrip(std::vector<double> const& values,
+                        Predict const& predict) {
+    std::string bytes;
+    XorCompressor compressor(&bytes);
+    double previous = 0;
+    for (double const value : values) {
+      compressor.Append(predict(previous), value);
+      previous = value;
+    }
+
+    XorDecompressor decompressor(bytes);
+    previous = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      double const value = values[i];
+      // The values are taken as groups of two.
+      if (i % 2 == 0) {
+        EXPECT_FALSE(decompressor.exhausted());
+      }
+      double const decompressed = decompressor.Next(predict(previous));
+      EXPECT_EQ(0, std::memcmp(&value, &decompressed, sizeof(double)));
+      previous = decompressed;
+    }
+    EXPECT_TRUE(decompressor.exhausted());
+    return bytes.size();
+  }
+};
+
+TEST_F(XorCompressionTest, Exact) {
+  std::vector<double> const values(100, 1.0 / 3.0);
+  // The first value is stored in full.
+  EXPECT_EQ(50 + 8,
+            RoundTrip(values, [](double const previous) { return previous; }));
+}
+
+TEST_F(XorCompressionTest, GoodPredictions) {
+  std::vector<double> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(1 + i * 1e-12);
+  }
+  // Predicting the previous value cancels the sign, the exponent and the
+  // leading bits of the mantissa.
+  std::size_t const size =
+      RoundTrip(values, [](double const previous) { return previous; });
+  EXPECT_LT(size, 4 * values.size());
+  EXPECT_GT(size, values.size());
+}
+
+TEST_F(XorCompressionTest, BadPredictions) {
+  std::vector<double> const values = {1, -2, 1e300, 1e-300, 42};
+  EXPECT_EQ(3 + 5 * 8,
+            RoundTrip(values, [](double const previous) {
+              return -1 / previous;
+            }));
+}
+
+TEST_F(XorCompressionTest, SpecialValues) {
+  std::vector<double> const values = {
+      0.0,
+      -0.0,
+      std::numeric_limits<double>::infinity(),
+      -std::numeric_limits<double>::infinity(),
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::denorm_min(),
+      std::numeric_limits<double>::max()};
+  RoundTrip(values, [](double const previous) { return previous; });
+}
+
+TEST_F(XorCompressionTest, Empty) {
+  EXPECT_EQ(0, RoundTrip({}, [](double const previous) { return previous; }));
+}
+
+}  // namespace base
+}  // namespace principia
@@ -1,10 +1,12 @@
 ﻿
 // .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=Ephemeris                                                                     // NOLINT(whitespace/line_length)
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <list>
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -25,6 +27,7 @@
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
+#include "physics/massive_body.hpp"
 #include "physics/massless_body.hpp"
 #include "quantities/astronomy.hpp"
 #include "quantities/bipm.hpp"
@@ -61,7 +64,9 @@ using integrators::methods::QuinlanTremaine1990Order12;
 using ksp_plugin::Barycentric;
 using quantities::DebugString;
 using quantities::Frequency;
+using quantities::GravitationalParameter;
 using quantities::Length;
+using quantities::Pow;
 using quantities::Speed;
 using quantities::Sqrt;
 using quantities::Time;
@@ -70,6 +75,7 @@ using quantities::astronomy::JulianYear;
 using quantities::bipm::NauticalMile;
 using quantities::si::ArcMinute;
 using quantities::si::ArcSecond;
+using quantities::si::Day;
 using quantities::si::Degree;
 using quantities::si::Hertz;
 using quantities::si::Kilo;
@@ -179,6 +185,97 @@ void BM_EphemerisSolarSystem(benchmark::State& state) {
   state.SetLabel(quantities::DebugString(error / AstronomicalUnit) + " ua");
 }
 
+// Constructs an ephemeris for the major bodies of the solar system and
+// |number_of_asteroids| light bodies on circular orbits in the main belt.  The
+// attraction between the light bodies is approximated with the given
+// |far_field_opening_angle|, or computed exactly if it is 0.
+not_null<std::unique_ptr<Ephemeris<Barycentric>>> MakeAsteroidBeltEphemeris(
+    int const number_of_asteroids,
+    double const far_field_opening_angle) {
+  auto const at_спутник_1_launch = SolarSystemAtСпутник1Launch(
+      SolarSystemFactory::Accuracy::MajorBodiesOnly);
+  std::string const sun_name =
+      SolarSystemFactory::name(SolarSystemFactory::Sun);
+  GravitationalParameter const μ_sun =
+      at_спутник_1_launch->gravitational_parameter(sun_name);
+  DegreesOfFreedom<Barycentric> const sun_degrees_of_freedom =
+      at_спутник_1_launch->degrees_of_freedom(sun_name);
+
+  auto bodies = at_спутник_1_launch->MakeAllMassiveBodies();
+  std::vector<DegreesOfFreedom<Barycentric>> initial_state;
+  for (auto const& name : at_спутник_1_launch->names()) {
+    initial_state.push_back(at_спутник_1_launch->degrees_of_freedom(name));
+  }
+
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<double> radius_distribution(2.2, 3.3);
+  std::uniform_real_distribution<double> angle_distribution(0, 2 * π);
+  std::uniform_real_distribution<double> height_distribution(-0.05, 0.05);
+  for (int i = 0; i < number_of_asteroids; ++i) {
+    Length const r = radius_distribution(random) * AstronomicalUnit;
+    double const θ = angle_distribution(random);
+    Speed const v = Sqrt(μ_sun / r);
+    bodies.emplace_back(make_not_null_unique<MassiveBody>(
+        MassiveBody::Parameters(1e9 * Pow<3>(Metre) / Pow<2>(Second))));
+    initial_state.push_back(
+        sun_degrees_of_freedom +
+        RelativeDegreesOfFreedom<Barycentric>(
+            Displacement<Barycentric>({r * std::cos(θ),
+                                       r * std::sin(θ),
+                                       height_distribution(random) * r}),
+            Velocity<Barycentric>(
+                {-v * std::sin(θ), v * std::cos(θ), Speed()})));
+  }
+
+  return make_not_null_unique<Ephemeris<Barycentric>>(
+      std::move(bodies),
+      initial_state,
+      at_спутник_1_launch->epoch(),
+      Ephemeris<Barycentric>::AccuracyParameters(
+          FittingTolerance(-3),
+          /*geopotential_tolerance=*/0x1p-24,
+          far_field_opening_angle,
+          /*light_body_gravitational_parameter=*/
+              1e10 * Pow<3>(Metre) / Pow<2>(Second)),
+      EphemerisParameters());
+}
+
+// Integrates an asteroid belt of |state.range(0)| bodies for 10 days, with a
+// far-field opening angle of |state.range(1) / 10|.  The label is the largest
+// distance between the final positions of the asteroids and those obtained
+// with the direct sum.
+void BM_EphemerisAsteroidBelt(benchmark::State& state) {
+  int const number_of_asteroids = state.range(0);
+  double const far_field_opening_angle = state.range(1) / 10.0;
+  Length error;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    auto const reference = MakeAsteroidBeltEphemeris(
+        number_of_asteroids, /*far_field_opening_angle=*/0);
+    auto const ephemeris =
+        MakeAsteroidBeltEphemeris(number_of_asteroids, far_field_opening_angle);
+    Instant const final_time = ephemeris->t_max() + 10 * Day;
+    reference->Prolong(final_time);
+
+    state.ResumeTiming();
+    ephemeris->Prolong(final_time);
+    state.PauseTiming();
+    error = Length();
+    for (int i = ephemeris->bodies().size() - number_of_asteroids;
+         i < ephemeris->bodies().size();
+         ++i) {
+      error = std::max(
+          error,
+          (ephemeris->trajectory(ephemeris->bodies()[i])->
+               EvaluatePosition(final_time) -
+           reference->trajectory(reference->bodies()[i])->
+               EvaluatePosition(final_time)).Norm());
+    }
+    state.ResumeTiming();
+  }
+  state.SetLabel(quantities::DebugString(error / Metre) + " m");
+}
+
 template<SolarSystemFactory::Accuracy accuracy, Flow* flow>
 void BM_EphemerisLEOProbe(benchmark::State& state) {
   Length sun_error;
@@ -597,6 +694,14 @@ BENCHMARK_TEMPLATE(BM_EphemerisSolarSystem,
 BENCHMARK_TEMPLATE(BM_EphemerisSolarSystem,
                    SolarSystemFactory::Accuracy::AllBodiesAndDampedOblateness)
     ->Arg(-3);
+BENCHMARK(BM_EphemerisAsteroidBelt)
+    ->ArgPair(100, 0)
+    ->ArgPair(100, 5)
+    ->ArgPair(1000, 0)
+    ->ArgPair(1000, 3)
+    ->ArgPair(1000, 5)
+    ->ArgPair(3000, 0)
+    ->ArgPair(3000, 5);
 BENCHMARK_TEMPLATE(BM_EphemerisL4Probe,
                    SolarSystemFactory::Accuracy::MajorBodiesOnly,
                    &FlowEphemerisWithAdaptiveStep)
@@ -0,0 +1,72 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=10 --benchmark_min_time=2 --benchmark_filter=SinCos  // NOLINT(whitespace/line_length)
+
+#include "numerics/sin_cos.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+namespace principia {
+namespace numerics {
+
+namespace {
+
+std::vector<double> Arguments(double const bound) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-bound, bound);
+  std::vector<double> input;
+  for (int i = 0; i < 1e3; ++i) {
+    input.push_back(distribution(random));
+  }
+  return input;
+}
+
+}  // namespace
+
+void BM_LibmSinCos(benchmark::State& state) {
+  std::vector<double> const input = Arguments(state.range_x());
+  while (state.KeepRunning()) {
+    double sin;
+    double cos;
+    for (double const x : input) {
+      sin = std::sin(x);
+      cos = std::cos(x);
+      benchmark::DoNotOptimize(sin);
+      benchmark::DoNotOptimize(cos);
+    }
+  }
+}
+
+void BM_ScalarSinCos(benchmark::State& state) {
+  std::vector<double> const input = Arguments(state.range_x());
+  while (state.KeepRunning()) {
+    double sin;
+    double cos;
+    for (double const x : input) {
+      ReproducibleSinCos(x, sin, cos);
+      benchmark::DoNotOptimize(sin);
+      benchmark::DoNotOptimize(cos);
+    }
+  }
+}
+
+void BM_BatchSinCos(benchmark::State& state) {
+  std::vector<double> const input = Arguments(state.range_x());
+  std::vector<double> sin;
+  std::vector<double> cos;
+  while (state.KeepRunning()) {
+    ReproducibleSinCos(input, &sin, &cos);
+    benchmark::DoNotOptimize(sin.data());
+    benchmark::DoNotOptimize(cos.data());
+  }
+}
+
+BENCHMARK(BM_LibmSinCos)->Arg(1)->Arg(1000);
+BENCHMARK(BM_ScalarSinCos)->Arg(1)->Arg(1000);
+BENCHMARK(BM_BatchSinCos)->Arg(1)->Arg(1000);
+
+}  // namespace numerics
+}  // namespace principia
@@ -43,6 +43,9 @@ class Perspective final {
 
   Length const& focal() const;
 
+  // The position of the camera in |FromFrame|.
+  Position<FromFrame> const& camera() const;
+
   // Returns the ℝP² element resulting from the projection of |point|.  This
   // is properly defined for all points other than the camera origin.
   RP2Point<Length, ToFrame> operator()(Position<FromFrame> const& point) const;
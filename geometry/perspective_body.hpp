@@ -45,6 +45,11 @@ Length const& Perspective<FromFrame, ToFrame>::focal() const {
   return focal_;
 }
 
+template<typename FromFrame, typename ToFrame>
+Position<FromFrame> const& Perspective<FromFrame, ToFrame>::camera() const {
+  return camera_;
+}
+
 template<typename FromFrame, typename ToFrame>
 RP2Point<Length, ToFrame> Perspective<FromFrame, ToFrame>::
 operator()(Position<FromFrame> const& point) const {
@@ -21,11 +21,10 @@ namespace internal_r3_element {
 
 using quantities::ArcSin;
 using quantities::ArcTan;
-using quantities::Cos;
 using quantities::DebugString;
 using quantities::DoubleOrQuantitySerializer;
 using quantities::Quantity;
-using quantities::Sin;
+using quantities::SinCos;
 using quantities::SIUnit;
 using quantities::ToM128D;
 
@@ -190,10 +189,15 @@ SphericalCoordinates<Scalar>::SphericalCoordinates() {}
 
 template<typename Scalar>
 R3Element<Scalar> SphericalCoordinates<Scalar>::ToCartesian() {
-  double const cos_latitude = Cos(latitude);
-  return {radius * Cos(longitude) * cos_latitude,
-          radius * Sin(longitude) * cos_latitude,
-          radius * Sin(latitude)};
+  double sin_latitude;
+  double cos_latitude;
+  SinCos(latitude, sin_latitude, cos_latitude);
+  double sin_longitude;
+  double cos_longitude;
+  SinCos(longitude, sin_longitude, cos_longitude);
+  return {radius * cos_longitude * cos_latitude,
+          radius * sin_longitude * cos_latitude,
+          radius * sin_latitude};
 }
 
 template<typename Scalar>
@@ -247,8 +247,13 @@ Rotation<FromFrame, ToFrame> operator*(
     Rotation<ThroughFrame, ToFrame> const& left,
     Rotation<FromFrame, ThroughFrame> const& right);
 
+// Returns the quaternion of a rotation of |angle| around |axis|.  |axis| must
+// be normalized.
+inline Quaternion AngleAxis(Angle const& angle, R3Element<double> const& axis);
+
 }  // namespace internal_rotation
 
+using internal_rotation::AngleAxis;
 using internal_rotation::CardanoAngles;
 using internal_rotation::DefinesFrame;
 using internal_rotation::EulerAngles;
@@ -17,8 +17,7 @@ namespace geometry {
 namespace internal_rotation {
 
 using base::not_null;
-using quantities::Cos;
-using quantities::Sin;
+using quantities::SinCos;
 
 // Well-conditioned conversion of a rotation matrix to a quaternion.  See
 // http://en.wikipedia.org/wiki/Rotation_matrix#Quaternion and
@@ -64,10 +63,11 @@ FORCE_INLINE(inline) Quaternion ToQuaternion(R3x3Matrix<double> const& matrix) {
   return Quaternion(real_part, imaginary_part);
 }
 
-// Returns a rotation of |angle| around |axis|.  |axis| must be normalized.
 inline Quaternion AngleAxis(Angle const& angle, R3Element<double> const& axis) {
-  quantities::Angle const half_angle = 0.5 * angle;
-  return Quaternion(Cos(half_angle), Sin(half_angle) * axis);
+  double sin_half_angle;
+  double cos_half_angle;
+  SinCos(0.5 * angle, sin_half_angle, cos_half_angle);
+  return Quaternion(cos_half_angle, sin_half_angle * axis);
 }
 
 // Returns the digits of the 3ⁿs from the given |BinaryCodedTernary number|.
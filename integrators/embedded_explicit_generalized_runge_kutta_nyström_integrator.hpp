@@ -103,6 +103,11 @@ class EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator
         not_null<serialization::IntegratorInstance*> message) const override;
 
    private:
+    // The body of |Solve|, specialized for the given summation policy so that
+    // the choice is not made in the inner loop.
+    template<CompensatedSummation compensated_summation>
+    Status SolveWithCompensatedSummation(Instant const& t_final);
+
     Instance(IntegrationProblem<ODE> const& problem,
              AppendState const& append_state,
              ToleranceToErrorRatio const& tolerance_to_error_ratio,
@@ -148,6 +148,93 @@ TEST_F(EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegratorTest, Legendre) {
   EXPECT_THAT(max_derivative_error, IsNear(4.54e-3 / Second));
 }
 
+// Checks that turning off compensated summation, in part or entirely, leaves
+// the accuracy of a short integration essentially unchanged.
+TEST_F(EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegratorTest,
+       CompensatedSummation) {
+  AdaptiveStepSizeIntegrator<ODE> const& integrator =
+      EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator<
+          methods::Fine1987RKNG34,
+          double>();
+  constexpr int degree = 3;
+  double const x_initial = 0;
+  Variation<double> const v_initial = -3 / (2 * Second);
+  Instant const t_initial;
+  Instant const t_final = t_initial + 0.99 * Second;
+  double const tolerance = 1e-6;
+  Variation<double> const derivative_tolerance = 1e-6 / Second;
+
+  ODE legendre_equation;
+  legendre_equation.compute_acceleration =
+      std::bind(ComputeLegendrePolynomialSecondDerivative<degree>,
+                _1, _2, _3, _4, /*evaluations=*/nullptr);
+  IntegrationProblem<ODE> problem;
+  problem.equation = legendre_equation;
+  problem.initial_state = {{x_initial}, {v_initial}, t_initial};
+  auto const tolerance_to_error_ratio = std::bind(ToleranceToErrorRatio,
+                                                  _1,
+                                                  _2,
+                                                  tolerance,
+                                                  derivative_tolerance,
+                                                  [](bool tolerable) {});
+
+  auto const solve = [&integrator, &problem, &t_final, &t_initial,
+                      &tolerance_to_error_ratio](
+      CompensatedSummation const compensated_summation) {
+    ODE::SystemState last_state;
+    AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+        /*first_time_step=*/t_final - t_initial,
+        /*safety_factor=*/0.9,
+        /*max_steps=*/std::numeric_limits<std::int64_t>::max(),
+        /*last_step_is_exact=*/true,
+        compensated_summation);
+    auto instance = integrator.NewInstance(
+        problem,
+        [&last_state](ODE::SystemState const& state) { last_state = state; },
+        tolerance_to_error_ratio,
+        parameters);
+    EXPECT_EQ(termination_condition::Done, instance->Solve(t_final).error());
+    return last_state;
+  };
+
+  ODE::SystemState const full = solve(CompensatedSummation::Full);
+  ODE::SystemState const time_only = solve(CompensatedSummation::TimeOnly);
+  ODE::SystemState const none = solve(CompensatedSummation::None);
+
+  EXPECT_EQ(t_final, full.time.value);
+  EXPECT_EQ(t_final, time_only.time.value);
+  EXPECT_THAT(AbsoluteError(t_final, none.time.value),
+              Lt(1e-12 * Second));
+
+  // The uncompensated accumulators don't carry any error term.
+  EXPECT_EQ(0, time_only.positions[0].error);
+  EXPECT_EQ(0 / Second, time_only.velocities[0].error);
+  EXPECT_EQ(0 * Second, none.time.error);
+  EXPECT_EQ(0, none.positions[0].error);
+  EXPECT_EQ(0 / Second, none.velocities[0].error);
+
+  // The errors with respect to the exact solution are dominated by the
+  // truncation error, which is the same for all policies.
+  double const x = (t_final - t_initial) / (1 * Second);
+  for (auto const* const state : {&full, &time_only, &none}) {
+    EXPECT_THAT(
+        AbsoluteError(LegendrePolynomial<degree, EstrinEvaluator>().Evaluate(x),
+                      state->positions[0].value),
+        IsNear(1.1e-4));
+    EXPECT_THAT(
+        AbsoluteError(LegendrePolynomial<degree, EstrinEvaluator>().
+                          Derivative().Evaluate(x) / (1 * Second),
+                      state->velocities[0].value),
+        IsNear(4.5e-3 / Second));
+  }
+  EXPECT_THAT(AbsoluteError(full.positions[0].value,
+                            none.positions[0].value),
+              Lt(1e-12));
+  EXPECT_THAT(AbsoluteError(full.velocities[0].value,
+                            none.velocities[0].value),
+              Lt(1e-12 / Second));
+}
+
 }  // namespace internal_embedded_explicit_generalized_runge_kutta_nyström_integrator  // NOLINT
 }  // namespace integrators
 }  // namespace principia
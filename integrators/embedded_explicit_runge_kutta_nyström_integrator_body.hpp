@@ -9,6 +9,7 @@
 #include <optional>
 #include <vector>
 
+#include "base/macros.hpp"
 #include "geometry/sign.hpp"
 #include "glog/logging.h"
 #include "quantities/quantities.hpp"
@@ -19,6 +20,9 @@ namespace internal_embedded_explicit_runge_kutta_nyström_integrator {
 
 using base::make_not_null_unique;
 using geometry::Sign;
+using internal_integrators::CompensatesState;
+using internal_integrators::CompensatesTime;
+using internal_integrators::Increment;
 using numerics::DoublePrecision;
 using quantities::DebugString;
 using quantities::Difference;
@@ -44,6 +48,25 @@ EmbeddedExplicitRungeKuttaNyströmIntegrator() {
 template<typename Method, typename Position>
 Status EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, Position>::
 Instance::Solve(Instant const& t_final) {
+  switch (this->parameters_.compensated_summation) {
+    case CompensatedSummation::Full:
+      return SolveWithCompensatedSummation<CompensatedSummation::Full>(
+          t_final);
+    case CompensatedSummation::TimeOnly:
+      return SolveWithCompensatedSummation<CompensatedSummation::TimeOnly>(
+          t_final);
+    case CompensatedSummation::None:
+      return SolveWithCompensatedSummation<CompensatedSummation::None>(
+          t_final);
+  }
+  LOG(FATAL) << "Unexpected summation policy";
+  base::noreturn();
+}
+
+template<typename Method, typename Position>
+template<CompensatedSummation compensated_summation>
+Status EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, Position>::
+Instance::SolveWithCompensatedSummation(Instant const& t_final) {
   using Displacement = typename ODE::Displacement;
   using Velocity = typename ODE::Velocity;
   using Acceleration = typename ODE::Acceleration;
@@ -189,6 +212,9 @@ Instance::Solve(Instant const& t_final) {
         }
         step_status.Update(
             equation.compute_acceleration(t_stage, q_stage, g[i]));
+        if (step_status.error() == termination_condition::Cancelled) {
+          return step_status;
+        }
       }
 
       // Increment computation and step size control.
@@ -233,10 +259,10 @@ Instance::Solve(Instant const& t_final) {
     }
 
     // Increment the solution with the high-order approximation.
-    t.Increment(h);
+    Increment<CompensatesTime(compensated_summation)>(t, h);
     for (int k = 0; k < dimension; ++k) {
-      q̂[k].Increment(Δq̂[k]);
-      v̂[k].Increment(Δv̂[k]);
+      Increment<CompensatesState(compensated_summation)>(q̂[k], Δq̂[k]);
+      Increment<CompensatesState(compensated_summation)>(v̂[k], Δv̂[k]);
     }
     append_state(current_state);
     ++step_count;
@@ -177,6 +177,86 @@ TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest,
   EXPECT_EQ(11, subsequent_rejections);
 }
 
+// Checks that turning off compensated summation, in part or entirely, leaves
+// the accuracy of a short integration essentially unchanged.
+TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, CompensatedSummation) {
+  AdaptiveStepSizeIntegrator<ODE> const& integrator =
+      EmbeddedExplicitRungeKuttaNyströmIntegrator<
+          methods::DormandالمكاوىPrince1986RKN434FM,
+          Length>();
+  Length const x_initial = 1 * Metre;
+  Speed const v_initial = 0 * Metre / Second;
+  Time const period = 2 * π * Second;
+  Instant const t_initial;
+  Instant const t_final = t_initial + 10 * period;
+  Length const length_tolerance = 1 * Milli(Metre);
+  Speed const speed_tolerance = 1 * Milli(Metre) / Second;
+
+  ODE harmonic_oscillator;
+  harmonic_oscillator.compute_acceleration =
+      std::bind(ComputeHarmonicOscillatorAcceleration1D,
+                _1, _2, _3, /*evaluations=*/nullptr);
+  IntegrationProblem<ODE> problem;
+  problem.equation = harmonic_oscillator;
+  problem.initial_state = {{x_initial}, {v_initial}, t_initial};
+  auto const tolerance_to_error_ratio =
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2,
+                length_tolerance,
+                speed_tolerance,
+                [](bool tolerable) {});
+
+  auto const solve = [&integrator, &problem, &t_final, &t_initial,
+                      &tolerance_to_error_ratio](
+      CompensatedSummation const compensated_summation) {
+    ODE::SystemState last_state;
+    AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+        /*first_time_step=*/t_final - t_initial,
+        /*safety_factor=*/0.9,
+        /*max_steps=*/std::numeric_limits<std::int64_t>::max(),
+        /*last_step_is_exact=*/true,
+        compensated_summation);
+    auto instance = integrator.NewInstance(
+        problem,
+        [&last_state](ODE::SystemState const& state) { last_state = state; },
+        tolerance_to_error_ratio,
+        parameters);
+    EXPECT_EQ(termination_condition::Done, instance->Solve(t_final).error());
+    return last_state;
+  };
+
+  ODE::SystemState const full = solve(CompensatedSummation::Full);
+  ODE::SystemState const time_only = solve(CompensatedSummation::TimeOnly);
+  ODE::SystemState const none = solve(CompensatedSummation::None);
+
+  EXPECT_EQ(t_final, full.time.value);
+  EXPECT_EQ(t_final, time_only.time.value);
+  EXPECT_THAT(AbsoluteError(t_final, none.time.value),
+              Lt(1e-12 * Second));
+
+  // The uncompensated accumulators don't carry any error term.
+  EXPECT_EQ(0 * Metre, time_only.positions[0].error);
+  EXPECT_EQ(0 * Metre / Second, time_only.velocities[0].error);
+  EXPECT_EQ(0 * Second, none.time.error);
+  EXPECT_EQ(0 * Metre, none.positions[0].error);
+  EXPECT_EQ(0 * Metre / Second, none.velocities[0].error);
+
+  // The errors with respect to the exact solution are dominated by the
+  // truncation error, which is the same for all policies.
+  for (auto const* const state : {&full, &time_only, &none}) {
+    EXPECT_THAT(AbsoluteError(x_initial, state->positions[0].value),
+                IsNear(3.5e-4 * Metre));
+    EXPECT_THAT(AbsoluteError(v_initial, state->velocities[0].value),
+                IsNear(2.8e-3 * Metre / Second));
+  }
+  EXPECT_THAT(AbsoluteError(full.positions[0].value,
+                            none.positions[0].value),
+              Lt(1e-12 * Metre));
+  EXPECT_THAT(AbsoluteError(full.velocities[0].value,
+                            none.velocities[0].value),
+              Lt(1e-12 * Metre / Second));
+}
+
 TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, MaxSteps) {
   AdaptiveStepSizeIntegrator<ODE> const& integrator =
       EmbeddedExplicitRungeKuttaNyströmIntegrator<
@@ -21,8 +21,33 @@ using base::not_null;
 using base::Status;
 using geometry::Instant;
 using numerics::DoublePrecision;
+using quantities::Difference;
 using quantities::Time;
 
+// Specifies which parts of the state of an integrator are accumulated using
+// compensated summation.  Compensated summation costs a few floating-point
+// operations per coordinate and per step; it is only useful for integrations
+// long enough for the rounding errors to accumulate.
+enum class CompensatedSummation {
+  // Both the time and the positions and velocities.
+  Full,
+  // Only the time.  The step boundaries remain accurate, which is convenient
+  // for clients that compare the times of the integrated points.
+  TimeOnly,
+  // Plain floating-point accumulation everywhere.
+  None,
+};
+
+constexpr bool CompensatesTime(CompensatedSummation compensated_summation);
+constexpr bool CompensatesState(CompensatedSummation compensated_summation);
+
+// Adds |increment| to |accumulator|, using compensated summation iff
+// |compensated|.  If |compensated| is false, |accumulator.error| is left
+// unchanged.
+template<bool compensated, typename T>
+void Increment(DoublePrecision<T>& accumulator,
+               Difference<T> const& increment);
+
 // A base class for integrators.
 template<typename ODE_>
 class Integrator {
@@ -150,6 +175,13 @@ class AdaptiveStepSizeIntegrator : public Integrator<ODE_> {
                            typename ODE::SystemStateError const& error)>;
 
   struct Parameters final {
+    Parameters(Time first_time_step,
+               double safety_factor,
+               std::int64_t max_steps,
+               bool last_step_is_exact,
+               CompensatedSummation compensated_summation);
+
+    // Uses |CompensatedSummation::Full|.
     Parameters(Time first_time_step,
                double safety_factor,
                std::int64_t max_steps,
@@ -179,6 +211,9 @@ class AdaptiveStepSizeIntegrator : public Integrator<ODE_> {
     // |state.time.value == t_final| (unless |max_steps| is reached).  Otherwise
     // it may have |state.time.value < t_final|.
     bool const last_step_is_exact;
+    // The parts of the state that use compensated summation.  Not serialized:
+    // deserialized parameters use |CompensatedSummation::Full|.
+    CompensatedSummation const compensated_summation;
   };
 
   // The last call to |append_state| will have |state.time.value == t_final|.
@@ -242,6 +277,7 @@ AdaptiveStepSizeIntegrator<Equation> const& ParseAdaptiveStepSizeIntegrator(
 }  // namespace internal_integrators
 
 using internal_integrators::AdaptiveStepSizeIntegrator;
+using internal_integrators::CompensatedSummation;
 using internal_integrators::FixedStepSizeIntegrator;
 using internal_integrators::Integrator;
 using internal_integrators::ParseAdaptiveStepSizeIntegrator;
@@ -13,6 +13,7 @@
 #include "integrators/methods.hpp"
 #include "integrators/symmetric_linear_multistep_integrator.hpp"
 #include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
+#include "integrators/wisdom_holman_integrator.hpp"
 
 #define PRINCIPIA_CASE_SLMS(kind, method)                      \
   case serialization::FixedStepSizeIntegrator::kind:           \
@@ -38,6 +39,11 @@
     return SymplecticRungeKuttaNyströmIntegrator<methods::method, \
                                                  typename ODE::Position>()
 
+#define PRINCIPIA_CASE_WH(kind, method)                    \
+  case serialization::FixedStepSizeIntegrator::kind:       \
+    return WisdomHolmanIntegrator<methods::method,         \
+                                  typename ODE::Position>()
+
 namespace principia {
 namespace integrators {
 namespace internal_integrators {
@@ -159,6 +165,26 @@ ReadFromMessage(serialization::AdaptiveStepSizeIntegrator const& message) {
   }
 }
 
+constexpr bool CompensatesTime(
+    CompensatedSummation const compensated_summation) {
+  return compensated_summation != CompensatedSummation::None;
+}
+
+constexpr bool CompensatesState(
+    CompensatedSummation const compensated_summation) {
+  return compensated_summation == CompensatedSummation::Full;
+}
+
+template<bool compensated, typename T>
+FORCE_INLINE(inline) void Increment(DoublePrecision<T>& accumulator,
+                                    Difference<T> const& increment) {
+  if constexpr (compensated) {
+    accumulator.Increment(increment);
+  } else {
+    accumulator.value += increment;
+  }
+}
+
 template<typename ODE_>
 Integrator<ODE_>::Instance::Instance(
     IntegrationProblem<ODE> const& problem,
@@ -250,6 +276,18 @@ FixedStepSizeIntegrator<ODE_>::ReadFromMessage(
                         BlanesMoan2002SRKN14A);
     PRINCIPIA_CASE_SPRK(CANDY_ROZMUS_1991_FOREST_RUTH_1990,
                         CandyRozmus1991ForestRuth1990);
+    PRINCIPIA_CASE_WH(LASKAR_ROBUTEL_2001_SABA_2,
+                      LaskarRobutel2001SABA2);
+    PRINCIPIA_CASE_WH(LASKAR_ROBUTEL_2001_SABA_3,
+                      LaskarRobutel2001SABA3);
+    PRINCIPIA_CASE_WH(LASKAR_ROBUTEL_2001_SABA_4,
+                      LaskarRobutel2001SABA4);
+    PRINCIPIA_CASE_WH(LASKAR_ROBUTEL_2001_SBAB_2,
+                      LaskarRobutel2001SBAB2);
+    PRINCIPIA_CASE_WH(LASKAR_ROBUTEL_2001_SBAB_3,
+                      LaskarRobutel2001SBAB3);
+    PRINCIPIA_CASE_WH(LASKAR_ROBUTEL_2001_SBAB_4,
+                      LaskarRobutel2001SBAB4);
     PRINCIPIA_CASE_SPRK(MCLACHLAN_1995_S2,
                         McLachlan1995S2);
     PRINCIPIA_CASE_SPRK(MCLACHLAN_1995_S4,
@@ -296,6 +334,8 @@ FixedStepSizeIntegrator<ODE_>::ReadFromMessage(
                         Ruth1983);
     PRINCIPIA_CASE_SPRK(SUZUKI_1990,
                         鈴木1990);
+    PRINCIPIA_CASE_WH(WISDOM_HOLMAN_1991,
+                      WisdomHolman1991);
     PRINCIPIA_CASE_SPRK(YOSHIDA_1990_ORDER_6A,
                         吉田1990Order6A);
     PRINCIPIA_CASE_SPRK(YOSHIDA_1990_ORDER_6B,
@@ -336,11 +376,25 @@ AdaptiveStepSizeIntegrator<ODE_>::Parameters::Parameters(
     Time const first_time_step,
     double const safety_factor,
     std::int64_t const max_steps,
-    bool const last_step_is_exact)
+    bool const last_step_is_exact,
+    CompensatedSummation const compensated_summation)
     : first_time_step(first_time_step),
       safety_factor(safety_factor),
       max_steps(max_steps),
-      last_step_is_exact(last_step_is_exact) {}
+      last_step_is_exact(last_step_is_exact),
+      compensated_summation(compensated_summation) {}
+
+template<typename ODE_>
+AdaptiveStepSizeIntegrator<ODE_>::Parameters::Parameters(
+    Time const first_time_step,
+    double const safety_factor,
+    std::int64_t const max_steps,
+    bool const last_step_is_exact)
+    : Parameters(first_time_step,
+                 safety_factor,
+                 max_steps,
+                 last_step_is_exact,
+                 CompensatedSummation::Full) {}
 
 template<typename ODE_>
 AdaptiveStepSizeIntegrator<ODE_>::Parameters::Parameters(
@@ -471,3 +525,4 @@ AdaptiveStepSizeIntegrator<Equation> const& ParseAdaptiveStepSizeIntegrator(
 #undef PRINCIPIA_CASE_SLMS
 #undef PRINCIPIA_CASE_SPRK
 #undef PRINCIPIA_CASE_SRKN
+#undef PRINCIPIA_CASE_WH
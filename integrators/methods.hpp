@@ -111,6 +111,36 @@ struct SymplecticPartitionedRungeKutta : not_constructible {
   // static constexpr FixedVector<double, stages> b(...);
 };
 
+// A mixed-variable symplectic method for a Hamiltonian H = A + εB, where A is
+// Keplerian and B is a perturbation, composes the evolutions exp(aᵢ h A) (the
+// Keplerian drifts) and exp(bᵢ h B) (the kicks), with the same conventions as
+// for |SymplecticRungeKuttaNyström|.  The composition is always ABA or BAB.
+// The |order| is that of the error terms linear in ε; the terms in ε² are of
+// order 2 for all the methods.
+struct WisdomHolman : not_constructible {
+ protected:
+  using CompositionMethod =
+      serialization::FixedStepSizeIntegrator::CompositionMethod;
+  static constexpr CompositionMethod ABA =
+      serialization::FixedStepSizeIntegrator::ABA;
+  static constexpr CompositionMethod BAB =
+      serialization::FixedStepSizeIntegrator::BAB;
+
+  // In both compositions, one of the kicks is either trivial or shared with
+  // the next step.
+  static constexpr int Stages(int const evaluations) {
+    return evaluations + 1;
+  }
+  // static constexpr int order = ...;
+  // static constexpr bool time_reversible = ...;
+  // static constexpr int evaluations = ...;
+  // static constexpr CompositionMethod composition = ...;
+  // static constexpr serialization::FixedStepSizeIntegrator::Kind kind = ...;
+  // static constexpr int stages = Stages(evaluations);
+  // static constexpr FixedVector<double, stages> a(...);
+  // static constexpr FixedVector<double, stages> b(...);
+};
+
 // Every SPRK may be transformed into an SRKN by specifying a composition method
 // (the possible composition methods are constrained by the properties of the
 // SPRK).  This struct effects that transformation.
@@ -402,6 +432,113 @@ struct DormandالمكاوىPrince1986RKN434FM :
       {13.0 /   21.0, -20.0 /  27.0, 275.0 / 189.0, -1.0 /  3.0}}};
 };
 
+// The following methods are from Laskar and Robutel (2001), High order
+// symplectic integrators for perturbed Hamiltonian systems.  The kicks of the
+// SABAₙ methods are at the Gauss-Legendre nodes, those of the SBABₙ methods at
+// the Gauss-Lobatto nodes, and their weights are the quadrature weights.
+struct LaskarRobutel2001SABA2 : WisdomHolman {
+  static constexpr int order = 4;
+  static constexpr bool time_reversible = true;
+  static constexpr int evaluations = 2;
+  static constexpr CompositionMethod composition = ABA;
+  static constexpr serialization::FixedStepSizeIntegrator::Kind kind =
+      serialization::FixedStepSizeIntegrator::LASKAR_ROBUTEL_2001_SABA_2;
+  static constexpr int stages = Stages(evaluations);
+  static constexpr FixedVector<double, stages> a{{{0.21132486540518711775,
+                                                   0.57735026918962576451,
+                                                   0.21132486540518711775}}};
+  static constexpr FixedVector<double, stages> b{{{0.0,
+                                                   0.5,
+                                                   0.5}}};
+};
+struct LaskarRobutel2001SABA3 : WisdomHolman {
+  static constexpr int order = 6;
+  static constexpr bool time_reversible = true;
+  static constexpr int evaluations = 3;
+  static constexpr CompositionMethod composition = ABA;
+  static constexpr serialization::FixedStepSizeIntegrator::Kind kind =
+      serialization::FixedStepSizeIntegrator::LASKAR_ROBUTEL_2001_SABA_3;
+  static constexpr int stages = Stages(evaluations);
+  static constexpr FixedVector<double, stages> a{{{0.11270166537925831148,
+                                                   0.38729833462074168852,
+                                                   0.38729833462074168852,
+                                                   0.11270166537925831148}}};
+  static constexpr FixedVector<double, stages> b{{{0.0,
+                                                   5.0 / 18.0,
+                                                   4.0 / 9.0,
+                                                   5.0 / 18.0}}};
+};
+struct LaskarRobutel2001SABA4 : WisdomHolman {
+  static constexpr int order = 8;
+  static constexpr bool time_reversible = true;
+  static constexpr int evaluations = 4;
+  static constexpr CompositionMethod composition = ABA;
+  static constexpr serialization::FixedStepSizeIntegrator::Kind kind =
+      serialization::FixedStepSizeIntegrator::LASKAR_ROBUTEL_2001_SABA_4;
+  static constexpr int stages = Stages(evaluations);
+  static constexpr FixedVector<double, stages> a{{{0.069431844202973712388,
+                                                   0.26057763400459815521,
+                                                   0.33998104358485626480,
+                                                   0.26057763400459815521,
+                                                   0.069431844202973712388}}};
+  static constexpr FixedVector<double, stages> b{{{0.0,
+                                                   0.17392742256872692869,
+                                                   0.32607257743127307131,
+                                                   0.32607257743127307131,
+                                                   0.17392742256872692869}}};
+};
+struct LaskarRobutel2001SBAB2 : WisdomHolman {
+  static constexpr int order = 4;
+  static constexpr bool time_reversible = true;
+  static constexpr int evaluations = 2;
+  static constexpr CompositionMethod composition = BAB;
+  static constexpr serialization::FixedStepSizeIntegrator::Kind kind =
+      serialization::FixedStepSizeIntegrator::LASKAR_ROBUTEL_2001_SBAB_2;
+  static constexpr int stages = Stages(evaluations);
+  static constexpr FixedVector<double, stages> a{{{0.5,
+                                                   0.5,
+                                                   0.0}}};
+  static constexpr FixedVector<double, stages> b{{{1.0 / 6.0,
+                                                   2.0 / 3.0,
+                                                   1.0 / 6.0}}};
+};
+struct LaskarRobutel2001SBAB3 : WisdomHolman {
+  static constexpr int order = 6;
+  static constexpr bool time_reversible = true;
+  static constexpr int evaluations = 3;
+  static constexpr CompositionMethod composition = BAB;
+  static constexpr serialization::FixedStepSizeIntegrator::Kind kind =
+      serialization::FixedStepSizeIntegrator::LASKAR_ROBUTEL_2001_SBAB_3;
+  static constexpr int stages = Stages(evaluations);
+  static constexpr FixedVector<double, stages> a{{{0.27639320225002103036,
+                                                   0.44721359549995793928,
+                                                   0.27639320225002103036,
+                                                   0.0}}};
+  static constexpr FixedVector<double, stages> b{{{1.0 / 12.0,
+                                                   5.0 / 12.0,
+                                                   5.0 / 12.0,
+                                                   1.0 / 12.0}}};
+};
+struct LaskarRobutel2001SBAB4 : WisdomHolman {
+  static constexpr int order = 8;
+  static constexpr bool time_reversible = true;
+  static constexpr int evaluations = 4;
+  static constexpr CompositionMethod composition = BAB;
+  static constexpr serialization::FixedStepSizeIntegrator::Kind kind =
+      serialization::FixedStepSizeIntegrator::LASKAR_ROBUTEL_2001_SBAB_4;
+  static constexpr int stages = Stages(evaluations);
+  static constexpr FixedVector<double, stages> a{{{0.17267316464601142810,
+                                                   0.32732683535398857190,
+                                                   0.32732683535398857190,
+                                                   0.17267316464601142810,
+                                                   0.0}}};
+  static constexpr FixedVector<double, stages> b{{{1.0 / 20.0,
+                                                   49.0 / 180.0,
+                                                   16.0 / 45.0,
+                                                   49.0 / 180.0,
+                                                   1.0 / 20.0}}};
+};
+
 // The following methods have coefficients from McLachlan (1995),
 // On the numerical integration of ordinary differential equations by symmetric
 // composition methods, http://www.massey.ac.nz/~rmclachl/sisc95.pdf.
@@ -866,6 +1003,23 @@ struct Ruth1983 : SymplecticPartitionedRungeKutta {
       {{7.0 / 24.0, 3.0 / 4.0, -1.0 / 24.0}}};
 };
 
+// Wisdom and Holman (1991), Symplectic maps for the n-body problem, in the
+// kick-drift-kick form of Saha and Tremaine (1992), Symplectic integrators for
+// solar system dynamics.  This is Laskar and Robutel's SBAB₁.
+struct WisdomHolman1991 : WisdomHolman {
+  static constexpr int order = 2;
+  static constexpr bool time_reversible = true;
+  static constexpr int evaluations = 1;
+  static constexpr CompositionMethod composition = BAB;
+  static constexpr serialization::FixedStepSizeIntegrator::Kind kind =
+      serialization::FixedStepSizeIntegrator::WISDOM_HOLMAN_1991;
+  static constexpr int stages = Stages(evaluations);
+  static constexpr FixedVector<double, stages> a{{{1.0,
+                                                   0.0}}};
+  static constexpr FixedVector<double, stages> b{{{0.5,
+                                                   0.5}}};
+};
+
 // Coefficients from Suzuki (1990), Fractal decomposition of exponential
 // operators with applications to many-body theories and Monte Carlo
 // simulations; see also the Japanese version:
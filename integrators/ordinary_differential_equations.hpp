@@ -25,6 +25,9 @@ constexpr base::Error Done = base::Error::OK;
 constexpr base::Error ReachedMaximalStepCount = base::Error::ABORTED;
 // A singularity.
 constexpr base::Error VanishingStepSize = base::Error::FAILED_PRECONDITION;
+// The computation of the right-hand side returned this error, the integration
+// stopped without completing the current step.
+constexpr base::Error Cancelled = base::Error::CANCELLED;
 }  // namespace termination_condition
 
 namespace internal_ordinary_differential_equations {
@@ -35,6 +38,7 @@ using base::Status;
 using geometry::Instant;
 using numerics::DoublePrecision;
 using quantities::Difference;
+using quantities::GravitationalParameter;
 using quantities::Quotient;
 using quantities::Time;
 using quantities::Variation;
@@ -181,11 +185,37 @@ struct SpecialSecondOrderDifferentialEquation final {
       typename ExplicitSecondOrderOrdinaryDifferentialEquation<
           Position>::SystemStateError;
 
+  // The motion of a body which dominates the motion of some of the bodies of
+  // the system, and around which integrators that split the Keplerian motion
+  // from the perturbations (e.g., Wisdom-Holman) compute the Keplerian part.
+  struct Centre final {
+    GravitationalParameter gravitational_parameter;
+    Position position;
+    Velocity velocity;
+    Acceleration acceleration;
+  };
+  using CentreSelection =
+      std::function<void(Instant const& t,
+                         std::vector<Position> const& positions,
+                         std::vector<int>& centres)>;
+  using CentreComputation =
+      std::function<Centre(Instant const& t, int centre)>;
+
   // A functor that computes f(q, t) and stores it in |accelerations|.
   // This functor must be called with |accelerations.size()| equal to
   // |positions.size()|, but there is no requirement on the values in
   // |acceleration|.
   RightHandSideComputation compute_acceleration;
+
+  // Optional.  A functor that stores in |centres| the index of the centre
+  // around which each of the bodies at |positions| is best integrated, or -1 if
+  // there is no such centre.  This functor must be called with |centres.size()|
+  // equal to |positions.size()|.  The indices are only meaningful to
+  // |compute_centre|.
+  CentreSelection select_centres;
+  // Optional, must be present if |select_centres| is.  A functor that returns
+  // the motion at time |t| of the centre having the given index.
+  CentreComputation compute_centre;
 };
 
 // An initial value problem.
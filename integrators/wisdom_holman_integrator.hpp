@@ -0,0 +1,140 @@
+﻿// The files containing the tree of of child classes of |Integrator| must be
+// included in the order of inheritance to avoid circular dependencies.  This
+// class will end up being reincluded as part of the implementation of its
+//  parent.
+#ifndef PRINCIPIA_INTEGRATORS_INTEGRATORS_HPP_
+#include "integrators/integrators.hpp"
+#else
+#ifndef PRINCIPIA_INTEGRATORS_WISDOM_HOLMAN_INTEGRATOR_HPP_
+#define PRINCIPIA_INTEGRATORS_WISDOM_HOLMAN_INTEGRATOR_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "base/status.hpp"
+#include "integrators/methods.hpp"
+#include "integrators/ordinary_differential_equations.hpp"
+#include "numerics/fixed_arrays.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace integrators {
+namespace internal_wisdom_holman_integrator {
+
+using base::not_null;
+using base::Status;
+using geometry::Instant;
+using numerics::FixedVector;
+using quantities::GravitationalParameter;
+using quantities::Time;
+
+// This class solves equations of the form q″ = f(q, t) where, for each body,
+// f is dominated by the attraction of a moving centre whose motion is known,
+// using a mixed-variable symplectic method in the sense of Wisdom and Holman
+// (1991), Symplectic maps for the n-body problem.
+// For each body, the motion relative to its centre is split into a Keplerian
+// part, which is integrated exactly (the drifts), and a perturbation,
+// comprising the accelerations other than the monopole of the centre as well
+// as the opposite of the acceleration of the centre, which is applied as
+// impulses (the kicks).  The drifts and kicks are composed as specified by the
+// |Method|.  The centres are chosen at the beginning of each step using
+// |select_centres|, and their motions are given by |compute_centre|.  If the
+// equation doesn't have a |select_centres|, or if a body has no centre, the
+// drifts are uniform and the method is the symplectic partitioned Runge-Kutta
+// method with the same coefficients.
+// The error is proportional to the ratio ε of the perturbations to the
+// Keplerian acceleration, so that these methods allow much larger steps than
+// general-purpose methods for near-Keplerian orbits.
+template<typename Method, typename Position>
+class WisdomHolmanIntegrator
+    : public FixedStepSizeIntegrator<
+                 SpecialSecondOrderDifferentialEquation<Position>> {
+ public:
+  using ODE = SpecialSecondOrderDifferentialEquation<Position>;
+  using AppendState = typename Integrator<ODE>::AppendState;
+
+  static constexpr auto order = Method::order;
+  static constexpr auto time_reversible = Method::time_reversible;
+  static constexpr auto evaluations = Method::evaluations;
+  static constexpr auto composition = Method::composition;
+
+  class Instance : public FixedStepSizeIntegrator<ODE>::Instance {
+   public:
+    Status Solve(Instant const& t_final) override;
+    WisdomHolmanIntegrator const& integrator() const override;
+    not_null<std::unique_ptr<typename Integrator<ODE>::Instance>> Clone()
+        const override;
+
+    void WriteToMessage(
+        not_null<serialization::IntegratorInstance*> message) const override;
+
+   private:
+    Instance(IntegrationProblem<ODE> const& problem,
+             AppendState const& append_state,
+             Time const& step,
+             WisdomHolmanIntegrator const& integrator);
+
+    WisdomHolmanIntegrator const& integrator_;
+    friend class WisdomHolmanIntegrator;
+  };
+
+  WisdomHolmanIntegrator();
+
+  not_null<std::unique_ptr<typename Integrator<ODE>::Instance>> NewInstance(
+      IntegrationProblem<ODE> const& problem,
+      AppendState const& append_state,
+      Time const& step) const override;
+
+  void WriteToMessage(
+      not_null<serialization::FixedStepSizeIntegrator*> message) const override;
+
+ private:
+  not_null<std::unique_ptr<typename Integrator<ODE>::Instance>> ReadFromMessage(
+      serialization::FixedStepSizeIntegratorInstance const& message,
+      IntegrationProblem<ODE> const& problem,
+      AppendState const& append_state,
+      Time const& step) const override;
+
+  static constexpr auto ABA = serialization::FixedStepSizeIntegrator::ABA;
+  static constexpr auto BAB = serialization::FixedStepSizeIntegrator::BAB;
+
+  static constexpr auto stages_ = Method::stages;
+  static constexpr auto a_ = Method::a;
+  static constexpr auto b_ = Method::b;
+
+  FixedVector<double, Method::stages> c_;
+};
+
+// Advances by |Δt| the Keplerian motion around a centre of gravitational
+// parameter |μ| of a body which is at |r| relative to the centre with the
+// velocity |w|.  Sets |Δr| and |Δw| to the increments of |r| and |w| over
+// |Δt|.  The computation uses universal variables and is valid for all conics.
+// Returns an |OUT_OF_RANGE| error, and leaves |Δr| and |Δw| unchanged, if the
+// solution of the universal Kepler equation does not converge, e.g., for
+// non-finite arguments.
+template<typename Displacement, typename Velocity>
+Status KeplerDrift(GravitationalParameter const& μ,
+                   Displacement const& r,
+                   Velocity const& w,
+                   Time const& Δt,
+                   Displacement& Δr,
+                   Velocity& Δw);
+
+}  // namespace internal_wisdom_holman_integrator
+
+using internal_wisdom_holman_integrator::KeplerDrift;
+
+template<typename Method, typename Position>
+internal_wisdom_holman_integrator::WisdomHolmanIntegrator<Method,
+                                                          Position> const&
+WisdomHolmanIntegrator();
+
+}  // namespace integrators
+}  // namespace principia
+
+#include "integrators/wisdom_holman_integrator_body.hpp"
+
+#endif  // PRINCIPIA_INTEGRATORS_WISDOM_HOLMAN_INTEGRATOR_HPP_
+#endif  // PRINCIPIA_INTEGRATORS_INTEGRATORS_HPP_
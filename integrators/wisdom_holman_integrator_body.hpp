@@ -0,0 +1,483 @@
+﻿
+#pragma once
+
+#include "integrators/wisdom_holman_integrator.hpp"
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include "geometry/grassmann.hpp"
+#include "geometry/sign.hpp"
+#include "numerics/sin_cos.hpp"
+#include "numerics/ulp_distance.hpp"
+#include "quantities/elementary_functions.hpp"
+
+namespace principia {
+namespace integrators {
+namespace internal_wisdom_holman_integrator {
+
+using base::Error;
+using geometry::InnerProduct;
+using geometry::Sign;
+using geometry::Vector;
+using numerics::DoublePrecision;
+using numerics::ReproducibleSinCos;
+using numerics::ULPDistance;
+using quantities::Abs;
+using quantities::Product;
+using quantities::Sqrt;
+
+// The inner product of displacements and velocities, whether they are vectors
+// or scalars.
+template<typename LScalar, typename RScalar, typename Frame>
+Product<LScalar, RScalar> Dot(Vector<LScalar, Frame> const& left,
+                              Vector<RScalar, Frame> const& right) {
+  return InnerProduct(left, right);
+}
+
+template<typename Left, typename Right>
+Product<Left, Right> Dot(Left const& left, Right const& right) {
+  return left * right;
+}
+
+// Returns the opposite of the acceleration exerted by a centre of gravitational
+// parameter |μ| on a body at |r| relative to it, i.e., the correction to apply
+// to the total acceleration to obtain the perturbation.
+template<typename Displacement>
+auto KeplerianCorrection(GravitationalParameter const& μ,
+                         Displacement const& r) {
+  auto const r_norm = Sqrt(Dot(r, r));
+  return μ * r / (r_norm * r_norm * r_norm);
+}
+
+// The Stumpff functions c₀(x), c₁(x), c₂(x), c₃(x).  See Danby (1988),
+// Fundamentals of Celestial Mechanics, section 6.9.  The circular functions
+// are reproducible, but the hyperbolic ones are those of the C runtime library.
+inline void StumpffFunctions(double const x,
+                             double& c0,
+                             double& c1,
+                             double& c2,
+                             double& c3) {
+  if (std::abs(x) < 1) {
+    // The series cₖ(x) = Σ (-x)ⁿ / (2n + k)!, truncated so that the first
+    // neglected term is below the unit roundoff.  The other functions follow
+    // from the identity cₖ(x) = 1 / k! - x cₖ₊₂(x).
+    c2 = 1;
+    c3 = 1;
+    for (int n = 10; n >= 1; --n) {
+      c2 = 1 - x * c2 / ((2 * n + 1) * (2 * n + 2));
+      c3 = 1 - x * c3 / ((2 * n + 2) * (2 * n + 3));
+    }
+    c2 /= 2;
+    c3 /= 6;
+    c1 = 1 - x * c3;
+    c0 = 1 - x * c2;
+  } else {
+    if (x > 0) {
+      double const y = std::sqrt(x);
+      double sin_y;
+      ReproducibleSinCos(y, sin_y, c0);
+      c1 = sin_y / y;
+    } else {
+      double const y = std::sqrt(-x);
+      c0 = std::cosh(y);
+      c1 = std::sinh(y) / y;
+    }
+    c2 = (1 - c0) / x;
+    c3 = (1 - c1) / x;
+  }
+}
+
+template<typename Displacement, typename Velocity>
+Status KeplerDrift(GravitationalParameter const& μ,
+                   Displacement const& r,
+                   Velocity const& w,
+                   Time const& Δt,
+                   Displacement& Δr,
+                   Velocity& Δw) {
+  // We follow the notation of Wisdom and Hernandez (2015), A fast and accurate
+  // universal Kepler solver without Stumpff series: s is the universal
+  // variable, and Gₙ(β, s) = sⁿ cₙ(βs²).
+  auto const r0 = Sqrt(Dot(r, r));
+  auto const η = Dot(r, w);
+  auto const β = 2 * μ / r0 - Dot(w, w);
+
+  // Laguerre-Conway iteration on the universal Kepler equation
+  //   f(s) = r₀ G₁ + η G₂ + μ G₃ - Δt = 0,
+  // see Conway (1986), An improved algorithm due to Laguerre for the solution
+  // of Kepler's equation.  f′(s) is the distance to the centre.
+  constexpr double n = 5;
+  constexpr int max_iterations = 50;
+  auto s = Δt / r0;
+  if (β * s * s < -1) {
+    // On a hyperbolic orbit with a large step, the iteration would take a long
+    // time to climb down the exponential from the above guess.  Use the
+    // asymptotic guess of Vallado (2013), Fundamentals of Astrodynamics and
+    // Applications, algorithm 8, if it is meaningful.
+    double const sign = Sign(Δt) * 1;
+    auto const sqrt_minus_β = Sqrt(-β);
+    double const argument =
+        -2 * β * Δt / (η + sign * (μ - β * r0) / sqrt_minus_β);
+    if (argument > 1) {
+      s = sign * std::log(argument) / sqrt_minus_β;
+    }
+  }
+  double c0, c1, c2, c3;
+  for (int i = 0;; ++i) {
+    StumpffFunctions(β * s * s, c0, c1, c2, c3);
+    auto const G1 = s * c1;
+    auto const G2 = s * s * c2;
+    auto const G3 = s * s * s * c3;
+    auto const f = r0 * G1 + η * G2 + μ * G3 - Δt;
+    auto const fʹ = r0 * c0 + η * G1 + μ * G2;
+    auto const fʺ = η * c0 + (μ - β * r0) * G1;
+    auto const Δs =
+        -n * f /
+        (fʹ + Sqrt(Abs((n - 1) * (n - 1) * fʹ * fʹ - n * (n - 1) * f * fʺ)));
+    s += Δs;
+    // Stop when the correction is negligible, or when the residual is at the
+    // level of the rounding errors in its terms, in which case the iteration
+    // would just oscillate around the root.
+    constexpr double ε = std::numeric_limits<double>::epsilon();
+    if (Abs(Δs) <= 2 * ε * Abs(s) ||
+        Abs(f) <= 2 * ε * (Abs(r0 * G1) + Abs(η * G2) + Abs(μ * G3) +
+                           Abs(Δt))) {
+      break;
+    }
+    if (i >= max_iterations) {
+      std::stringstream message;
+      message << "No convergence of the Kepler drift for r = " << r
+              << ", w = " << w << ", Δt = " << Δt;
+      return Status(Error::OUT_OF_RANGE, message.str());
+    }
+  }
+
+  StumpffFunctions(β * s * s, c0, c1, c2, c3);
+  auto const G1 = s * c1;
+  auto const G2 = s * s * c2;
+  auto const r1 = r0 * c0 + η * G1 + μ * G2;
+
+  // The Lagrange coefficients, with f - 1 and ġ - 1 computed directly to avoid
+  // cancellations for small steps.
+  auto const f_minus_1 = -μ * G2 / r0;
+  auto const g = r0 * G1 + η * G2;
+  auto const ḟ = -μ * G1 / (r1 * r0);
+  auto const ġ_minus_1 = -μ * G2 / r1;
+  Δr = f_minus_1 * r + g * w;
+  Δw = ḟ * r + ġ_minus_1 * w;
+  return Status::OK;
+}
+
+template<typename Method, typename Position>
+Status WisdomHolmanIntegrator<Method, Position>::Instance::Solve(
+    Instant const& t_final) {
+  using Displacement = typename ODE::Displacement;
+  using Velocity = typename ODE::Velocity;
+  using Acceleration = typename ODE::Acceleration;
+  using Centre = typename ODE::Centre;
+
+  auto const& a = integrator_.a_;
+  auto const& b = integrator_.b_;
+  auto const& c = integrator_.c_;
+
+  auto& current_state = this->current_state_;
+  auto& append_state = this->append_state_;
+  auto const& equation = this->equation_;
+  auto const& step = this->step_;
+
+  // |current_state| is updated as the integration progresses to allow
+  // restartability.
+
+  // Argument checks.
+  int const dimension = current_state.positions.size();
+  CHECK_NE(Time(), step);
+  Sign const integration_direction = Sign(step);
+  if (integration_direction.Positive()) {
+    // Integrating forward.
+    CHECK_LT(current_state.time.value, t_final);
+  } else {
+    // Integrating backward.
+    CHECK_GT(current_state.time.value, t_final);
+  }
+  bool const has_centres = static_cast<bool>(equation.select_centres);
+  CHECK(!has_centres || equation.compute_centre);
+
+  // Time step.
+  Time const& h = step;
+  Time const abs_h = integration_direction * h;
+  // Current time.  This is a non-const reference whose purpose is to make the
+  // equations more readable.
+  DoublePrecision<Instant>& t = current_state.time;
+
+  // Position increment.  For the bodies that have a centre, this is the
+  // increment of the position relative to the centre until the end of the
+  // step.
+  std::vector<Displacement> Δq(dimension);
+  // Velocity increment, with the same convention.
+  std::vector<Velocity> Δv(dimension);
+  // Current position.  This is a non-const reference whose purpose is to make
+  // the equations more readable.
+  std::vector<DoublePrecision<Position>>& q = current_state.positions;
+  // Current velocity.  This is a non-const reference whose purpose is to make
+  // the equations more readable.
+  std::vector<DoublePrecision<Velocity>>& v = current_state.velocities;
+
+  // For each body, the index of its centre, or -1.
+  std::vector<int> centre_indices(dimension, -1);
+  // For each body that has a centre, its position and velocity relative to
+  // the centre at the beginning of the step.
+  std::vector<Displacement> r(dimension);
+  std::vector<Velocity> w(dimension);
+  // The motions of the centres at the beginning of the step, at the current
+  // stage, and at the end of the step, indexed by centre.
+  std::map<int, Centre> centres_at_start;
+  std::map<int, Centre> centres_at_stage;
+  std::map<int, Centre> centres_at_end;
+  auto const compute_centres = [&centre_indices, &equation](
+                                   Instant const& t,
+                                   std::map<int, Centre>& centres) {
+    for (int const centre : centre_indices) {
+      if (centre >= 0 && centres.count(centre) == 0) {
+        centres.emplace(centre, equation.compute_centre(t, centre));
+      }
+    }
+  };
+
+  // Current stage.
+  std::vector<Position> q_stage(dimension);
+  // Accelerations at the current stage.
+  std::vector<Acceleration> g(dimension);
+
+  Status status;
+
+  for (int k = 0; k < dimension; ++k) {
+    q_stage[k] = q[k].value;
+  }
+  if (composition == BAB) {
+    status.Update(equation.compute_acceleration(t.value, q_stage, g));
+  }
+
+  while (abs_h <= Abs((t_final - t.value) - t.error)) {
+    Instant const t_start = t.value + t.error;
+    Instant const t_end = t.value + (t.error + h);
+    std::fill(Δq.begin(), Δq.end(), Displacement{});
+    std::fill(Δv.begin(), Δv.end(), Velocity{});
+
+    // Select the centres, reusing the motions computed at the end of the
+    // previous step, and go to the coordinates relative to the centres.
+    if (has_centres) {
+      equation.select_centres(t_start, q_stage, centre_indices);
+      centres_at_start.swap(centres_at_end);
+      centres_at_end.clear();
+      compute_centres(t_start, centres_at_start);
+      for (int k = 0; k < dimension; ++k) {
+        int const centre = centre_indices[k];
+        if (centre >= 0) {
+          Centre const& start = centres_at_start.at(centre);
+          r[k] = q[k].value - start.position;
+          w[k] = v[k].value - start.velocity;
+        }
+      }
+    }
+
+    for (int i = 0; i < stages_; ++i) {
+      // exp(bᵢ h B).  In the ABA case, b₀ = 0.  In the BAB case, the
+      // accelerations for i = 0 are those of the end of the previous step.
+      if (i > 0 || composition == BAB) {
+        std::map<int, Centre> const* centres = &centres_at_start;
+        if (i > 0) {
+          bool const is_end = composition == BAB && i == stages_ - 1;
+          Instant const t_stage =
+              is_end ? t_end : t.value + (t.error + c[i] * h);
+          if (is_end) {
+            compute_centres(t_stage, centres_at_end);
+            centres = &centres_at_end;
+          } else {
+            centres_at_stage.clear();
+            compute_centres(t_stage, centres_at_stage);
+            centres = &centres_at_stage;
+          }
+          for (int k = 0; k < dimension; ++k) {
+            int const centre = centre_indices[k];
+            q_stage[k] = centre < 0
+                             ? q[k].value + Δq[k]
+                             : centres->at(centre).position + (r[k] + Δq[k]);
+          }
+          status.Update(equation.compute_acceleration(t_stage, q_stage, g));
+        }
+        for (int k = 0; k < dimension; ++k) {
+          int const centre = centre_indices[k];
+          if (centre < 0) {
+            Δv[k] += h * b[i] * g[k];
+          } else {
+            Centre const& stage_centre = centres->at(centre);
+            Δv[k] += h * b[i] *
+                     (g[k] - stage_centre.acceleration +
+                      KeplerianCorrection(stage_centre.gravitational_parameter,
+                                          r[k] + Δq[k]));
+          }
+        }
+      }
+
+      // exp(aᵢ h A).  In the BAB case, the last aᵢ is 0.
+      if (i < stages_ - 1 || composition == ABA) {
+        for (int k = 0; k < dimension; ++k) {
+          int const centre = centre_indices[k];
+          if (centre < 0) {
+            Δq[k] += h * a[i] * (v[k].value + Δv[k]);
+          } else {
+            Displacement Δr;
+            Velocity Δw;
+            Status const drift_status = KeplerDrift(
+                centres_at_start.at(centre).gravitational_parameter,
+                r[k] + Δq[k],
+                w[k] + Δv[k],
+                h * a[i],
+                Δr,
+                Δw);
+            // The integration stops without completing the current step, so
+            // that |current_state| is that of the end of the previous step.
+            if (!drift_status.ok()) {
+              status.Update(drift_status);
+              return status;
+            }
+            Δq[k] += Δr;
+            Δv[k] += Δw;
+          }
+        }
+      }
+    }
+
+    // Go back to the original coordinates.
+    if (has_centres) {
+      compute_centres(t_end, centres_at_end);
+      for (int k = 0; k < dimension; ++k) {
+        int const centre = centre_indices[k];
+        if (centre >= 0) {
+          Centre const& start = centres_at_start.at(centre);
+          Centre const& end = centres_at_end.at(centre);
+          Δq[k] += end.position - start.position;
+          Δv[k] += end.velocity - start.velocity;
+        }
+      }
+    }
+
+    // Increment the solution.
+    t.Increment(h);
+    for (int k = 0; k < dimension; ++k) {
+      q[k].Increment(Δq[k]);
+      v[k].Increment(Δv[k]);
+      if (composition == ABA) {
+        q_stage[k] = q[k].value;
+      }
+    }
+    append_state(current_state);
+  }
+
+  return status;
+}
+
+template<typename Method, typename Position>
+WisdomHolmanIntegrator<Method, Position> const&
+WisdomHolmanIntegrator<Method, Position>::Instance::integrator() const {
+  return integrator_;
+}
+
+template<typename Method, typename Position>
+not_null<std::unique_ptr<typename Integrator<
+    SpecialSecondOrderDifferentialEquation<Position>>::Instance>>
+WisdomHolmanIntegrator<Method, Position>::Instance::Clone() const {
+  return std::unique_ptr<Instance>(new Instance(*this));
+}
+
+template<typename Method, typename Position>
+void WisdomHolmanIntegrator<Method, Position>::Instance::WriteToMessage(
+    not_null<serialization::IntegratorInstance*> message) const {
+  FixedStepSizeIntegrator<ODE>::Instance::WriteToMessage(message);
+  message
+      ->MutableExtension(
+          serialization::FixedStepSizeIntegratorInstance::extension)
+      ->MutableExtension(
+          serialization::WisdomHolmanIntegratorInstance::extension);
+}
+
+template<typename Method, typename Position>
+WisdomHolmanIntegrator<Method, Position>::Instance::Instance(
+    IntegrationProblem<ODE> const& problem,
+    AppendState const& append_state,
+    Time const& step,
+    WisdomHolmanIntegrator const& integrator)
+    : FixedStepSizeIntegrator<ODE>::Instance(problem,
+                                             std::move(append_state),
+                                             step),
+      integrator_(integrator) {}
+
+template<typename Method, typename Position>
+WisdomHolmanIntegrator<Method, Position>::WisdomHolmanIntegrator() {
+  DoublePrecision<double> c_i(0.0);
+  for (int i = 0; i < stages_; ++i) {
+    c_[i] = c_i.value;
+    c_i += DoublePrecision<double>(a_[i]);
+  }
+  CHECK_LE(ULPDistance(1.0, c_i.value), 4);
+  if (composition == ABA) {
+    CHECK_EQ(0.0, b_[0]);
+  } else {
+    CHECK_EQ(BAB, composition);
+    CHECK_EQ(0.0, a_[stages_ - 1]);
+  }
+}
+
+template<typename Method, typename Position>
+not_null<std::unique_ptr<typename Integrator<
+    SpecialSecondOrderDifferentialEquation<Position>>::Instance>>
+WisdomHolmanIntegrator<Method, Position>::NewInstance(
+    IntegrationProblem<ODE> const& problem,
+    AppendState const& append_state,
+    Time const& step) const {
+  // Cannot use |make_not_null_unique| because the constructor of |Instance| is
+  // private.
+  return std::unique_ptr<Instance>(
+      new Instance(problem, append_state, step, *this));
+}
+
+template<typename Method, typename Position>
+void WisdomHolmanIntegrator<Method, Position>::WriteToMessage(
+    not_null<serialization::FixedStepSizeIntegrator*> message) const {
+  message->set_kind(Method::kind);
+}
+
+template<typename Method, typename Position>
+not_null<std::unique_ptr<typename Integrator<
+    SpecialSecondOrderDifferentialEquation<Position>>::Instance>>
+WisdomHolmanIntegrator<Method, Position>::ReadFromMessage(
+    serialization::FixedStepSizeIntegratorInstance const& message,
+    IntegrationProblem<ODE> const& problem,
+    AppendState const& append_state,
+    Time const& step) const {
+  CHECK(message.HasExtension(
+      serialization::WisdomHolmanIntegratorInstance::extension))
+      << message.DebugString();
+
+  return std::unique_ptr<typename Integrator<ODE>::Instance>(
+      new Instance(problem, append_state, step, *this));
+}
+
+}  // namespace internal_wisdom_holman_integrator
+
+template<typename Method, typename Position>
+internal_wisdom_holman_integrator::WisdomHolmanIntegrator<Method,
+                                                          Position> const&
+WisdomHolmanIntegrator() {
+  static_assert(std::is_base_of<methods::WisdomHolman, Method>::value,
+                "Method must be derived from WisdomHolman");
+  static internal_wisdom_holman_integrator::WisdomHolmanIntegrator<
+      Method, Position> const integrator;
+  return integrator;
+}
+
+}  // namespace integrators
+}  // namespace principia
@@ -0,0 +1,474 @@
+﻿
+#include "integrators/wisdom_holman_integrator.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/status.hpp"
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
+#include "geometry/named_quantities.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "integrators/methods.hpp"
+#include "integrators/symmetric_linear_multistep_integrator.hpp"
+#include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/numbers.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/is_near.hpp"
+#include "testing_utilities/matchers.hpp"
+#include "testing_utilities/numerics.hpp"
+
+namespace principia {
+namespace integrators {
+
+using base::Error;
+using base::Status;
+using geometry::Displacement;
+using geometry::Frame;
+using geometry::InnerProduct;
+using geometry::Instant;
+using geometry::Position;
+using geometry::Vector;
+using geometry::Velocity;
+using geometry::Wedge;
+using quantities::Acceleration;
+using quantities::AngularFrequency;
+using quantities::Cos;
+using quantities::GravitationalParameter;
+using quantities::Length;
+using quantities::NaN;
+using quantities::Pow;
+using quantities::Sin;
+using quantities::Speed;
+using quantities::SpecificEnergy;
+using quantities::Sqrt;
+using quantities::Time;
+using quantities::si::Centi;
+using quantities::si::Day;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Micro;
+using quantities::si::Milli;
+using quantities::si::Minute;
+using quantities::si::Radian;
+using quantities::si::Second;
+using testing_utilities::AbsoluteError;
+using testing_utilities::EqualsProto;
+using testing_utilities::IsNear;
+using testing_utilities::RelativeError;
+using testing_utilities::StatusIs;
+using ::testing::Lt;
+
+class WisdomHolmanIntegratorTest : public ::testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      serialization::Frame::TEST,
+                      /*frame_is_inertial=*/true>;
+  using ODE = SpecialSecondOrderDifferentialEquation<Position<World>>;
+
+  WisdomHolmanIntegratorTest()
+      : μ_star_(1.327'124'400'18e20 * Pow<3>(Metre) / Pow<2>(Second)),
+        μ_planet_(3.986'004'418e14 * Pow<3>(Metre) / Pow<2>(Second)),
+        planet_radius_(6'378'136.3 * Metre),
+        planet_j2_(1.082'626'7e-3),
+        planet_orbit_radius_(1.495'978'707e11 * Metre),
+        planet_angular_frequency_(
+            Sqrt(μ_star_ / Pow<3>(planet_orbit_radius_)) * Radian) {}
+
+  // The motion of a planet on a circular orbit around a star fixed at the
+  // origin.
+  ODE::Centre Planet(Instant const& t) const {
+    double const cos = Cos(planet_angular_frequency_ * (t - t0_));
+    double const sin = Sin(planet_angular_frequency_ * (t - t0_));
+    Speed const speed = planet_orbit_radius_ * planet_angular_frequency_ /
+                        Radian;
+    return {μ_planet_,
+            World::origin +
+                Displacement<World>({planet_orbit_radius_ * cos,
+                                     planet_orbit_radius_ * sin,
+                                     0 * Metre}),
+            Velocity<World>({-speed * sin, speed * cos, 0 * Metre / Second}),
+            Vector<Acceleration, World>(
+                {-μ_star_ / Pow<2>(planet_orbit_radius_) * cos,
+                 -μ_star_ / Pow<2>(planet_orbit_radius_) * sin,
+                 0 * Metre / Pow<2>(Second)})};
+  }
+
+  // The accelerations exerted on a satellite by the star and by the planet,
+  // including the J2 of the latter, whose axis is the z axis.
+  Status ComputeSatelliteAccelerations(
+      Instant const& t,
+      std::vector<Position<World>> const& positions,
+      std::vector<Vector<Acceleration, World>>& accelerations) const {
+    Position<World> const planet_position = Planet(t).position;
+    for (int i = 0; i < positions.size(); ++i) {
+      Displacement<World> const r_star = positions[i] - World::origin;
+      Displacement<World> const r = positions[i] - planet_position;
+      Length const r_norm = r.Norm();
+      auto const& c = r.coordinates();
+      double const z²_over_r² = Pow<2>(c.z / r_norm);
+      auto const j2_factor = -1.5 * planet_j2_ * μ_planet_ *
+                             Pow<2>(planet_radius_) / Pow<5>(r_norm);
+      accelerations[i] =
+          -μ_star_ * r_star / Pow<3>(r_star.Norm()) -
+          μ_planet_ * r / Pow<3>(r_norm) +
+          Vector<Acceleration, World>(
+              {j2_factor * c.x * (1 - 5 * z²_over_r²),
+               j2_factor * c.y * (1 - 5 * z²_over_r²),
+               j2_factor * c.z * (3 - 5 * z²_over_r²)});
+    }
+    return Status::OK;
+  }
+
+  // An equation for satellites orbiting the planet.  If |with_centres| is
+  // false, the equation has no centres.
+  ODE SatelliteEquation(bool const with_centres) const {
+    ODE equation;
+    equation.compute_acceleration =
+        [this](Instant const& t,
+               std::vector<Position<World>> const& positions,
+               std::vector<Vector<Acceleration, World>>& accelerations) {
+          return ComputeSatelliteAccelerations(t, positions, accelerations);
+        };
+    if (with_centres) {
+      equation.select_centres =
+          [](Instant const& t,
+             std::vector<Position<World>> const& positions,
+             std::vector<int>& centres) {
+            std::fill(centres.begin(), centres.end(), 0);
+          };
+      equation.compute_centre = [this](Instant const& t, int const centre) {
+        CHECK_EQ(0, centre);
+        return Planet(t);
+      };
+    }
+    return equation;
+  }
+
+  // A satellite in a low, inclined, eccentric orbit around the planet.
+  IntegrationProblem<ODE> SatelliteProblem(bool const with_centres) const {
+    ODE::Centre const planet = Planet(t0_);
+    Length const periapsis = 7000 * Kilo(Metre);
+    double const eccentricity = 0.1;
+    Speed const periapsis_speed =
+        Sqrt(μ_planet_ * (1 + eccentricity) / periapsis);
+    IntegrationProblem<ODE> problem;
+    problem.equation = SatelliteEquation(with_centres);
+    problem.initial_state = {
+        {planet.position +
+         Displacement<World>({periapsis, 0 * Metre, 0 * Metre})},
+        {planet.velocity +
+         Velocity<World>({0 * Metre / Second,
+                          periapsis_speed * Cos(0.5 * Radian),
+                          periapsis_speed * Sin(0.5 * Radian)})},
+        t0_};
+    return problem;
+  }
+
+  // Integrates the |problem| until |t_final| with the given |integrator|, and
+  // returns the final position.
+  Position<World> FinalPosition(FixedStepSizeIntegrator<ODE> const& integrator,
+                                IntegrationProblem<ODE> const& problem,
+                                Time const& step,
+                                Instant const& t_final) const {
+    Position<World> result;
+    auto const append_state = [&result](ODE::SystemState const& state) {
+      result = state.positions[0].value;
+    };
+    auto const instance = integrator.NewInstance(problem, append_state, step);
+    instance->Solve(t_final);
+    return result;
+  }
+
+  Instant const t0_;
+  GravitationalParameter const μ_star_;
+  GravitationalParameter const μ_planet_;
+  Length const planet_radius_;
+  double planet_j2_;
+  Length const planet_orbit_radius_;
+  AngularFrequency const planet_angular_frequency_;
+};
+
+// The drift is exact for all conics, and reversible.
+TEST_F(WisdomHolmanIntegratorTest, KeplerDrift) {
+  GravitationalParameter const μ = μ_planet_;
+  Displacement<World> const r({7000 * Kilo(Metre),
+                               1000 * Kilo(Metre),
+                               -500 * Kilo(Metre)});
+  Vector<double, World> const direction({-0.1, 0.9, 0.3});
+  // Elliptic, parabolic, hyperbolic.
+  for (Speed const speed : {7 * Kilo(Metre) / Second,
+                            Sqrt(2 * μ / r.Norm()),
+                            15 * Kilo(Metre) / Second}) {
+    Velocity<World> const w = speed * direction / direction.Norm();
+    SpecificEnergy const energy = 0.5 * InnerProduct(w, w) - μ / r.Norm();
+    for (Time const Δt : {1 * Second, 1000 * Second, 1 * Day}) {
+      Displacement<World> Δr;
+      Velocity<World> Δw;
+      EXPECT_OK(KeplerDrift(μ, r, w, Δt, Δr, Δw));
+      Displacement<World> const r1 = r + Δr;
+      Velocity<World> const w1 = w + Δw;
+      EXPECT_THAT(
+          AbsoluteError(energy,
+                        0.5 * InnerProduct(w1, w1) - μ / r1.Norm()),
+          Lt(1e-15 * μ / r.Norm())) << speed << " " << Δt;
+      EXPECT_THAT(RelativeError(Wedge(r, w), Wedge(r1, w1)), Lt(1e-14))
+          << speed << " " << Δt;
+
+      // The backward drift along a hyperbola amplifies the rounding errors of
+      // the forward drift, hence the looser bounds.
+      Displacement<World> Δr_back;
+      Velocity<World> Δw_back;
+      EXPECT_OK(KeplerDrift(μ, r1, w1, -Δt, Δr_back, Δw_back));
+      EXPECT_THAT(RelativeError(r, r1 + Δr_back), Lt(1e-11))
+          << speed << " " << Δt;
+      EXPECT_THAT(RelativeError(w, w1 + Δw_back), Lt(1e-11))
+          << speed << " " << Δt;
+    }
+  }
+}
+
+// The drift reports its failures instead of aborting.
+TEST_F(WisdomHolmanIntegratorTest, KeplerDriftNoConvergence) {
+  Displacement<World> const r({NaN<Length>(),
+                               1000 * Kilo(Metre),
+                               -500 * Kilo(Metre)});
+  Velocity<World> const w({7 * Kilo(Metre) / Second,
+                           0 * Kilo(Metre) / Second,
+                           0 * Kilo(Metre) / Second});
+  Displacement<World> Δr;
+  Velocity<World> Δw;
+  EXPECT_THAT(KeplerDrift(μ_planet_, r, w, 1000 * Second, Δr, Δw),
+              StatusIs(Error::OUT_OF_RANGE));
+  EXPECT_EQ(Displacement<World>(), Δr);
+  EXPECT_EQ(Velocity<World>(), Δw);
+}
+
+// For an unperturbed Keplerian orbit, the integrators are exact, even with
+// steps that are a sizeable fraction of the period.
+TEST_F(WisdomHolmanIntegratorTest, KeplerOrbit) {
+  ODE equation;
+  equation.compute_acceleration =
+      [this](Instant const& t,
+             std::vector<Position<World>> const& positions,
+             std::vector<Vector<Acceleration, World>>& accelerations) {
+        for (int i = 0; i < positions.size(); ++i) {
+          Displacement<World> const r = positions[i] - World::origin;
+          accelerations[i] = -μ_planet_ * r / Pow<3>(r.Norm());
+        }
+        return Status::OK;
+      };
+  equation.select_centres = [](Instant const& t,
+                               std::vector<Position<World>> const& positions,
+                               std::vector<int>& centres) {
+    std::fill(centres.begin(), centres.end(), 0);
+  };
+  equation.compute_centre = [this](Instant const& t, int const centre) {
+    return ODE::Centre{μ_planet_,
+                       World::origin,
+                       Velocity<World>(),
+                       Vector<Acceleration, World>()};
+  };
+
+  Length const semimajor_axis = 10'000 * Kilo(Metre);
+  double const eccentricity = 0.5;
+  Time const period = 2 * π * Sqrt(Pow<3>(semimajor_axis) / μ_planet_);
+  Length const periapsis = semimajor_axis * (1 - eccentricity);
+  Speed const periapsis_speed =
+      Sqrt(μ_planet_ * (1 + eccentricity) / periapsis);
+  Position<World> const q0 =
+      World::origin + Displacement<World>({periapsis, 0 * Metre, 0 * Metre});
+
+  IntegrationProblem<ODE> problem;
+  problem.equation = equation;
+  problem.initial_state = {
+      {q0},
+      {Velocity<World>(
+          {0 * Metre / Second, periapsis_speed, 0 * Metre / Second})},
+      t0_};
+  EXPECT_THAT(
+      AbsoluteError(
+          q0,
+          FinalPosition(WisdomHolmanIntegrator<methods::WisdomHolman1991,
+                                               Position<World>>(),
+                        problem,
+                        period / 8,
+                        t0_ + 100 * period)),
+      Lt(50 * Micro(Metre)));
+  EXPECT_THAT(
+      AbsoluteError(
+          q0,
+          FinalPosition(WisdomHolmanIntegrator<methods::LaskarRobutel2001SABA4,
+                                               Position<World>>(),
+                        problem,
+                        period / 8,
+                        t0_ + 100 * period)),
+      Lt(50 * Micro(Metre)));
+}
+
+// For a satellite perturbed by the oblateness of its planet, the error is
+// proportional to the ratio of the perturbation to the Keplerian acceleration,
+// so the integrators are much more accurate than general-purpose ones with the
+// same step, even of higher order.
+TEST_F(WisdomHolmanIntegratorTest, OblatePlanet) {
+  Instant const t_final = t0_ + 1 * Day;
+  Time const step = 1 * Minute;
+  IntegrationProblem<ODE> const problem =
+      SatelliteProblem(/*with_centres=*/true);
+  IntegrationProblem<ODE> const problem_without_centres =
+      SatelliteProblem(/*with_centres=*/false);
+  Position<World> const reference = FinalPosition(
+      SymplecticRungeKuttaNyströmIntegrator<methods::BlanesMoan2002SRKN14A,
+                                            Position<World>>(),
+      problem_without_centres,
+      1 * Second,
+      t_final);
+
+  EXPECT_THAT(
+      AbsoluteError(
+          reference,
+          FinalPosition(SymplecticRungeKuttaNyströmIntegrator<
+                            methods::NewtonDelambreStørmerVerletLeapfrog,
+                            serialization::FixedStepSizeIntegrator::BAB,
+                            Position<World>>(),
+                        problem_without_centres,
+                        step,
+                        t_final)),
+      IsNear(860 * Kilo(Metre)));
+  EXPECT_THAT(
+      AbsoluteError(
+          reference,
+          FinalPosition(SymplecticRungeKuttaNyströmIntegrator<
+                            methods::McLachlanAtela1992Order4Optimal,
+                            Position<World>>(),
+                        problem_without_centres,
+                        step,
+                        t_final)),
+      IsNear(111 * Metre));
+
+  EXPECT_THAT(
+      AbsoluteError(
+          reference,
+          FinalPosition(WisdomHolmanIntegrator<methods::WisdomHolman1991,
+                                               Position<World>>(),
+                        problem,
+                        step,
+                        t_final)),
+      IsNear(573 * Metre));
+  EXPECT_THAT(
+      AbsoluteError(
+          reference,
+          FinalPosition(WisdomHolmanIntegrator<methods::LaskarRobutel2001SABA2,
+                                               Position<World>>(),
+                        problem,
+                        step,
+                        t_final)),
+      IsNear(60 * Centi(Metre)));
+  EXPECT_THAT(
+      AbsoluteError(
+          reference,
+          FinalPosition(WisdomHolmanIntegrator<methods::LaskarRobutel2001SBAB4,
+                                               Position<World>>(),
+                        problem,
+                        step,
+                        t_final)),
+      IsNear(19 * Centi(Metre)));
+}
+
+// For a satellite of a spherical planet, the perturbations come from the tides
+// of the star and are tiny, so the integrators reach the accuracy of a
+// high-order method with a short step using much longer steps.
+TEST_F(WisdomHolmanIntegratorTest, SphericalPlanet) {
+  planet_j2_ = 0;
+  Instant const t_final = t0_ + 1 * Day;
+  IntegrationProblem<ODE> const problem =
+      SatelliteProblem(/*with_centres=*/true);
+  IntegrationProblem<ODE> const problem_without_centres =
+      SatelliteProblem(/*with_centres=*/false);
+  Position<World> const reference = FinalPosition(
+      SymplecticRungeKuttaNyströmIntegrator<methods::BlanesMoan2002SRKN14A,
+                                            Position<World>>(),
+      problem_without_centres,
+      1 * Second,
+      t_final);
+
+  EXPECT_THAT(
+      AbsoluteError(reference,
+                    FinalPosition(SymmetricLinearMultistepIntegrator<
+                                      methods::Quinlan1999Order8A,
+                                      Position<World>>(),
+                                  problem_without_centres,
+                                  10 * Second,
+                                  t_final)),
+      Lt(1 * Milli(Metre)));
+  EXPECT_THAT(
+      AbsoluteError(
+          reference,
+          FinalPosition(WisdomHolmanIntegrator<methods::WisdomHolman1991,
+                                               Position<World>>(),
+                        problem,
+                        5 * Minute,
+                        t_final)),
+      IsNear(1.8 * Metre));
+  EXPECT_THAT(
+      AbsoluteError(
+          reference,
+          FinalPosition(WisdomHolmanIntegrator<methods::LaskarRobutel2001SBAB2,
+                                               Position<World>>(),
+                        problem,
+                        5 * Minute,
+                        t_final)),
+      Lt(1 * Centi(Metre)));
+}
+
+// Without centres, the integrators are the corresponding symplectic partitioned
+// Runge-Kutta methods.
+TEST_F(WisdomHolmanIntegratorTest, WithoutCentres) {
+  Instant const t_final = t0_ + 1 * Day;
+  IntegrationProblem<ODE> const problem =
+      SatelliteProblem(/*with_centres=*/false);
+  EXPECT_EQ(FinalPosition(SymplecticRungeKuttaNyströmIntegrator<
+                              methods::NewtonDelambreStørmerVerletLeapfrog,
+                              serialization::FixedStepSizeIntegrator::BAB,
+                              Position<World>>(),
+                          problem,
+                          10 * Second,
+                          t_final),
+            FinalPosition(WisdomHolmanIntegrator<methods::WisdomHolman1991,
+                                                 Position<World>>(),
+                          problem,
+                          10 * Second,
+                          t_final));
+}
+
+TEST_F(WisdomHolmanIntegratorTest, Serialization) {
+  IntegrationProblem<ODE> const problem =
+      SatelliteProblem(/*with_centres=*/true);
+  auto const append_state = [](ODE::SystemState const& state) {};
+  auto const instance1 =
+      WisdomHolmanIntegrator<methods::LaskarRobutel2001SABA3,
+                             Position<World>>().NewInstance(
+          problem, append_state, 10 * Second);
+  instance1->Solve(t0_ + 1000 * Second);
+  serialization::IntegratorInstance message1;
+  instance1->WriteToMessage(&message1);
+  EXPECT_EQ(serialization::FixedStepSizeIntegrator::LASKAR_ROBUTEL_2001_SABA_3,
+            message1
+                .GetExtension(
+                    serialization::FixedStepSizeIntegratorInstance::extension)
+                .integrator()
+                .kind());
+  auto const instance2 =
+      FixedStepSizeIntegrator<ODE>::Instance::ReadFromMessage(
+          message1, problem.equation, append_state);
+  serialization::IntegratorInstance message2;
+  instance2->WriteToMessage(&message2);
+  EXPECT_THAT(message1, EqualsProto(message2));
+}
+
+}  // namespace integrators
+}  // namespace principia
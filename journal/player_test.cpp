@@ -11,12 +11,31 @@
 #include "journal/method.hpp"
 #include "journal/profiles.hpp"
 #include "journal/recorder.hpp"
+#include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/interface.hpp"
+#include "ksp_plugin/iterators.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "quantities/si.hpp"
 #include "serialization/journal.pb.h"
 
 namespace principia {
 namespace journal {
 
+using base::make_not_null_unique;
+using geometry::Displacement;
+using geometry::Instant;
+using geometry::RP2Line;
+using geometry::RP2Point;
+using geometry::Velocity;
+using ksp_plugin::Camera;
+using ksp_plugin::TypedIterator;
+using ksp_plugin::World;
+using physics::DegreesOfFreedom;
+using physics::DiscreteTrajectory;
+using quantities::Length;
+using quantities::si::Metre;
+using quantities::si::Second;
+
 void BM_PlayForReal(benchmark::State& state) {
   while (state.KeepRunning()) {
     Player player(
@@ -47,6 +66,13 @@ class PlayerTest : public ::testing::Test {
     return player.RunIfAppropriate<Profile>(method_in, method_out_return);
   }
 
+  // Makes a pointer that was not created by the journal known to |player|.
+  template<typename T>
+  void InsertPointer(T const* const pointer, Player& player) {
+    player.pointer_map_[reinterpret_cast<std::uint64_t>(pointer)] =
+        const_cast<T*>(pointer);
+  }
+
   ::testing::TestInfo const* const test_info_;
   std::string const test_case_name_;
   std::string const test_name_;
@@ -80,6 +106,55 @@ TEST_F(PlayerTest, PlayTiny) {
   EXPECT_EQ(2, count);
 }
 
+// The arrays returned by the bulk exports are owned by the iterators and must
+// not be looked up in the pointer map on replay.
+TEST_F(PlayerTest, PlayIteratorExport) {
+  auto trajectory = make_not_null_unique<DiscreteTrajectory<World>>();
+  for (int i = 0; i < 3; ++i) {
+    trajectory->Append(
+        Instant() + i * Second,
+        DegreesOfFreedom<World>(
+            World::origin +
+                Displacement<World>({i * Metre, 2 * i * Metre, 3 * i * Metre}),
+            Velocity<World>()));
+  }
+  TypedIterator<DiscreteTrajectory<World>> const trajectory_iterator(
+      std::move(trajectory), plugin_.get());
+  TypedIterator<RP2Line<Length, Camera>> const line_iterator(
+      RP2Line<Length, Camera>{RP2Point<Length, Camera>(1 * Metre, 2 * Metre, 1),
+                              RP2Point<Length, Camera>(3 * Metre, 4 * Metre, 1)});
+
+  {
+    Recorder* const r(new Recorder(test_name_ + ".journal.hex"));
+    Recorder::Activate(r);
+    auto const* const qps =
+        interface::principia__IteratorExportDiscreteTrajectoryQP(
+            &trajectory_iterator);
+    EXPECT_EQ(4, qps[2].q.y);
+    auto const* const xyzs =
+        interface::principia__IteratorExportDiscreteTrajectoryXYZ(
+            &trajectory_iterator);
+    EXPECT_EQ(3, xyzs[1].z);
+    auto const* const xys =
+        interface::principia__IteratorExportRP2LineXY(&line_iterator);
+    EXPECT_EQ(3, xys[1].x);
+    Recorder::Deactivate();
+  }
+
+  Player player(test_name_ + ".journal.hex");
+  // The iterators were not created by the journal, so make them known to the
+  // player.
+  InsertPointer(&trajectory_iterator, player);
+  InsertPointer(&line_iterator, player);
+
+  // Replay the journal.
+  int count = 0;
+  while (player.Play()) {
+    ++count;
+  }
+  EXPECT_EQ(3, count);
+}
+
 TEST_F(PlayerTest, DISABLED_Benchmarks) {
   benchmark::RunSpecifiedBenchmarks();
 }
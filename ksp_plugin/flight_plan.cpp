@@ -15,12 +15,14 @@ namespace principia {
 namespace ksp_plugin {
 namespace internal_flight_plan {
 
+using base::check_not_null;
 using base::Error;
 using base::make_not_null_unique;
 using base::Status;
 using geometry::Position;
 using geometry::Vector;
 using geometry::Velocity;
+using integrators::CompensatedSummation;
 using integrators::EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator;
 using integrators::EmbeddedExplicitRungeKuttaNyströmIntegrator;
 using integrators::methods::DormandالمكاوىPrince1986RKN434FM;
@@ -71,6 +73,14 @@ FlightPlan::FlightPlan(
   ComputeSegments(manœuvres_.begin(), manœuvres_.end());
 }
 
+not_null<std::unique_ptr<FlightPlan>> FlightPlan::Clone() const {
+  return check_not_null(std::unique_ptr<FlightPlan>(new FlightPlan(*this)));
+}
+
+void FlightPlan::set_cancelled(std::atomic_bool const* const cancelled) {
+  cancelled_ = cancelled;
+}
+
 Instant FlightPlan::initial_time() const {
   return initial_time_;
 }
@@ -107,10 +117,10 @@ Status FlightPlan::Append(NavigationManœuvre::Burn const& burn) {
   if (!manœuvre.FitsBetween(start_of_last_coast(), desired_final_time_)) {
     return DoesNotFit();
   }
-  // Reset the last coast and integrate it followed by a burn followed by a new
-  // last coast;
+  // Truncate the last coast at the beginning of the burn and integrate it
+  // followed by a burn followed by a new last coast;
   manœuvres_.push_back(manœuvre);
-  ResetLastSegment();
+  TruncateLastSegment(manœuvre.initial_time());
   return ComputeSegments(manœuvres_.begin() + manœuvres_.size() - 1,
                          manœuvres_.end());
 }
@@ -152,6 +162,9 @@ void FlightPlan::ForgetBefore(Instant const& time,
   auto const root_begin = root_->Begin();
   initial_time_ = root_begin.time();
   initial_degrees_of_freedom_ = root_begin.degrees_of_freedom();
+  for (auto const& pair : apsides_) {
+    pair.second->ForgetBefore(initial_time_);
+  }
 }
 
 Status FlightPlan::RemoveLast() {
@@ -159,8 +172,8 @@ Status FlightPlan::RemoveLast() {
   manœuvres_.pop_back();
   PopLastSegment();  // Last coast.
   PopLastSegment();  // Last burn.
-  // Clear and recompute the last coast.
-  ResetLastSegment();
+  // Extend the last coast.
+  TruncateLastSegment(desired_final_time_);
   return ComputeSegments(manœuvres_.end(), manœuvres_.end());
 }
 
@@ -193,10 +206,11 @@ Status FlightPlan::Replace(NavigationManœuvre::Burn const& burn,
     PopLastSegment();  // Last burn.
   }
 
-  // TODO(phl): Recompute as late as possible.
   // At this point the last coast is the one to which |manœuvre| gets attached.
-  // Clear it and recompute everything that follows.
-  ResetLastSegment();
+  // Only the part of it that follows the beginning of |manœuvre| needs to be
+  // recomputed, and when dragging the Δv the timing usually doesn't change, so
+  // there is nothing to recompute before the burn.
+  TruncateLastSegment(manœuvre.initial_time());
   return ComputeSegments(manœuvres_.begin() + index, manœuvres_.end());
 }
 
@@ -209,8 +223,8 @@ Status FlightPlan::SetDesiredFinalTime(Instant const& desired_final_time) {
     return BadDesiredFinalTime();
   }
   desired_final_time_ = desired_final_time;
-  // Reset the last coast and recompute it.
-  ResetLastSegment();
+  // Truncate the last coast and extend it to the new final time.
+  TruncateLastSegment(desired_final_time_);
   return ComputeSegments(manœuvres_.end(), manœuvres_.end());
 }
 
@@ -256,6 +270,22 @@ void FlightPlan::GetAllSegments(
   CHECK(begin != end);
 }
 
+ApsidesDetector<Barycentric> const& FlightPlan::GetApsides(
+    Trajectory<Barycentric> const& reference) const {
+  auto it = apsides_.find(&reference);
+  if (it == apsides_.end()) {
+    it = apsides_.emplace(
+        &reference,
+        make_not_null_unique<ApsidesDetector<Barycentric>>(reference)).first;
+  }
+  ApsidesDetector<Barycentric>& detector = *it->second;
+  DiscreteTrajectory<Barycentric>::Iterator begin;
+  DiscreteTrajectory<Barycentric>::Iterator end;
+  GetAllSegments(begin, end);
+  detector.Extend(begin, end);
+  return detector;
+}
+
 void FlightPlan::WriteToMessage(
     not_null<serialization::FlightPlan*> const message) const {
   initial_mass_.WriteToMessage(message->mutable_initial_mass());
@@ -346,6 +376,39 @@ FlightPlan::FlightPlan()
           /*length_integration_tolerance=*/1 * Metre,
           /*speed_integration_tolerance=*/1 * Metre / Second) {}
 
+FlightPlan::FlightPlan(FlightPlan const& other)
+    : initial_mass_(other.initial_mass_),
+      initial_time_(other.initial_time_),
+      initial_degrees_of_freedom_(other.initial_degrees_of_freedom_),
+      desired_final_time_(other.desired_final_time_),
+      root_(make_not_null_unique<DiscreteTrajectory<Barycentric>>()),
+      anomalous_segments_(other.anomalous_segments_),
+      manœuvres_(other.manœuvres_),
+      ephemeris_(other.ephemeris_),
+      adaptive_step_parameters_(other.adaptive_step_parameters_),
+      generalized_adaptive_step_parameters_(
+          other.generalized_adaptive_step_parameters_) {
+  root_->Append(initial_time_, initial_degrees_of_freedom_);
+  for (auto const other_segment : other.segments_) {
+    if (segments_.empty()) {
+      segments_.emplace_back(root_->NewForkWithoutCopy(initial_time_));
+    } else {
+      segments_.emplace_back(segments_.back()->NewForkAtLast());
+    }
+    auto& segment = segments_.back();
+    // Skip the fork point, which is already in the ancestry of |segment|.
+    for (auto it = other_segment->Fork(); it != other_segment->End(); ++it) {
+      if (it.time() > segment->last().time()) {
+        segment->Append(it.time(), it.degrees_of_freedom());
+      }
+    }
+  }
+  // The coasting trajectories of the manœuvres must point to our segments.
+  for (int i = 0; i < manœuvres_.size(); ++i) {
+    manœuvres_[i].set_coasting_trajectory(segments_[2 * i]);
+  }
+}
+
 Status FlightPlan::RecomputeAllSegments() {
   // It is important that the segments be destroyed in (reverse chronological)
   // order of the forks.
@@ -359,22 +422,37 @@ Status FlightPlan::RecomputeAllSegments() {
 Status FlightPlan::BurnSegment(
     NavigationManœuvre const& manœuvre,
     not_null<DiscreteTrajectory<Barycentric>*> const segment) {
+  if (cancelled_ != nullptr && *cancelled_) {
+    return Status::CANCELLED;
+  }
   Instant const final_time = manœuvre.final_time();
+  // A burn is recomputed each time it is edited, and it is too short for the
+  // rounding errors on the state to accumulate, so only the time is
+  // compensated.
   if (manœuvre.initial_time() < final_time) {
     if (manœuvre.is_inertially_fixed()) {
+      auto adaptive_step_parameters = adaptive_step_parameters_;
+      adaptive_step_parameters.set_cancelled(cancelled_);
+      adaptive_step_parameters.set_compensated_summation(
+          CompensatedSummation::TimeOnly);
       return ephemeris_->FlowWithAdaptiveStep(
                              segment,
                              manœuvre.InertialIntrinsicAcceleration(),
                              final_time,
-                             adaptive_step_parameters_,
+                             adaptive_step_parameters,
                              max_ephemeris_steps_per_frame,
                              /*last_point_only=*/false);
     } else {
+      auto generalized_adaptive_step_parameters =
+          generalized_adaptive_step_parameters_;
+      generalized_adaptive_step_parameters.set_cancelled(cancelled_);
+      generalized_adaptive_step_parameters.set_compensated_summation(
+          CompensatedSummation::TimeOnly);
       return ephemeris_->FlowWithAdaptiveStep(
                              segment,
                              manœuvre.FrenetIntrinsicAcceleration(),
                              final_time,
-                             generalized_adaptive_step_parameters_,
+                             generalized_adaptive_step_parameters,
                              max_ephemeris_steps_per_frame,
                              /*last_point_only=*/false);
     }
@@ -386,11 +464,16 @@ Status FlightPlan::BurnSegment(
 Status FlightPlan::CoastSegment(
     Instant const& desired_final_time,
     not_null<DiscreteTrajectory<Barycentric>*> const segment) {
+  if (cancelled_ != nullptr && *cancelled_) {
+    return Status::CANCELLED;
+  }
+  auto adaptive_step_parameters = adaptive_step_parameters_;
+  adaptive_step_parameters.set_cancelled(cancelled_);
   return ephemeris_->FlowWithAdaptiveStep(
                          segment,
                          Ephemeris<Barycentric>::NoIntrinsicAcceleration,
                          desired_final_time,
-                         adaptive_step_parameters_,
+                         adaptive_step_parameters,
                          max_ephemeris_steps_per_frame,
                          /*last_point_only=*/false);
 }
@@ -444,13 +527,27 @@ void FlightPlan::AddLastSegment() {
 }
 
 void FlightPlan::ResetLastSegment() {
+  InvalidateApsides();
   segments_.back()->ForgetAfter(segments_.back()->Fork().time());
   if (anomalous_segments_ == 1) {
     anomalous_segments_ = 0;
   }
 }
 
+void FlightPlan::TruncateLastSegment(Instant const& time) {
+  auto& segment = segments_.back();
+  Instant const cutoff = std::max(time, segment->Fork().time());
+  if (cutoff < segment->last().time()) {
+    InvalidateApsides();
+    segment->ForgetAfter(cutoff);
+  }
+  if (anomalous_segments_ == 1) {
+    anomalous_segments_ = 0;
+  }
+}
+
 void FlightPlan::PopLastSegment() {
+  InvalidateApsides();
   DiscreteTrajectory<Barycentric>* trajectory = segments_.back();
   CHECK(!trajectory->is_root());
   trajectory->parent()->DeleteFork(trajectory);
@@ -460,6 +557,10 @@ void FlightPlan::PopLastSegment() {
   }
 }
 
+void FlightPlan::InvalidateApsides() {
+  apsides_.clear();
+}
+
 Instant FlightPlan::start_of_last_coast() const {
   return manœuvres_.empty() ? initial_time_ : manœuvres_.back().final_time();
 }
@@ -1,6 +1,9 @@
 ﻿
 #pragma once
 
+#include <atomic>
+#include <map>
+#include <memory>
 #include <vector>
 
 #include "base/not_null.hpp"
@@ -9,9 +12,11 @@
 #include "integrators/ordinary_differential_equations.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/manœuvre.hpp"
+#include "physics/apsides.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
+#include "physics/trajectory.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 #include "serialization/ksp_plugin.pb.h"
@@ -25,9 +30,11 @@ using base::not_null;
 using base::Status;
 using geometry::Instant;
 using integrators::AdaptiveStepSizeIntegrator;
+using physics::ApsidesDetector;
 using physics::DegreesOfFreedom;
 using physics::DiscreteTrajectory;
 using physics::Ephemeris;
+using physics::Trajectory;
 using quantities::Length;
 using quantities::Mass;
 using quantities::Speed;
@@ -52,6 +59,16 @@ class FlightPlan {
                  generalized_adaptive_step_parameters);
   virtual ~FlightPlan() = default;
 
+  // Returns a deep copy of this flight plan, which shares the ephemeris but
+  // owns copies of the segments.  No integration takes place.
+  virtual not_null<std::unique_ptr<FlightPlan>> Clone() const;
+
+  // If |cancelled| is not null, it is checked before integrating each segment
+  // and during the integration, and once it is true the integrations stop with
+  // |Error::CANCELLED|, leaving anomalous segments.  This is used to abandon a mutation whose result will
+  // be discarded.  |cancelled| must outlive the mutations of this object.
+  void set_cancelled(std::atomic_bool const* cancelled);
+
   // Construction parameters.
   virtual Instant initial_time() const;
   virtual Instant desired_final_time() const;
@@ -131,6 +148,12 @@ class FlightPlan {
       DiscreteTrajectory<Barycentric>::Iterator& begin,
       DiscreteTrajectory<Barycentric>::Iterator& end) const;
 
+  // Returns the apsides of all the segments with respect to |reference|.  The
+  // apsides are cached: they are only computed for the points that were added
+  // to the segments since the last call, unless points were removed.
+  virtual ApsidesDetector<Barycentric> const& GetApsides(
+      Trajectory<Barycentric> const& reference) const;
+
   void WriteToMessage(not_null<serialization::FlightPlan*> message) const;
 
   // This may return a null pointer if the flight plan contained in the
@@ -150,16 +173,20 @@ class FlightPlan {
   FlightPlan();
 
  private:
+  // Used by |Clone|.
+  FlightPlan(FlightPlan const& other);
+
   // Clears and recomputes all trajectories in |segments_|.
   Status RecomputeAllSegments();
 
   // Flows the given |segment| for the duration of |manœuvre| using its
-  // intrinsic acceleration.
+  // intrinsic acceleration.  Returns |Error::CANCELLED| as soon as
+  // |cancelled_| is set.
   Status BurnSegment(NavigationManœuvre const& manœuvre,
                      not_null<DiscreteTrajectory<Barycentric>*> segment);
 
   // Flows the given |segment| until |desired_final_time| with no intrinsic
-  // acceleration.
+  // acceleration.  Returns |Error::CANCELLED| as soon as |cancelled_| is set.
   Status CoastSegment(Instant const& desired_final_time,
                       not_null<DiscreteTrajectory<Barycentric>*> segment);
 
@@ -182,10 +209,19 @@ class FlightPlan {
   // only anomalous one, there are no anomalous trajectories after this call.
   void ResetLastSegment();
 
+  // Forgets the last trajectory after |time| (or after its fork if |time| is
+  // earlier), so that its integration resumes from its last point at or
+  // before |time| instead of from its fork.  If that trajectory was the only
+  // anomalous one, there are no anomalous trajectories after this call.
+  void TruncateLastSegment(Instant const& time);
+
   // Deletes the last trajectory and removes it from |segments_|.  If there are
   // anomalous trajectories, their number is decremented and may become 0.
   void PopLastSegment();
 
+  // Must be called whenever points are removed from the end of |segments_|.
+  void InvalidateApsides();
+
   Instant start_of_last_coast() const;
 
   // In the following functions, |index| refers to the index of a manœuvre.
@@ -213,6 +249,15 @@ class FlightPlan {
   Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters_;
   Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters
       generalized_adaptive_step_parameters_;
+
+  // Not owned; null unless this flight plan is being mutated asynchronously.
+  std::atomic_bool const* cancelled_ = nullptr;
+
+  // The apsides of the flight plan, indexed by reference.  Points appended to
+  // the segments are picked lazily by |GetApsides|.
+  mutable std::map<Trajectory<Barycentric> const*,
+                   not_null<std::unique_ptr<ApsidesDetector<Barycentric>>>>
+      apsides_;
 };
 
 }  // namespace internal_flight_plan
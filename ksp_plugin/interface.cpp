@@ -115,6 +115,10 @@ constexpr char hexadecimal_encoder[] = "hexadecimal";
 constexpr int chunk_size = 64 << 10;
 constexpr int number_of_chunks = 8;
 
+// The arena on which the plugin message is built during serialization and
+// deserialization.  Protocol buffers allocate all the submessages on the arena
+// of their parent, so the entire tree is freed in bulk by |Reset| once the
+// streaming has completed.
 not_null<Arena*> arena = []() {
   ArenaOptions options;
   options.initial_block_size = chunk_size;
@@ -2,6 +2,7 @@
 #include "ksp_plugin/interface.hpp"
 
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "base/array.hpp"
@@ -31,12 +32,10 @@ using physics::RigidTransformation;
 namespace {
 
 Status MakeStatus(base::Status const status) {
-  Status result;
   if (!status.ok()) {
     LOG(ERROR) << status.message();
   }
-  result.error = static_cast<int>(status.error());
-  return result;
+  return ToStatus(status);
 }
 
 // A wrapper for |MakeStatus(base::Status(error, message))|, since we often
@@ -207,11 +206,18 @@ Status principia__ExternalGetNearestPlannedCoastDegreesOfFreedom(
   flight_plan.GetSegment(segment_index, coast_begin, coast_end);
   auto const body_centred_inertial =
       plugin->NewBodyCentredNonRotatingNavigationFrame(central_body_index);
-  DiscreteTrajectory<Navigation> coast;
+  std::vector<Instant> times;
+  std::vector<DegreesOfFreedom<Barycentric>> degrees_of_freedom;
   for (auto it = coast_begin; it != coast_end; ++it) {
-    coast.Append(it.time(),
-                 body_centred_inertial->ToThisFrameAtTime(it.time())(
-                     it.degrees_of_freedom()));
+    times.push_back(it.time());
+    degrees_of_freedom.push_back(it.degrees_of_freedom());
+  }
+  std::vector<DegreesOfFreedom<Navigation>> const
+      degrees_of_freedom_in_navigation =
+          body_centred_inertial->ToThisFrameAtTimes(times, degrees_of_freedom);
+  DiscreteTrajectory<Navigation> coast;
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    coast.Append(times[i], degrees_of_freedom_in_navigation[i]);
   }
 
   Instant const current_time = plugin->CurrentTime();
@@ -1,6 +1,9 @@
 ﻿
 #include "ksp_plugin/interface.hpp"
 
+#include <memory>
+#include <utility>
+
 #include "base/not_null.hpp"
 #include "geometry/named_quantities.hpp"
 #include "glog/logging.h"
@@ -167,29 +170,83 @@ NavigationManoeuvre ToInterfaceNavigationManoeuvre(
   return result;
 }
 
-}  // namespace
+// The following functions implement the edits that may be done synchronously
+// or asynchronously.  They return OK if the edit was accepted.
+// NOTE(phl): Preserving the previous semantics of FlightPlan.
 
-bool principia__FlightPlanAppend(Plugin const* const plugin,
-                                 char const* const vessel_guid,
-                                 Burn const burn) {
-  journal::Method<journal::FlightPlanAppend> m({plugin, vessel_guid, burn});
-  CHECK_NOTNULL(plugin);
-
-  // NOTE(phl): Preserving the previous semantics of FlightPlan.
-  auto& flight_plan = GetFlightPlan(*plugin, vessel_guid);
-  base::Status const status =
-      flight_plan.Append(FromInterfaceBurn(*plugin, burn));
+base::Status Append(FlightPlan& flight_plan,
+                    NavigationManœuvre::Burn const& burn) {
+  base::Status const status = flight_plan.Append(burn);
   if (status.error() == FlightPlan::singular ||
       status.error() == FlightPlan::does_not_fit) {
-    return m.Return(false);
+    return status;
   } else if (status.ok() || flight_plan.number_of_anomalous_manœuvres() == 0) {
-    return m.Return(true);
+    return base::Status::OK;
   } else {
     flight_plan.RemoveLast();
-    return m.Return(false);
+    return status;
   }
 }
 
+base::Status ReplaceLast(FlightPlan& flight_plan,
+                         NavigationManœuvre::Burn const& burn) {
+  auto const manœuvre =
+      flight_plan.GetManœuvre(flight_plan.number_of_manœuvres() - 1);
+  base::Status const status = flight_plan.ReplaceLast(burn);
+  if (status.error() == FlightPlan::singular ||
+      status.error() == FlightPlan::does_not_fit) {
+    return status;
+  } else if (status.ok() || flight_plan.number_of_anomalous_manœuvres() == 0) {
+    return base::Status::OK;
+  } else {
+    flight_plan.Append(manœuvre.burn());
+    return status;
+  }
+}
+
+base::Status SetAdaptiveStepParameters(
+    FlightPlan& flight_plan,
+    std::pair<Ephemeris<Barycentric>::AdaptiveStepParameters,
+              Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters> const&
+        parameters) {
+  auto const adaptive_step_parameters =
+      flight_plan.adaptive_step_parameters();
+  auto const generalized_adaptive_step_parameters =
+      flight_plan.generalized_adaptive_step_parameters();
+  base::Status const status =
+      flight_plan.SetAdaptiveStepParameters(parameters.first,
+                                            parameters.second);
+  if (!status.ok()) {
+    flight_plan.SetAdaptiveStepParameters(adaptive_step_parameters,
+                                          generalized_adaptive_step_parameters);
+  }
+  return status;
+}
+
+base::Status SetDesiredFinalTime(FlightPlan& flight_plan,
+                                 Instant const& final_time) {
+  base::Status const status = flight_plan.SetDesiredFinalTime(final_time);
+  if (status.error() == FlightPlan::bad_desired_final_time) {
+    return status;
+  }
+  return base::Status::OK;
+}
+
+}  // namespace
+
+bool principia__FlightPlanAppend(Plugin const* const plugin,
+                                 char const* const vessel_guid,
+                                 Burn const burn) {
+  journal::Method<journal::FlightPlanAppend> m({plugin, vessel_guid, burn});
+  CHECK_NOTNULL(plugin);
+  auto const navigation_burn = FromInterfaceBurn(*plugin, burn);
+  return m.Return(
+      plugin->GetVessel(vessel_guid)->MutateFlightPlan(
+          [&navigation_burn](FlightPlan& flight_plan) {
+            return Append(flight_plan, navigation_burn);
+          }).ok());
+}
+
 void principia__FlightPlanCreate(Plugin const* const plugin,
                                  char const* const vessel_guid,
                                  double const final_time,
@@ -335,11 +392,23 @@ int principia__FlightPlanNumberOfSegments(Plugin const* const plugin,
   return m.Return(GetFlightPlan(*plugin, vessel_guid).number_of_segments());
 }
 
+Status principia__FlightPlanPollAsynchronousMutation(
+    Plugin const* const plugin,
+    char const* const vessel_guid) {
+  journal::Method<journal::FlightPlanPollAsynchronousMutation> m(
+      {plugin, vessel_guid});
+  CHECK_NOTNULL(plugin);
+  return m.Return(
+      ToStatus(plugin->GetVessel(vessel_guid)->PollFlightPlanMutation()));
+}
+
 void principia__FlightPlanRemoveLast(Plugin const* const plugin,
                                      char const* const vessel_guid) {
   journal::Method<journal::FlightPlanRemoveLast> m({plugin, vessel_guid});
   CHECK_NOTNULL(plugin);
-  GetFlightPlan(*plugin, vessel_guid).RemoveLast();
+  plugin->GetVessel(vessel_guid)->MutateFlightPlan([](FlightPlan& flight_plan) {
+    return flight_plan.RemoveLast();
+  });
   return m.Return();
 }
 
@@ -353,16 +422,14 @@ void principia__FlightPlanRenderedApsides(Plugin const* const plugin,
       {plugin, vessel_guid, celestial_index, sun_world_position},
       {apoapsides, periapsides});
   CHECK_NOTNULL(plugin);
-  DiscreteTrajectory<Barycentric>::Iterator begin;
-  DiscreteTrajectory<Barycentric>::Iterator end;
-  GetFlightPlan(*plugin, vessel_guid).GetAllSegments(begin, end);
+  auto const& apsides = GetFlightPlan(*plugin, vessel_guid).GetApsides(
+      plugin->GetCelestial(celestial_index).trajectory());
   std::unique_ptr<DiscreteTrajectory<World>> rendered_apoapsides;
   std::unique_ptr<DiscreteTrajectory<World>> rendered_periapsides;
-  plugin->ComputeAndRenderApsides(celestial_index,
-                                  begin, end,
-                                  FromXYZ<Position<World>>(sun_world_position),
-                                  rendered_apoapsides,
-                                  rendered_periapsides);
+  plugin->RenderApsides(apsides,
+                        FromXYZ<Position<World>>(sun_world_position),
+                        rendered_apoapsides,
+                        rendered_periapsides);
   *apoapsides = new TypedIterator<DiscreteTrajectory<World>>(
       check_not_null(std::move(rendered_apoapsides)),
       plugin);
@@ -463,22 +530,29 @@ bool principia__FlightPlanReplaceLast(Plugin const* const plugin,
                                                      vessel_guid,
                                                      burn});
   CHECK_NOTNULL(plugin);
+  auto const navigation_burn = FromInterfaceBurn(*plugin, burn);
+  return m.Return(
+      plugin->GetVessel(vessel_guid)->MutateFlightPlan(
+          [&navigation_burn](FlightPlan& flight_plan) {
+            return ReplaceLast(flight_plan, navigation_burn);
+          }).ok());
+}
 
-  // NOTE(phl): Preserving the previous semantics of FlightPlan.
-  auto& flight_plan = GetFlightPlan(*plugin, vessel_guid);
-  auto const manœuvre =
-      flight_plan.GetManœuvre(flight_plan.number_of_manœuvres() - 1);
-  base::Status const status =
-      flight_plan.ReplaceLast(FromInterfaceBurn(*plugin, burn));
-  if (status.error() == FlightPlan::singular ||
-      status.error() == FlightPlan::does_not_fit) {
-    return m.Return(false);
-  } else if (status.ok() || flight_plan.number_of_anomalous_manœuvres() == 0) {
-    return m.Return(true);
-  } else {
-    flight_plan.Append(manœuvre.burn());
-    return m.Return(false);
-  }
+void principia__FlightPlanReplaceLastAsynchronously(
+    Plugin const* const plugin,
+    char const* const vessel_guid,
+    Burn const burn) {
+  journal::Method<journal::FlightPlanReplaceLastAsynchronously> m(
+      {plugin, vessel_guid, burn});
+  CHECK_NOTNULL(plugin);
+  // The burn owns its frame, so it cannot be copied into an |std::function|.
+  auto const navigation_burn = std::make_shared<NavigationManœuvre::Burn>(
+      FromInterfaceBurn(*plugin, burn));
+  plugin->GetVessel(vessel_guid)->MutateFlightPlanAsynchronously(
+      [navigation_burn](FlightPlan& flight_plan) {
+        return ReplaceLast(flight_plan, *navigation_burn);
+      });
+  return m.Return();
 }
 
 bool principia__FlightPlanSetAdaptiveStepParameters(
@@ -491,23 +565,28 @@ bool principia__FlightPlanSetAdaptiveStepParameters(
   CHECK_NOTNULL(plugin);
   auto const parameters = FromFlightPlanAdaptiveStepParameters(
       flight_plan_adaptive_step_parameters);
+  return m.Return(
+      plugin->GetVessel(vessel_guid)->MutateFlightPlan(
+          [&parameters](FlightPlan& flight_plan) {
+            return SetAdaptiveStepParameters(flight_plan, parameters);
+          }).ok());
+}
 
-  // NOTE(phl): Preserving the previous semantics of FlightPlan.
-  auto& flight_plan = GetFlightPlan(*plugin, vessel_guid);
-  auto const adaptive_step_parameters =
-      flight_plan.adaptive_step_parameters();
-  auto const generalized_adaptive_step_parameters =
-      flight_plan.generalized_adaptive_step_parameters();
-  base::Status const status =
-      flight_plan.SetAdaptiveStepParameters(parameters.first,
-                                            parameters.second);
-  if (status.ok()) {
-    return m.Return(true);
-  } else {
-    flight_plan.SetAdaptiveStepParameters(adaptive_step_parameters,
-                                          generalized_adaptive_step_parameters);
-    return m.Return(false);
-  }
+void principia__FlightPlanSetAdaptiveStepParametersAsynchronously(
+    Plugin const* const plugin,
+    char const* const vessel_guid,
+    FlightPlanAdaptiveStepParameters const
+        flight_plan_adaptive_step_parameters) {
+  journal::Method<journal::FlightPlanSetAdaptiveStepParametersAsynchronously> m(
+      {plugin, vessel_guid, flight_plan_adaptive_step_parameters});
+  CHECK_NOTNULL(plugin);
+  auto const parameters = FromFlightPlanAdaptiveStepParameters(
+      flight_plan_adaptive_step_parameters);
+  plugin->GetVessel(vessel_guid)->MutateFlightPlanAsynchronously(
+      [parameters](FlightPlan& flight_plan) {
+        return SetAdaptiveStepParameters(flight_plan, parameters);
+      });
+  return m.Return();
 }
 
 bool principia__FlightPlanSetDesiredFinalTime(Plugin const* const plugin,
@@ -517,12 +596,27 @@ bool principia__FlightPlanSetDesiredFinalTime(Plugin const* const plugin,
                                                              vessel_guid,
                                                              final_time});
   CHECK_NOTNULL(plugin);
+  Instant const desired_final_time = FromGameTime(*plugin, final_time);
+  return m.Return(
+      plugin->GetVessel(vessel_guid)->MutateFlightPlan(
+          [&desired_final_time](FlightPlan& flight_plan) {
+            return SetDesiredFinalTime(flight_plan, desired_final_time);
+          }).ok());
+}
 
-  // NOTE(phl): Preserving the previous semantics of FlightPlan.
-  auto& flight_plan = GetFlightPlan(*plugin, vessel_guid);
-  base::Status const status =
-      flight_plan.SetDesiredFinalTime(FromGameTime(*plugin, final_time));
-  return m.Return(status.error() != FlightPlan::bad_desired_final_time);
+void principia__FlightPlanSetDesiredFinalTimeAsynchronously(
+    Plugin const* const plugin,
+    char const* const vessel_guid,
+    double const final_time) {
+  journal::Method<journal::FlightPlanSetDesiredFinalTimeAsynchronously> m(
+      {plugin, vessel_guid, final_time});
+  CHECK_NOTNULL(plugin);
+  Instant const desired_final_time = FromGameTime(*plugin, final_time);
+  plugin->GetVessel(vessel_guid)->MutateFlightPlanAsynchronously(
+      [desired_final_time](FlightPlan& flight_plan) {
+        return SetDesiredFinalTime(flight_plan, desired_final_time);
+      });
+  return m.Return();
 }
 
 }  // namespace interface
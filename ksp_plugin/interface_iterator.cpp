@@ -87,6 +87,41 @@ Iterator* principia__IteratorGetRP2LinesIterator(
       }));
 }
 
+XYZ const* principia__IteratorExportDiscreteTrajectoryXYZ(
+    Iterator const* const iterator) {
+  journal::Method<journal::IteratorExportDiscreteTrajectoryXYZ> m({iterator});
+  CHECK_NOTNULL(iterator);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<DiscreteTrajectory<World>> const*>(iterator));
+  return m.Return(typed_iterator->Export<XYZ>(
+      [](DiscreteTrajectory<World>::Iterator const& iterator) -> XYZ {
+        return ToXYZ(iterator.degrees_of_freedom().position());
+      }));
+}
+
+QP const* principia__IteratorExportDiscreteTrajectoryQP(
+    Iterator const* const iterator) {
+  journal::Method<journal::IteratorExportDiscreteTrajectoryQP> m({iterator});
+  CHECK_NOTNULL(iterator);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<DiscreteTrajectory<World>> const*>(iterator));
+  return m.Return(typed_iterator->Export<QP>(
+      [](DiscreteTrajectory<World>::Iterator const& iterator) -> QP {
+        return ToQP(iterator.degrees_of_freedom());
+      }));
+}
+
+XY const* principia__IteratorExportRP2LineXY(Iterator const* const iterator) {
+  journal::Method<journal::IteratorExportRP2LineXY> m({iterator});
+  CHECK_NOTNULL(iterator);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<RP2Line<Length, Camera>> const*>(iterator));
+  return m.Return(typed_iterator->Export<XY>(
+      [](RP2Point<Length, Camera> const& rp2_point) -> XY {
+        return ToXY(rp2_point);
+      }));
+}
+
 XY principia__IteratorGetRP2LineXY(Iterator const* const iterator) {
   journal::Method<journal::IteratorGetRP2LineXY> m({iterator});
   CHECK_NOTNULL(iterator);
@@ -56,6 +56,9 @@ RP2Lines<Length, Camera> PlotMethodN(
     case 1:
       return planetarium.PlotMethod1(begin, end, now, reverse);
     case 2:
+    case 3:
+      // Levels of detail are only maintained for psychohistories, see
+      // |principia__PlanetariumPlotPsychohistory|.
       return planetarium.PlotMethod2(begin, end, now, reverse);
     default:
       LOG(FATAL) << "Unexpected method " << method;
@@ -202,13 +205,24 @@ Iterator* principia__PlanetariumPlotPsychohistory(
   if (plugin->renderer().HasTargetVessel()) {
     return m.Return(new TypedIterator<RP2Lines<Length, Camera>>({}));
   } else {
-    auto const& psychohistory = plugin->GetVessel(vessel_guid)->psychohistory();
-    auto const rp2_lines = PlotMethodN(*planetarium,
-                                       method,
-                                       psychohistory.Begin(),
-                                       psychohistory.End(),
-                                       plugin->CurrentTime(),
-                                       /*reverse=*/true);
+    auto const vessel = plugin->GetVessel(vessel_guid);
+    auto const& psychohistory = vessel->psychohistory();
+    RP2Lines<Length, Camera> rp2_lines;
+    if (method == 3) {
+      rp2_lines = planetarium->PlotMethod3(
+          psychohistory.Begin(),
+          psychohistory.End(),
+          plugin->renderer().LevelsOfDetailInPlotting(vessel),
+          plugin->CurrentTime(),
+          /*reverse=*/true);
+    } else {
+      rp2_lines = PlotMethodN(*planetarium,
+                              method,
+                              psychohistory.Begin(),
+                              psychohistory.End(),
+                              plugin->CurrentTime(),
+                              /*reverse=*/true);
+    }
     return m.Return(new TypedIterator<RP2Lines<Length, Camera>>(rp2_lines));
   }
 }
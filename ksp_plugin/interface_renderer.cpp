@@ -43,15 +43,14 @@ void principia__RenderedPredictionApsides(Plugin const* const plugin,
       {plugin, vessel_guid, celestial_index, sun_world_position},
       {apoapsides, periapsides});
   CHECK_NOTNULL(plugin);
-  auto const& prediction = plugin->GetVessel(vessel_guid)->prediction();
+  auto const& apsides = plugin->GetVessel(vessel_guid)->PredictionApsides(
+      plugin->GetCelestial(celestial_index));
   std::unique_ptr<DiscreteTrajectory<World>> rendered_apoapsides;
   std::unique_ptr<DiscreteTrajectory<World>> rendered_periapsides;
-  plugin->ComputeAndRenderApsides(celestial_index,
-                                  prediction.Fork(),
-                                  prediction.End(),
-                                  FromXYZ<Position<World>>(sun_world_position),
-                                  rendered_apoapsides,
-                                  rendered_periapsides);
+  plugin->RenderApsides(apsides,
+                        FromXYZ<Position<World>>(sun_world_position),
+                        rendered_apoapsides,
+                        rendered_periapsides);
   *apoapsides = new TypedIterator<DiscreteTrajectory<World>>(
       check_not_null(std::move(rendered_apoapsides)),
       plugin);
@@ -1,6 +1,10 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "base/not_null.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/identification.hpp"
@@ -37,6 +41,16 @@ class TypedIterator : public Iterator {
       std::function<Interchange(typename Container::value_type const&)> const&
           convert) const;
 
+  // Converts all the elements of the container, irrespective of the position
+  // of this iterator, to some |Interchange| type using |convert|.  Returns a
+  // pointer to a contiguous array of |Size()| results, which is owned by this
+  // object and remains valid until the next call to |Export| or until this
+  // object is destroyed.
+  template<typename Interchange>
+  Interchange const* Export(
+      std::function<Interchange(typename Container::value_type const&)> const&
+          convert) const;
+
   bool AtEnd() const override;
   void Increment() override;
   void Reset() override;
@@ -45,6 +59,7 @@ class TypedIterator : public Iterator {
  private:
   Container container_;
   typename Container::const_iterator iterator_;
+  mutable std::shared_ptr<void> exported_;
 };
 
 // A specialization for |DiscreteTrajectory<World>|.
@@ -61,6 +76,12 @@ class TypedIterator<DiscreteTrajectory<World>> : public Iterator {
       std::function<Interchange(
           DiscreteTrajectory<World>::Iterator const&)> const& convert) const;
 
+  // Same as above, but for all the points of the trajectory.
+  template<typename Interchange>
+  Interchange const* Export(
+      std::function<Interchange(
+          DiscreteTrajectory<World>::Iterator const&)> const& convert) const;
+
   bool AtEnd() const override;
   void Increment() override;
   void Reset() override;
@@ -73,6 +94,7 @@ class TypedIterator<DiscreteTrajectory<World>> : public Iterator {
   not_null<std::unique_ptr<DiscreteTrajectory<World>>> trajectory_;
   DiscreteTrajectory<World>::Iterator iterator_;
   not_null<Plugin const*> plugin_;
+  mutable std::shared_ptr<void> exported_;
 };
 
 }  // namespace ksp_plugin
@@ -20,6 +20,20 @@ Interchange TypedIterator<Container>::Get(
   return convert(*iterator_);
 }
 
+template<typename Container>
+template<typename Interchange>
+Interchange const* TypedIterator<Container>::Export(
+    std::function<Interchange(typename Container::value_type const&)> const&
+        convert) const {
+  auto const exported = std::make_shared<std::vector<Interchange>>();
+  exported->reserve(container_.size());
+  for (auto const& element : container_) {
+    exported->push_back(convert(element));
+  }
+  exported_ = exported;
+  return exported->data();
+}
+
 template<typename Container>
 bool TypedIterator<Container>::AtEnd() const {
   return iterator_ == container_.end();
@@ -57,6 +71,19 @@ Interchange TypedIterator<DiscreteTrajectory<World>>::Get(
   return convert(iterator_);
 }
 
+template<typename Interchange>
+Interchange const* TypedIterator<DiscreteTrajectory<World>>::Export(
+    std::function<Interchange(
+        DiscreteTrajectory<World>::Iterator const&)> const& convert) const {
+  auto const exported = std::make_shared<std::vector<Interchange>>();
+  exported->reserve(trajectory_->Size());
+  for (auto it = trajectory_->Begin(); it != trajectory_->End(); ++it) {
+    exported->push_back(convert(it));
+  }
+  exported_ = exported;
+  return exported->data();
+}
+
 inline bool TypedIterator<DiscreteTrajectory<World>>::AtEnd() const {
   return iterator_ == trajectory_->End();
 }
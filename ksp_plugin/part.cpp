@@ -2,6 +2,7 @@
 #include "ksp_plugin/part.hpp"
 
 #include <list>
+#include <memory>
 #include <string>
 
 #include "base/array.hpp"
@@ -28,6 +29,8 @@ Part::Part(
       mass_(mass),
       degrees_of_freedom_(degrees_of_freedom),
       prehistory_(make_not_null_unique<DiscreteTrajectory<Barycentric>>()),
+      rigid_trajectory_offset_(Barycentric::origin - Barycentric::origin,
+                               Velocity<Barycentric>()),
       subset_node_(make_not_null_unique<Subset<Part>::Node>()),
       deletion_callback_(std::move(deletion_callback)) {
   CHECK_GT(mass_, Mass{}) << ShortDebugString();
@@ -80,16 +83,19 @@ Part::degrees_of_freedom() const {
 }
 
 DiscreteTrajectory<Barycentric>::Iterator Part::history_begin() {
+  MaterializeRigidTrajectory();
   // Make sure that we skip the point of the prehistory.
   auto it = history_->Fork();
   return ++it;
 }
 
 DiscreteTrajectory<Barycentric>::Iterator Part::history_end() {
+  MaterializeRigidTrajectory();
   return history_->End();
 }
 
 DiscreteTrajectory<Barycentric>::Iterator Part::psychohistory_begin() {
+  MaterializeRigidTrajectory();
   if (psychohistory_ == nullptr) {
     psychohistory_ = history_->NewForkAtLast();
   }
@@ -99,6 +105,7 @@ DiscreteTrajectory<Barycentric>::Iterator Part::psychohistory_begin() {
 }
 
 DiscreteTrajectory<Barycentric>::Iterator Part::psychohistory_end() {
+  MaterializeRigidTrajectory();
   if (psychohistory_ == nullptr) {
     psychohistory_ = history_->NewForkAtLast();
   }
@@ -108,6 +115,7 @@ DiscreteTrajectory<Barycentric>::Iterator Part::psychohistory_end() {
 void Part::AppendToHistory(
     Instant const& time,
     DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+  MaterializeRigidTrajectory();
   if (psychohistory_ != nullptr) {
     history_->DeleteFork(psychohistory_);
   }
@@ -117,13 +125,43 @@ void Part::AppendToHistory(
 void Part::AppendToPsychohistory(
     Instant const& time,
     DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+  MaterializeRigidTrajectory();
   if (psychohistory_ == nullptr) {
     psychohistory_ = history_->NewForkAtLast();
   }
   psychohistory_->Append(time, degrees_of_freedom);
 }
 
+void Part::AppendRigidTrajectory(
+    not_null<std::shared_ptr<PileUpTrajectory const>> const& trajectory,
+    RelativeDegreesOfFreedom<Barycentric> const& offset) {
+  MaterializeRigidTrajectory();
+  auto const is_empty = [](DiscreteTrajectory<Barycentric> const* const fork) {
+    if (fork == nullptr) {
+      return true;
+    }
+    auto it = fork->Fork();
+    return ++it == fork->End();
+  };
+  if (is_empty(history_) && is_empty(psychohistory_)) {
+    rigid_trajectory_ = trajectory;
+    rigid_trajectory_offset_ = offset;
+  } else {
+    AppendRigidTrajectory(*trajectory, offset, *history_, psychohistory_);
+  }
+}
+
+PileUpTrajectory const* Part::rigid_trajectory() const {
+  return rigid_trajectory_.get();
+}
+
+RelativeDegreesOfFreedom<Barycentric> const&
+Part::rigid_trajectory_offset() const {
+  return rigid_trajectory_offset_;
+}
+
 void Part::ClearHistory() {
+  rigid_trajectory_.reset();
   if (psychohistory_ != nullptr) {
     history_->DeleteFork(psychohistory_);
   }
@@ -166,8 +204,25 @@ void Part::WriteToMessage(not_null<serialization::Part*> const message,
         serialization_index_for_pile_up(containing_pile_up_.get()));
   }
   degrees_of_freedom_.WriteToMessage(message->mutable_degrees_of_freedom());
-  prehistory_->WriteToMessage(message->mutable_prehistory(),
-                              /*forks=*/{history_, psychohistory_});
+  if (rigid_trajectory_ == nullptr) {
+    prehistory_->WriteToMessage(message->mutable_prehistory(),
+                                /*forks=*/{history_, psychohistory_});
+  } else {
+    // Serialize a materialized copy of the trajectories, this object is const.
+    auto const prehistory =
+        make_not_null_unique<DiscreteTrajectory<Barycentric>>();
+    prehistory->Append(astronomy::InfinitePast,
+                       {Barycentric::origin, Velocity<Barycentric>()});
+    DiscreteTrajectory<Barycentric>* const history =
+        prehistory->NewForkAtLast();
+    DiscreteTrajectory<Barycentric>* psychohistory = nullptr;
+    AppendRigidTrajectory(*rigid_trajectory_,
+                          rigid_trajectory_offset_,
+                          *history,
+                          psychohistory);
+    prehistory->WriteToMessage(message->mutable_prehistory(),
+                               /*forks=*/{history, psychohistory});
+  }
 }
 
 not_null<std::unique_ptr<Part>> Part::ReadFromMessage(
@@ -223,6 +278,37 @@ std::string Part::ShortDebugString() const {
   return name_ + " (" + hex_id.data.get() + ")";
 }
 
+void Part::AppendRigidTrajectory(
+    PileUpTrajectory const& trajectory,
+    RelativeDegreesOfFreedom<Barycentric> const& offset,
+    DiscreteTrajectory<Barycentric>& history,
+    DiscreteTrajectory<Barycentric>*& psychohistory) {
+  for (auto const& pair : trajectory.history) {
+    if (psychohistory != nullptr) {
+      history.DeleteFork(psychohistory);
+    }
+    history.Append(pair.first, pair.second + offset);
+  }
+  for (auto const& pair : trajectory.psychohistory) {
+    if (psychohistory == nullptr) {
+      psychohistory = history.NewForkAtLast();
+    }
+    psychohistory->Append(pair.first, pair.second + offset);
+  }
+}
+
+void Part::MaterializeRigidTrajectory() {
+  if (rigid_trajectory_ != nullptr) {
+    std::shared_ptr<PileUpTrajectory const> const trajectory =
+        std::move(rigid_trajectory_);
+    rigid_trajectory_.reset();
+    AppendRigidTrajectory(*trajectory,
+                          rigid_trajectory_offset_,
+                          *history_,
+                          psychohistory_);
+  }
+}
+
 std::ostream& operator<<(std::ostream& out, Part const& part) {
   return out << "{"
              << part.part_id() << ", "
@@ -31,6 +31,7 @@ using geometry::Vector;
 using geometry::Velocity;
 using physics::DegreesOfFreedom;
 using physics::DiscreteTrajectory;
+using physics::RelativeDegreesOfFreedom;
 using quantities::Force;
 using quantities::Mass;
 
@@ -89,6 +90,22 @@ class Part final {
       Instant const& time,
       DegreesOfFreedom<Barycentric> const& degrees_of_freedom);
 
+  // Appends to the history and psychohistory of this part the points of the
+  // |trajectory| of its pile-up, shifted by |offset|.  The points are shared by
+  // all the parts of the pile-up.  They are only copied into the trajectories
+  // of this part when these are accessed through the functions above.
+  void AppendRigidTrajectory(
+      not_null<std::shared_ptr<PileUpTrajectory const>> const& trajectory,
+      RelativeDegreesOfFreedom<Barycentric> const& offset);
+
+  // If the history and psychohistory of this part are entirely given by a call
+  // to |AppendRigidTrajectory|, returns the |trajectory| passed to that call.
+  // Otherwise returns null.
+  PileUpTrajectory const* rigid_trajectory() const;
+  // The |offset| passed to |AppendRigidTrajectory|.  Only meaningful if
+  // |rigid_trajectory()| is not null.
+  RelativeDegreesOfFreedom<Barycentric> const& rigid_trajectory_offset() const;
+
   // Clears the history and psychohistory.
   void ClearHistory();
 
@@ -121,6 +138,19 @@ class Part final {
   std::string ShortDebugString() const;
 
  private:
+  // Appends the points of |trajectory| shifted by |offset| to |history| and
+  // |psychohistory|, with the same semantics as |AppendToHistory| and
+  // |AppendToPsychohistory|.  |psychohistory| may be null.
+  static void AppendRigidTrajectory(
+      PileUpTrajectory const& trajectory,
+      RelativeDegreesOfFreedom<Barycentric> const& offset,
+      DiscreteTrajectory<Barycentric>& history,
+      DiscreteTrajectory<Barycentric>*& psychohistory);
+
+  // Copies the points of the |rigid_trajectory_|, if any, into the |history_|
+  // and |psychohistory_|, and resets it.
+  void MaterializeRigidTrajectory();
+
   PartId const part_id_;
   std::string const name_;
   Mass mass_;
@@ -144,6 +174,11 @@ class Part final {
   // as needed by |AppendToPsychohistory| or by |tail|.  That's because
   // |NewForkAtLast| is relatively expensive so we only call it when necessary.
   DiscreteTrajectory<Barycentric>* psychohistory_ = nullptr;
+  // If not null, the points of this trajectory, shifted by
+  // |rigid_trajectory_offset_|, logically follow those of the |history_| and
+  // |psychohistory_|, which are then empty.
+  std::shared_ptr<PileUpTrajectory const> rigid_trajectory_;
+  RelativeDegreesOfFreedom<Barycentric> rigid_trajectory_offset_;
 
   // TODO(egg): we may want to keep track of the moment of inertia, angular
   // momentum, etc.
@@ -4,6 +4,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <vector>
 
 #include "base/map_util.hpp"
 #include "geometry/identity.hpp"
@@ -18,6 +19,7 @@ namespace internal_pile_up {
 
 using base::check_not_null;
 using base::FindOrDie;
+using base::make_not_null_shared;
 using base::make_not_null_unique;
 using geometry::AngularVelocity;
 using geometry::BarycentreCalculator;
@@ -32,6 +34,26 @@ using ::std::placeholders::_1;
 using ::std::placeholders::_2;
 using ::std::placeholders::_3;
 
+namespace {
+
+// The costs below are in units of the cost of advancing a pile-up in free fall
+// by one frame.  Only their ordering matters: a poor estimate degrades the load
+// balancing of |Plugin::CatchUpLaggingVessels|, not the results.
+
+// A pile-up in free fall takes a few steps of the fixed-step integrator, with
+// one evaluation of the acceleration per step.
+constexpr double free_fall_catch_up_cost = 1;
+// A pile-up subject to an intrinsic force is integrated with the adaptive
+// integrator, which takes three evaluations per step and short steps, appends
+// all its points to the history and the parts, and restarts the fixed-step
+// integrator afterwards.  This is about one order of magnitude more expensive.
+constexpr double intrinsic_force_catch_up_cost = 10;
+// A pile-up in the bubble is deformed and nudged, which costs about a tenth of
+// an evaluation of the acceleration per part.
+constexpr double catch_up_cost_per_part_in_bubble = 0.1;
+
+}  // namespace
+
 PileUp::PileUp(
     std::list<not_null<Part*>>&& parts,
     Instant const& t,
@@ -66,9 +88,9 @@ PileUp::PileUp(
           Identity<Barycentric, RigidPileUp>().Forget()},
       AngularVelocity<Barycentric>{},
       barycentre.velocity()};
+  actual_part_degrees_of_freedom_.reserve(parts_.size());
   for (not_null<Part*> const part : parts_) {
-    actual_part_degrees_of_freedom_.emplace(
-        part,
+    actual_part_degrees_of_freedom_.push_back(
         barycentric_to_pile_up(part->degrees_of_freedom()));
   }
   psychohistory_ = history_->NewForkAtLast();
@@ -117,9 +139,12 @@ void PileUp::NudgeParts() const {
       AngularVelocity<Barycentric>(),
       actual_centre_of_mass.velocity()};
   auto const pile_up_to_barycentric = barycentric_to_pile_up.Inverse();
+  auto actual_part_degrees_of_freedom =
+      actual_part_degrees_of_freedom_.cbegin();
   for (not_null<Part*> const part : parts_) {
-    part->set_degrees_of_freedom(pile_up_to_barycentric(
-        FindOrDie(actual_part_degrees_of_freedom_, part)));
+    part->set_degrees_of_freedom(
+        pile_up_to_barycentric(*actual_part_degrees_of_freedom));
+    ++actual_part_degrees_of_freedom;
   }
 }
 
@@ -134,6 +159,16 @@ Status PileUp::DeformAndAdvanceTime(Instant const& t) {
   return status;
 }
 
+double PileUp::EstimatedCatchUpCost() const {
+  double cost = intrinsic_force_ == Vector<Force, Barycentric>{}
+                    ? free_fall_catch_up_cost
+                    : intrinsic_force_catch_up_cost;
+  if (!apparent_part_degrees_of_freedom_.empty()) {
+    cost += catch_up_cost_per_part_in_bubble * parts_.size();
+  }
+  return cost;
+}
+
 void PileUp::WriteToMessage(not_null<serialization::PileUp*> message) const {
   for (not_null<Part*> const part : parts_) {
     message->add_part_id(part->part_id());
@@ -142,11 +177,12 @@ void PileUp::WriteToMessage(not_null<serialization::PileUp*> message) const {
   intrinsic_force_.WriteToMessage(message->mutable_intrinsic_force());
   history_->WriteToMessage(message->mutable_history(),
                            /*forks=*/{psychohistory_});
-  for (auto const& pair : actual_part_degrees_of_freedom_) {
-    auto const part = pair.first;
-    auto const& degrees_of_freedom = pair.second;
-    degrees_of_freedom.WriteToMessage(&(
+  auto actual_part_degrees_of_freedom =
+      actual_part_degrees_of_freedom_.cbegin();
+  for (not_null<Part*> const part : parts_) {
+    actual_part_degrees_of_freedom->WriteToMessage(&(
         (*message->mutable_actual_part_degrees_of_freedom())[part->part_id()]));
+    ++actual_part_degrees_of_freedom;
   }
   for (auto const& pair : apparent_part_degrees_of_freedom_) {
     auto const part = pair.first;
@@ -234,12 +270,13 @@ not_null<std::unique_ptr<PileUp>> PileUp::ReadFromMessage(
   pile_up->mass_ = Mass::ReadFromMessage(message.mass());
   pile_up->intrinsic_force_ =
       Vector<Force, Barycentric>::ReadFromMessage(message.intrinsic_force());
-  for (auto const& pair : message.actual_part_degrees_of_freedom()) {
-    std::uint32_t const part_id = pair.first;
-    serialization::Pair const& degrees_of_freedom = pair.second;
-    pile_up->actual_part_degrees_of_freedom_.emplace(
-        part_id_to_part(part_id),
-        DegreesOfFreedom<RigidPileUp>::ReadFromMessage(degrees_of_freedom));
+  if (!message.actual_part_degrees_of_freedom().empty()) {
+    pile_up->actual_part_degrees_of_freedom_.reserve(pile_up->parts_.size());
+    for (not_null<Part*> const part : pile_up->parts_) {
+      pile_up->actual_part_degrees_of_freedom_.push_back(
+          DegreesOfFreedom<RigidPileUp>::ReadFromMessage(
+              message.actual_part_degrees_of_freedom().at(part->part_id())));
+    }
   }
   for (auto const& pair : message.apparent_part_degrees_of_freedom()) {
     std::uint32_t const part_id = pair.first;
@@ -279,16 +316,12 @@ void PileUp::DeformPileUpIfNeeded() {
   // need a clean way of getting the debug strings of all parts (rather than
   // giant self-evaluating lambdas).
   CHECK_EQ(parts_.size(), apparent_part_degrees_of_freedom_.size());
-  for (not_null<Part*> const part : parts_) {
-    CHECK(Contains(apparent_part_degrees_of_freedom_, part));
-  }
 
   // Compute the apparent centre of mass of the parts.
   BarycentreCalculator<DegreesOfFreedom<ApparentBubble>, Mass> calculator;
-  for (auto const& pair : apparent_part_degrees_of_freedom_) {
-    auto const part = pair.first;
-    auto const& apparent_part_degrees_of_freedom = pair.second;
-    calculator.Add(apparent_part_degrees_of_freedom, part->mass());
+  for (not_null<Part*> const part : parts_) {
+    calculator.Add(FindOrDie(apparent_part_degrees_of_freedom_, part),
+                   part->mass());
   }
   auto const apparent_centre_of_mass = calculator.Get();
 
@@ -307,12 +340,9 @@ void PileUp::DeformPileUpIfNeeded() {
 
   // Now update the positions of the parts in the pile-up frame.
   actual_part_degrees_of_freedom_.clear();
-  for (auto const& pair : apparent_part_degrees_of_freedom_) {
-    auto const part = pair.first;
-    auto const& apparent_part_degrees_of_freedom = pair.second;
-    actual_part_degrees_of_freedom_.emplace(
-        part,
-        apparent_bubble_to_pile_up_motion(apparent_part_degrees_of_freedom));
+  for (not_null<Part*> const part : parts_) {
+    actual_part_degrees_of_freedom_.push_back(apparent_bubble_to_pile_up_motion(
+        FindOrDie(apparent_part_degrees_of_freedom_, part)));
   }
   apparent_part_degrees_of_freedom_.clear();
 }
@@ -384,37 +414,46 @@ Status PileUp::AdvanceTime(Instant const& t) {
 
   // Append the |history_| authoritatively to the parts' tails and the
   // |psychohistory_| non-authoritatively.
+  auto const trajectory = make_not_null_shared<PileUpTrajectory>();
   auto const history_end = history_->End();
   auto const psychohistory_end = psychohistory_->End();
   auto it = history_last;
   for (++it; it != history_end; ++it) {
-    AppendToPart<&Part::AppendToHistory>(it);
+    trajectory->history.emplace_back(it.time(), it.degrees_of_freedom());
   }
   it = psychohistory_->Fork();
   for (++it; it != psychohistory_end; ++it) {
-    AppendToPart<&Part::AppendToPsychohistory>(it);
+    trajectory->psychohistory.emplace_back(it.time(), it.degrees_of_freedom());
   }
+  AppendToParts(trajectory);
   history_->ForgetBefore(psychohistory_->Fork().time());
 
   return status;
 }
 
-template<PileUp::AppendToPartTrajectory append_to_part_trajectory>
-void PileUp::AppendToPart(DiscreteTrajectory<Barycentric>::Iterator it) const {
-  auto const& pile_up_dof = it.degrees_of_freedom();
+void PileUp::AppendToParts(
+    not_null<std::shared_ptr<PileUpTrajectory const>> const& trajectory)
+    const {
+  // Since |RigidPileUp| is non-rotating, the degrees of freedom of a part are
+  // those of the centre of mass shifted by a constant offset, which we compute
+  // using an arbitrary reference point for the centre of mass.
+  DegreesOfFreedom<Barycentric> const reference(Barycentric::origin,
+                                                Velocity<Barycentric>());
   RigidMotion<Barycentric, RigidPileUp> const barycentric_to_pile_up(
       RigidTransformation<Barycentric, RigidPileUp>(
-          pile_up_dof.position(),
+          reference.position(),
           RigidPileUp::origin,
           Identity<Barycentric, RigidPileUp>().Forget()),
       AngularVelocity<Barycentric>{},
-      pile_up_dof.velocity());
+      reference.velocity());
   auto const pile_up_to_barycentric = barycentric_to_pile_up.Inverse();
+  auto actual_part_degrees_of_freedom =
+      actual_part_degrees_of_freedom_.cbegin();
   for (not_null<Part*> const part : parts_) {
-    (static_cast<Part*>(part)->*append_to_part_trajectory)(
-        it.time(),
-        pile_up_to_barycentric(
-            FindOrDie(actual_part_degrees_of_freedom_, part)));
+    part->AppendRigidTrajectory(
+        trajectory,
+        pile_up_to_barycentric(*actual_part_degrees_of_freedom) - reference);
+    ++actual_part_degrees_of_freedom;
   }
 }
 
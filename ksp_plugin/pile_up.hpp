@@ -5,6 +5,9 @@
 #include <future>
 #include <list>
 #include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "absl/synchronization/mutex.h"
 #include "base/not_null.hpp"
@@ -39,6 +42,17 @@ using physics::RelativeDegreesOfFreedom;
 using quantities::Force;
 using quantities::Mass;
 
+// The points computed by one call to |PileUp::DeformAndAdvanceTime| for the
+// centre of mass of a pile-up.  They are shared by the parts of the pile-up,
+// whose trajectories are obtained by a constant offset, so that they are only
+// stored once irrespective of the number of parts.
+struct PileUpTrajectory {
+  // The new authoritative points.
+  std::vector<std::pair<Instant, DegreesOfFreedom<Barycentric>>> history;
+  // The non-authoritative points, which follow those of |history|.
+  std::vector<std::pair<Instant, DegreesOfFreedom<Barycentric>>> psychohistory;
+};
+
 // A |PileUp| handles a connected component of the graph of |Parts| under
 // physical contact.  It advances the history and psychohistory of its component
 // |Parts|, modeling them as a massless body at their centre of mass.
@@ -77,6 +91,12 @@ class PileUp {
   // not concurrently with any other method of this class.
   Status DeformAndAdvanceTime(Instant const& t);
 
+  // A crude estimate of the relative cost of the next call to
+  // |DeformAndAdvanceTime|, used to start the most expensive pile-ups first.
+  // The cost is higher for a pile-up subject to an intrinsic force, and it
+  // increases with the number of parts if the pile-up is in the bubble.
+  double EstimatedCatchUpCost() const;
+
   // We'd like to return |not_null<std::shared_ptr<PileUp> const&|, but the
   // compiler gets confused when defining the corresponding lambda, and thinks
   // that we return a local variable even though we capture by reference.
@@ -94,11 +114,6 @@ class PileUp {
       std::function<void()> deletion_callback);
 
  private:
-  // A pointer to a member function of |Part| used to append a point to either
-  // trajectory (history or psychohistory).
-  using AppendToPartTrajectory =
-      void (Part::*)(Instant const&, DegreesOfFreedom<Barycentric> const&);
-
   // For deserialization.
   PileUp(std::list<not_null<Part*>>&& parts,
          Ephemeris<Barycentric>::AdaptiveStepParameters const&
@@ -133,8 +148,11 @@ class PileUp {
   // |DeformPileUpIfNeeded|.
   void NudgeParts() const;
 
-  template<AppendToPartTrajectory append_to_part_trajectory>
-  void AppendToPart(DiscreteTrajectory<Barycentric>::Iterator it) const;
+  // Hands over the |trajectory| of the pile-up to each of its parts, together
+  // with the offset of the part from the centre of mass.
+  void AppendToParts(
+      not_null<std::shared_ptr<PileUpTrajectory const>> const& trajectory)
+      const;
 
   // Wrapped in a |unique_ptr| to be moveable.
   not_null<std::unique_ptr<absl::Mutex>> lock_;
@@ -184,7 +202,10 @@ class PileUp {
                             serialization::Frame::RIGID_PILE_UP,
                             /*frame_is_inertial=*/false>;
 
-  PartTo<DegreesOfFreedom<RigidPileUp>> actual_part_degrees_of_freedom_;
+  // The degrees of freedom of the parts in |RigidPileUp|, in the order of
+  // |parts_|.  These are used for every point appended to the parts'
+  // trajectories, so we don't want a map lookup here.
+  std::vector<DegreesOfFreedom<RigidPileUp>> actual_part_degrees_of_freedom_;
   PartTo<DegreesOfFreedom<ApparentBubble>> apparent_part_degrees_of_freedom_;
 
   // Called in the destructor.
@@ -204,6 +225,7 @@ struct PileUpFuture {
 
 using internal_pile_up::PileUp;
 using internal_pile_up::PileUpFuture;
+using internal_pile_up::PileUpTrajectory;
 
 }  // namespace ksp_plugin
 }  // namespace principia
@@ -241,6 +241,53 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
   return lines;
 }
 
+RP2Lines<Length, Camera> Planetarium::PlotMethod3(
+    DiscreteTrajectory<Barycentric>::Iterator const& begin,
+    DiscreteTrajectory<Barycentric>::Iterator const& end,
+    TrajectoryLevelsOfDetail const& levels_of_detail,
+    Instant const& now,
+    bool const reverse) const {
+  if (levels_of_detail.empty()) {
+    return PlotMethod2(begin, end, now, reverse);
+  }
+  // The angular error is largest for the part of the trajectory closest to the
+  // camera.
+  auto polyline = levels_of_detail.Polyline(
+      perspective_.camera(), parameters_.tan_angular_resolution_);
+  if (!polyline.has_value()) {
+    return PlotMethod2(begin, end, now, reverse);
+  }
+  // Like |PlotMethod2|, start from the end of the trajectory if |reverse|, so
+  // that styles that fade along the lines fade the oldest points.
+  if (reverse) {
+    std::reverse(polyline->begin(), polyline->end());
+  }
+
+  RP2Lines<Length, Camera> lines;
+  auto const plottable_spheres = ComputePlottableSpheres(now);
+  std::optional<Position<Navigation>> last_endpoint;
+  for (int i = 1; i < polyline->size(); ++i) {
+    auto const segment_behind_focal_plane =
+        perspective_.SegmentBehindFocalPlane(
+            Segment<Navigation>((*polyline)[i - 1], (*polyline)[i]));
+    if (!segment_behind_focal_plane) {
+      continue;
+    }
+    auto const visible_segments = perspective_.VisibleSegments(
+                                      *segment_behind_focal_plane,
+                                      plottable_spheres);
+    for (auto const& segment : visible_segments) {
+      if (last_endpoint != segment.first) {
+        lines.emplace_back();
+        lines.back().push_back(perspective_(segment.first));
+      }
+      lines.back().push_back(perspective_(segment.second));
+      last_endpoint = segment.second;
+    }
+  }
+  return lines;
+}
+
 std::vector<Sphere<Navigation>> Planetarium::ComputePlottableSpheres(
     Instant const& now) const {
   RigidMotion<Barycentric, Navigation> const rigid_motion_at_now =
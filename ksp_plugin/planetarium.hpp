@@ -10,6 +10,7 @@
 #include "geometry/rp2_point.hpp"
 #include "geometry/sphere.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/trajectory_levels_of_detail.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
@@ -88,6 +89,18 @@ class Planetarium {
       Instant const& now,
       bool reverse) const;
 
+  // A method that plots the coarsest of the |levels_of_detail| whose error is
+  // below the angular resolution for the part of the trajectory closest to the
+  // camera.  The |levels_of_detail| must be those of the trajectory defined by
+  // |begin| and |end| in the plotting frame.  If none of the levels is accurate
+  // enough, falls back to |PlotMethod2|.
+  RP2Lines<Length, Camera> PlotMethod3(
+      DiscreteTrajectory<Barycentric>::Iterator const& begin,
+      DiscreteTrajectory<Barycentric>::Iterator const& end,
+      TrajectoryLevelsOfDetail const& levels_of_detail,
+      Instant const& now,
+      bool reverse) const;
+
  private:
   // Computes the coordinates of the spheres that represent the |ephemeris_|
   // bodies.  These coordinates are in the |plotting_frame_| at time |now|.
@@ -35,6 +35,7 @@
 #include "geometry/permutation.hpp"
 #include "glog/logging.h"
 #include "glog/stl_logging.h"
+#include "google/protobuf/arena.h"
 #include "ksp_plugin/equator_relevance_threshold.hpp"
 #include "ksp_plugin/integrators.hpp"
 #include "ksp_plugin/part_subsets.hpp"
@@ -102,6 +103,7 @@ using quantities::si::Kilogram;
 using quantities::si::Milli;
 using quantities::si::Minute;
 using quantities::si::Radian;
+using ::google::protobuf::Arena;
 using ::operator<<;
 
 Plugin::Plugin(std::string const& game_epoch,
@@ -268,11 +270,14 @@ void Plugin::EndInitialization() {
               ephemeris_.get(),
               sun_->body()));
 
-  // Log the serialized ephemeris.
-  serialization::Ephemeris ephemeris_message;
-  ephemeris_->WriteToMessage(&ephemeris_message);
+  // Log the serialized ephemeris.  The message holds all the Чебышёв series
+  // of the celestials, so build it on an arena which is freed in bulk.
+  Arena arena;
+  not_null<serialization::Ephemeris*> const ephemeris_message =
+      Arena::CreateMessage<serialization::Ephemeris>(&arena);
+  ephemeris_->WriteToMessage(ephemeris_message);
   HexadecimalEncoder</*null_terminated=*/true> encoder;
-  auto const hex = encoder.Encode(SerializeAsBytes(ephemeris_message).get());
+  auto const hex = encoder.Encode(SerializeAsBytes(*ephemeris_message).get());
   // Begin and end markers to make sure the hex did not get clipped (this might
   // happen if the message is very big).
   LOG(INFO) << "Ephemeris at initialization:\nbegin\n"
@@ -482,18 +487,28 @@ void Plugin::IncrementPartIntrinsicForce(PartId const part_id,
 }
 
 void Plugin::PrepareToReportCollisions() {
+  unperturbed_vessels_.clear();
   for (auto const& pair : vessels_) {
-    Vessel& vessel = *pair.second;
+    not_null<Vessel*> const vessel = pair.second.get();
+    // The subsets of the parts of an unloaded vessel that is alone in its
+    // pile-up only contain parts of that vessel, so we can leave them alone
+    // unless a collision is reported.  This is the common case for the vessels
+    // outside of the physics bubble.
+    if (!is_loaded(vessel) && IsAloneInPileUp(*vessel)) {
+      unperturbed_vessels_.insert(vessel);
+      continue;
+    }
     // TODO(egg): we're taking the address of a parameter passed by reference
     // here; but then I don't think I want to pass this by pointer, it's quite
     // convenient everywhere else...
-    vessel.ForAllParts(
+    vessel->ForAllParts(
         [](Part& part) { Subset<Part>::MakeSingleton(part, &part); });
   }
 }
 
 void Plugin::ReportGroundCollision(PartId const part) const {
   Vessel const& v = *FindOrDie(part_id_to_vessel_, part);
+  PerturbVessel(v);
   Part& p = *v.part(part);
   LOG(INFO) << "Collision between " << p.ShortDebugString()
             << " and the ground.";
@@ -503,6 +518,8 @@ void Plugin::ReportGroundCollision(PartId const part) const {
 void Plugin::ReportPartCollision(PartId const part1, PartId const part2) const {
   Vessel const& v1 = *FindOrDie(part_id_to_vessel_, part1);
   Vessel const& v2 = *FindOrDie(part_id_to_vessel_, part2);
+  PerturbVessel(v1);
+  PerturbVessel(v2);
   Part& p1 = *v1.part(part1);
   Part& p2 = *v2.part(part2);
   LOG(INFO) << "Collision between " << p1.ShortDebugString() << " and "
@@ -532,8 +549,10 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
       ++it;
     } else {
       loaded_vessels_.erase(vessel);
+      unperturbed_vessels_.erase(vessel);
       LOG(INFO) << "Removing vessel " << vessel->ShortDebugString();
       renderer_->ClearTargetVesselIf(vessel);
+      renderer_->ForgetLevelsOfDetail(vessel);
       it = vessels_.erase(it);
     }
   }
@@ -546,9 +565,12 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
   }
 
   // Bind the vessels.  This guarantees that all part subsets are disjoint
-  // unions of vessels.
+  // unions of vessels.  The unperturbed vessels are already bound.
   for (auto const& pair : vessels_) {
     Vessel& vessel = *pair.second;
+    if (Contains(unperturbed_vessels_, &vessel)) {
+      continue;
+    }
     vessel.ForSomePart([&vessel](Part& first_part) {
       vessel.ForAllParts([&first_part](Part& part) {
         Subset<Part>::Unite(Subset<Part>::Find(first_part),
@@ -567,6 +589,9 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
     VesselSet grounded_vessels;
     for (auto const& pair : vessels_) {
       not_null<Vessel*> const vessel = pair.second.get();
+      if (Contains(unperturbed_vessels_, vessel)) {
+        continue;
+      }
       vessel->ForSomePart([vessel, &grounded_vessels](Part& part) {
         if (Subset<Part>::Find(part).properties().grounded()) {
           grounded_vessels.insert(vessel);
@@ -577,14 +602,29 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
       loaded_vessels_.erase(vessel);
       LOG(INFO) << "Removing grounded vessel " << vessel->ShortDebugString();
       renderer_->ClearTargetVesselIf(vessel);
+      renderer_->ForgetLevelsOfDetail(vessel);
       CHECK_EQ(vessels_.erase(vessel->guid()), 1);
     }
   }
 
   // We only need to collect one part per vessel, since the other parts are in
-  // the same subset.
+  // the same subset.  The pile-ups of the unperturbed vessels are kept, but
+  // their mass and intrinsic force must be updated.
   for (auto const& pair : vessels_) {
     not_null<Vessel*> const vessel = pair.second.get();
+    if (Contains(unperturbed_vessels_, vessel)) {
+      PileUp* pile_up = nullptr;
+      Mass mass;
+      Vector<Force, Barycentric> intrinsic_force;
+      vessel->ForAllParts([&pile_up, &mass, &intrinsic_force](Part& part) {
+        pile_up = part.containing_pile_up();
+        mass += part.mass();
+        intrinsic_force += part.intrinsic_force();
+      });
+      pile_up->set_mass(mass);
+      pile_up->set_intrinsic_force(intrinsic_force);
+      continue;
+    }
     Instant const vessel_time =
         is_loaded(vessel) ? current_time_ - Δt : current_time_;
     vessel->ForSomePart([&vessel_time, this](Part& first_part) {
@@ -596,6 +636,7 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
           ephemeris_.get());
     });
   }
+  unperturbed_vessels_.clear();
 }
 
 void Plugin::SetPartApparentDegreesOfFreedom(
@@ -703,39 +744,59 @@ void Plugin::AdvanceTime(Instant const& t, Angle const& planetarium_rotation) {
   ephemeris_->Prolong(current_time_);
   UpdatePlanetariumRotation();
   loaded_vessels_.clear();
+  renderer_->ClearPlottingFrameCache();
 }
 
 void Plugin::CatchUpLaggingVessels(VesselSet& collided_vessels) {
   CHECK(!initializing_);
 
-  // Start all the integrations in parallel.
-  std::vector<PileUpFuture> pile_up_futures;
+  // Start the most expensive integrations first, so that the thread pool is
+  // not left waiting for a long integration that was queued last.
+  std::vector<std::pair<double, PileUp*>> costs_and_pile_ups;
   for (auto* const pile_up : pile_ups_) {
+    costs_and_pile_ups.emplace_back(pile_up->EstimatedCatchUpCost(), pile_up);
+  }
+  std::stable_sort(costs_and_pile_ups.begin(),
+                   costs_and_pile_ups.end(),
+                   [](std::pair<double, PileUp*> const& left,
+                      std::pair<double, PileUp*> const& right) {
+                     return left.first > right.first;
+                   });
+
+  // Start all the integrations in parallel.  Each task updates the vessels of
+  // its pile-up as soon as the integration is done.  A vessel belongs to
+  // exactly one pile-up, so there is no contention on the vessels.
+  std::vector<PileUpFuture> pile_up_futures;
+  for (auto const& pair : costs_and_pile_ups) {
+    PileUp* const pile_up = pair.second;
+    VesselSet vessels;
+    for (not_null<Part*> const part : pile_up->parts()) {
+      vessels.insert(FindOrDie(part_id_to_vessel_, part->part_id()));
+    }
     pile_up_futures.emplace_back(
         pile_up,
-        vessel_thread_pool_.Add([this, pile_up]() {
+        vessel_thread_pool_.Add([this, pile_up, vessels]() {
           // Note that there cannot be contention in the following method as
           // no two pile-ups are advanced at the same time.
-          return pile_up->DeformAndAdvanceTime(current_time_);
+          Status const status = pile_up->DeformAndAdvanceTime(current_time_);
+          for (not_null<Vessel*> const vessel : vessels) {
+            if (vessel->psychohistory().last().time() < current_time_) {
+              if (!status.ok()) {
+                vessel->DisableDownsampling();
+              }
+              vessel->AdvanceTime();
+            }
+          }
+          return status;
         }));
   }
 
-  // Wait for the integrations to finish and figure out which vessels collided
-  // with a celestial.
+  // Wait for the tasks to finish and figure out which vessels collided with a
+  // celestial.  The order doesn't matter since all the work is done by the
+  // tasks.
   for (auto& pile_up_future : pile_up_futures) {
     WaitForVesselToCatchUp(pile_up_future, collided_vessels);
   }
-
-  // Update the vessels.
-  for (auto const& pair : vessels_) {
-    Vessel& vessel = *pair.second;
-    if (vessel.psychohistory().last().time() < current_time_) {
-      if (Contains(collided_vessels, &vessel)) {
-        vessel.DisableDownsampling();
-      }
-      vessel.AdvanceTime();
-    }
-  }
 }
 
 not_null<std::unique_ptr<PileUpFuture>> Plugin::CatchUpVessel(
@@ -852,6 +913,8 @@ void Plugin::UpdatePrediction(GUID const& vessel_guid) const {
   if (renderer_->HasTargetVessel()) {
     Vessel& target_vessel = renderer_->GetTargetVessel();
     target_vessel.RefreshPrediction();
+    // The plotting frame depends on the prediction of the target vessel.
+    renderer_->ClearPlottingFrameCache();
     vessel.RefreshPrediction(target_vessel.prediction().last().time());
   } else {
     vessel.RefreshPrediction();
@@ -871,30 +934,21 @@ void Plugin::CreateFlightPlan(GUID const& vessel_guid,
       DefaultBurnParameters());
 }
 
-void Plugin::ComputeAndRenderApsides(
-    Index const celestial_index,
-    DiscreteTrajectory<Barycentric>::Iterator const& begin,
-    DiscreteTrajectory<Barycentric>::Iterator const& end,
+void Plugin::RenderApsides(
+    ApsidesDetector<Barycentric> const& apsides,
     Position<World> const& sun_world_position,
     std::unique_ptr<DiscreteTrajectory<World>>& apoapsides,
     std::unique_ptr<DiscreteTrajectory<World>>& periapsides) const {
-  DiscreteTrajectory<Barycentric> apoapsides_trajectory;
-  DiscreteTrajectory<Barycentric> periapsides_trajectory;
-  ComputeApsides(FindOrDie(celestials_, celestial_index)->trajectory(),
-                 begin,
-                 end,
-                 apoapsides_trajectory,
-                 periapsides_trajectory);
   apoapsides = renderer_->RenderBarycentricTrajectoryInWorld(
                    current_time_,
-                   apoapsides_trajectory.Begin(),
-                   apoapsides_trajectory.End(),
+                   apsides.apoapsides().Begin(),
+                   apsides.apoapsides().End(),
                    sun_world_position,
                    PlanetariumRotation());
   periapsides = renderer_->RenderBarycentricTrajectoryInWorld(
                     current_time_,
-                    periapsides_trajectory.Begin(),
-                    periapsides_trajectory.End(),
+                    apsides.periapsides().Begin(),
+                    apsides.periapsides().End(),
                     sun_world_position,
                     PlanetariumRotation());
 }
@@ -1534,6 +1588,31 @@ bool Plugin::is_loaded(not_null<Vessel*> vessel) const {
   return Contains(loaded_vessels_, vessel);
 }
 
+bool Plugin::IsAloneInPileUp(Vessel const& vessel) {
+  PileUp* pile_up = nullptr;
+  std::size_t number_of_parts = 0;
+  bool alone = true;
+  vessel.ForAllParts([&alone, &number_of_parts, &pile_up](Part& part) {
+    ++number_of_parts;
+    if (!part.is_piled_up()) {
+      alone = false;
+    } else if (pile_up == nullptr) {
+      pile_up = part.containing_pile_up();
+    } else if (pile_up != part.containing_pile_up()) {
+      alone = false;
+    }
+  });
+  return alone && pile_up != nullptr &&
+         pile_up->parts().size() == number_of_parts;
+}
+
+void Plugin::PerturbVessel(Vessel const& vessel) const {
+  if (unperturbed_vessels_.erase(&vessel)) {
+    vessel.ForAllParts(
+        [](Part& part) { Subset<Part>::MakeSingleton(part, &part); });
+  }
+}
+
 }  // namespace internal_plugin
 }  // namespace ksp_plugin
 }  // namespace principia
@@ -26,6 +26,7 @@
 #include "ksp_plugin/renderer.hpp"
 #include "ksp_plugin/vessel.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
+#include "physics/apsides.hpp"
 #include "physics/body.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
@@ -63,6 +64,7 @@ using geometry::Vector;
 using geometry::Velocity;
 using integrators::FixedStepSizeIntegrator;
 using integrators::AdaptiveStepSizeIntegrator;
+using physics::ApsidesDetector;
 using physics::Body;
 using physics::DegreesOfFreedom;
 using physics::DiscreteTrajectory;
@@ -216,7 +218,9 @@ class Plugin {
   // Calls |MakeSingleton| for all parts in loaded vessels, enabling the use of
   // union-find for pile up construction.  This must be called after the calls
   // to |IncrementPartIntrinsicForce|, and before the calls to
-  // |ReportGroundCollision| or |ReportPartCollision|.
+  // |ReportGroundCollision| or |ReportPartCollision|.  The parts of unloaded
+  // vessels which are alone in their pile-up are left untouched, and their
+  // pile-up is kept as is unless a collision is reported for them.
   virtual void PrepareToReportCollisions();
 
   // Notifies |this| that the given part is touching the ground.
@@ -326,12 +330,11 @@ class Plugin {
                                 Instant const& final_time,
                                 Mass const& initial_mass) const;
 
-  // Computes the apsides of the trajectory defined by |begin| and |end| with
-  // respect to the celestial with index |celestial_index|.
-  virtual void ComputeAndRenderApsides(
-      Index celestial_index,
-      DiscreteTrajectory<Barycentric>::Iterator const& begin,
-      DiscreteTrajectory<Barycentric>::Iterator const& end,
+  // Renders the apsides detected by |apsides|.  The apsides are typically
+  // those cached with a prediction or a flight plan, see
+  // |Vessel::PredictionApsides| and |FlightPlan::GetApsides|.
+  virtual void RenderApsides(
+      ApsidesDetector<Barycentric> const& apsides,
       Position<World> const& sun_world_position,
       std::unique_ptr<DiscreteTrajectory<World>>& apoapsides,
       std::unique_ptr<DiscreteTrajectory<World>>& periapsides) const;
@@ -466,6 +469,13 @@ class Plugin {
   // Whether |loaded_vessels_| contains |vessel|.
   bool is_loaded(not_null<Vessel*> vessel) const;
 
+  // Whether the parts of |vessel| form exactly one existing pile-up.
+  static bool IsAloneInPileUp(Vessel const& vessel);
+
+  // If |vessel| is in |unperturbed_vessels_|, removes it from there and calls
+  // |MakeSingleton| for its parts, so that they take part in the union-find.
+  void PerturbVessel(Vessel const& vessel) const;
+
   // Initialization objects.
   base::Monostable initializing_;
   serialization::GravityModel gravity_model_;
@@ -522,6 +532,11 @@ class Plugin {
   VesselSet loaded_vessels_;
   // The vessels that will be kept during the next call to |AdvanceTime|.
   VesselConstSet kept_vessels_;
+  // The unloaded vessels that are alone in their pile-up and for which no
+  // collision has been reported since |PrepareToReportCollisions|.  Their part
+  // subsets are not rebuilt and their pile-ups are kept.  Mutable because the
+  // collision reports are const.
+  mutable VesselConstSet unperturbed_vessels_;
 
   friend class NavballFrameField;
   friend class TestablePlugin;
@@ -3,12 +3,14 @@
 
 #include <algorithm>
 #include <optional>
+#include <vector>
 
 #include "geometry/grassmann.hpp"
 #include "geometry/named_quantities.hpp"
 #include "physics/apsides.hpp"
 #include "physics/body_centred_body_direction_dynamic_frame.hpp"
 #include "physics/degrees_of_freedom.hpp"
+#include "quantities/si.hpp"
 
 namespace principia {
 namespace ksp_plugin {
@@ -21,6 +23,24 @@ using geometry::Vector;
 using geometry::Velocity;
 using physics::BodyCentredBodyDirectionDynamicFrame;
 using physics::DegreesOfFreedom;
+using quantities::si::Metre;
+
+namespace {
+
+// The finest level of detail is accurate enough for trajectories about
+// 1000 km away from the camera, the coarsest for trajectories across the solar
+// system.
+Length const levels_of_detail_finest_tolerance = 100 * Metre;
+constexpr double levels_of_detail_tolerance_ratio = 4;
+constexpr int levels_of_detail_number_of_levels = 16;
+
+TrajectoryLevelsOfDetail NewLevelsOfDetail() {
+  return TrajectoryLevelsOfDetail(levels_of_detail_finest_tolerance,
+                                  levels_of_detail_tolerance_ratio,
+                                  levels_of_detail_number_of_levels);
+}
+
+}  // namespace
 
 Renderer::Renderer(not_null<Celestial const*> const sun,
                    not_null<std::unique_ptr<NavigationFrame>> plotting_frame)
@@ -30,6 +50,8 @@ Renderer::Renderer(not_null<Celestial const*> const sun,
 void Renderer::SetPlottingFrame(
     not_null<std::unique_ptr<NavigationFrame>> plotting_frame) {
   plotting_frame_ = std::move(plotting_frame);
+  ClearPlottingFrameCache();
+  levels_of_detail_in_plotting_.clear();
 }
 
 not_null<NavigationFrame const*> Renderer::GetPlottingFrame() const {
@@ -45,19 +67,29 @@ void Renderer::SetTargetVessel(
       target_->vessel != vessel ||
       target_->celestial != celestial) {
     target_.emplace(vessel, celestial, ephemeris);
+    ClearPlottingFrameCache();
+    levels_of_detail_in_plotting_.clear();
   }
 }
 
 void Renderer::ClearTargetVessel() {
   target_ = std::nullopt;
+  ClearPlottingFrameCache();
+  levels_of_detail_in_plotting_.clear();
 }
 
 void Renderer::ClearTargetVesselIf(not_null<Vessel*> const vessel) {
   if (target_ && target_->vessel == vessel) {
     target_ = std::nullopt;
+    ClearPlottingFrameCache();
+    levels_of_detail_in_plotting_.clear();
   }
 }
 
+void Renderer::ClearPlottingFrameCache() {
+  barycentric_to_plotting_.clear();
+}
+
 bool Renderer::HasTargetVessel() const {
   return static_cast<bool>(target_);
 }
@@ -94,7 +126,8 @@ not_null<std::unique_ptr<DiscreteTrajectory<Navigation>>>
 Renderer::RenderBarycentricTrajectoryInPlotting(
     DiscreteTrajectory<Barycentric>::Iterator const& begin,
     DiscreteTrajectory<Barycentric>::Iterator const& end) const {
-  auto trajectory = make_not_null_unique<DiscreteTrajectory<Navigation>>();
+  std::vector<Instant> times;
+  std::vector<DegreesOfFreedom<Barycentric>> degrees_of_freedom;
   for (auto it = begin; it != end; ++it) {
     Instant const& t = it.time();
     if (target_) {
@@ -105,11 +138,102 @@ Renderer::RenderBarycentricTrajectoryInPlotting(
         break;
       }
     }
-    trajectory->Append(t, BarycentricToPlotting(t)(it.degrees_of_freedom()));
+    times.push_back(t);
+    degrees_of_freedom.push_back(it.degrees_of_freedom());
+  }
+  if (times.empty()) {
+    return make_not_null_unique<DiscreteTrajectory<Navigation>>();
+  }
+
+  // The trajectories rendered during a frame tend to share their times, so
+  // only the motions of the plotting frame that are not in the cache are
+  // computed, in a single pass, and then cached.  The times are increasing, so
+  // they are merged with the cached ones in a single pass.
+  std::vector<Instant> missing_times;
+  auto hint = barycentric_to_plotting_.lower_bound(times.front());
+  for (Instant const& t : times) {
+    while (hint != barycentric_to_plotting_.end() && hint->first < t) {
+      ++hint;
+    }
+    if (hint == barycentric_to_plotting_.end() || hint->first != t) {
+      missing_times.push_back(t);
+    }
+  }
+  std::vector<RigidMotion<Barycentric, Navigation>> const missing_motions =
+      GetPlottingFrame()->MotionsToThisFrameAtTimes(missing_times);
+  hint = barycentric_to_plotting_.end();
+  for (std::size_t i = missing_times.size(); i > 0; --i) {
+    hint = barycentric_to_plotting_.emplace_hint(
+        hint, missing_times[i - 1], missing_motions[i - 1]);
+  }
+
+  auto trajectory = make_not_null_unique<DiscreteTrajectory<Navigation>>();
+  auto motion = barycentric_to_plotting_.lower_bound(times.front());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    while (motion->first < times[i]) {
+      ++motion;
+    }
+    trajectory->Append(times[i], motion->second(degrees_of_freedom[i]));
   }
   return trajectory;
 }
 
+TrajectoryLevelsOfDetail const& Renderer::LevelsOfDetailInPlotting(
+    not_null<Vessel const*> const vessel) const {
+  CHECK(!target_);
+  auto const plotting_frame = GetPlottingFrame();
+  auto const& trajectory = vessel->psychohistory();
+  auto const first = trajectory.LowerBound(plotting_frame->t_min());
+  auto it = levels_of_detail_in_plotting_.find(vessel);
+  if (it == levels_of_detail_in_plotting_.end()) {
+    it = levels_of_detail_in_plotting_.emplace(vessel,
+                                               NewLevelsOfDetail()).first;
+  }
+  TrajectoryLevelsOfDetail& levels_of_detail = it->second;
+
+  // Check that the time range previously processed is still covered by the
+  // trajectory.  Points in that range may have been removed by downsampling or
+  // replaced when a psychohistory became authoritative, but they are close to
+  // the ones that remain, so the levels of detail are still a good
+  // approximation.  The beginning of the trajectory is forgotten as time goes
+  // by, and we just drop the corresponding vertices.
+  DiscreteTrajectory<Barycentric>::Iterator begin = first;
+  if (!levels_of_detail.empty()) {
+    if (first == trajectory.End() ||
+        first.time() < levels_of_detail.first_time() ||
+        trajectory.last().time() < levels_of_detail.last_time()) {
+      levels_of_detail = NewLevelsOfDetail();
+    } else {
+      levels_of_detail.ForgetBefore(first.time());
+      begin = trajectory.LowerBound(levels_of_detail.last_time());
+      if (begin.time() == levels_of_detail.last_time()) {
+        ++begin;
+      }
+    }
+  }
+
+  std::vector<Instant> times;
+  std::vector<DegreesOfFreedom<Barycentric>> degrees_of_freedom;
+  for (auto jt = begin;
+       jt != trajectory.End() && jt.time() <= plotting_frame->t_max();
+       ++jt) {
+    times.push_back(jt.time());
+    degrees_of_freedom.push_back(jt.degrees_of_freedom());
+  }
+  std::vector<DegreesOfFreedom<Navigation>> const
+      degrees_of_freedom_in_plotting =
+          plotting_frame->ToThisFrameAtTimes(times, degrees_of_freedom);
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    levels_of_detail.Append(times[i],
+                            degrees_of_freedom_in_plotting[i].position());
+  }
+  return levels_of_detail;
+}
+
+void Renderer::ForgetLevelsOfDetail(not_null<Vessel const*> const vessel) {
+  levels_of_detail_in_plotting_.erase(vessel);
+}
+
 not_null<std::unique_ptr<DiscreteTrajectory<World>>>
 Renderer::RenderPlottingTrajectoryInWorld(
     Instant const& time,
@@ -156,7 +280,12 @@ Renderer::RenderPlottingTrajectoryInWorld(
 
 RigidMotion<Barycentric, Navigation> Renderer::BarycentricToPlotting(
     Instant const& time) const {
-  return GetPlottingFrame()->ToThisFrameAtTime(time);
+  auto it = barycentric_to_plotting_.find(time);
+  if (it == barycentric_to_plotting_.end()) {
+    it = barycentric_to_plotting_.emplace(
+        time, GetPlottingFrame()->ToThisFrameAtTime(time)).first;
+  }
+  return it->second;
 }
 
 RigidTransformation<Barycentric, World> Renderer::BarycentricToWorld(
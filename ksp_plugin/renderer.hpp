@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 
@@ -11,6 +12,7 @@
 #include "geometry/rotation.hpp"
 #include "ksp_plugin/celestial.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/trajectory_levels_of_detail.hpp"
 #include "ksp_plugin/vessel.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/dynamic_frame.hpp"
@@ -62,6 +64,11 @@ class Renderer {
   virtual void ClearTargetVessel();
   virtual void ClearTargetVesselIf(not_null<Vessel*> vessel);
 
+  // Forgets the motions of the plotting frame computed so far.  Must be called
+  // when the ephemeris or the prediction of the target vessel change.  The
+  // cache is also cleared when the plotting frame or the target vessel change.
+  virtual void ClearPlottingFrameCache();
+
   // Determines if there is a target vessel and returns it.
   virtual bool HasTargetVessel() const;
   virtual Vessel& GetTargetVessel();
@@ -88,6 +95,19 @@ class Renderer {
       DiscreteTrajectory<Barycentric>::Iterator const& begin,
       DiscreteTrajectory<Barycentric>::Iterator const& end) const;
 
+  // Returns the levels of detail of the psychohistory of |vessel| in the
+  // current plotting frame, over the time range of that frame.  The levels are
+  // kept from one call to the next, and extended with the points after the
+  // last one processed.  They are rebuilt if the beginning or the end of the
+  // psychohistory has been forgotten, and cleared when the plotting frame
+  // changes.  There must be no target vessel.
+  virtual TrajectoryLevelsOfDetail const& LevelsOfDetailInPlotting(
+      not_null<Vessel const*> vessel) const;
+
+  // Forgets the levels of detail of |vessel|.  Must be called before |vessel|
+  // is destroyed.
+  virtual void ForgetLevelsOfDetail(not_null<Vessel const*> vessel);
+
   // Returns a trajectory in |World| corresponding to the trajectory defined by
   // |begin| and |end| in the current plotting frame.
   virtual not_null<std::unique_ptr<DiscreteTrajectory<World>>>
@@ -100,6 +120,7 @@ class Renderer {
 
   // Coordinate transforms.
 
+  // The result is cached, see |ClearPlottingFrameCache|.
   virtual RigidMotion<Barycentric, Navigation> BarycentricToPlotting(
       Instant const& time) const;
 
@@ -181,6 +202,19 @@ class Renderer {
   not_null<std::unique_ptr<NavigationFrame>> plotting_frame_;
 
   std::optional<Target> target_;
+
+  // A cache of |BarycentricToPlotting| for the current plotting frame.  The
+  // trajectories rendered during a frame tend to share their times, and the
+  // computation of the motion requires several evaluations of trajectories.
+  // |RenderBarycentricTrajectoryInPlotting| fills it in a batch.
+  // Not thread-safe, but the renderer is only used by the main thread.
+  mutable std::map<Instant, RigidMotion<Barycentric, Navigation>>
+      barycentric_to_plotting_;
+
+  // The levels of detail of the psychohistories plotted in the current
+  // plotting frame.
+  mutable std::map<not_null<Vessel const*>, TrajectoryLevelsOfDetail>
+      levels_of_detail_in_plotting_;
 };
 
 }  // namespace internal_renderer
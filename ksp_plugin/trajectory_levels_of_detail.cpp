@@ -0,0 +1,190 @@
+#include "ksp_plugin/trajectory_levels_of_detail.hpp"
+
+#include <algorithm>
+
+#include "glog/logging.h"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace internal_trajectory_levels_of_detail {
+
+using geometry::Displacement;
+using geometry::InnerProduct;
+using quantities::Pow;
+using quantities::Sqrt;
+using quantities::Square;
+
+namespace {
+
+// The maximum number of vertices pending in a level.  When it is reached, a
+// vertex is kept even if the tolerance is not exceeded, which bounds the cost
+// of |Append|.
+constexpr int max_pending_vertices = 32;
+
+// Returns the square of the distance between |point| and the segment
+// [|first|, |second|].
+Square<Length> SquaredDistanceToSegment(
+    Position<Navigation> const& point,
+    Position<Navigation> const& first,
+    Position<Navigation> const& second) {
+  Displacement<Navigation> const segment = second - first;
+  Displacement<Navigation> const from_first = point - first;
+  Square<Length> const segment² = segment.Norm²();
+  if (segment² == Square<Length>()) {
+    return from_first.Norm²();
+  }
+  double const λ =
+      std::clamp(InnerProduct(from_first, segment) / segment², 0.0, 1.0);
+  return (from_first - λ * segment).Norm²();
+}
+
+}  // namespace
+
+TrajectoryLevelsOfDetail::Level::Level(Length const& tolerance,
+                                       Length const& error)
+    : tolerance(tolerance),
+      error(error) {}
+
+TrajectoryLevelsOfDetail::TrajectoryLevelsOfDetail(
+    Length const& finest_tolerance,
+    double const tolerance_ratio,
+    int const number_of_levels) {
+  CHECK_LT(0, number_of_levels);
+  Length tolerance = finest_tolerance;
+  Length error;
+  for (int i = 0; i < number_of_levels; ++i) {
+    // The vertices of the previous level are within its error of the
+    // trajectory.
+    error += tolerance;
+    levels_.emplace_back(tolerance, error);
+    tolerance *= tolerance_ratio;
+  }
+}
+
+void TrajectoryLevelsOfDetail::Append(Instant const& time,
+                                      Position<Navigation> const& position) {
+  if (!empty()) {
+    CHECK_LT(last_time(), time);
+  }
+  AppendToLevel(0, {time, position});
+}
+
+void TrajectoryLevelsOfDetail::ForgetBefore(Instant const& time) {
+  for (Level& level : levels_) {
+    while (level.vertices.size() > 1 && level.vertices[1].time <= time) {
+      level.vertices.pop_front();
+    }
+  }
+}
+
+bool TrajectoryLevelsOfDetail::empty() const {
+  return levels_.front().vertices.empty();
+}
+
+Instant const& TrajectoryLevelsOfDetail::first_time() const {
+  CHECK(!empty());
+  return levels_.front().vertices.front().time;
+}
+
+Instant const& TrajectoryLevelsOfDetail::last_time() const {
+  CHECK(!empty());
+  Level const& first_level = levels_.front();
+  return first_level.pending.empty() ? first_level.vertices.back().time
+                                     : first_level.pending.back().time;
+}
+
+std::optional<std::vector<Position<Navigation>>>
+TrajectoryLevelsOfDetail::Polyline(Length const& tolerance) const {
+  CHECK(!empty());
+  // The errors are increasing with the levels.
+  for (int i = levels_.size() - 1; i >= 0; --i) {
+    if (levels_[i].error <= tolerance) {
+      return LevelPolyline(i);
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<std::vector<Position<Navigation>>>
+TrajectoryLevelsOfDetail::Polyline(Position<Navigation> const& camera,
+                                   double const tan_angular_resolution) const {
+  CHECK(!empty());
+  for (int i = levels_.size() - 1; i >= 0; --i) {
+    Length const error = levels_[i].error;
+    std::vector<Position<Navigation>> polyline = LevelPolyline(i);
+    Square<Length> distance² = (polyline.front() - camera).Norm²();
+    for (int j = 1; j < polyline.size(); ++j) {
+      distance² = std::min(
+          distance²,
+          SquaredDistanceToSegment(camera, polyline[j - 1], polyline[j]));
+    }
+    // The points of the trajectory are within |error| of the polyline, so they
+    // are at least at |Sqrt(distance²) - error| from the camera.
+    if (error <= tan_angular_resolution * (Sqrt(distance²) - error)) {
+      return polyline;
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<Position<Navigation>> TrajectoryLevelsOfDetail::LevelPolyline(
+    int const index) const {
+  Level const& level = levels_[index];
+  std::vector<Position<Navigation>> polyline;
+  polyline.reserve(level.vertices.size() + index + 1);
+  for (Vertex const& vertex : level.vertices) {
+    polyline.push_back(vertex.position);
+  }
+  // The end of the trajectory after the last vertex of this level is covered
+  // by the provisional ends of this level and of the finer ones.
+  Instant last_time = level.vertices.back().time;
+  for (int i = index; i >= 0; --i) {
+    std::vector<Vertex> const& pending = levels_[i].pending;
+    if (!pending.empty() && pending.back().time > last_time) {
+      last_time = pending.back().time;
+      polyline.push_back(pending.back().position);
+    }
+  }
+  return polyline;
+}
+
+void TrajectoryLevelsOfDetail::AppendToLevel(int const index,
+                                             Vertex const& vertex) {
+  if (index == levels_.size()) {
+    return;
+  }
+  Level& level = levels_[index];
+  if (level.vertices.empty()) {
+    level.vertices.push_back(vertex);
+    AppendToLevel(index + 1, vertex);
+    return;
+  }
+
+  // Check if the pending vertices are still within tolerance if |vertex|
+  // becomes the end of the polyline.  If not, the current end is kept.
+  bool keep = level.pending.size() >= max_pending_vertices;
+  if (!keep) {
+    Square<Length> const tolerance² = Pow<2>(level.tolerance);
+    Position<Navigation> const& last_vertex = level.vertices.back().position;
+    for (Vertex const& pending : level.pending) {
+      if (SquaredDistanceToSegment(
+              pending.position, last_vertex, vertex.position) > tolerance²) {
+        keep = true;
+        break;
+      }
+    }
+  }
+  if (keep) {
+    Vertex const kept = level.pending.back();
+    level.vertices.push_back(kept);
+    level.pending.clear();
+    AppendToLevel(index + 1, kept);
+  }
+  level.pending.push_back(vertex);
+}
+
+}  // namespace internal_trajectory_levels_of_detail
+}  // namespace ksp_plugin
+}  // namespace principia
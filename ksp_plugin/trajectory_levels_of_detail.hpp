@@ -0,0 +1,107 @@
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "geometry/grassmann.hpp"
+#include "geometry/named_quantities.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace internal_trajectory_levels_of_detail {
+
+using geometry::Instant;
+using geometry::Position;
+using quantities::Length;
+
+// Successive simplifications of a trajectory in the plotting frame, used to
+// plot it at a cost that depends on the resolution rather than on the number
+// of points.  Each level is a polyline whose vertices are a subset of those of
+// the previous level (the first level simplifies the trajectory itself), chosen
+// so that each vertex of the previous level lies within the tolerance of the
+// level of the polyline.  The tolerances grow geometrically from one level to
+// the next.  The levels are updated incrementally as points are appended.
+class TrajectoryLevelsOfDetail final {
+ public:
+  // The first level has tolerance |finest_tolerance|, each subsequent one has
+  // a tolerance |tolerance_ratio| times that of the previous one.  There must
+  // be at least one level.
+  TrajectoryLevelsOfDetail(Length const& finest_tolerance,
+                           double tolerance_ratio,
+                           int number_of_levels);
+
+  // Appends a point to the trajectory.  |time| must be after the time of the
+  // last point appended.
+  void Append(Instant const& time, Position<Navigation> const& position);
+
+  // Forgets the vertices before |time|.  On each level the last vertex at or
+  // before |time| is kept, so that the polyline still covers the points of the
+  // trajectory after |time|.  The cost is proportional to the number of
+  // vertices forgotten.
+  void ForgetBefore(Instant const& time);
+
+  bool empty() const;
+  // The times of the first vertex and of the last point appended.  The
+  // trajectory must not be empty.
+  Instant const& first_time() const;
+  Instant const& last_time() const;
+
+  // Returns the vertices of the coarsest level such that every point of the
+  // trajectory lies within |tolerance| of the polyline.  The last point of the
+  // trajectory is always a vertex.  Returns nullopt if no level is accurate
+  // enough.
+  std::optional<std::vector<Position<Navigation>>> Polyline(
+      Length const& tolerance) const;
+
+  // Same as above, but the tolerance is such that every point of the
+  // trajectory lies within |tan_angular_resolution| times its distance to
+  // |camera| of the polyline.  The distance is estimated from the distance
+  // between |camera| and the polyline of each level, so the cost is
+  // proportional to the number of vertices of the levels tried, from the
+  // coarsest one.
+  std::optional<std::vector<Position<Navigation>>> Polyline(
+      Position<Navigation> const& camera,
+      double tan_angular_resolution) const;
+
+ private:
+  struct Vertex {
+    Instant time;
+    Position<Navigation> position;
+  };
+
+  struct Level {
+    Level(Length const& tolerance, Length const& error);
+
+    // The maximum distance between the vertices of the previous level and the
+    // polyline of this level.
+    Length tolerance;
+    // The maximum distance between the points of the trajectory and the
+    // polyline of this level.
+    Length error;
+    std::deque<Vertex> vertices;
+    // The vertices of the previous level that come after |vertices.back()|.
+    // The last one is the provisional end of the polyline, and the others lie
+    // within |tolerance| of the segment joining it to |vertices.back()|.
+    std::vector<Vertex> pending;
+  };
+
+  // Processes a |vertex| of the level preceding the one at |index|.
+  void AppendToLevel(int index, Vertex const& vertex);
+
+  // Returns the polyline of the level at |index|, which covers the trajectory
+  // within the |error| of that level.
+  std::vector<Position<Navigation>> LevelPolyline(int index) const;
+
+  // The first level receives all the points of the trajectory.
+  std::vector<Level> levels_;
+};
+
+}  // namespace internal_trajectory_levels_of_detail
+
+using internal_trajectory_levels_of_detail::TrajectoryLevelsOfDetail;
+
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -2,6 +2,9 @@
 #include "ksp_plugin/vessel.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <limits>
 #include <list>
 #include <string>
@@ -25,6 +28,8 @@ using base::FindOrDie;
 using base::make_not_null_unique;
 using geometry::BarycentreCalculator;
 using geometry::Position;
+using geometry::Velocity;
+using physics::RelativeDegreesOfFreedom;
 using quantities::IsFinite;
 using quantities::Length;
 using quantities::Time;
@@ -45,6 +50,7 @@ bool operator!=(Vessel::PrognosticatorParameters const& left,
              right.adaptive_step_parameters.length_integration_tolerance() ||
          left.adaptive_step_parameters.speed_integration_tolerance() !=
              right.adaptive_step_parameters.speed_integration_tolerance() ||
+         left.apsides_references != right.apsides_references ||
          left.shutdown != right.shutdown;
 }
 
@@ -67,6 +73,8 @@ Vessel::Vessel(GUID const& guid,
 
 Vessel::~Vessel() {
   LOG(INFO) << "Destroying vessel " << ShortDebugString();
+  // Stop the flight plan mutation, if any, as soon as possible.
+  CancelFlightPlanMutations();
   // Ask the prognosticator to shut down.  This may take a while.  Make sure
   // that we handle the case where |PrepareHistory| was not called.
   if (prognosticator_.joinable()) {
@@ -77,6 +85,7 @@ Vessel::~Vessel() {
                                    psychohistory_->last().time(),
                                    psychohistory_->last().degrees_of_freedom(),
                                    prediction_adaptive_step_parameters_,
+                                   /*apsides_references=*/{},
                                    /*shutdown=*/true};
     }
     prognosticator_.join();
@@ -234,21 +243,28 @@ void Vessel::AdvanceTime() {
   // Squirrel away the prediction so that we can reattach it if we don't have a
   // prognostication.
   auto prediction = prediction_->DetachFork();
+  Apsides prediction_apsides;
+  prediction_apsides.swap(prediction_apsides_);
 
   history_->DeleteFork(psychohistory_);
-  AppendToVesselTrajectory(&Part::history_begin,
-                           &Part::history_end,
-                           *history_);
-  psychohistory_ = history_->NewForkAtLast();
-  AppendToVesselTrajectory(&Part::psychohistory_begin,
-                           &Part::psychohistory_end,
-                           *psychohistory_);
+  if (!AppendRigidTrajectoryToVesselTrajectories()) {
+    AppendToVesselTrajectory(&Part::history_begin,
+                             &Part::history_end,
+                             *history_);
+    psychohistory_ = history_->NewForkAtLast();
+    AppendToVesselTrajectory(&Part::psychohistory_begin,
+                             &Part::psychohistory_end,
+                             *psychohistory_);
+  }
   {
     absl::MutexLock l(&prognosticator_lock_);
     if (prognostication_ == nullptr) {
-      AttachPrediction(std::move(prediction));
+      AttachPrediction(std::move(prediction), std::move(prediction_apsides));
     } else {
-      AttachPrediction(std::move(prognostication_));
+      Apsides prognostication_apsides;
+      prognostication_apsides.swap(prognostication_apsides_);
+      AttachPrediction(std::move(prognostication_),
+                       std::move(prognostication_apsides));
     }
   }
 
@@ -265,6 +281,14 @@ void Vessel::ForgetBefore(Instant const& time) {
   history_->ForgetBefore(std::min(time, history_->last().time()));
   if (flight_plan_ != nullptr) {
     flight_plan_->ForgetBefore(time, [this]() { flight_plan_.reset(); });
+    if (flight_plan_ == nullptr) {
+      CancelFlightPlanMutations();
+    } else if (mutated_flight_plan_ != nullptr) {
+      // The mutation in progress works on a copy which still has the forgotten
+      // part of the flight plan.  It will be forgotten when the copy is
+      // published.
+      mutated_flight_plan_forget_time_ = time;
+    }
   }
 }
 
@@ -275,6 +299,7 @@ void Vessel::CreateFlightPlan(
         flight_plan_adaptive_step_parameters,
     Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters const&
         flight_plan_generalized_adaptive_step_parameters) {
+  CancelFlightPlanMutations();
   auto const history_last = history_->last();
   flight_plan_ = std::make_unique<FlightPlan>(
       initial_mass,
@@ -287,9 +312,76 @@ void Vessel::CreateFlightPlan(
 }
 
 void Vessel::DeleteFlightPlan() {
+  CancelFlightPlanMutations();
   flight_plan_.reset();
 }
 
+Status Vessel::MutateFlightPlan(
+    std::function<Status(FlightPlan& flight_plan)> const& mutation) {
+  FinishFlightPlanMutations();
+  if (flight_plan_ == nullptr) {
+    return Status(Error::NOT_FOUND,
+                  "Flight plan forgotten when publishing a mutation");
+  }
+  return mutation(*flight_plan_);
+}
+
+void Vessel::MutateFlightPlanAsynchronously(
+    std::function<Status(FlightPlan& flight_plan)> mutation) {
+  CHECK(has_flight_plan());
+  if (synchronous_) {
+    // Run the mutation on this thread and publish it at once, so that the
+    // result of |PollFlightPlanMutation| doesn't depend on thread timing.
+    FinishFlightPlanMutations();
+    not_null<std::unique_ptr<FlightPlan>> mutated_flight_plan =
+        flight_plan_->Clone();
+    std::promise<Status> status;
+    status.set_value(mutation(*mutated_flight_plan));
+    flight_plan_ = std::move(mutated_flight_plan);
+    flight_plan_mutation_ = status.get_future();
+    return;
+  }
+  if (flight_plan_mutation_.valid()) {
+    // Supersede the mutation in progress and any pending one.  The former
+    // stops as soon as possible since its result will be discarded.
+    pending_flight_plan_mutation_ = std::move(mutation);
+    flight_plan_mutation_cancelled_ = true;
+  } else {
+    StartFlightPlanMutation(std::move(mutation));
+  }
+}
+
+Status Vessel::PollFlightPlanMutation() {
+  if (!flight_plan_mutation_.valid()) {
+    return Status::OK;
+  }
+  if (flight_plan_mutation_.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready) {
+    return Status(Error::UNAVAILABLE, "Flight plan mutation in progress");
+  }
+  Status const status = flight_plan_mutation_.get();
+  if (pending_flight_plan_mutation_) {
+    // The mutation that just completed was superseded, drop its result and
+    // start the most recent one.
+    std::optional<std::function<Status(FlightPlan& flight_plan)>> mutation;
+    std::swap(mutation, pending_flight_plan_mutation_);
+    StartFlightPlanMutation(std::move(*mutation));
+    return Status(Error::UNAVAILABLE, "Flight plan mutation in progress");
+  }
+  if (mutated_flight_plan_ != nullptr) {
+    // The published flight plan must not be affected by the cancellation of
+    // later mutations.
+    flight_plan_ = std::move(mutated_flight_plan_);
+    flight_plan_->set_cancelled(nullptr);
+    if (mutated_flight_plan_forget_time_) {
+      flight_plan_->ForgetBefore(*mutated_flight_plan_forget_time_,
+                                 [this]() { flight_plan_.reset(); });
+      mutated_flight_plan_forget_time_.reset();
+    }
+  }
+  return status;
+}
+
 void Vessel::RefreshPrediction() {
   absl::MutexLock l(&prognosticator_lock_);
   // The guard below ensures that the ephemeris will not be "forgotten before"
@@ -308,20 +400,29 @@ void Vessel::RefreshPrediction() {
                                psychohistory_->last().time(),
                                psychohistory_->last().degrees_of_freedom(),
                                prediction_adaptive_step_parameters_,
+                               std::move(apsides_references_),
                                /*shutdown=*/false};
+  // Only the references that are still in use get detected by subsequent
+  // prognostications.
+  apsides_references_.clear();
   if (synchronous_) {
     std::unique_ptr<DiscreteTrajectory<Barycentric>> prognostication;
+    Apsides prognostication_apsides;
     std::optional<PrognosticatorParameters> prognosticator_parameters;
     std::swap(prognosticator_parameters, prognosticator_parameters_);
     Status const status =
         FlowPrognostication(std::move(*prognosticator_parameters),
-                            prognostication);
-    SwapPrognostication(prognostication, status);
+                            prognostication,
+                            prognostication_apsides);
+    SwapPrognostication(prognostication, prognostication_apsides, status);
   } else {
     StartPrognosticatorIfNeeded();
   }
   if (prognostication_ != nullptr) {
-    AttachPrediction(std::move(prognostication_));
+    Apsides prognostication_apsides;
+    prognostication_apsides.swap(prognostication_apsides_);
+    AttachPrediction(std::move(prognostication_),
+                     std::move(prognostication_apsides));
   }
 }
 
@@ -330,6 +431,29 @@ void Vessel::RefreshPrediction(Instant const& time) {
   prediction_->ForgetAfter(time);
 }
 
+ApsidesDetector<Barycentric> const& Vessel::PredictionApsides(
+    Celestial const& celestial) {
+  apsides_references_.insert(&celestial);
+  auto it = prediction_apsides_.find(&celestial);
+  // A detector that has seen points past the end of the prediction (e.g.,
+  // because of |RefreshPrediction(time)|) cannot be reused.
+  if (it != prediction_apsides_.end() &&
+      it->second->last_time() &&
+      *it->second->last_time() > prediction_->last().time()) {
+    prediction_apsides_.erase(it);
+    it = prediction_apsides_.end();
+  }
+  if (it == prediction_apsides_.end()) {
+    it = prediction_apsides_.emplace(
+        &celestial,
+        make_not_null_unique<ApsidesDetector<Barycentric>>(
+            celestial.trajectory())).first;
+  }
+  ApsidesDetector<Barycentric>& detector = *it->second;
+  detector.Extend(prediction_->Fork(), prediction_->End());
+  return detector;
+}
+
 std::string Vessel::ShortDebugString() const {
   return name_ + " (" + guid_ + ")";
 }
@@ -490,12 +614,14 @@ void Vessel::RepeatedlyFlowPrognostication() {
     }
 
     std::unique_ptr<DiscreteTrajectory<Barycentric>> prognostication;
+    Apsides prognostication_apsides;
     Status const status =
         FlowPrognostication(std::move(*prognosticator_parameters),
-                            prognostication);
+                            prognostication,
+                            prognostication_apsides);
     {
       absl::MutexLock l(&prognosticator_lock_);
-      SwapPrognostication(prognostication, status);
+      SwapPrognostication(prognostication, prognostication_apsides, status);
     }
 
     std::this_thread::sleep_until(wakeup_time);
@@ -504,13 +630,30 @@ void Vessel::RepeatedlyFlowPrognostication() {
 
 Status Vessel::FlowPrognostication(
     PrognosticatorParameters prognosticator_parameters,
-    std::unique_ptr<DiscreteTrajectory<Barycentric>>& prognostication) {
+    std::unique_ptr<DiscreteTrajectory<Barycentric>>& prognostication,
+    Apsides& prognostication_apsides) {
   // The guard contained in |prognosticator_parameters| ensures that the |t_min|
   // of the ephemeris doesn't move in this function.
   prognostication = std::make_unique<DiscreteTrajectory<Barycentric>>();
   prognostication->Append(
       prognosticator_parameters.first_time,
       prognosticator_parameters.first_degrees_of_freedom);
+
+  // The apsides are detected on this thread after each chunk of integration,
+  // so that the main thread only has to look them up.
+  prognostication_apsides.clear();
+  for (auto const celestial : prognosticator_parameters.apsides_references) {
+    prognostication_apsides.emplace(
+        celestial,
+        make_not_null_unique<ApsidesDetector<Barycentric>>(
+            celestial->trajectory()));
+  }
+  auto const detect_apsides = [&prognostication, &prognostication_apsides]() {
+    for (auto const& pair : prognostication_apsides) {
+      pair.second->Extend(prognostication->Begin(), prognostication->End());
+    }
+  };
+
   Status status;
   status = ephemeris_->FlowWithAdaptiveStep(
       prognostication.get(),
@@ -519,6 +662,7 @@ Status Vessel::FlowPrognostication(
       prognosticator_parameters.adaptive_step_parameters,
       FlightPlan::max_ephemeris_steps_per_frame,
       /*last_point_only=*/false);
+  detect_apsides();
   bool const reached_t_max = status.ok();
   if (reached_t_max) {
     // This will prolong the ephemeris by |max_ephemeris_steps_per_frame|.
@@ -529,6 +673,7 @@ Status Vessel::FlowPrognostication(
         prognosticator_parameters.adaptive_step_parameters,
         FlightPlan::max_ephemeris_steps_per_frame,
         /*last_point_only=*/false);
+    detect_apsides();
   }
   LOG_IF(INFO, !status.ok())
       << "Prognostication from " << prognosticator_parameters.first_time
@@ -539,11 +684,46 @@ Status Vessel::FlowPrognostication(
 
 void Vessel::SwapPrognostication(
     std::unique_ptr<DiscreteTrajectory<Barycentric>>& prognostication,
+    Apsides& prognostication_apsides,
     Status const& status) {
   prognosticator_lock_.AssertHeld();
   if (status.error() != Error::CANCELLED) {
     prognostication_.swap(prognostication);
+    prognostication_apsides_.swap(prognostication_apsides);
+  }
+}
+
+bool Vessel::AppendRigidTrajectoryToVesselTrajectories() {
+  CHECK(psychohistory_ == nullptr);
+  // The offset of the centre of mass of the vessel is the barycentre of the
+  // offsets of the parts, which we compute using an arbitrary reference point.
+  DegreesOfFreedom<Barycentric> const reference(Barycentric::origin,
+                                                Velocity<Barycentric>());
+  PileUpTrajectory const* trajectory = nullptr;
+  BarycentreCalculator<DegreesOfFreedom<Barycentric>, Mass> calculator;
+  for (auto const& pair : parts_) {
+    Part const& part = *pair.second;
+    if (part.rigid_trajectory() == nullptr ||
+        (trajectory != nullptr && part.rigid_trajectory() != trajectory)) {
+      return false;
+    }
+    trajectory = part.rigid_trajectory();
+    calculator.Add(reference + part.rigid_trajectory_offset(), part.mass());
   }
+  if (trajectory == nullptr) {
+    return false;
+  }
+  RelativeDegreesOfFreedom<Barycentric> const offset =
+      calculator.Get() - reference;
+
+  for (auto const& pair : trajectory->history) {
+    history_->Append(pair.first, pair.second + offset);
+  }
+  psychohistory_ = history_->NewForkAtLast();
+  for (auto const& pair : trajectory->psychohistory) {
+    psychohistory_->Append(pair.first, pair.second + offset);
+  }
+  return true;
 }
 
 void Vessel::AppendToVesselTrajectory(
@@ -594,14 +774,58 @@ void Vessel::AppendToVesselTrajectory(
   }
 }
 
+void Vessel::StartFlightPlanMutation(
+    std::function<Status(FlightPlan& flight_plan)> mutation) {
+  CHECK(!flight_plan_mutation_.valid());
+  flight_plan_mutation_cancelled_ = false;
+  mutated_flight_plan_forget_time_.reset();
+  mutated_flight_plan_ = flight_plan_->Clone();
+  mutated_flight_plan_->set_cancelled(&flight_plan_mutation_cancelled_);
+  // The guard ensures that the ephemeris is not forgotten before the start of
+  // the flight plan while the worker integrates.
+  flight_plan_mutation_ = std::async(
+      std::launch::async,
+      [guard = Ephemeris<Barycentric>::Guard(ephemeris_),
+       flight_plan = mutated_flight_plan_.get(),
+       mutation = std::move(mutation)]() {
+        return mutation(*flight_plan);
+      });
+}
+
+void Vessel::CancelFlightPlanMutations() {
+  pending_flight_plan_mutation_.reset();
+  if (flight_plan_mutation_.valid()) {
+    // The integration stops at the next evaluation of the right-hand side.
+    flight_plan_mutation_cancelled_ = true;
+    flight_plan_mutation_.get();
+  }
+  mutated_flight_plan_.reset();
+  mutated_flight_plan_forget_time_.reset();
+}
+
+void Vessel::FinishFlightPlanMutations() {
+  while (flight_plan_mutation_.valid()) {
+    flight_plan_mutation_.wait();
+    // This either publishes the mutated flight plan or starts the pending
+    // mutation, in which case we wait again.
+    PollFlightPlanMutation();
+  }
+}
+
 void Vessel::AttachPrediction(
-    not_null<std::unique_ptr<DiscreteTrajectory<Barycentric>>> trajectory) {
+    not_null<std::unique_ptr<DiscreteTrajectory<Barycentric>>> trajectory,
+    Apsides apsides) {
   trajectory->ForgetBefore(psychohistory_->last().time());
   if (trajectory->Empty()) {
     prediction_ = psychohistory_->NewForkAtLast();
+    prediction_apsides_.clear();
   } else {
     prediction_ = trajectory.get();
     psychohistory_->AttachFork(std::move(trajectory));
+    prediction_apsides_ = std::move(apsides);
+    for (auto const& pair : prediction_apsides_) {
+      pair.second->ForgetBefore(prediction_->Fork().time());
+    }
   }
 }
 
@@ -1,9 +1,13 @@
 ﻿
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <future>
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -14,6 +18,7 @@
 #include "ksp_plugin/flight_plan.hpp"
 #include "ksp_plugin/part.hpp"
 #include "ksp_plugin/pile_up.hpp"
+#include "physics/apsides.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/massless_body.hpp"
@@ -28,6 +33,7 @@ using base::not_null;
 using base::Status;
 using geometry::Instant;
 using geometry::Vector;
+using physics::ApsidesDetector;
 using physics::DegreesOfFreedom;
 using physics::DiscreteTrajectory;
 using physics::Ephemeris;
@@ -132,7 +138,8 @@ class Vessel {
   virtual void AdvanceTime();
 
   // Forgets the trajectories and flight plan before |time|.  This may delete
-  // the flight plan.
+  // the flight plan.  A flight plan mutation in progress is not cancelled, its
+  // result is forgotten when it is published.
   virtual void ForgetBefore(Instant const& time);
 
   // Creates a |flight_plan_| at the end of history using the given parameters.
@@ -147,6 +154,35 @@ class Vessel {
   // Deletes the |flight_plan_|.  Performs no action unless |has_flight_plan()|.
   virtual void DeleteFlightPlan();
 
+  // Applies |mutation| to the flight plan on this thread and returns its
+  // status.  The asynchronous mutations requested earlier, if any, are waited
+  // for and published first, so that no edit is lost and the edits take effect
+  // in the order in which they were requested.  Returns |Error::NOT_FOUND|
+  // without applying |mutation| if publishing them deleted the flight plan
+  // because it was entirely forgotten.  Requires |has_flight_plan()|.
+  Status MutateFlightPlan(
+      std::function<Status(FlightPlan& flight_plan)> const& mutation);
+
+  // Applies |mutation| to a copy of the flight plan on another thread and
+  // returns immediately.  The current flight plan is unaffected, and may still
+  // be rendered, until the copy is published by |PollFlightPlanMutation|.  A
+  // mutation requested while another one is in progress supersedes it: the
+  // latter is cancelled, its result is discarded, and the new mutation is
+  // applied to the current flight plan.  Therefore, mutations should be
+  // absolute edits (e.g., replacing a burn) rather than relative ones (e.g.,
+  // appending a burn).  In synchronous mode the mutation is applied and
+  // published before this function returns, and its status is returned by the
+  // next call to |PollFlightPlanMutation|.  Requires |has_flight_plan()|.
+  virtual void MutateFlightPlanAsynchronously(
+      std::function<Status(FlightPlan& flight_plan)> mutation);
+
+  // If the last mutation requested by |MutateFlightPlanAsynchronously| has
+  // completed, publishes the mutated flight plan and returns the status of the
+  // mutation.  If |ForgetBefore| was called while the mutation was in progress,
+  // the mutated flight plan is forgotten accordingly, which may delete it.  Returns |Error::UNAVAILABLE| if a mutation is still in progress
+  // and OK if there is no mutation.
+  virtual Status PollFlightPlanMutation();
+
   // Tries to replace the current prediction with a more recently computed one.
   // No guarantees that this happens.  No guarantees regarding the end time of
   // the prediction when this call returns.
@@ -156,6 +192,16 @@ class Vessel {
   // have a last time at or before |time|.
   virtual void RefreshPrediction(Instant const& time);
 
+  // Returns the apsides of the prediction with respect to the trajectory of
+  // |celestial|.  Once this has been called for a given |celestial|, the
+  // apsides are detected by the prognosticator as it integrates the next
+  // prediction, so that they don't have to be recomputed here.  A |celestial|
+  // for which this is not called between two calls to |RefreshPrediction| is
+  // dropped from the prognostication.  The result is invalidated by the next
+  // call to |AdvanceTime| or |RefreshPrediction|.
+  virtual ApsidesDetector<Barycentric> const& PredictionApsides(
+      Celestial const& celestial);
+
   // Returns "vessel_name (GUID)".
   std::string ShortDebugString() const;
 
@@ -186,6 +232,7 @@ class Vessel {
     Instant first_time;
     DegreesOfFreedom<Barycentric> first_degrees_of_freedom;
     Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters;
+    std::set<not_null<Celestial const*>> apsides_references;
     bool shutdown = false;
   };
   friend bool operator!=(PrognosticatorParameters const& left,
@@ -194,6 +241,13 @@ class Vessel {
   using TrajectoryIterator =
       DiscreteTrajectory<Barycentric>::Iterator (Part::*)();
 
+  // The apsides of a prediction or prognostication, indexed by the celestial
+  // whose trajectory is the reference.  Celestials outlive the vessels, so
+  // these keys never dangle.
+  using Apsides =
+      std::map<not_null<Celestial const*>,
+               not_null<std::unique_ptr<ApsidesDetector<Barycentric>>>>;
+
   // Starts the |prognosticator_| if it is not started already.  The
   // |prognosticator_parameters_| must have been set.
   void StartPrognosticatorIfNeeded() REQUIRES(prognosticator_lock_);
@@ -203,26 +257,51 @@ class Vessel {
   void RepeatedlyFlowPrognostication();
 
   // Runs the integrator to compute the |prognostication_| based on the given
-  // parameters.
+  // parameters.  The apsides with respect to the references given in the
+  // parameters are detected as the integration proceeds.
   Status FlowPrognostication(
       PrognosticatorParameters prognosticator_parameters,
-      std::unique_ptr<DiscreteTrajectory<Barycentric>>& prognostication);
+      std::unique_ptr<DiscreteTrajectory<Barycentric>>& prognostication,
+      Apsides& prognostication_apsides);
 
-  // Publishes the prognostication if the computation was not cancelled.
+  // Publishes the prognostication and its apsides if the computation was not
+  // cancelled.
   void SwapPrognostication(
       std::unique_ptr<DiscreteTrajectory<Barycentric>>& prognostication,
+      Apsides& prognostication_apsides,
       Status const& status);
 
+  // If the trajectories of all the parts are given by the same
+  // |PileUpTrajectory|, appends its points, shifted to the centre of mass of
+  // the parts, to the |history_| and |psychohistory_|, and returns true.  This
+  // avoids copying the points into each part.  Otherwise returns false and
+  // doesn't change the trajectories.  The |psychohistory_| must be null.
+  bool AppendRigidTrajectoryToVesselTrajectories();
+
   // Appends to |trajectory| the centre of mass of the trajectories of the parts
   // denoted by |part_trajectory_begin| and |part_trajectory_end|.
   void AppendToVesselTrajectory(TrajectoryIterator part_trajectory_begin,
                                 TrajectoryIterator part_trajectory_end,
                                 DiscreteTrajectory<Barycentric>& trajectory);
 
+  // Starts |mutation| on a clone of the |flight_plan_|.  There must be no
+  // mutation in progress.
+  void StartFlightPlanMutation(
+      std::function<Status(FlightPlan& flight_plan)> mutation);
+
+  // Cancels the mutation in progress, if any, waits for it, and discards its
+  // result as well as the pending mutation.
+  void CancelFlightPlanMutations();
+
+  // Waits for the mutation in progress and the pending one, if any, and
+  // publishes the result.
+  void FinishFlightPlanMutations();
+
   // Attaches the given |trajectory| to the end of the |psychohistory_| to
-  // become the new |prediction_|.
+  // become the new |prediction_|, with the given |apsides|.
   void AttachPrediction(
-      not_null<std::unique_ptr<DiscreteTrajectory<Barycentric>>> trajectory);
+      not_null<std::unique_ptr<DiscreteTrajectory<Barycentric>>> trajectory,
+      Apsides apsides);
 
   GUID const guid_;
   std::string name_;
@@ -257,9 +336,30 @@ class Vessel {
   // and may or may not be used as a prediction;
   std::unique_ptr<DiscreteTrajectory<Barycentric>> prognostication_
       GUARDED_BY(prognosticator_lock_);
+  Apsides prognostication_apsides_ GUARDED_BY(prognosticator_lock_);
+
+  // The celestials for which apsides have been requested since the last call
+  // to |RefreshPrediction|, and the apsides of the |prediction_| with respect
+  // to them.
+  std::set<not_null<Celestial const*>> apsides_references_;
+  Apsides prediction_apsides_;
 
   std::unique_ptr<FlightPlan> flight_plan_;
 
+  // The asynchronous mutations of the flight plan.  All these members are only
+  // accessed on the main thread, the worker only touches the
+  // |mutated_flight_plan_| and reads |flight_plan_mutation_cancelled_|.  The
+  // |flight_plan_mutation_| is declared last so that it gets destroyed (and
+  // joined) first.
+  std::optional<std::function<Status(FlightPlan& flight_plan)>>
+      pending_flight_plan_mutation_;
+  std::unique_ptr<FlightPlan> mutated_flight_plan_;
+  // If set, the |mutated_flight_plan_| must be forgotten before that time when
+  // it is published.
+  std::optional<Instant> mutated_flight_plan_forget_time_;
+  std::atomic_bool flight_plan_mutation_cancelled_ = false;
+  std::future<Status> flight_plan_mutation_;
+
   static std::atomic_bool synchronous_;
 };
 
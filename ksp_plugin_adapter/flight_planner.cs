@@ -88,6 +88,27 @@ class FlightPlanner : SupervisedWindowRenderer {
   }
 
   private void UpdateVesselAndBurnEditors() {
+    {
+      // Publish the edit of the last burn if it has completed, and show its
+      // result in the editor.
+      string vessel_guid = vessel_?.id.ToString();
+      if (vessel_guid != null &&
+          plugin.HasVessel(vessel_guid) &&
+          plugin.FlightPlanExists(vessel_guid) &&
+          plugin.FlightPlanPollAsynchronousMutation(vessel_guid).error !=
+              unavailable) {
+        if (last_burn_mutation_in_progress_ &&
+            burn_editors_?.Count > 0 &&
+            plugin.FlightPlanNumberOfManoeuvres(vessel_guid) ==
+                burn_editors_.Count) {
+          burn_editors_.Last().Reset(
+              plugin.FlightPlanGetManoeuvre(vessel_guid,
+                                            burn_editors_.Count - 1));
+        }
+        last_burn_mutation_in_progress_ = false;
+      }
+    }
+
     {
       string vessel_guid = vessel_?.id.ToString();
       if (vessel_guid == null ||
@@ -242,10 +263,11 @@ class FlightPlanner : SupervisedWindowRenderer {
                                                    (burn_editors_.Count),
                                enabled           : true,
                                actual_final_time : actual_final_time)) {
-            plugin.FlightPlanReplaceLast(vessel_guid, last_burn.Burn());
-            last_burn.Reset(
-                plugin.FlightPlanGetManoeuvre(vessel_guid,
-                                              burn_editors_.Count - 1));
+            // The flight plan is recomputed on another thread, the editor is
+            // reset when the result is published.
+            plugin.FlightPlanReplaceLastAsynchronously(vessel_guid,
+                                                       last_burn.Burn());
+            last_burn_mutation_in_progress_ = true;
           }
           if (UnityEngine.GUILayout.Button(
                   "Delete last manœuvre",
@@ -413,9 +435,13 @@ class FlightPlanner : SupervisedWindowRenderer {
   private List<BurnEditor> burn_editors_;
   private DifferentialSlider final_time_;
   private int? first_future_manoeuvre_;
+  // Whether an asynchronous edit of the last burn has not been published yet.
+  private bool last_burn_mutation_in_progress_ = false;
 
   private bool show_guidance_ = false;
   
+  // The error returned while an asynchronous edit is in progress.
+  private const int unavailable = 14;
   private const double log10_time_lower_rate = 0.0;
   private const double log10_time_upper_rate = 7.0;
 }
@@ -1,6 +1,7 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.Linq;
+using System.Runtime.InteropServices;
 using System.Text;
 
 namespace principia {
@@ -106,12 +107,20 @@ public enum Style {
          rp2_lines_iterator.IteratorIncrement()) {
       using (DisposableIterator rp2_line_iterator =
                 rp2_lines_iterator.IteratorGetRP2LinesIterator()) {
+        // Copy the whole line in one call rather than crossing the interface
+        // for each point.  An |XY| is laid out as two doubles.
+        int line_size = rp2_line_iterator.IteratorSize();
+        double[] coordinates = new double[2 * line_size];
+        if (line_size > 0) {
+          Marshal.Copy(rp2_line_iterator.IteratorExportRP2LineXY(),
+                       coordinates,
+                       0,
+                       coordinates.Length);
+        }
         XY? previous_rp2_point = null;
-        for (;
-             !rp2_line_iterator.IteratorAtEnd();
-             rp2_line_iterator.IteratorIncrement()) {
-          XY current_rp2_point = ToScreen(
-              rp2_line_iterator.IteratorGetRP2LineXY());
+        for (int i = 0; i < line_size; ++i) {
+          XY current_rp2_point = ToScreen(new XY{x = coordinates[2 * i],
+                                                 y = coordinates[2 * i + 1]});
           if (previous_rp2_point.HasValue) {
             if (style == Style.FADED) {
               colour.a = 1 - (float)(4 * index) / (float)(5 * size);
@@ -62,6 +62,7 @@ private enum UnityLayers {
   private bool hide_all_gui_ = false;
 
   private const int чебышёв_plotting_method_ = 2;
+  private const int levels_of_detail_plotting_method_ = 3;
 
   private IntPtr plugin_ = IntPtr.Zero;
   internal IntPtr Plugin() {
@@ -1767,7 +1768,7 @@ private enum UnityLayers {
           using (DisposableIterator rp2_lines_iterator =
                     planetarium.PlanetariumPlotPsychohistory(
                         plugin_,
-                        чебышёв_plotting_method_,
+                        levels_of_detail_plotting_method_,
                         main_vessel_guid)) {
             GLLines.PlotRP2Lines(rp2_lines_iterator,
                                  XKCDColors.Lime,
@@ -1790,7 +1791,7 @@ private enum UnityLayers {
             using (DisposableIterator rp2_lines_iterator =
                       planetarium.PlanetariumPlotPsychohistory(
                           plugin_,
-                          чебышёв_plotting_method_,
+                          levels_of_detail_plotting_method_,
                           target_id)) {
               GLLines.PlotRP2Lines(rp2_lines_iterator,
                                    XKCDColors.Goldenrod,
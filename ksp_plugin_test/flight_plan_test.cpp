@@ -2,6 +2,7 @@
 #include "ksp_plugin/flight_plan.hpp"
 
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -36,6 +37,7 @@ using integrators::methods::DormandالمكاوىPrince1986RKN434FM;
 using integrators::methods::Fine1987RKNG34;
 using integrators::methods::QuinlanTremaine1990Order12;
 using physics::BodyCentredNonRotatingDynamicFrame;
+using physics::ComputeApsides;
 using physics::DegreesOfFreedom;
 using physics::DiscreteTrajectory;
 using physics::Frenet;
@@ -404,6 +406,83 @@ TEST_F(FlightPlanTest, ReplaceLast) {
   EXPECT_EQ(1, flight_plan_->number_of_manœuvres());
 }
 
+TEST_F(FlightPlanTest, IncrementalReplace) {
+  flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second);
+  EXPECT_OK(flight_plan_->Append(MakeFirstBurn()));
+  EXPECT_OK(flight_plan_->Append(MakeSecondBurn()));
+
+  auto const segment_points = [this](int const index) {
+    std::vector<std::pair<Instant, DegreesOfFreedom<Barycentric>>> points;
+    DiscreteTrajectory<Barycentric>::Iterator begin;
+    DiscreteTrajectory<Barycentric>::Iterator end;
+    flight_plan_->GetSegment(index, begin, end);
+    for (auto it = begin; it != end; ++it) {
+      points.emplace_back(it.time(), it.degrees_of_freedom());
+    }
+    return points;
+  };
+  auto const first_coast = segment_points(0);
+  auto const second_coast = segment_points(2);
+
+  // Changing the Δv of the second burn doesn't change its timing: the coasts
+  // that precede it are reused as is.
+  auto stronger_burn = MakeSecondBurn();
+  *stronger_burn.intensity.Δv *= 2;
+  EXPECT_OK(flight_plan_->Replace(stronger_burn, /*index=*/1));
+  EXPECT_EQ(5, flight_plan_->number_of_segments());
+  EXPECT_THAT(segment_points(0), Eq(first_coast));
+  EXPECT_THAT(segment_points(2), Eq(second_coast));
+
+  // Moving the second burn earlier truncates the coast that precedes it: the
+  // points before the new beginning of the burn are kept.
+  auto earlier_burn = MakeSecondBurn();
+  *earlier_burn.timing.initial_time -= 0.25 * Second;
+  EXPECT_OK(flight_plan_->Replace(earlier_burn, /*index=*/1));
+  auto const truncated_second_coast = segment_points(2);
+  EXPECT_EQ(t0_ + 1.75 * Second, truncated_second_coast.back().first);
+  ASSERT_LE(truncated_second_coast.size(), second_coast.size());
+  for (int i = 0; i < truncated_second_coast.size() - 1; ++i) {
+    EXPECT_THAT(truncated_second_coast[i], Eq(second_coast[i]));
+  }
+
+  // Extending the flight plan extends the last coast.
+  auto const last_coast = segment_points(4);
+  EXPECT_OK(flight_plan_->SetDesiredFinalTime(t0_ + 50 * Second));
+  auto const extended_last_coast = segment_points(4);
+  EXPECT_EQ(t0_ + 50 * Second, extended_last_coast.back().first);
+  EXPECT_LT(last_coast.size(), extended_last_coast.size());
+}
+
+TEST_F(FlightPlanTest, Clone) {
+  flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second);
+  EXPECT_OK(flight_plan_->Append(MakeFirstBurn()));
+  EXPECT_OK(flight_plan_->Append(MakeSecondBurn()));
+  auto const clone = flight_plan_->Clone();
+  EXPECT_EQ(flight_plan_->number_of_manœuvres(),
+            clone->number_of_manœuvres());
+  ASSERT_EQ(flight_plan_->number_of_segments(), clone->number_of_segments());
+  for (int i = 0; i < flight_plan_->number_of_segments(); ++i) {
+    DiscreteTrajectory<Barycentric>::Iterator begin;
+    DiscreteTrajectory<Barycentric>::Iterator end;
+    DiscreteTrajectory<Barycentric>::Iterator clone_begin;
+    DiscreteTrajectory<Barycentric>::Iterator clone_end;
+    flight_plan_->GetSegment(i, begin, end);
+    clone->GetSegment(i, clone_begin, clone_end);
+    auto clone_it = clone_begin;
+    for (auto it = begin; it != end; ++it, ++clone_it) {
+      ASSERT_TRUE(clone_it != clone_end);
+      EXPECT_EQ(it.time(), clone_it.time());
+      EXPECT_EQ(it.degrees_of_freedom(), clone_it.degrees_of_freedom());
+    }
+    EXPECT_TRUE(clone_it == clone_end);
+  }
+
+  // Mutating the clone doesn't affect the original.
+  EXPECT_OK(clone->RemoveLast());
+  EXPECT_EQ(2, flight_plan_->number_of_manœuvres());
+  EXPECT_EQ(1, clone->number_of_manœuvres());
+}
+
 TEST_F(FlightPlanTest, Segments) {
   flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second);
   EXPECT_OK(flight_plan_->Append(MakeFirstBurn()));
@@ -430,6 +509,44 @@ TEST_F(FlightPlanTest, Segments) {
   }
 }
 
+TEST_F(FlightPlanTest, Apsides) {
+  auto const& reference = *ephemeris_->trajectory(ephemeris_->bodies().back());
+  // Checks that the cached apsides are those of the current segments.
+  auto const expect_apsides_of_segments = [this, &reference]() {
+    DiscreteTrajectory<Barycentric>::Iterator begin;
+    DiscreteTrajectory<Barycentric>::Iterator end;
+    flight_plan_->GetAllSegments(begin, end);
+    DiscreteTrajectory<Barycentric> apoapsides;
+    DiscreteTrajectory<Barycentric> periapsides;
+    ComputeApsides(reference, begin, end, apoapsides, periapsides);
+    auto const& apsides = flight_plan_->GetApsides(reference);
+    EXPECT_EQ(apoapsides.Size(), apsides.apoapsides().Size());
+    EXPECT_EQ(periapsides.Size(), apsides.periapsides().Size());
+    for (auto it1 = apoapsides.Begin(), it2 = apsides.apoapsides().Begin();
+         it1 != apoapsides.End() && it2 != apsides.apoapsides().End();
+         ++it1, ++it2) {
+      EXPECT_EQ(it1.time(), it2.time());
+    }
+    for (auto it1 = periapsides.Begin(), it2 = apsides.periapsides().Begin();
+         it1 != periapsides.End() && it2 != apsides.periapsides().End();
+         ++it1, ++it2) {
+      EXPECT_EQ(it1.time(), it2.time());
+    }
+    return apsides.apoapsides().Size() + apsides.periapsides().Size();
+  };
+
+  flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second);
+  EXPECT_OK(flight_plan_->Append(MakeFirstBurn()));
+  EXPECT_LT(0, expect_apsides_of_segments());
+  EXPECT_OK(flight_plan_->Append(MakeSecondBurn()));
+  expect_apsides_of_segments();
+  // The cache must not retain the apsides of the removed segments.
+  flight_plan_->RemoveLast();
+  expect_apsides_of_segments();
+  flight_plan_->SetDesiredFinalTime(t0_ + 20 * Second);
+  expect_apsides_of_segments();
+}
+
 TEST_F(FlightPlanTest, SetAdaptiveStepParameter) {
   DiscreteTrajectory<Barycentric>::Iterator begin;
   DiscreteTrajectory<Barycentric>::Iterator end;
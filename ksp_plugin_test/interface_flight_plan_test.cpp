@@ -365,7 +365,9 @@ TEST_F(InterfaceFlightPlanTest, FlightPlan) {
       DegreesOfFreedom<World>(
           World::origin +
               Displacement<World>({0 * Metre, 2 * Metre, 4 * Metre}),
-          Velocity<World>()));
+          Velocity<World>({3 * (Metre / Second),
+                           5 * (Metre / Second),
+                           7 * (Metre / Second)})));
   auto segment = make_not_null_unique<DiscreteTrajectory<Barycentric>>();
   DegreesOfFreedom<Barycentric> immobile_origin{Barycentric::origin,
                                                 Velocity<Barycentric>{}};
@@ -391,6 +393,24 @@ TEST_F(InterfaceFlightPlanTest, FlightPlan) {
   principia__IteratorIncrement(iterator);
   EXPECT_EQ(XYZ({0, 2, 4}),
             principia__IteratorGetDiscreteTrajectoryXYZ(iterator));
+  EXPECT_EQ(3, principia__IteratorSize(iterator));
+  XYZ const* const exported =
+      principia__IteratorExportDiscreteTrajectoryXYZ(iterator);
+  EXPECT_EQ(XYZ({0, 0, 0}), exported[0]);
+  EXPECT_EQ(XYZ({0, 1, 2}), exported[1]);
+  EXPECT_EQ(XYZ({0, 2, 4}), exported[2]);
+  // The export covers the entire trajectory irrespective of the position of
+  // the iterator, and the exported array, which is owned by the iterator,
+  // survives its moves.
+  principia__IteratorReset(iterator);
+  QP const* const exported_qp =
+      principia__IteratorExportDiscreteTrajectoryQP(iterator);
+  principia__IteratorIncrement(iterator);
+  EXPECT_EQ(QP({{0, 0, 0}, {0, 0, 0}}), exported_qp[0]);
+  EXPECT_EQ(QP({{0, 1, 2}, {0, 0, 0}}), exported_qp[1]);
+  EXPECT_EQ(QP({{0, 2, 4}, {3, 5, 7}}), exported_qp[2]);
+  EXPECT_EQ(principia__IteratorGetDiscreteTrajectoryQP(iterator),
+            exported_qp[1]);
 
   interface_burn.thrust_in_kilonewtons = 10;
   EXPECT_CALL(*plugin_,
@@ -7,7 +7,9 @@
 #include "geometry/rotation.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "geometry/rp2_point.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/iterators.hpp"
 #include "ksp_plugin_test/mock_planetarium.hpp"
 #include "ksp_plugin_test/mock_plugin.hpp"
 #include "ksp_plugin_test/mock_renderer.hpp"
@@ -22,13 +24,18 @@ using base::not_null;
 using geometry::Instant;
 using geometry::OrthogonalMap;
 using geometry::RigidTransformation;
+using geometry::RP2Line;
+using geometry::RP2Lines;
+using geometry::RP2Point;
 using geometry::Rotation;
 using ksp_plugin::Camera;
+using ksp_plugin::TypedIterator;
 using ksp_plugin::Navigation;
 using ksp_plugin::MockPlanetarium;
 using ksp_plugin::MockPlugin;
 using ksp_plugin::MockRenderer;
 using quantities::Length;
+using quantities::si::Metre;
 using testing_utilities::FillUniquePtr;
 using ::testing::IsNull;
 using ::testing::Return;
@@ -71,5 +78,48 @@ TEST_F(InterfacePlanetariumTest, ConstructionDestruction) {
   EXPECT_THAT(planetarium, IsNull());
 }
 
+TEST_F(InterfacePlanetariumTest, ExportRP2Line) {
+  RP2Lines<Length, Camera> const rp2_lines{
+      RP2Line<Length, Camera>{
+          RP2Point<Length, Camera>(1 * Metre, 2 * Metre, 1),
+          RP2Point<Length, Camera>(6 * Metre, -8 * Metre, 2),
+          RP2Point<Length, Camera>(-9 * Metre, 3 * Metre, 3)},
+      RP2Line<Length, Camera>{
+          RP2Point<Length, Camera>(5 * Metre, 7 * Metre, 1)}};
+  Iterator* rp2_lines_iterator =
+      new TypedIterator<RP2Lines<Length, Camera>>(rp2_lines);
+  Iterator* rp2_line_iterator =
+      principia__IteratorGetRP2LinesIterator(rp2_lines_iterator);
+  EXPECT_EQ(3, principia__IteratorSize(rp2_line_iterator));
+
+  // The export covers the entire line irrespective of the position of the
+  // iterator, and the exported array, which is owned by the iterator, survives
+  // its moves.
+  principia__IteratorIncrement(rp2_line_iterator);
+  XY const* const exported =
+      principia__IteratorExportRP2LineXY(rp2_line_iterator);
+  principia__IteratorIncrement(rp2_line_iterator);
+  principia__IteratorReset(rp2_line_iterator);
+  EXPECT_EQ(XY({1, 2}), exported[0]);
+  EXPECT_EQ(XY({3, -4}), exported[1]);
+  EXPECT_EQ(XY({-3, 1}), exported[2]);
+  EXPECT_EQ(principia__IteratorGetRP2LineXY(rp2_line_iterator), exported[0]);
+
+  // The line iterator owns a copy of the line, so its export is independent
+  // from the lifetime of the iterator over the lines.
+  principia__IteratorDelete(&rp2_lines_iterator);
+  EXPECT_THAT(rp2_lines_iterator, IsNull());
+  EXPECT_EQ(XY({3, -4}), exported[1]);
+
+  // A second export replaces the first one.
+  XY const* const reexported =
+      principia__IteratorExportRP2LineXY(rp2_line_iterator);
+  EXPECT_EQ(XY({1, 2}), reexported[0]);
+  EXPECT_EQ(XY({3, -4}), reexported[1]);
+  EXPECT_EQ(XY({-3, 1}), reexported[2]);
+  principia__IteratorDelete(&rp2_line_iterator);
+  EXPECT_THAT(rp2_line_iterator, IsNull());
+}
+
 }  // namespace interface
 }  // namespace principia
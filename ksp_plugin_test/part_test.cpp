@@ -1,6 +1,8 @@
 ﻿
 #include "ksp_plugin/part.hpp"
 
+#include <memory>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "ksp_plugin/frames.hpp"
@@ -10,6 +12,7 @@ namespace principia {
 namespace ksp_plugin {
 namespace internal_part {
 
+using base::make_not_null_shared;
 using geometry::Displacement;
 using quantities::Force;
 using quantities::si::Kilogram;
@@ -84,11 +87,11 @@ TEST_F(PartTest, Serialization) {
                    multivector().vector().y().quantity().magnitude());
   EXPECT_EQ(6, message.degrees_of_freedom().t2().
                    multivector().vector().z().quantity().magnitude());
-  EXPECT_EQ(1, message.prehistory().timeline_size());
+  EXPECT_TRUE(message.prehistory().has_compressed_timeline());
   EXPECT_EQ(1, message.prehistory().children_size());
   EXPECT_EQ(1, message.prehistory().children(0).trajectories_size());
-  EXPECT_EQ(1,
-            message.prehistory().children(0).trajectories(0).timeline_size());
+  EXPECT_TRUE(message.prehistory().children(0).trajectories(0).
+                  has_compressed_timeline());
 
   auto const p = Part::ReadFromMessage(message, /*deletion_callback=*/nullptr);
   EXPECT_EQ(part_.mass(), p->mass());
@@ -101,6 +104,47 @@ TEST_F(PartTest, Serialization) {
   EXPECT_THAT(message, EqualsProto(second_message));
 }
 
+TEST_F(PartTest, RigidTrajectory) {
+  Part part(part_id_ + 1,
+            "rigid part",
+            mass_,
+            degrees_of_freedom_,
+            /*deletion_callback=*/nullptr);
+  auto const trajectory = make_not_null_shared<PileUpTrajectory>();
+  trajectory->history.emplace_back(astronomy::J2000, degrees_of_freedom_);
+  trajectory->psychohistory.emplace_back(astronomy::J2000 + 1 * Second,
+                                         degrees_of_freedom_);
+  RelativeDegreesOfFreedom<Barycentric> const offset(
+      Displacement<Barycentric>({1 * Metre, 0 * Metre, 0 * Metre}),
+      Velocity<Barycentric>({0 * Metre / Second,
+                             1 * Metre / Second,
+                             0 * Metre / Second}));
+  part.AppendRigidTrajectory(trajectory, offset);
+  EXPECT_EQ(trajectory.get(), part.rigid_trajectory());
+  EXPECT_EQ(offset, part.rigid_trajectory_offset());
+
+  // Accessing the trajectories materializes them.
+  auto const history_begin = part.history_begin();
+  EXPECT_EQ(nullptr, part.rigid_trajectory());
+  EXPECT_EQ(astronomy::J2000, history_begin.time());
+  EXPECT_EQ(degrees_of_freedom_ + offset, history_begin.degrees_of_freedom());
+  auto history_it = history_begin;
+  EXPECT_EQ(part.history_end(), ++history_it);
+  auto const psychohistory_begin = part.psychohistory_begin();
+  EXPECT_EQ(astronomy::J2000 + 1 * Second, psychohistory_begin.time());
+  EXPECT_EQ(degrees_of_freedom_ + offset,
+            psychohistory_begin.degrees_of_freedom());
+  auto psychohistory_it = psychohistory_begin;
+  EXPECT_EQ(part.psychohistory_end(), ++psychohistory_it);
+
+  // A part that already has points doesn't share the trajectory.
+  auto const next_trajectory = make_not_null_shared<PileUpTrajectory>();
+  next_trajectory->history.emplace_back(astronomy::J2000 + 2 * Second,
+                                        degrees_of_freedom_);
+  part.AppendRigidTrajectory(next_trajectory, offset);
+  EXPECT_EQ(nullptr, part.rigid_trajectory());
+}
+
 }  // namespace internal_part
 }  // namespace ksp_plugin
 }  // namespace principia
@@ -87,9 +87,15 @@ class TestablePileUp : public PileUp {
     return psychohistory_;
   }
 
-  PartTo<DegreesOfFreedom<RigidPileUp>> const&
+  PartTo<DegreesOfFreedom<RigidPileUp>>
   actual_part_degrees_of_freedom() const {
-    return actual_part_degrees_of_freedom_;
+    PartTo<DegreesOfFreedom<RigidPileUp>> result;
+    auto it = actual_part_degrees_of_freedom_.cbegin();
+    for (not_null<Part*> const part : parts()) {
+      result.emplace(part, *it);
+      ++it;
+    }
+    return result;
   }
 
   PartTo<DegreesOfFreedom<ApparentBubble>> const&
@@ -587,6 +593,110 @@ TEST_F(PileUpTest, MidStepIntrinsicForce) {
               AlmostEquals(old_velocity + 0.5 * fixed_step * a, 1));
 }
 
+// Checks that a change of the mass of a part causes the pile-up to be deformed
+// again even if the apparent degrees of freedom are unchanged.
+TEST_F(PileUpTest, DeformationAfterMassChange) {
+  MockEphemeris<Barycentric> ephemeris;
+  EXPECT_CALL(deletion_callback_, Call()).Times(1);
+  TestablePileUp pile_up({&p1_, &p2_},
+                         astronomy::J2000,
+                         DefaultPsychohistoryParameters(),
+                         DefaultHistoryParameters(),
+                         &ephemeris,
+                         deletion_callback_.AsStdFunction());
+
+  CheckPreDeformPileUpInvariants(pile_up);
+  pile_up.DeformPileUpIfNeeded();
+  CheckPreAdvanceTimeInvariants(pile_up);
+
+  // Same apparent degrees of freedom as in
+  // |CheckPreDeformPileUpInvariants|, but |p1_| is now as heavy as |p2_|.
+  p1_.set_mass(2 * Kilogram);
+  pile_up.SetPartApparentDegreesOfFreedom(
+      &p1_,
+      DegreesOfFreedom<ApparentBubble>(
+          ApparentBubble::origin +
+              Displacement<ApparentBubble>({-11.0 / 3.0 * Metre,
+                                            -1.0 * Metre,
+                                            2.0 / 3.0 * Metre}),
+          Velocity<ApparentBubble>({-110.0 / 3.0 * Metre / Second,
+                                    -10.0 * Metre / Second,
+                                    20.0 / 3.0 * Metre / Second})));
+  pile_up.SetPartApparentDegreesOfFreedom(
+      &p2_,
+      DegreesOfFreedom<ApparentBubble>(
+          ApparentBubble::origin +
+              Displacement<ApparentBubble>({2.0 * Metre,
+                                            0.0 * Metre,
+                                            -2.0 / 3.0 * Metre}),
+          Velocity<ApparentBubble>({20.0 * Metre / Second,
+                                    0.0 * Metre / Second,
+                                    -20.0 / 3.0 * Metre / Second})));
+  pile_up.DeformPileUpIfNeeded();
+
+  // The apparent centre of mass is now, in SI units:
+  //   {-5 / 6, -1 / 2, 0} {-25 / 3, -5, 0}
+  EXPECT_THAT(
+      pile_up.actual_part_degrees_of_freedom().at(&p1_),
+      Componentwise(AlmostEquals(RigidPileUp::origin +
+                                     Displacement<RigidPileUp>(
+                                         {-17.0 / 6.0 * Metre,
+                                          -1.0 / 2.0 * Metre,
+                                          2.0 / 3.0 * Metre}), 1),
+                    AlmostEquals(Velocity<RigidPileUp>(
+                                     {-85.0 / 3.0 * Metre / Second,
+                                      -5.0 * Metre / Second,
+                                      20.0 / 3.0 * Metre / Second}), 1)));
+  EXPECT_THAT(
+      pile_up.actual_part_degrees_of_freedom().at(&p2_),
+      Componentwise(AlmostEquals(RigidPileUp::origin +
+                                     Displacement<RigidPileUp>(
+                                         {17.0 / 6.0 * Metre,
+                                          1.0 / 2.0 * Metre,
+                                          -2.0 / 3.0 * Metre}), 1),
+                    AlmostEquals(Velocity<RigidPileUp>(
+                                     {85.0 / 3.0 * Metre / Second,
+                                      5.0 * Metre / Second,
+                                      -20.0 / 3.0 * Metre / Second}), 1)));
+}
+
+// Checks the ordering used to schedule the catch-up of the pile-ups.
+TEST_F(PileUpTest, EstimatedCatchUpCost) {
+  MockEphemeris<Barycentric> ephemeris;
+  EXPECT_CALL(deletion_callback_, Call()).Times(1);
+  TestablePileUp pile_up({&p1_, &p2_},
+                         astronomy::J2000,
+                         DefaultPsychohistoryParameters(),
+                         DefaultHistoryParameters(),
+                         &ephemeris,
+                         deletion_callback_.AsStdFunction());
+  DegreesOfFreedom<ApparentBubble> const degrees_of_freedom(
+      ApparentBubble::origin, Velocity<ApparentBubble>());
+
+  double const free_fall_cost = pile_up.EstimatedCatchUpCost();
+
+  // A pile-up in the bubble costs more, because it is deformed and nudged.
+  pile_up.SetPartApparentDegreesOfFreedom(&p1_, degrees_of_freedom);
+  pile_up.SetPartApparentDegreesOfFreedom(&p2_, degrees_of_freedom);
+  double const free_fall_in_bubble_cost = pile_up.EstimatedCatchUpCost();
+  EXPECT_LT(free_fall_cost, free_fall_in_bubble_cost);
+
+  // Once deformed, the pile-up is no longer expected to be deformed and nudged.
+  pile_up.DeformPileUpIfNeeded();
+  EXPECT_EQ(free_fall_cost, pile_up.EstimatedCatchUpCost());
+
+  // The adaptive integration of a pile-up under thrust dominates the cost of
+  // a pile-up in free fall, even in the bubble.
+  pile_up.set_intrinsic_force(
+      Vector<Force, Barycentric>({1 * Newton, 2 * Newton, 3 * Newton}));
+  double const intrinsic_force_cost = pile_up.EstimatedCatchUpCost();
+  EXPECT_LT(free_fall_in_bubble_cost, intrinsic_force_cost);
+
+  pile_up.SetPartApparentDegreesOfFreedom(&p1_, degrees_of_freedom);
+  pile_up.SetPartApparentDegreesOfFreedom(&p2_, degrees_of_freedom);
+  EXPECT_LT(intrinsic_force_cost, pile_up.EstimatedCatchUpCost());
+}
+
 TEST_F(PileUpTest, Serialization) {
   MockEphemeris<Barycentric> ephemeris;
   p1_.increment_intrinsic_force(
@@ -607,7 +717,7 @@ TEST_F(PileUpTest, Serialization) {
   EXPECT_EQ(2, message.part_id_size());
   EXPECT_EQ(part_id1_, message.part_id(0));
   EXPECT_EQ(part_id2_, message.part_id(1));
-  EXPECT_EQ(1, message.history().timeline_size());
+  EXPECT_TRUE(message.history().has_compressed_timeline());
   EXPECT_EQ(2, message.actual_part_degrees_of_freedom().size());
   EXPECT_TRUE(message.apparent_part_degrees_of_freedom().empty());
 
@@ -650,7 +760,7 @@ TEST_F(PileUpTest, SerializationCompatibility) {
 
   // Clear the children to simulate pre-Cesàro serialization.
   message.mutable_history()->clear_children();
-  EXPECT_EQ(1, message.history().timeline_size());
+  EXPECT_TRUE(message.history().has_compressed_timeline());
 
   auto const part_id_to_part = [this](PartId const part_id) {
     if (part_id == part_id1_) {
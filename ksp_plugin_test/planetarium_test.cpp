@@ -57,6 +57,7 @@ using quantities::si::ArcMinute;
 using quantities::si::Degree;
 using quantities::si::Kilogram;
 using quantities::si::Metre;
+using quantities::si::Milli;
 using quantities::si::Radian;
 using quantities::si::Second;
 using testing_utilities::AlmostEquals;
@@ -239,6 +240,63 @@ TEST_F(PlanetariumTest, PlotMethod2) {
   }
 }
 
+TEST_F(PlanetariumTest, PlotMethod3) {
+  // A quarter of a circular trajectory around the origin, with many small
+  // segments.
+  auto const discrete_trajectory =
+      NewCircularTrajectory(/*period=*/100'000 * Second,
+                            /*step=*/1 * Second,
+                            /*last=*/25'000 * Second);
+  // The plotting frame is the identity.
+  TrajectoryLevelsOfDetail levels_of_detail(
+      /*finest_tolerance=*/1 * Milli(Metre),
+      /*tolerance_ratio=*/4,
+      /*number_of_levels=*/8);
+  for (auto it = discrete_trajectory->Begin();
+       it != discrete_trajectory->End();
+       ++it) {
+    levels_of_detail.Append(
+        it.time(),
+        Navigation::origin +
+            Displacement<Navigation>((it.degrees_of_freedom().position() -
+                                      Barycentric::origin).coordinates()));
+  }
+
+  // No dark area, human visual acuity, wide field of view.
+  Planetarium::Parameters parameters(
+      /*sphere_radius_multiplier=*/1,
+      /*angular_resolution=*/0.4 * ArcMinute,
+      /*field_of_view=*/90 * Degree);
+  Planetarium planetarium(
+      parameters, perspective_, &ephemeris_, &plotting_frame_);
+  auto const rp2_lines =
+      planetarium.PlotMethod3(discrete_trajectory->Begin(),
+                              discrete_trajectory->End(),
+                              levels_of_detail,
+                              t0_ + 10 * Second,
+                              /*reverse=*/false);
+  auto const reversed_rp2_lines =
+      planetarium.PlotMethod3(discrete_trajectory->Begin(),
+                              discrete_trajectory->End(),
+                              levels_of_detail,
+                              t0_ + 10 * Second,
+                              /*reverse=*/true);
+
+  // The trajectory starts at {0, 10, 0}, which projects to the centre of the
+  // screen, and ends at {10, 0, 0}, which projects at x = 2.5 m.  The reversed
+  // line has the same points in the opposite order.
+  EXPECT_THAT(rp2_lines, SizeIs(1));
+  EXPECT_THAT(reversed_rp2_lines, SizeIs(1));
+  ASSERT_THAT(reversed_rp2_lines[0], SizeIs(rp2_lines[0].size()));
+  EXPECT_THAT(rp2_lines[0].front().x(), VanishesBefore(1 * Metre, 0, 14));
+  EXPECT_THAT(rp2_lines[0].back().x(),
+              AllOf(Ge(2.49 * Metre), Le(2.51 * Metre)));
+  for (int i = 0; i < rp2_lines[0].size(); ++i) {
+    EXPECT_EQ(rp2_lines[0][i],
+              reversed_rp2_lines[0][rp2_lines[0].size() - 1 - i]);
+  }
+}
+
 #if !defined(_DEBUG)
 TEST_F(PlanetariumTest, RealSolarSystem) {
   auto discrete_trajectory = DiscreteTrajectory<Barycentric>::ReadFromMessage(
@@ -453,11 +453,15 @@ TEST_F(PluginTest, Serialization) {
   EXPECT_EQ(SolarSystemFactory::Earth, message.vessel(0).parent_index());
   EXPECT_TRUE(message.vessel(0).vessel().has_flight_plan());
   EXPECT_TRUE(message.vessel(0).vessel().has_history());
-  auto const& vessel_0_history = message.vessel(0).vessel().history();
-  EXPECT_EQ(4, vessel_0_history.timeline_size());
-  Instant const t0 =
-      Instant() +
-      vessel_0_history.timeline(0).instant().scalar().magnitude() * Second;
+  // Drop the forks, we only look at the points of the history.
+  auto vessel_0_history_message = message.vessel(0).vessel().history();
+  vessel_0_history_message.clear_children();
+  vessel_0_history_message.clear_fork_position();
+  auto const vessel_0_history =
+      DiscreteTrajectory<Barycentric>::ReadFromMessage(vessel_0_history_message,
+                                                       /*forks=*/{});
+  EXPECT_EQ(4, vessel_0_history->Size());
+  Instant const t0 = vessel_0_history->Begin().time();
   EXPECT_THAT(t0,
               AllOf(Gt(HistoryTime(time, 3) - step), Le(HistoryTime(time, 3))));
   EXPECT_TRUE(message.has_renderer());
@@ -1014,6 +1018,73 @@ TEST_F(PluginTest, VesselInsertionAtInitialization) {
                     AlmostEquals(satellite_initial_velocity_, 6)));
 }
 
+// The pile-up of an unloaded vessel that is alone in it is kept across frames,
+// with its mass and intrinsic force refreshed, until a collision is reported.
+TEST_F(PluginTest, UnperturbedUnloadedVessel) {
+  GUID const guid = "Test Satellite";
+  PartId const part_id = 666;
+  InsertAllSolarSystemBodies();
+  plugin_->EndInitialization();
+  Instant const initial_time = ParseTT(initial_time_);
+  EXPECT_CALL(plugin_->mock_ephemeris(), Prolong(initial_time))
+      .Times(AnyNumber());
+
+  bool inserted;
+  plugin_->InsertOrKeepVessel(guid,
+                              "v" + guid,
+                              SolarSystemFactory::Earth,
+                              /*loaded=*/false,
+                              inserted);
+  EXPECT_TRUE(inserted);
+  plugin_->InsertUnloadedPart(
+      part_id,
+      "part",
+      guid,
+      RelativeDegreesOfFreedom<AliceSun>(satellite_initial_displacement_,
+                                         satellite_initial_velocity_));
+  plugin_->PrepareToReportCollisions();
+  plugin_->FreeVesselsAndPartsAndCollectPileUps(20 * Milli(Second));
+  not_null<Part*> const part = plugin_->GetVessel(guid)->part(part_id);
+  PileUp* const pile_up = part->containing_pile_up();
+  ASSERT_THAT(pile_up, Ne(nullptr));
+
+  // Change the mass and the intrinsic force of the part behind the back of the
+  // plugin, and run another frame.
+  Mass const mass = 3 * Kilogram;
+  Vector<Force, Barycentric> const intrinsic_force({1 * Newton,
+                                                    2 * Newton,
+                                                    3 * Newton});
+  part->set_mass(mass);
+  part->increment_intrinsic_force(intrinsic_force);
+  plugin_->InsertOrKeepVessel(guid,
+                              "v" + guid,
+                              SolarSystemFactory::Earth,
+                              /*loaded=*/false,
+                              inserted);
+  EXPECT_FALSE(inserted);
+  plugin_->PrepareToReportCollisions();
+  plugin_->FreeVesselsAndPartsAndCollectPileUps(20 * Milli(Second));
+  EXPECT_EQ(pile_up, part->containing_pile_up());
+  serialization::PileUp message;
+  pile_up->WriteToMessage(&message);
+  EXPECT_EQ(mass, Mass::ReadFromMessage(message.mass()));
+  EXPECT_EQ(intrinsic_force,
+            Vector<Force, Barycentric>::ReadFromMessage(
+                message.intrinsic_force()));
+
+  // A collision with the ground goes through the union-find, which finds the
+  // vessel grounded and destroys it.
+  plugin_->InsertOrKeepVessel(guid,
+                              "v" + guid,
+                              SolarSystemFactory::Earth,
+                              /*loaded=*/false,
+                              inserted);
+  plugin_->PrepareToReportCollisions();
+  plugin_->ReportGroundCollision(part_id);
+  plugin_->FreeVesselsAndPartsAndCollectPileUps(20 * Milli(Second));
+  EXPECT_FALSE(plugin_->HasVessel(guid));
+}
+
 TEST_F(PluginTest, UpdateCelestialHierarchy) {
   InsertAllSolarSystemBodies();
   plugin_->EndInitialization();
@@ -1,6 +1,7 @@
 
 #include "ksp_plugin/renderer.hpp"
 
+#include "astronomy/epoch.hpp"
 #include "base/not_null.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/named_quantities.hpp"
@@ -23,6 +24,8 @@ namespace principia {
 namespace ksp_plugin {
 namespace internal_renderer {
 
+using astronomy::InfiniteFuture;
+using astronomy::InfinitePast;
 using base::not_null;
 using geometry::AngularVelocity;
 using geometry::Bivector;
@@ -146,6 +149,11 @@ TEST_F(RendererTest, RenderBarycentricTrajectoryInPlottingWithoutTargetVessel) {
       renderer_.RenderBarycentricTrajectoryInPlotting(
           trajectory_to_render.Begin(),
           trajectory_to_render.End());
+  // The motions are cached, so rendering again doesn't evaluate the frame.
+  EXPECT_EQ(10,
+            renderer_.RenderBarycentricTrajectoryInPlotting(
+                trajectory_to_render.Begin(),
+                trajectory_to_render.End())->Size());
 
   EXPECT_EQ(10, rendered_trajectory->Size());
   int index = 0;
@@ -307,6 +315,54 @@ TEST_F(RendererTest, RenderPlottingTrajectoryInWorldWithoutTargetVessel) {
   }
 }
 
+TEST_F(RendererTest, LevelsOfDetailInPlotting) {
+  MockVessel vessel;
+  DiscreteTrajectory<Barycentric> psychohistory;
+  FillTrajectory<Barycentric>(
+      /*time=*/t0_,
+      /*step=*/1 * Second,
+      /*number_of_steps=*/5,
+      /*position_function=*/
+          [this](Instant const& t) {
+            return Barycentric::origin +
+                   (t - t0_) * Velocity<Barycentric>({6 * Metre / Second,
+                                                      5 * Metre / Second,
+                                                      4 * Metre / Second});
+          },
+      /*velocity_function=*/
+          [](Instant const& t) {
+            return Velocity<Barycentric>(
+                {6 * Metre / Second, 5 * Metre / Second, 4 * Metre / Second});
+          },
+      psychohistory);
+  EXPECT_CALL(vessel, psychohistory())
+      .WillRepeatedly(ReturnRef(psychohistory));
+  EXPECT_CALL(*dynamic_frame_, t_min()).WillRepeatedly(Return(InfinitePast));
+  EXPECT_CALL(*dynamic_frame_, t_max()).WillRepeatedly(Return(InfiniteFuture));
+
+  RigidMotion<Barycentric, Navigation> rigid_motion(
+      RigidTransformation<Barycentric, Navigation>::Identity(),
+      AngularVelocity<Barycentric>(),
+      Velocity<Barycentric>());
+  // Each point is converted once before and once after the levels of detail
+  // are forgotten.
+  for (Instant t = t0_; t < t0_ + 5 * Second; t += 1 * Second) {
+    EXPECT_CALL(*dynamic_frame_, ToThisFrameAtTime(t))
+        .Times(2)
+        .WillRepeatedly(Return(rigid_motion));
+  }
+
+  EXPECT_EQ(t0_ + 4 * Second,
+            renderer_.LevelsOfDetailInPlotting(&vessel).last_time());
+  // The levels of detail are kept from one call to the next.
+  EXPECT_EQ(t0_ + 4 * Second,
+            renderer_.LevelsOfDetailInPlotting(&vessel).last_time());
+  renderer_.ForgetLevelsOfDetail(&vessel);
+  auto const& levels_of_detail = renderer_.LevelsOfDetailInPlotting(&vessel);
+  EXPECT_EQ(t0_, levels_of_detail.first_time());
+  EXPECT_EQ(t0_ + 4 * Second, levels_of_detail.last_time());
+}
+
 TEST_F(RendererTest, Serialization) {
   serialization::Renderer message;
   EXPECT_CALL(*dynamic_frame_, WriteToMessage(_));
@@ -0,0 +1,185 @@
+#include "ksp_plugin/trajectory_levels_of_detail.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "geometry/grassmann.hpp"
+#include "geometry/named_quantities.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/numbers.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace internal_trajectory_levels_of_detail {
+
+using geometry::Displacement;
+using geometry::InnerProduct;
+using quantities::Angle;
+using quantities::Cos;
+using quantities::Sin;
+using quantities::Time;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Minute;
+using quantities::si::Radian;
+using quantities::si::Second;
+using ::testing::Eq;
+using ::testing::Ge;
+using ::testing::Le;
+using ::testing::Lt;
+using ::testing::SizeIs;
+
+class TrajectoryLevelsOfDetailTest : public ::testing::Test {
+ protected:
+  TrajectoryLevelsOfDetailTest()
+      : levels_of_detail_(/*finest_tolerance=*/10 * Metre,
+                          /*tolerance_ratio=*/4,
+                          /*number_of_levels=*/8) {
+    // Three revolutions of a circle of radius 1000 km.
+    Time const period = 90 * Minute;
+    for (int i = 0; i < number_of_points; ++i) {
+      Time const t = i * 3 * period / number_of_points;
+      Angle const ɑ = 2 * π * Radian * (t / period);
+      times_.push_back(t0_ + t);
+      positions_.push_back(
+          Navigation::origin +
+          Displacement<Navigation>({1000 * Kilo(Metre) * Cos(ɑ),
+                                    1000 * Kilo(Metre) * Sin(ɑ),
+                                    0 * Metre}));
+    }
+  }
+
+  // The distance between |point| and the given |polyline|.
+  static Length DistanceToPolyline(
+      Position<Navigation> const& point,
+      std::vector<Position<Navigation>> const& polyline) {
+    Length distance = std::numeric_limits<double>::infinity() * Metre;
+    for (int i = 1; i < polyline.size(); ++i) {
+      Displacement<Navigation> const segment = polyline[i] - polyline[i - 1];
+      Displacement<Navigation> const from_first = point - polyline[i - 1];
+      double const λ = std::clamp(
+          InnerProduct(from_first, segment) / segment.Norm²(), 0.0, 1.0);
+      distance = std::min(distance, (from_first - λ * segment).Norm());
+    }
+    return distance;
+  }
+
+  static constexpr int number_of_points = 3000;
+  Instant const t0_;
+  std::vector<Instant> times_;
+  std::vector<Position<Navigation>> positions_;
+  TrajectoryLevelsOfDetail levels_of_detail_;
+};
+
+TEST_F(TrajectoryLevelsOfDetailTest, Empty) {
+  EXPECT_TRUE(levels_of_detail_.empty());
+  levels_of_detail_.Append(times_[0], positions_[0]);
+  EXPECT_FALSE(levels_of_detail_.empty());
+  EXPECT_EQ(times_[0], levels_of_detail_.first_time());
+  EXPECT_EQ(times_[0], levels_of_detail_.last_time());
+  auto const polyline = levels_of_detail_.Polyline(1 * Kilo(Metre));
+  ASSERT_TRUE(polyline.has_value());
+  EXPECT_THAT(*polyline, SizeIs(1));
+}
+
+TEST_F(TrajectoryLevelsOfDetailTest, Polyline) {
+  for (int i = 0; i < number_of_points; ++i) {
+    levels_of_detail_.Append(times_[i], positions_[i]);
+  }
+  EXPECT_EQ(times_.front(), levels_of_detail_.first_time());
+  EXPECT_EQ(times_.back(), levels_of_detail_.last_time());
+
+  // No level is accurate enough.
+  EXPECT_FALSE(levels_of_detail_.Polyline(5 * Metre).has_value());
+
+  std::size_t previous_size = number_of_points;
+  for (Length tolerance = 20 * Metre;
+       tolerance < 1000 * Kilo(Metre);
+       tolerance *= 4) {
+    auto const polyline = levels_of_detail_.Polyline(tolerance);
+    ASSERT_TRUE(polyline.has_value());
+    EXPECT_THAT(polyline->size(), Le(previous_size));
+    previous_size = polyline->size();
+    EXPECT_EQ(positions_.front(), polyline->front());
+    EXPECT_EQ(positions_.back(), polyline->back());
+    for (auto const& position : positions_) {
+      EXPECT_THAT(DistanceToPolyline(position, *polyline), Le(tolerance))
+          << tolerance;
+    }
+  }
+  // The coarsest levels are much simpler than the trajectory.
+  EXPECT_THAT(previous_size, Lt(number_of_points / 10));
+}
+
+TEST_F(TrajectoryLevelsOfDetailTest, ForgetBefore) {
+  for (int i = 0; i < number_of_points; ++i) {
+    levels_of_detail_.Append(times_[i], positions_[i]);
+  }
+  Length const tolerance = 1 * Kilo(Metre);
+  std::size_t const size_before = levels_of_detail_.Polyline(tolerance)->size();
+
+  // Forget the first revolution.
+  int const first_kept = number_of_points / 3;
+  levels_of_detail_.ForgetBefore(times_[first_kept]);
+  EXPECT_THAT(levels_of_detail_.first_time(), Le(times_[first_kept]));
+  EXPECT_THAT(levels_of_detail_.first_time(), Ge(times_[first_kept - 100]));
+  EXPECT_EQ(times_.back(), levels_of_detail_.last_time());
+
+  auto const polyline = levels_of_detail_.Polyline(tolerance);
+  ASSERT_TRUE(polyline.has_value());
+  EXPECT_THAT(polyline->size(), Lt(size_before));
+  EXPECT_EQ(positions_.back(), polyline->back());
+  for (int i = first_kept; i < number_of_points; ++i) {
+    EXPECT_THAT(DistanceToPolyline(positions_[i], *polyline), Le(tolerance));
+  }
+
+  // Forgetting again at the same time has no effect.
+  levels_of_detail_.ForgetBefore(times_[first_kept]);
+  EXPECT_THAT(*levels_of_detail_.Polyline(tolerance), Eq(*polyline));
+}
+
+TEST_F(TrajectoryLevelsOfDetailTest, PolylineSeenFromCamera) {
+  for (int i = 0; i < number_of_points; ++i) {
+    levels_of_detail_.Append(times_[i], positions_[i]);
+  }
+  double const tan_angular_resolution = 1e-3;
+
+  // The camera is at the centre of the circle, inside its bounding box.
+  auto const polyline =
+      levels_of_detail_.Polyline(Navigation::origin, tan_angular_resolution);
+  ASSERT_TRUE(polyline.has_value());
+  EXPECT_THAT(polyline->size(), Lt(number_of_points / 10));
+  EXPECT_EQ(positions_.back(), polyline->back());
+  for (auto const& position : positions_) {
+    EXPECT_THAT(DistanceToPolyline(position, *polyline),
+                Le(tan_angular_resolution *
+                   (position - Navigation::origin).Norm()));
+  }
+
+  // Further away, a coarser level is good enough.
+  Position<Navigation> const far_camera =
+      Navigation::origin + Displacement<Navigation>({0 * Metre,
+                                                     0 * Metre,
+                                                     5000 * Kilo(Metre)});
+  auto const far_polyline =
+      levels_of_detail_.Polyline(far_camera, tan_angular_resolution);
+  ASSERT_TRUE(far_polyline.has_value());
+  EXPECT_THAT(far_polyline->size(), Lt(polyline->size()));
+  for (auto const& position : positions_) {
+    EXPECT_THAT(DistanceToPolyline(position, *far_polyline),
+                Le(tan_angular_resolution * (position - far_camera).Norm()));
+  }
+
+  // No level is accurate enough for a camera on the trajectory.
+  EXPECT_FALSE(levels_of_detail_.Polyline(positions_[number_of_points / 2],
+                                          tan_angular_resolution)
+                   .has_value());
+}
+
+}  // namespace internal_trajectory_levels_of_detail
+}  // namespace ksp_plugin
+}  // namespace principia
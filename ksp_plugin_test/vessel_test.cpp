@@ -4,6 +4,7 @@
 #include <limits>
 #include <set>
 
+#include "absl/synchronization/notification.h"
 #include "astronomy/epoch.hpp"
 #include "base/not_null.hpp"
 #include "base/status.hpp"
@@ -23,6 +24,7 @@ namespace principia {
 namespace ksp_plugin {
 namespace internal_vessel {
 
+using base::Error;
 using base::make_not_null_unique;
 using base::Status;
 using geometry::Displacement;
@@ -42,6 +44,7 @@ using testing_utilities::EqualsProto;
 using ::testing::AnyNumber;
 using ::testing::DoAll;
 using ::testing::ElementsAre;
+using ::testing::InvokeWithoutArgs;
 using ::testing::MockFunction;
 using ::testing::Return;
 using ::testing::_;
@@ -399,6 +402,245 @@ TEST_F(VesselTest, FlightPlan) {
   EXPECT_FALSE(vessel_.has_flight_plan());
 }
 
+TEST_F(VesselTest, FlightPlanMutation) {
+  // These mutations must run on another thread even in debug mode.
+  Vessel::MakeAsynchronous();
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(astronomy::J2000 + 2 * Second));
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 3 * Second, _, _, _))
+      .WillOnce(Return(Status::OK));
+  vessel_.PrepareHistory(astronomy::J2000);
+  vessel_.CreateFlightPlan(astronomy::J2000 + 3 * Second,
+                           10 * Kilogram,
+                           DefaultPredictionParameters(),
+                           DefaultBurnParameters());
+
+  // No mutation.
+  EXPECT_OK(vessel_.PollFlightPlanMutation());
+
+  // The mutation blocks in the integration until we let it proceed.
+  absl::Notification proceed;
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 4 * Second, _, _, _))
+      .WillOnce(InvokeWithoutArgs([&proceed]() {
+        proceed.WaitForNotification();
+        return Status::OK;
+      }));
+  vessel_.MutateFlightPlanAsynchronously([](FlightPlan& flight_plan) {
+    return flight_plan.SetDesiredFinalTime(astronomy::J2000 + 4 * Second);
+  });
+  EXPECT_EQ(Error::UNAVAILABLE, vessel_.PollFlightPlanMutation().error());
+  EXPECT_EQ(astronomy::J2000 + 3 * Second,
+            vessel_.flight_plan().desired_final_time());
+
+  proceed.Notify();
+  Status status;
+  do {
+    status = vessel_.PollFlightPlanMutation();
+  } while (status.error() == Error::UNAVAILABLE);
+  EXPECT_OK(status);
+  EXPECT_EQ(astronomy::J2000 + 4 * Second,
+            vessel_.flight_plan().desired_final_time());
+  EXPECT_OK(vessel_.PollFlightPlanMutation());
+  Vessel::MakeSynchronous();
+}
+
+TEST_F(VesselTest, SupersededFlightPlanMutation) {
+  // These mutations must run on another thread even in debug mode.
+  Vessel::MakeAsynchronous();
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(astronomy::J2000 + 2 * Second));
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 3 * Second, _, _, _))
+      .WillOnce(Return(Status::OK));
+  vessel_.PrepareHistory(astronomy::J2000);
+  vessel_.CreateFlightPlan(astronomy::J2000 + 3 * Second,
+                           10 * Kilogram,
+                           DefaultPredictionParameters(),
+                           DefaultBurnParameters());
+
+  // The first mutation integrates twice, but it is superseded while in the
+  // first integration, so the second one never happens.
+  absl::Notification started;
+  absl::Notification proceed;
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 4 * Second, _, _, _))
+      .WillOnce(InvokeWithoutArgs([&started, &proceed]() {
+        started.Notify();
+        proceed.WaitForNotification();
+        return Status::OK;
+      }));
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 5 * Second, _, _, _))
+      .Times(0);
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 6 * Second, _, _, _))
+      .WillOnce(Return(Status::OK));
+  Status first_mutation_status;
+  vessel_.MutateFlightPlanAsynchronously(
+      [&first_mutation_status](FlightPlan& flight_plan) {
+        first_mutation_status =
+            flight_plan.SetDesiredFinalTime(astronomy::J2000 + 4 * Second);
+        first_mutation_status.Update(
+            flight_plan.SetDesiredFinalTime(astronomy::J2000 + 5 * Second));
+        return first_mutation_status;
+      });
+  started.WaitForNotification();
+  vessel_.MutateFlightPlanAsynchronously([](FlightPlan& flight_plan) {
+    return flight_plan.SetDesiredFinalTime(astronomy::J2000 + 6 * Second);
+  });
+
+  proceed.Notify();
+  Status status;
+  do {
+    status = vessel_.PollFlightPlanMutation();
+  } while (status.error() == Error::UNAVAILABLE);
+  EXPECT_OK(status);
+  EXPECT_EQ(Error::CANCELLED, first_mutation_status.error());
+  EXPECT_EQ(astronomy::J2000 + 6 * Second,
+            vessel_.flight_plan().desired_final_time());
+  Vessel::MakeSynchronous();
+}
+
+TEST_F(VesselTest, ConcurrentFlightPlanMutations) {
+  // These mutations must run on another thread even in debug mode.
+  Vessel::MakeAsynchronous();
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(astronomy::J2000 + 2 * Second));
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 3 * Second, _, _, _))
+      .WillOnce(Return(Status::OK));
+  vessel_.PrepareHistory(astronomy::J2000);
+  vessel_.CreateFlightPlan(astronomy::J2000 + 3 * Second,
+                           10 * Kilogram,
+                           DefaultPredictionParameters(),
+                           DefaultBurnParameters());
+  std::int64_t const max_steps =
+      vessel_.flight_plan().adaptive_step_parameters().max_steps();
+
+  // The asynchronous mutation changes the final time, the synchronous one
+  // changes the parameters and recomputes the flight plan.
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 4 * Second, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(Status::OK));
+  vessel_.MutateFlightPlanAsynchronously([](FlightPlan& flight_plan) {
+    return flight_plan.SetDesiredFinalTime(astronomy::J2000 + 4 * Second);
+  });
+  EXPECT_OK(vessel_.MutateFlightPlan(
+      [max_steps](FlightPlan& flight_plan) {
+        auto adaptive_step_parameters = flight_plan.adaptive_step_parameters();
+        adaptive_step_parameters.set_max_steps(max_steps + 1);
+        return flight_plan.SetAdaptiveStepParameters(
+            adaptive_step_parameters,
+            flight_plan.generalized_adaptive_step_parameters());
+      }));
+
+  // Both edits are in the flight plan, and the asynchronous mutation has been
+  // published.
+  EXPECT_EQ(astronomy::J2000 + 4 * Second,
+            vessel_.flight_plan().desired_final_time());
+  EXPECT_EQ(max_steps + 1,
+            vessel_.flight_plan().adaptive_step_parameters().max_steps());
+  EXPECT_OK(vessel_.PollFlightPlanMutation());
+  Vessel::MakeSynchronous();
+}
+
+// Checks that forgetting the history while a mutation is in progress doesn't
+// cancel the mutation, and that its result is forgotten when published.
+TEST_F(VesselTest, ForgetBeforeDuringFlightPlanMutation) {
+  Vessel::MakeAsynchronous();
+  DegreesOfFreedom<Barycentric> const degrees_of_freedom(
+      Barycentric::origin, Velocity<Barycentric>());
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(astronomy::J2000 + 2 * Second));
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 3 * Second, _, _, _))
+      .WillOnce(DoAll(AppendToDiscreteTrajectory(astronomy::J2000 + 3 * Second,
+                                                 degrees_of_freedom),
+                      Return(Status::OK)));
+  vessel_.PrepareHistory(astronomy::J2000);
+  vessel_.CreateFlightPlan(astronomy::J2000 + 3 * Second,
+                           10 * Kilogram,
+                           DefaultPredictionParameters(),
+                           DefaultBurnParameters());
+
+  absl::Notification started;
+  absl::Notification proceed;
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 4 * Second, _, _, _))
+      .WillOnce(DoAll(InvokeWithoutArgs([&started, &proceed]() {
+                        started.Notify();
+                        proceed.WaitForNotification();
+                      }),
+                      AppendToDiscreteTrajectory(astronomy::J2000 + 4 * Second,
+                                                 degrees_of_freedom),
+                      Return(Status::OK)));
+  vessel_.MutateFlightPlanAsynchronously([](FlightPlan& flight_plan) {
+    return flight_plan.SetDesiredFinalTime(astronomy::J2000 + 4 * Second);
+  });
+  started.WaitForNotification();
+
+  // The current flight plan is forgotten at once.
+  vessel_.ForgetBefore(astronomy::J2000 + 1 * Second);
+  EXPECT_EQ(astronomy::J2000 + 3 * Second,
+            vessel_.flight_plan().initial_time());
+
+  proceed.Notify();
+  Status status;
+  do {
+    status = vessel_.PollFlightPlanMutation();
+  } while (status.error() == Error::UNAVAILABLE);
+  EXPECT_OK(status);
+
+  // The mutated flight plan is forgotten when published.
+  EXPECT_EQ(astronomy::J2000 + 3 * Second,
+            vessel_.flight_plan().initial_time());
+  EXPECT_EQ(astronomy::J2000 + 4 * Second,
+            vessel_.flight_plan().desired_final_time());
+  Vessel::MakeSynchronous();
+}
+
+TEST_F(VesselTest, SynchronousFlightPlanMutation) {
+  Vessel::MakeSynchronous();
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(astronomy::J2000 + 2 * Second));
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 3 * Second, _, _, _))
+      .WillOnce(Return(Status::OK));
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 4 * Second, _, _, _))
+      .WillOnce(Return(Status(Error::OUT_OF_RANGE, "Too far")));
+  vessel_.PrepareHistory(astronomy::J2000);
+  vessel_.CreateFlightPlan(astronomy::J2000 + 3 * Second,
+                           10 * Kilogram,
+                           DefaultPredictionParameters(),
+                           DefaultBurnParameters());
+
+  // The mutation is published immediately and its status is returned by the
+  // first poll.
+  vessel_.MutateFlightPlanAsynchronously([](FlightPlan& flight_plan) {
+    return flight_plan.SetDesiredFinalTime(astronomy::J2000 + 4 * Second);
+  });
+  EXPECT_EQ(astronomy::J2000 + 4 * Second,
+            vessel_.flight_plan().desired_final_time());
+  EXPECT_EQ(Error::OUT_OF_RANGE, vessel_.PollFlightPlanMutation().error());
+  EXPECT_OK(vessel_.PollFlightPlanMutation());
+}
+
 TEST_F(VesselTest, SerializationSuccess) {
   MockFunction<int(not_null<PileUp const*>)>
       serialization_index_for_pile_up;
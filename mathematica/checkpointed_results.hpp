@@ -0,0 +1,69 @@
+﻿
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "base/file.hpp"
+
+namespace principia {
+namespace mathematica {
+namespace internal_checkpointed_results {
+
+using base::OFStream;
+
+// A Mathematica file to which the results of independent computations are
+// written as soon as they complete, so that a long run may be inspected while
+// it progresses.  Each result is a list of numbers, and is assigned to a part
+// of the variable |name|, which is a list of |size| elements, initially
+// |Missing[]|.  If the file already exists, the results that it contains are
+// read back, so that an interrupted run may be resumed.  The file starts with
+// the given |preamble|, which must match that of an existing file, so it must
+// describe all the parameters of the computation.  The file should be deleted
+// once the run completes, so that subsequent runs don't use stale results.
+// This class is thread-safe.
+class CheckpointedResults final {
+ public:
+  CheckpointedResults(std::filesystem::path const& path,
+                      std::string const& preamble,
+                      std::string const& name,
+                      int size);
+
+  // Returns the result at |index| if it has been read from the file or
+  // written, or nullopt otherwise.
+  std::optional<std::vector<double>> Find(int index) const;
+
+  // Writes the result at |index| to the file.
+  void Write(int index, std::vector<double> const& values);
+
+  // Deletes the file.  No other member function may be called afterwards.
+  void Delete();
+
+ private:
+  // Parses a |line| produced by |Write|.  Returns false if |line| is
+  // incomplete, which happens if the run was interrupted while writing it.
+  bool Parse(std::string const& line,
+             int& index,
+             std::vector<double>& values) const;
+
+  std::filesystem::path const path_;
+  std::string const name_;
+  int const size_;
+
+  mutable absl::Mutex lock_;
+  std::map<int, std::vector<double>> results_ GUARDED_BY(lock_);
+  OFStream file_ GUARDED_BY(lock_);
+};
+
+}  // namespace internal_checkpointed_results
+
+using internal_checkpointed_results::CheckpointedResults;
+
+}  // namespace mathematica
+}  // namespace principia
+
+#include "mathematica/checkpointed_results_body.hpp"
@@ -0,0 +1,173 @@
+﻿
+#pragma once
+
+#include "mathematica/checkpointed_results.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "mathematica/mathematica.hpp"
+
+namespace principia {
+namespace mathematica {
+namespace internal_checkpointed_results {
+
+inline CheckpointedResults::CheckpointedResults(
+    std::filesystem::path const& path,
+    std::string const& preamble,
+    std::string const& name,
+    int const size)
+    : path_(path),
+      name_(name),
+      size_(size) {
+  std::string contents =
+      preamble +
+      Assign(name_, Apply("ConstantArray", {"Missing[]",
+                                            std::to_string(size_)}));
+  if (std::filesystem::exists(path)) {
+    std::ifstream stream(path);
+    CHECK(stream.good()) << path;
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    std::string const existing = buffer.str();
+    CHECK(existing.compare(0, contents.size(), contents) == 0)
+        << path << " was produced by a different computation; delete it to "
+        << "start over";
+
+    // The file is rewritten without the incomplete lines, if any.
+    absl::MutexLock l(&lock_);
+    std::istringstream lines(existing.substr(contents.size()));
+    for (std::string line; std::getline(lines, line);) {
+      int index;
+      std::vector<double> values;
+      if (Parse(line, index, values)) {
+        results_.emplace(index, std::move(values));
+        contents += line + "\n";
+      }
+    }
+    LOG(INFO) << "Resuming from " << results_.size() << " results in "
+              << path;
+  }
+  // Write the new file next to the old one and replace it, so that a crash
+  // doesn't lose the existing results.
+  std::filesystem::path temporary_path = path;
+  temporary_path += ".tmp";
+  {
+    OFStream temporary_file(temporary_path);
+    temporary_file << contents;
+  }
+  std::filesystem::rename(temporary_path, path);
+  absl::MutexLock l(&lock_);
+  file_ = OFStream(path, std::ios::app);
+}
+
+inline std::optional<std::vector<double>> CheckpointedResults::Find(
+    int const index) const {
+  absl::ReaderMutexLock l(&lock_);
+  auto const it = results_.find(index);
+  if (it == results_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+inline void CheckpointedResults::Write(int const index,
+                                       std::vector<double> const& values) {
+  CHECK_LE(0, index);
+  CHECK_LT(index, size_);
+  std::string const line =
+      Assign(name_ + "[[" + std::to_string(index + 1) + "]]", values);
+  absl::MutexLock l(&lock_);
+  results_[index] = values;
+  file_ << line;
+  file_.Flush();
+}
+
+inline void CheckpointedResults::Delete() {
+  absl::MutexLock l(&lock_);
+  // Close the file before deleting it.
+  file_ = OFStream();
+  std::filesystem::remove(path_);
+}
+
+inline bool CheckpointedResults::Parse(std::string const& line,
+                                       int& index,
+                                       std::vector<double>& values) const {
+  // The |line| has the form
+  //   Set[name[[i]],List[SetPrecision[x,$MachinePrecision],...]];
+  // where the elements may also be Infinity, Minus[Infinity], or
+  // Indeterminate, see |ToMathematica|.
+  std::string const prefix = "Set[" + name_ + "[[";
+  std::string const infix = "]],List[";
+  std::string const suffix = "]];";
+  if (line.compare(0, prefix.size(), prefix) != 0 ||
+      line.size() < prefix.size() + suffix.size() ||
+      line.compare(line.size() - suffix.size(), suffix.size(), suffix) != 0) {
+    return false;
+  }
+  std::size_t const infix_begin = line.find(infix, prefix.size());
+  if (infix_begin == std::string::npos) {
+    return false;
+  }
+  index = std::atoi(line.substr(prefix.size(),
+                                infix_begin - prefix.size()).c_str()) - 1;
+  if (index < 0 || index >= size_) {
+    return false;
+  }
+
+  std::string const precision = "SetPrecision[";
+  std::string const machine_precision = ",$MachinePrecision]";
+  std::size_t position = infix_begin + infix.size();
+  std::size_t const end = line.size() - suffix.size();
+  values.clear();
+  while (position < end) {
+    if (line.compare(position, precision.size(), precision) == 0) {
+      position += precision.size();
+      std::size_t const number_end = line.find(machine_precision, position);
+      if (number_end == std::string::npos) {
+        return false;
+      }
+      std::string number = line.substr(position, number_end - position);
+      std::size_t const exponent = number.find("*^");
+      if (exponent != std::string::npos) {
+        number.replace(exponent, 2, "e");
+      }
+      values.push_back(std::strtod(number.c_str(), nullptr));
+      position = number_end + machine_precision.size();
+    } else {
+      static std::vector<std::pair<std::string, double>> const specials = {
+          {"Infinity", std::numeric_limits<double>::infinity()},
+          {"Minus[Infinity]", -std::numeric_limits<double>::infinity()},
+          {"Indeterminate", std::numeric_limits<double>::quiet_NaN()}};
+      bool found = false;
+      for (auto const& special : specials) {
+        if (line.compare(position, special.first.size(), special.first) == 0) {
+          values.push_back(special.second);
+          position += special.first.size();
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        return false;
+      }
+    }
+    if (position < end) {
+      if (line[position] != ',') {
+        return false;
+      }
+      ++position;
+    }
+  }
+  return true;
+}
+
+}  // namespace internal_checkpointed_results
+}  // namespace mathematica
+}  // namespace principia
@@ -0,0 +1,114 @@
+﻿
+#include "mathematica/checkpointed_results.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/file.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "mathematica/mathematica.hpp"
+
+namespace principia {
+namespace mathematica {
+namespace internal_checkpointed_results {
+
+using base::OFStream;
+using ::testing::ElementsAre;
+
+class CheckpointedResultsTest : public ::testing::Test {
+ protected:
+  CheckpointedResultsTest()
+      : path_(TEMP_DIR / "checkpointed_results_test.checkpoint.wl"),
+        preamble_(Assign("parameter", 42.0)) {
+    std::filesystem::remove(path_);
+  }
+
+  ~CheckpointedResultsTest() override {
+    std::filesystem::remove(path_);
+  }
+
+  std::string Contents() const {
+    std::ifstream stream(path_);
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    return buffer.str();
+  }
+
+  std::filesystem::path const path_;
+  std::string const preamble_;
+};
+
+using CheckpointedResultsDeathTest = CheckpointedResultsTest;
+
+TEST_F(CheckpointedResultsDeathTest, PreambleMismatch) {
+  {
+    CheckpointedResults results(path_, preamble_, "results", 3);
+  }
+  EXPECT_DEATH({
+    CheckpointedResults results(
+        path_, Assign("parameter", 43.0), "results", 3);
+  }, "different computation");
+}
+
+TEST_F(CheckpointedResultsTest, RoundTrip) {
+  double const infinity = std::numeric_limits<double>::infinity();
+  double const nan = std::numeric_limits<double>::quiet_NaN();
+  {
+    CheckpointedResults results(path_, preamble_, "results", 4);
+    EXPECT_FALSE(results.Find(0).has_value());
+    results.Write(0, {1.0, -0x1.23456789ABCDEp-1000, 6.02214076e23});
+    results.Write(2, {infinity, -infinity, nan});
+    results.Write(3, {});
+    EXPECT_THAT(*results.Find(0),
+                ElementsAre(1.0, -0x1.23456789ABCDEp-1000, 6.02214076e23));
+  }
+
+  CheckpointedResults const results(path_, preamble_, "results", 4);
+  EXPECT_THAT(*results.Find(0),
+              ElementsAre(1.0, -0x1.23456789ABCDEp-1000, 6.02214076e23));
+  EXPECT_FALSE(results.Find(1).has_value());
+  std::vector<double> const specials = *results.Find(2);
+  ASSERT_EQ(3, specials.size());
+  EXPECT_EQ(infinity, specials[0]);
+  EXPECT_EQ(-infinity, specials[1]);
+  EXPECT_TRUE(std::isnan(specials[2]));
+  EXPECT_THAT(*results.Find(3), ElementsAre());
+}
+
+TEST_F(CheckpointedResultsTest, IncompleteLine) {
+  {
+    CheckpointedResults results(path_, preamble_, "results", 2);
+    results.Write(0, {1.0, 2.0});
+  }
+  std::string const complete = Contents();
+  {
+    OFStream file(path_, std::ios::app);
+    file << "Set[results[[2]],List[SetPrecision[3.";
+  }
+
+  {
+    CheckpointedResults const results(path_, preamble_, "results", 2);
+    EXPECT_THAT(*results.Find(0), ElementsAre(1.0, 2.0));
+    EXPECT_FALSE(results.Find(1).has_value());
+  }
+  // The incomplete line was removed from the file.
+  EXPECT_EQ(complete, Contents());
+}
+
+TEST_F(CheckpointedResultsTest, Delete) {
+  CheckpointedResults results(path_, preamble_, "results", 1);
+  results.Write(0, {1.0});
+  EXPECT_TRUE(std::filesystem::exists(path_));
+  results.Delete();
+  EXPECT_FALSE(std::filesystem::exists(path_));
+}
+
+}  // namespace internal_checkpointed_results
+}  // namespace mathematica
+}  // namespace principia
@@ -2,8 +2,10 @@
 #include "mathematica/integrator_plots.hpp"
 
 #include <algorithm>
+#include <filesystem>
 #include <fstream>  // NOLINT(readability/streams)
 #include <iostream>  // NOLINT(readability/streams)
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -19,6 +21,7 @@
 #include "physics/massive_body.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/named_quantities.hpp"
+#include "mathematica/checkpointed_results.hpp"
 #include "mathematica/mathematica.hpp"
 #include "serialization/integrators.pb.h"
 #include "testing_utilities/integration.hpp"
@@ -222,18 +225,68 @@ class WorkErrorGraphGenerator {
     }
   }
 
-  std::string GetMathematicaData() {
+  // Writes the data for the graphs to the file at |path|.  The results of the
+  // integrations are written to the file at |checkpoint_path| as they
+  // complete.  If that file exists, it must come from an interrupted run with
+  // the same parameters, and only the missing integrations are done.  The
+  // checkpoint is deleted once |path| has been written.
+  void WriteMathematicaData(std::filesystem::path const& path,
+                            std::filesystem::path const& checkpoint_path) {
     LOG(INFO) << "Using " << std::thread::hardware_concurrency()
               << " worker threads";
+    std::vector<std::string> names;
+    for (int i = 0; i < methods_.size(); ++i) {
+      names.emplace_back(Escape(methods_[i].name));
+    }
+    std::vector<Length> initial_positions;
+    for (auto const& q : initial_state_.positions) {
+      initial_positions.push_back(q.value);
+    }
+    std::vector<Speed> initial_velocities;
+    for (auto const& v : initial_state_.velocities) {
+      initial_velocities.push_back(v.value);
+    }
+    // The equation and the errors cannot be written out, they are identified
+    // by the |problem_name_|.
+    CheckpointedResults results(
+        checkpoint_path,
+        Assign("names", names) +
+            Assign("problemName", Escape(problem_name_)) +
+            Assign("initialPositions", initial_positions) +
+            Assign("initialVelocities", initial_velocities) +
+            Assign("initialTime", initial_state_.time.value) +
+            Assign("tmax", tmax_) +
+            Assign("stepReduction", step_reduction_) +
+            Assign("startingStepSizePerEvaluation",
+                   starting_step_size_per_evaluation_) +
+            Assign("integrationsPerIntegrator",
+                   static_cast<double>(integrations_per_integrator_)),
+        "results",
+        methods_.size() * integrations_per_integrator_);
+
     Bundle bundle;
     for (int method_index = 0; method_index < methods_.size(); ++method_index) {
       for (int time_step_index = 0;
            time_step_index < integrations_per_integrator_;
            ++time_step_index) {
+        std::optional<std::vector<double>> const checkpointed_result =
+            results.Find(ResultIndex(method_index, time_step_index));
+        if (checkpointed_result.has_value()) {
+          q_errors_[method_index][time_step_index] =
+              (*checkpointed_result)[0] * Metre;
+          v_errors_[method_index][time_step_index] =
+              (*checkpointed_result)[1] * (Metre / Second);
+          e_errors_[method_index][time_step_index] =
+              (*checkpointed_result)[2] * SIUnit<Energy>();
+          evaluations_[method_index][time_step_index] =
+              (*checkpointed_result)[3];
+          continue;
+        }
         bundle.Add(std::bind(&WorkErrorGraphGenerator::Integrate,
                              this,
                              method_index,
-                             time_step_index));
+                             time_step_index,
+                             &results));
       }
     }
     bundle.Join();
@@ -241,7 +294,6 @@ class WorkErrorGraphGenerator {
     std::vector<std::string> q_error_data;
     std::vector<std::string> v_error_data;
     std::vector<std::string> e_error_data;
-    std::vector<std::string> names;
     for (int i = 0; i < methods_.size(); ++i) {
       q_error_data.emplace_back(
           PlottableDataset(evaluations_[i], q_errors_[i]));
@@ -249,18 +301,25 @@ class WorkErrorGraphGenerator {
           PlottableDataset(evaluations_[i], v_errors_[i]));
       e_error_data.emplace_back(
           PlottableDataset(evaluations_[i], e_errors_[i]));
-      names.emplace_back(Escape(methods_[i].name));
     }
-    std::string result;
-    result += Assign("qErrorData", q_error_data);
-    result += Assign("vErrorData", v_error_data);
-    result += Assign("eErrorData", e_error_data);
-    result += Assign("names", names);
-    return result;
+    {
+      OFStream file(path);
+      file << Assign("qErrorData", q_error_data);
+      file << Assign("vErrorData", v_error_data);
+      file << Assign("eErrorData", e_error_data);
+      file << Assign("names", names);
+    }
+    results.Delete();
   }
 
  private:
-  Status Integrate(int const method_index, int const time_step_index) {
+  int ResultIndex(int const method_index, int const time_step_index) const {
+    return method_index * integrations_per_integrator_ + time_step_index;
+  }
+
+  Status Integrate(int const method_index,
+                   int const time_step_index,
+                   not_null<CheckpointedResults*> const results) {
     auto const& method = methods_[method_index];
     Problem problem;
     int number_of_evaluations = 0;
@@ -301,6 +360,11 @@ class WorkErrorGraphGenerator {
     v_errors_[method_index][time_step_index] = max_v_error;
     e_errors_[method_index][time_step_index] = max_e_error;
     evaluations_[method_index][time_step_index] = amortized_evaluations;
+    results->Write(ResultIndex(method_index, time_step_index),
+                   {max_q_error / Metre,
+                    max_v_error / (Metre / Second),
+                    max_e_error / SIUnit<Energy>(),
+                    static_cast<double>(amortized_evaluations)});
 
     return Status::OK;
   }
@@ -357,8 +421,9 @@ void GenerateSimpleHarmonicMotionWorkErrorGraphs() {
       tmax,
       "Harmonic oscillator");
 
-  OFStream file(TEMP_DIR / "simple_harmonic_motion_graphs.generated.wl");
-  file << generator.GetMathematicaData();
+  generator.WriteMathematicaData(
+      TEMP_DIR / "simple_harmonic_motion_graphs.generated.wl",
+      TEMP_DIR / "simple_harmonic_motion_graphs.checkpoint.wl");
 }
 
 void GenerateKeplerProblemWorkErrorGraphs(double const eccentricity) {
@@ -417,9 +482,11 @@ void GenerateKeplerProblemWorkErrorGraphs(double const eccentricity) {
       tmax,
       " Kepler problem with e = " + std::to_string(eccentricity));
 
-  OFStream file(TEMP_DIR / ("kepler_problem_graphs_" +
-                            std::to_string(eccentricity) + ".generated.wl"));
-  file << generator.GetMathematicaData();
+  generator.WriteMathematicaData(
+      TEMP_DIR / ("kepler_problem_graphs_" + std::to_string(eccentricity) +
+                  ".generated.wl"),
+      TEMP_DIR / ("kepler_problem_graphs_" + std::to_string(eccentricity) +
+                  ".checkpoint.wl"));
 }
 
 }  // namespace mathematica
@@ -2,18 +2,26 @@
 #include "mathematica/local_error_analysis.hpp"
 
 #include <filesystem>
+#include <string>
 #include <vector>
 
 #include "astronomy/stabilize_ksp.hpp"
+#include "base/bundle.hpp"
 #include "base/file.hpp"
+#include "base/status.hpp"
+#include "integrators/methods.hpp"
+#include "mathematica/checkpointed_results.hpp"
 #include "mathematica/mathematica.hpp"
+#include "numerics/double_precision.hpp"
 
 namespace principia {
 namespace mathematica {
 
-using base::OFStream;
+using base::Bundle;
 using base::make_not_null_unique;
-using geometry::Position;
+using base::OFStream;
+using base::Status;
+using integrators::methods::BlanesMoan2002SRKN14A;
 using physics::DegreesOfFreedom;
 using physics::MassiveBody;
 using quantities::Length;
@@ -26,6 +34,16 @@ namespace {
 
 constexpr Length fitting_tolerance = 1 * Milli(Metre);
 
+// Returns a Mathematica string that identifies the |integrator|, including its
+// composition method if any.
+std::string ToMathematicaString(
+    FixedStepSizeIntegrator<Ephemeris<ICRS>::NewtonianMotionEquation> const&
+        integrator) {
+  serialization::FixedStepSizeIntegrator message;
+  integrator.WriteToMessage(&message);
+  return Escape(message.ShortDebugString());
+}
+
 }  // namespace
 
 LocalErrorAnalyser::LocalErrorAnalyser(
@@ -52,38 +70,126 @@ void LocalErrorAnalyser::WriteLocalErrors(
     Time const& fine_step,
     Time const& granularity,
     Time const& duration) const {
-  auto const reference_ephemeris = solar_system_->MakeEphemeris(
+  WriteErrors(
+      path,
+      Assign("fineIntegrator", ToMathematicaString(fine_integrator)) +
+          Assign("fineStep", fine_step),
+      granularity,
+      duration,
+      [this, &fine_integrator, fine_step](Ephemeris<ICRS> const& ephemeris,
+                                          Instant const& t0,
+                                          Instant const& t) {
+        std::unique_ptr<Ephemeris<ICRS>> const refined_ephemeris =
+            ForkEphemeris(ephemeris, t0, fine_integrator, fine_step);
+        refined_ephemeris->Prolong(t);
+        std::vector<DoublePrecision<Position<ICRS>>> refined_positions;
+        for (not_null<MassiveBody const*> const body :
+                 refined_ephemeris->bodies()) {
+          refined_positions.emplace_back(
+              refined_ephemeris->trajectory(body)->EvaluatePosition(t));
+        }
+        return refined_positions;
+      });
+}
+
+void LocalErrorAnalyser::WriteLocalErrorsWithReference(
+    std::filesystem::path const& path,
+    Time const& fine_step,
+    Time const& granularity,
+    Time const& duration) const {
+  WriteErrors(path,
+              Assign("fineIntegrator", Escape("reference")) +
+                  Assign("fineStep", fine_step),
+              granularity,
+              duration,
+              [fine_step](Ephemeris<ICRS> const& ephemeris,
+                          Instant const& t0,
+                          Instant const& t) {
+                return ephemeris
+                    .ComputeReferencePositions<BlanesMoan2002SRKN14A>(
+                        t0, t, fine_step);
+              });
+}
+
+void LocalErrorAnalyser::WriteErrors(
+    std::filesystem::path const& path,
+    std::string const& fine_integration,
+    Time const& granularity,
+    Time const& duration,
+    RefinedPositionsComputation const& compute_refined_positions) const {
+  Instant const epoch = solar_system_->epoch();
+  std::vector<Instant> interval_ends;
+  for (Instant t = epoch + granularity;
+       t < epoch + duration;
+       t += granularity) {
+    interval_ends.push_back(t);
+  }
+  std::filesystem::path checkpoint_path = path;
+  checkpoint_path.replace_extension(".checkpoint.wl");
+  CheckpointedResults results(
+      checkpoint_path,
+      Assign("bodyNames", solar_system_->names()) +
+          Assign("epoch", epoch) +
+          Assign("integrator", ToMathematicaString(integrator_)) +
+          Assign("step", step_) +
+          fine_integration +
+          Assign("granularity", granularity) +
+          Assign("duration", duration),
+      "errors",
+      interval_ends.size());
+
+  // The main integration is sequential, but it is much cheaper than the
+  // refined ones, which are done in parallel.
+  auto const main_ephemeris = solar_system_->MakeEphemeris(
       /*accuracy_parameters=*/{fitting_tolerance,
                                /*geopotential_tolerance=*/0x1p-24},
       Ephemeris<ICRS>::FixedStepParameters(integrator_, step_));
-  reference_ephemeris->Prolong(solar_system_->epoch());
-  std::vector<std::vector<Length>> errors;
-  for (Instant t0 = solar_system_->epoch(),
-               t = t0 + granularity;
-       t < solar_system_->epoch() + duration;
-       t0 = t, t += granularity) {
-    std::unique_ptr<Ephemeris<ICRS>> refined_ephemeris =
-        ForkEphemeris(*reference_ephemeris, t0, fine_integrator, fine_step);
-    reference_ephemeris->Prolong(t);
-    refined_ephemeris->Prolong(t);
-    LOG_EVERY_N(INFO, 10) << "Prolonged to "
-                          << (t - solar_system_->epoch()) / Day << " days.";
-
-    errors.emplace_back();
-    for (auto const& body_name : solar_system_->names()) {
-      int const body_index = solar_system_->index(body_name);
-      errors.back().push_back(
-          (reference_ephemeris
-               ->trajectory(reference_ephemeris->bodies()[body_index])
-               ->EvaluatePosition(t) -
-           refined_ephemeris
-               ->trajectory(refined_ephemeris->bodies()[body_index])
-               ->EvaluatePosition(t)).Norm());
+  main_ephemeris->Prolong(interval_ends.empty() ? epoch
+                                                : interval_ends.back());
+
+  Bundle bundle;
+  for (int i = 0; i < interval_ends.size(); ++i) {
+    if (results.Find(i).has_value()) {
+      continue;
     }
+    bundle.Add([this,
+                &compute_refined_positions,
+                &interval_ends,
+                &main_ephemeris,
+                &results,
+                epoch,
+                i]() {
+      Instant const t0 = i == 0 ? epoch : interval_ends[i - 1];
+      Instant const& t = interval_ends[i];
+      std::vector<DoublePrecision<Position<ICRS>>> const refined_positions =
+          compute_refined_positions(*main_ephemeris, t0, t);
+      std::vector<double> errors;
+      for (auto const& body_name : solar_system_->names()) {
+        int const body_index = solar_system_->index(body_name);
+        DoublePrecision<Position<ICRS>> const position(
+            main_ephemeris->trajectory(main_ephemeris->bodies()[body_index])
+                ->EvaluatePosition(t));
+        errors.push_back(ExpressIn(
+            Metre, (position - refined_positions[body_index]).value.Norm()));
+      }
+      results.Write(i, errors);
+      LOG_EVERY_N(INFO, 10) << "Computed the errors after "
+                            << (t - epoch) / Day << " days.";
+      return Status::OK;
+    });
+  }
+  CHECK_OK(bundle.Join());
+
+  std::vector<std::vector<double>> errors;
+  for (int i = 0; i < interval_ends.size(); ++i) {
+    errors.push_back(*results.Find(i));
+  }
+  {
+    OFStream file(path);
+    file << Assign("bodyNames", solar_system_->names());
+    file << Assign("errors", errors);
   }
-  OFStream file(path);
-  file << Assign("bodyNames", solar_system_->names());
-  file << Assign("errors", ExpressIn(Metre, errors));
+  results.Delete();
 }
 
 not_null<std::unique_ptr<Ephemeris<ICRS>>> LocalErrorAnalyser::ForkEphemeris(
@@ -2,8 +2,13 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "integrators/integrators.hpp"
+#include "numerics/double_precision.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/solar_system.hpp"
 
@@ -13,7 +18,9 @@ namespace mathematica {
 using astronomy::ICRS;
 using base::not_null;
 using geometry::Instant;
+using geometry::Position;
 using integrators::FixedStepSizeIntegrator;
+using numerics::DoublePrecision;
 using physics::Ephemeris;
 using physics::SolarSystem;
 using quantities::Time;
@@ -30,7 +37,12 @@ class LocalErrorAnalyser {
 
   // Computes the error over |granularity| between the main integration and a
   // fine integration forked off the main one, for |duration| from the solar
-  // system epoch.  Writes the errors to a file with the given |path|.
+  // system epoch, and writes them to a file with the given |path|.  The fine
+  // integrations run in parallel, and their errors are written to a checkpoint
+  // file next to |path| as they are computed.  If the checkpoint exists, it
+  // must come from an interrupted run with the same parameters, and only the
+  // missing errors are computed.  The checkpoint is deleted once |path| has
+  // been written.
   void WriteLocalErrors(
       std::filesystem::path const& path,
       FixedStepSizeIntegrator<Ephemeris<ICRS>::NewtonianMotionEquation> const&
@@ -39,7 +51,35 @@ class LocalErrorAnalyser {
       Time const& granularity,
       Time const& duration) const;
 
+  // Same as above, but the fine integration is done in double-double
+  // arithmetic with the method of Blanes and Moan (2002), see
+  // |Ephemeris::ComputeReferencePositions|.  This is much slower, but the
+  // errors are not polluted by the rounding errors of the fine integration.
+  void WriteLocalErrorsWithReference(
+      std::filesystem::path const& path,
+      Time const& fine_step,
+      Time const& granularity,
+      Time const& duration) const;
+
  private:
+  // Returns the positions of the bodies at |t|, in the order of
+  // |ephemeris.bodies()|, computed by a fine integration starting from the
+  // state of the |ephemeris| at |t0|.
+  using RefinedPositionsComputation =
+      std::function<std::vector<DoublePrecision<Position<ICRS>>>(
+          Ephemeris<ICRS> const& ephemeris,
+          Instant const& t0,
+          Instant const& t)>;
+
+  // The |fine_integration| is Mathematica code describing the parameters of
+  // |compute_refined_positions|; it is part of the preamble of the checkpoint.
+  void WriteErrors(
+      std::filesystem::path const& path,
+      std::string const& fine_integration,
+      Time const& granularity,
+      Time const& duration,
+      RefinedPositionsComputation const& compute_refined_positions) const;
+
   not_null<std::unique_ptr<Ephemeris<ICRS>>> ForkEphemeris(
       Ephemeris<ICRS> const& original,
       Instant const& t,
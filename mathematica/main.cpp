@@ -82,6 +82,8 @@ int main(int argc, char const* argv[]) {
           "    [--output_directory=<path>] default: .\n"
           "    [--fine_integrator=<fixed_step_size_integrator >] "
           "        default: BLANES_MOAN_2002_SRKN_14A\n"
+          "    [--reference] fine integration in double-double arithmetic "
+          "with BLANES_MOAN_2002_SRKN_14A\n"
           "    [--fine_step=<quantity(time)>] default: 1 min\n"
           "    [--granularity=<quantity(time)>] default: 1 d\n"
           "    [--duration=<quantity(time)>] default: 500 d\n",
@@ -106,13 +108,24 @@ int main(int argc, char const* argv[]) {
          solar_system->epoch_literal() + "," + *flags["integrator"] + "," +
          DebugString(time_step) + "].wl");
     LocalErrorAnalyser analyser(std::move(solar_system), integrator, time_step);
-    analyser.WriteLocalErrors(
-        out,
-        ParseFixedStepSizeIntegrator<Ephemeris<ICRS>::NewtonianMotionEquation>(
-            flags["fine_integrator"].value_or("BLANES_MOAN_2002_SRKN_14A")),
-        ParseQuantity<Time>(flags["fine_step"].value_or("1 min")),
-        ParseQuantity<Time>(flags["granularity"].value_or("1 d")),
-        ParseQuantity<Time>(flags["duration"].value_or("500 d")));
+    if (Contains(flags, "reference")) {
+      CHECK(!Contains(flags, "fine_integrator"))
+          << "--fine_integrator cannot be used with --reference";
+      analyser.WriteLocalErrorsWithReference(
+          out,
+          ParseQuantity<Time>(flags["fine_step"].value_or("1 min")),
+          ParseQuantity<Time>(flags["granularity"].value_or("1 d")),
+          ParseQuantity<Time>(flags["duration"].value_or("500 d")));
+    } else {
+      analyser.WriteLocalErrors(
+          out,
+          ParseFixedStepSizeIntegrator<
+              Ephemeris<ICRS>::NewtonianMotionEquation>(
+              flags["fine_integrator"].value_or("BLANES_MOAN_2002_SRKN_14A")),
+          ParseQuantity<Time>(flags["fine_step"].value_or("1 min")),
+          ParseQuantity<Time>(flags["granularity"].value_or("1 d")),
+          ParseQuantity<Time>(flags["duration"].value_or("500 d")));
+    }
   } else {
     LOG(FATAL) << "unexpected argument " << argv[1];
   }
@@ -14,6 +14,8 @@ namespace internal_double_precision {
 using base::not_null;
 using quantities::Difference;
 using quantities::Product;
+using quantities::Quotient;
+using quantities::SquareRoot;
 using quantities::Sum;
 
 // A simple container for accumulating a value using double precision.  The
@@ -101,6 +103,20 @@ template<typename T, typename U>
 DoublePrecision<Difference<T, U>> operator-(DoublePrecision<T> const& left,
                                             DoublePrecision<U> const& right);
 
+// Double-double multiplication, division, and square root, following Hida, Li
+// and Bailey (2007).  These are only defined if |T| and |U| are |double| or
+// |Quantity|.  The results are accurate to a few units of 2⁻¹⁰⁴ relative.
+template<typename T, typename U>
+DoublePrecision<Product<T, U>> operator*(DoublePrecision<T> const& left,
+                                         DoublePrecision<U> const& right);
+
+template<typename T, typename U>
+DoublePrecision<Quotient<T, U>> operator/(DoublePrecision<T> const& left,
+                                          DoublePrecision<U> const& right);
+
+template<typename T>
+DoublePrecision<SquareRoot<T>> Sqrt(DoublePrecision<T> const& x);
+
 template<typename T>
 std::string DebugString(DoublePrecision<T> const& double_precision);
 
@@ -20,6 +20,7 @@ using geometry::DoubleOrQuantityOrPointOrMultivectorSerializer;
 using geometry::DoubleOrQuantityOrMultivectorSerializer;
 using quantities::Abs;
 using quantities::FusedMultiplyAdd;
+using quantities::is_quantity;
 using quantities::Quantity;
 using quantities::SIUnit;
 
@@ -255,6 +256,50 @@ DoublePrecision<Difference<T, U>> operator-(DoublePrecision<T> const& left,
   return QuickTwoSum(sum.value, (sum.error + left.error) - right.error);
 }
 
+template<typename T, typename U>
+DoublePrecision<Product<T, U>> operator*(DoublePrecision<T> const& left,
+                                         DoublePrecision<U> const& right) {
+  static_assert(is_quantity<T>::value && is_quantity<U>::value,
+                "Double-double multiplication must be used on quantities");
+  // Hida, Li and Bailey (2007), Library for Double-Double and Quad-Double
+  // Arithmetic, algorithm 12 with the cross terms, i.e., the accurate version.
+  auto product = TwoProduct(left.value, right.value);
+  product.error += left.value * right.error + left.error * right.value;
+  return QuickTwoSum(product.value, product.error);
+}
+
+template<typename T, typename U>
+DoublePrecision<Quotient<T, U>> operator/(DoublePrecision<T> const& left,
+                                          DoublePrecision<U> const& right) {
+  static_assert(is_quantity<T>::value && is_quantity<U>::value,
+                "Double-double division must be used on quantities");
+  // Hida, Li and Bailey (2007), Library for Double-Double and Quad-Double
+  // Arithmetic, long division with one correction.
+  Quotient<T, U> const q1 = left.value / right.value;
+  DoublePrecision<T> const r =
+      right * DoublePrecision<Quotient<T, U>>(q1);
+  auto s = TwoDifference(left.value, r.value);
+  s.error -= r.error;
+  s.error += left.error;
+  Quotient<T, U> const q2 = (s.value + s.error) / right.value;
+  return QuickTwoSum(q1, q2);
+}
+
+template<typename T>
+DoublePrecision<SquareRoot<T>> Sqrt(DoublePrecision<T> const& x) {
+  static_assert(is_quantity<T>::value,
+                "Double-double square root must be used on quantities");
+  if (x.value == T{}) {
+    return DoublePrecision<SquareRoot<T>>();
+  }
+  // Hida, Li and Bailey (2007), Library for Double-Double and Quad-Double
+  // Arithmetic: one Newton iteration from the double-precision square root,
+  // known as Karp's trick.
+  SquareRoot<T> const y = quantities::Sqrt(x.value);
+  DoublePrecision<T> const residual = x - TwoProduct(y, y);
+  return QuickTwoSum(y, residual.value / (2 * y));
+}
+
 template<typename T>
 std::string DebugString(DoublePrecision<T> const& double_precision) {
   // We use |DebugString| to get all digits when |T| is |double|.  In that case
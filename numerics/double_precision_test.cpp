@@ -25,12 +25,15 @@ using geometry::Frame;
 using geometry::Position;
 using geometry::Point;
 using geometry::R3Element;
+using quantities::Abs;
 using quantities::Length;
 using quantities::Mass;
 using quantities::Momentum;
 using quantities::Speed;
+using quantities::Square;
 using quantities::Sqrt;
 using quantities::Tan;
+using quantities::Time;
 using quantities::si::Kilogram;
 using quantities::si::Metre;
 using quantities::si::Radian;
@@ -38,6 +41,7 @@ using quantities::si::Second;
 using testing_utilities::AlmostEquals;
 using ::testing::Eq;
 using ::testing::Ge;
+using ::testing::Lt;
 using ::testing::Ne;
 
 // Let's not try to compare those things.
@@ -291,6 +295,27 @@ TEST_F(DoublePrecisionTest, Product) {
                            0));
 }
 
+TEST_F(DoublePrecisionTest, DoubleDoubleArithmetic) {
+  DoublePrecision<Length> const x = TwoSum(1 * Metre, 0x1p-60 * Metre);
+  DoublePrecision<Time> const three_seconds(3 * Second);
+  DoublePrecision<Speed> const v = x / three_seconds;
+  EXPECT_THAT(v.value, Eq(1.0 / 3.0 * Metre / Second));
+  EXPECT_THAT(Abs((v * three_seconds - x).value), Lt(0x1p-104 * Metre));
+
+  DoublePrecision<Square<Length>> const x² = x * x;
+  EXPECT_THAT(x².value, Eq(1 * Metre * Metre));
+  EXPECT_THAT(x².error, Eq(0x1p-59 * Metre * Metre));
+
+  // The number below was obtained using Mathematica.
+  DoublePrecision<Length> const diagonal =
+      Sqrt(DoublePrecision<Square<Length>>(2 * Metre * Metre));
+  EXPECT_THAT(diagonal.value, Eq(Sqrt(2) * Metre));
+  EXPECT_THAT(diagonal.error,
+              AlmostEquals(-9.6672933134529135e-17 * Metre, 0, 1));
+  EXPECT_THAT(Sqrt(DoublePrecision<Square<Length>>()),
+              Eq(DoublePrecision<Length>()));
+}
+
 }  // namespace internal_double_precision
 }  // namespace numerics
 }  // namespace principia
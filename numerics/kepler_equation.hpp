@@ -0,0 +1,33 @@
+﻿
+#pragma once
+
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace numerics {
+namespace internal_kepler_equation {
+
+using quantities::Angle;
+
+// Returns the eccentric anomaly E such that M = E - e sin E, where M is the
+// |mean_anomaly| and e the |eccentricity|, 0 ≤ e < 1.  The result is in the
+// same turn as |mean_anomaly|.  The trigonometric functions are those of
+// numerics/sin_cos.hpp, so the result is the same on all platforms.
+Angle SolveKeplerEquation(Angle const& mean_anomaly, double eccentricity);
+
+// Returns the hyperbolic eccentric anomaly H such that M = e sinh H - H, where
+// M is the |hyperbolic_mean_anomaly| and e the |eccentricity|, e > 1.  The
+// hyperbolic functions are those of the C runtime library, so the result may
+// differ across platforms.
+Angle SolveHyperbolicKeplerEquation(Angle const& hyperbolic_mean_anomaly,
+                                    double eccentricity);
+
+}  // namespace internal_kepler_equation
+
+using internal_kepler_equation::SolveHyperbolicKeplerEquation;
+using internal_kepler_equation::SolveKeplerEquation;
+
+}  // namespace numerics
+}  // namespace principia
+
+#include "numerics/kepler_equation_body.hpp"
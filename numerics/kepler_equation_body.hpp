@@ -0,0 +1,197 @@
+﻿
+#pragma once
+
+#include "numerics/kepler_equation.hpp"
+
+#include <cmath>
+
+#include "glog/logging.h"
+#include "numerics/sin_cos.hpp"
+#include "quantities/numbers.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace numerics {
+namespace internal_kepler_equation {
+
+using quantities::si::Radian;
+
+// Beyond this, Halley's method has failed to converge and we let bisection
+// finish the job.
+constexpr int max_iterations = 100;
+
+// x - sin x, without cancellation for small |x|.
+inline double XMinusSinX(double const x) {
+  if (std::abs(x) >= 1) {
+    return x - ReproducibleSin(x);
+  }
+  // The Taylor series, truncated so that the remainder is below 2⁻⁵³ times
+  // the first term on [-1, 1].
+  double const x² = x * x;
+  return x * x² / 6 *
+         (1 - x² / 20 *
+              (1 - x² / 42 *
+                   (1 - x² / 72 *
+                        (1 - x² / 110 *
+                             (1 - x² / 156 *
+                                  (1 - x² / 210 *
+                                       (1 - x² / 272 *
+                                            (1 - x² / 342))))))));
+}
+
+// sinh x - x, without cancellation for small |x|.  This uses the C runtime
+// library, see |SolveHyperbolicKeplerEquation|.
+inline double SinhXMinusX(double const x) {
+  if (std::abs(x) >= 1) {
+    return std::sinh(x) - x;
+  }
+  double const x² = x * x;
+  return x * x² / 6 *
+         (1 + x² / 20 *
+              (1 + x² / 42 *
+                   (1 + x² / 72 *
+                        (1 + x² / 110 *
+                             (1 + x² / 156 *
+                                  (1 + x² / 210 *
+                                       (1 + x² / 272 *
+                                            (1 + x² / 342))))))));
+}
+
+// Finds a root of an increasing function |f| in [lower, upper], where
+// f(lower) ≤ 0 ≤ f(upper), starting from |x|.  |evaluate| returns f, f′ and
+// f″ at its argument.  Uses Halley's method, falling back to bisection when an
+// iterate leaves the bracketing interval, so convergence is guaranteed.
+template<typename Evaluate>
+double SafeguardedHalley(Evaluate const& evaluate,
+                         double lower,
+                         double upper,
+                         double x) {
+  for (int i = 0; i < max_iterations; ++i) {
+    double f;
+    double df;
+    double d²f;
+    evaluate(x, f, df, d²f);
+    if (f == 0) {
+      return x;
+    } else if (f < 0) {
+      lower = x;
+    } else {
+      upper = x;
+    }
+    double next_x = x - 2 * f * df / (2 * df * df - f * d²f);
+    if (!(next_x > lower && next_x < upper)) {
+      next_x = 0.5 * (lower + upper);
+    }
+    if (next_x == x || next_x == lower || next_x == upper) {
+      return next_x;
+    }
+    // Halley's method converges cubically, so once the step is this small the
+    // next iterate is correct to the last bit.
+    if (std::abs(next_x - x) <= 0x1p-26 * std::abs(next_x)) {
+      evaluate(next_x, f, df, d²f);
+      return next_x - f / df;
+    }
+    x = next_x;
+  }
+  // Bisection.
+  for (;;) {
+    double const middle = 0.5 * (lower + upper);
+    if (middle == lower || middle == upper) {
+      return middle;
+    }
+    double f;
+    double df;
+    double d²f;
+    evaluate(middle, f, df, d²f);
+    if (f == 0) {
+      return middle;
+    } else if (f < 0) {
+      lower = middle;
+    } else {
+      upper = middle;
+    }
+  }
+}
+
+inline Angle SolveKeplerEquation(Angle const& mean_anomaly,
+                                 double const eccentricity) {
+  double const e = eccentricity;
+  CHECK_LE(0, e);
+  CHECK_LT(e, 1);
+  if (e == 0) {
+    return mean_anomaly;
+  }
+  // Reduce the mean anomaly to [-π, π] and use the symmetry of the equation to
+  // solve it on [0, π].
+  double const M = mean_anomaly / Radian;
+  double const turns = std::nearbyint(M / (2 * π));
+  double const reduced_M = M - turns * (2 * π);
+  double const abs_M = std::abs(reduced_M);
+
+  // E - e sin E - M, written to avoid cancellations near the parabolic case.
+  auto const evaluate = [abs_M, e](double const E,
+                                   double& f,
+                                   double& df,
+                                   double& d²f) {
+    double sin_E;
+    double cos_E;
+    ReproducibleSinCos(E, sin_E, cos_E);
+    f = (1 - e) * E + e * XMinusSinX(E) - abs_M;
+    df = 1 - e * cos_E;
+    d²f = e * sin_E;
+  };
+
+  // E - M = e sin E ∈ [0, e] on [0, π].
+  double const lower = abs_M;
+  double const upper = std::min(abs_M + e, π);
+  // The starter is that of Danby (1987) away from the parabolic case; near it,
+  // M ≈ E³/6 at periapsis.
+  double starter = abs_M + 0.85 * e;
+  if (e > 0.9 && abs_M < 1) {
+    starter = std::cbrt(6 * abs_M);
+  }
+  starter = std::min(std::max(starter, lower), upper);
+  double const abs_E = SafeguardedHalley(evaluate, lower, upper, starter);
+  return (std::copysign(abs_E, reduced_M) + turns * (2 * π)) * Radian;
+}
+
+inline Angle SolveHyperbolicKeplerEquation(
+    Angle const& hyperbolic_mean_anomaly,
+    double const eccentricity) {
+  double const e = eccentricity;
+  CHECK_LT(1, e);
+  double const M = hyperbolic_mean_anomaly / Radian;
+  double const abs_M = std::abs(M);
+
+  // e sinh H - H - M, written to avoid cancellations near the parabolic case.
+  // There is no reproducible implementation of the hyperbolic functions, so
+  // unlike that of |SolveKeplerEquation| the result depends on the C runtime
+  // library.
+  auto const evaluate = [abs_M, e](double const H,
+                                   double& f,
+                                   double& df,
+                                   double& d²f) {
+    double const sinh_H = std::sinh(H);
+    double const cosh_H = std::cosh(H);
+    f = (e - 1) * H + e * SinhXMinusX(H) - abs_M;
+    df = e * cosh_H - 1;
+    d²f = e * sinh_H;
+  };
+
+  // Since sinh H ≥ H, e sinh H - H ≥ (e - 1) sinh H.
+  double const lower = 0;
+  double const upper = std::asinh(abs_M / (e - 1));
+  // For large anomalies, e sinh H ≈ M; near the parabolic case and at small
+  // anomalies, M ≈ e H³/6.
+  double starter = std::asinh(abs_M / e);
+  if (e < 1.1 && abs_M < 1) {
+    starter = std::cbrt(6 * abs_M / e);
+  }
+  starter = std::min(std::max(starter, lower), upper);
+  double const abs_H = SafeguardedHalley(evaluate, lower, upper, starter);
+  return std::copysign(abs_H, M) * Radian;
+}
+
+}  // namespace internal_kepler_equation
+}  // namespace numerics
+}  // namespace principia
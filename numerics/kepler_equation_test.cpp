@@ -0,0 +1,87 @@
+﻿
+#include "numerics/kepler_equation.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "numerics/root_finders.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/numbers.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/almost_equals.hpp"
+#include "testing_utilities/numerics.hpp"
+
+namespace principia {
+
+using quantities::Angle;
+using quantities::Sin;
+using quantities::Sinh;
+using quantities::si::Radian;
+using testing_utilities::AbsoluteError;
+using testing_utilities::AlmostEquals;
+using testing_utilities::RelativeError;
+using ::testing::Lt;
+
+namespace numerics {
+
+class KeplerEquationTest : public ::testing::Test {};
+
+TEST_F(KeplerEquationTest, EllipticBisection) {
+  for (double const e : {0.0, 0.01, 0.1, 0.5, 0.9, 0.99}) {
+    for (Angle M = -π * Radian; M <= π * Radian; M += 0.01 * Radian) {
+      auto const kepler_equation = [e, M](Angle const& E) -> Angle {
+        return M - (E - e * Sin(E) * Radian);
+      };
+      Angle const expected =
+          e == 0 ? M : Bisect(kepler_equation, M - e * Radian, M + e * Radian);
+      EXPECT_THAT(AbsoluteError(expected, SolveKeplerEquation(M, e)),
+                  Lt(1e-15 * Radian))
+          << "e = " << e << ", M = " << M;
+    }
+  }
+}
+
+TEST_F(KeplerEquationTest, EllipticTurns) {
+  double const e = 0.3;
+  Angle const E = SolveKeplerEquation(1 * Radian, e);
+  EXPECT_THAT(SolveKeplerEquation(1 * Radian + 10 * π * Radian, e),
+              AlmostEquals(E + 10 * π * Radian, 0, 2));
+  EXPECT_THAT(SolveKeplerEquation(1 * Radian - 4 * π * Radian, e),
+              AlmostEquals(E - 4 * π * Radian, 0, 2));
+  EXPECT_THAT(SolveKeplerEquation(-1 * Radian, e), AlmostEquals(-E, 0));
+}
+
+// Near the parabolic case the Kepler equation suffers from cancellations, so
+// we compare with eccentric anomalies for which the mean anomaly is known
+// accurately.
+TEST_F(KeplerEquationTest, NearParabolic) {
+  double const e = 1 - 0x1p-40;
+  for (Angle const E : {1e-6 * Radian, 1e-3 * Radian, 1e-2 * Radian}) {
+    double const x = E / Radian;
+    // E - sin E by its Taylor series, which converges very fast here.
+    double const x_minus_sin_x =
+        x * x * x / 6 * (1 - x * x / 20 * (1 - x * x / 42 * (1 - x * x / 72)));
+    Angle const M = ((1 - e) * x + e * x_minus_sin_x) * Radian;
+    EXPECT_THAT(RelativeError(E, SolveKeplerEquation(M, e)), Lt(1e-14))
+        << E;
+  }
+}
+
+TEST_F(KeplerEquationTest, HyperbolicBisection) {
+  // Bisection is not accurate near the parabolic case.
+  for (double const e : {1.5, 2.0, 10.0}) {
+    for (Angle M = -100 * Radian; M <= 100 * Radian; M += 0.1 * Radian) {
+      auto const hyperbolic_kepler_equation = [e, M](Angle const& H) -> Angle {
+        return M - (e * Sinh(H) * Radian - H);
+      };
+      Angle const expected =
+          Bisect(hyperbolic_kepler_equation, 0 * Radian, M / (e - 1));
+      EXPECT_THAT(RelativeError(expected, SolveHyperbolicKeplerEquation(M, e)),
+                  Lt(2e-15))
+          << "e = " << e << ", M = " << M;
+    }
+  }
+}
+
+}  // namespace numerics
+}  // namespace principia
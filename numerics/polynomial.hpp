@@ -41,6 +41,12 @@ class Polynomial {
   virtual Value Evaluate(Argument const& argument) const = 0;
   virtual Derivative<Value, Argument> EvaluateDerivative(
       Argument const& argument) const = 0;
+  // Equivalent to calling |Evaluate| and |EvaluateDerivative| but faster as
+  // the two evaluations share some of their computations.
+  virtual void EvaluateWithDerivative(
+      Argument const& argument,
+      Value& value,
+      Derivative<Value, Argument>& derivative) const = 0;
 
   // Only useful for benchmarking or analyzing performance.  Do not use in real
   // code.
@@ -74,6 +80,11 @@ class PolynomialInMonomialBasis : public Polynomial<Value, Argument> {
   Evaluate(Argument const& argument) const override;
   FORCE_INLINE(inline) Derivative<Value, Argument>
   EvaluateDerivative(Argument const& argument) const override;
+  FORCE_INLINE(inline) void
+  EvaluateWithDerivative(
+      Argument const& argument,
+      Value& value,
+      quantities::Derivative<Value, Argument>& derivative) const override;
 
   constexpr int degree() const override;
 
@@ -147,6 +158,10 @@ class PolynomialInMonomialBasis<Value, Point<Argument>, degree_, Evaluator>
   Evaluate(Point<Argument> const& argument) const override;
   FORCE_INLINE(inline) Derivative<Value, Argument>
   EvaluateDerivative(Point<Argument> const& argument) const override;
+  FORCE_INLINE(inline) void
+  EvaluateWithDerivative(Point<Argument> const& argument,
+                         Value& value,
+                         Derivative<Value, Argument>& derivative) const override;
 
   constexpr int degree() const override;
 
@@ -164,6 +164,17 @@ EvaluateDerivative(Argument const& argument) const {
       coefficients_, argument);
 }
 
+template<typename Value, typename Argument, int degree_,
+         template<typename, typename, int> class Evaluator>
+void PolynomialInMonomialBasis<Value, Argument, degree_, Evaluator>::
+EvaluateWithDerivative(
+    Argument const& argument,
+    Value& value,
+    quantities::Derivative<Value, Argument>& derivative) const {
+  Evaluator<Value, Argument, degree_>::EvaluateWithDerivative(
+      coefficients_, argument, value, derivative);
+}
+
 template<typename Value, typename Argument, int degree_,
          template<typename, typename, int> class Evaluator>
 constexpr int
@@ -240,6 +251,16 @@ EvaluateDerivative(Point<Argument> const& argument) const {
       coefficients_, argument - origin_);
 }
 
+template<typename Value, typename Argument, int degree_,
+         template<typename, typename, int> class Evaluator>
+void PolynomialInMonomialBasis<Value, Point<Argument>, degree_, Evaluator>::
+EvaluateWithDerivative(Point<Argument> const& argument,
+                       Value& value,
+                       Derivative<Value, Argument>& derivative) const {
+  Evaluator<Value, Argument, degree_>::EvaluateWithDerivative(
+      coefficients_, argument - origin_, value, derivative);
+}
+
 template<typename Value, typename Argument, int degree_,
          template<typename, typename, int> class Evaluator>
 constexpr int
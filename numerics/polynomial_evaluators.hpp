@@ -32,6 +32,13 @@ struct EstrinEvaluator {
   FORCE_INLINE(static) Derivative<Value, Argument>
   EvaluateDerivative(Coefficients const& coefficients,
                      Argument const& argument);
+  // Equivalent to calling |Evaluate| and |EvaluateDerivative|, but shares the
+  // work between the two evaluations.
+  FORCE_INLINE(static) void
+  EvaluateWithDerivative(Coefficients const& coefficients,
+                         Argument const& argument,
+                         Value& value,
+                         Derivative<Value, Argument>& derivative);
 };
 
 template<typename Value, typename Argument, int degree>
@@ -49,6 +56,13 @@ struct HornerEvaluator {
   FORCE_INLINE(static) Derivative<Value, Argument>
   EvaluateDerivative(Coefficients const& coefficients,
                      Argument const& argument);
+  // Equivalent to calling |Evaluate| and |EvaluateDerivative|, but shares the
+  // work between the two evaluations.
+  FORCE_INLINE(static) void
+  EvaluateWithDerivative(Coefficients const& coefficients,
+                         Argument const& argument,
+                         Value& value,
+                         Derivative<Value, Argument>& derivative);
 };
 
 }  // namespace internal_polynomial_evaluators
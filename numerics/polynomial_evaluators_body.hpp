@@ -243,6 +243,38 @@ EstrinEvaluator<Value, Argument, degree>::EvaluateDerivative(
   }
 }
 
+template<typename Value, typename Argument, int degree>
+void EstrinEvaluator<Value, Argument, degree>::EvaluateWithDerivative(
+    Coefficients const& coefficients,
+    Argument const& argument,
+    Value& value,
+    Derivative<Value, Argument>& derivative) {
+  if constexpr (degree == 0) {
+    value = std::get<0>(coefficients);
+    derivative = Derivative<Value, Argument>{};
+  } else {
+    using InternalEvaluator = InternalEstrinEvaluator<Value,
+                                                      Argument,
+                                                      degree,
+                                                      /*low=*/0,
+                                                      /*subdegree=*/degree>;
+    using InternalDerivativeEvaluator =
+        InternalEstrinEvaluator<Value,
+                                Argument,
+                                degree,
+                                /*low=*/1,
+                                /*subdegree=*/degree - 1>;
+    // The squares only depend on |degree|, so they are the same for the value
+    // and the derivative.
+    auto const argument_squares =
+        InternalEvaluator::ArgumentSquaresGenerator::Evaluate(argument);
+    value = InternalEvaluator::Evaluate(
+        coefficients, argument, argument_squares);
+    derivative = InternalDerivativeEvaluator::EvaluateDerivative(
+        coefficients, argument, argument_squares);
+  }
+}
+
 // Internal helper for Horner evaluation.  |degree| is the degree of the overall
 // polynomial, |low| defines the subpolynomial that we currently evaluate, i.e.,
 // the one with a constant term coefficient |std::get<low>(coefficients)|.
@@ -258,6 +290,13 @@ struct InternalHornerEvaluator {
   FORCE_INLINE(static) Derivative<Value, Argument, low>
   EvaluateDerivative(Coefficients const& coefficients,
                      Argument const& argument);
+  // Computes the subpolynomial and its derivative in a single Horner pass.
+  // Only valid for |low < degree|.
+  FORCE_INLINE(static) void
+  EvaluateWithDerivative(Coefficients const& coefficients,
+                         Argument const& argument,
+                         Derivative<Value, Argument, low>& value,
+                         Derivative<Value, Argument, low + 1>& derivative);
 };
 
 template<typename Value, typename Argument, int degree>
@@ -296,6 +335,26 @@ InternalHornerEvaluator<Value, Argument, degree, low>::EvaluateDerivative(
              EvaluateDerivative(coefficients, argument);
 }
 
+template<typename Value, typename Argument, int degree, int low>
+void InternalHornerEvaluator<Value, Argument, degree, low>::
+EvaluateWithDerivative(Coefficients const& coefficients,
+                       Argument const& argument,
+                       Derivative<Value, Argument, low>& value,
+                       Derivative<Value, Argument, low + 1>& derivative) {
+  if constexpr (low == degree - 1) {
+    derivative = std::get<degree>(coefficients);
+    value = std::get<low>(coefficients) + argument * derivative;
+  } else {
+    Derivative<Value, Argument, low + 1> tail_value;
+    Derivative<Value, Argument, low + 2> tail_derivative;
+    InternalHornerEvaluator<Value, Argument, degree, low + 1>::
+        EvaluateWithDerivative(
+            coefficients, argument, tail_value, tail_derivative);
+    value = std::get<low>(coefficients) + argument * tail_value;
+    derivative = tail_value + argument * tail_derivative;
+  }
+}
+
 template<typename Value, typename Argument, int degree>
 Derivative<Value, Argument, degree>
 InternalHornerEvaluator<Value, Argument, degree, degree>::Evaluate(
@@ -333,6 +392,21 @@ HornerEvaluator<Value, Argument, degree>::EvaluateDerivative(
   }
 }
 
+template<typename Value, typename Argument, int degree>
+void HornerEvaluator<Value, Argument, degree>::EvaluateWithDerivative(
+    Coefficients const& coefficients,
+    Argument const& argument,
+    Value& value,
+    Derivative<Value, Argument>& derivative) {
+  if constexpr (degree == 0) {
+    value = std::get<0>(coefficients);
+    derivative = Derivative<Value, Argument>{};
+  } else {
+    InternalHornerEvaluator<Value, Argument, degree, /*low=*/0>::
+        EvaluateWithDerivative(coefficients, argument, value, derivative);
+  }
+}
+
 }  // namespace internal_polynomial_evaluators
 }  // namespace numerics
 }  // namespace principia
@@ -33,6 +33,14 @@ class PolynomialEvaluatorTest : public ::testing::Test {
       EXPECT_EQ(E::EvaluateDerivative(binomial_coefficients, argument),
                 degree * std::pow(argument + 1, degree - 1))
           << argument << " " << degree;
+      double value;
+      double derivative;
+      E::EvaluateWithDerivative(
+          binomial_coefficients, argument, value, derivative);
+      EXPECT_EQ(value, std::pow(argument + 1, degree))
+          << argument << " " << degree;
+      EXPECT_EQ(derivative, degree * std::pow(argument + 1, degree - 1))
+          << argument << " " << degree;
     }
   }
 };
@@ -137,6 +137,17 @@ TEST_F(PolynomialTest, Evaluate2A) {
                                                0 * Metre / Second}), 0));
 }
 
+// Check that the fused evaluation agrees with the separate evaluations.
+TEST_F(PolynomialTest, EvaluateWithDerivative) {
+  Instant const t0 = Instant() + 0.3 * Second;
+  P2A const p(coefficients_, t0);
+  Displacement<World> d;
+  Velocity<World> v;
+  p.EvaluateWithDerivative(t0 + 0.5 * Second, d, v);
+  EXPECT_THAT(d, AlmostEquals(p.Evaluate(t0 + 0.5 * Second), 0));
+  EXPECT_THAT(v, AlmostEquals(p.EvaluateDerivative(t0 + 0.5 * Second), 0));
+}
+
 // Check that a polynomial of high order may be declared.
 TEST_F(PolynomialTest, Evaluate17) {
   P17::Coefficients const coefficients;
@@ -0,0 +1,42 @@
+﻿
+#pragma once
+
+#include <vector>
+
+#include "base/not_null.hpp"
+
+namespace principia {
+namespace numerics {
+namespace internal_sin_cos {
+
+using base::not_null;
+
+// Implementations of sin and cos that do not depend on the C runtime library,
+// so that they give the same results on all platforms.  For |x| ≤ 2¹⁹ π/2, the
+// argument reduction is accurate and the error is below 1 ULP.  For larger
+// arguments, and for infinities and NaNs, the results are those of the C
+// runtime library.
+
+double ReproducibleSin(double x);
+double ReproducibleCos(double x);
+
+// Computes both lines at once, sharing the argument reduction.
+void ReproducibleSinCos(double x, double& sin, double& cos);
+
+// The same as above for all the elements of |x|; the results are resized as
+// needed and are bitwise identical to those of the scalar function.  The bulk
+// of the computation has no branches, so that it can be vectorized.
+void ReproducibleSinCos(std::vector<double> const& x,
+                        not_null<std::vector<double>*> sin,
+                        not_null<std::vector<double>*> cos);
+
+}  // namespace internal_sin_cos
+
+using internal_sin_cos::ReproducibleCos;
+using internal_sin_cos::ReproducibleSin;
+using internal_sin_cos::ReproducibleSinCos;
+
+}  // namespace numerics
+}  // namespace principia
+
+#include "numerics/sin_cos_body.hpp"
@@ -0,0 +1,221 @@
+﻿
+#pragma once
+
+#include "numerics/sin_cos.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "base/macros.hpp"
+
+namespace principia {
+namespace numerics {
+namespace internal_sin_cos {
+
+// The polynomials and the argument reduction are those of fdlibm (files
+// k_sin.c, k_cos.c and e_rem_pio2.c), which are freely distributable.
+// Contracting a multiplication and an addition into an FMA would change the
+// results depending on the platform.  Therefore each product is rounded in a
+// statement of its own, which prevents contraction when it is restricted to
+// expressions (the default of Clang, and of MSVC with /fp:precise), and
+// contraction is turned off explicitly where the compiler lets us, see
+// |PRINCIPIA_NO_FP_CONTRACT|.
+
+// Coefficients of the polynomial approximating sin x on [-π/4, π/4].
+constexpr double S1 = -1.66666666666666324348e-01;
+constexpr double S2 = 8.33333333332248946124e-03;
+constexpr double S3 = -1.98412698298579493134e-04;
+constexpr double S4 = 2.75573137070700676789e-06;
+constexpr double S5 = -2.50507602534068634195e-08;
+constexpr double S6 = 1.58969099521155010221e-10;
+
+// Coefficients of the polynomial approximating cos x on [-π/4, π/4].
+constexpr double C1 = 4.16666666666666019037e-02;
+constexpr double C2 = -1.38888888888741095749e-03;
+constexpr double C3 = 2.48015872894767294178e-05;
+constexpr double C4 = -2.75573143513906633035e-07;
+constexpr double C5 = 2.08757232129817482790e-09;
+constexpr double C6 = -1.13596475577881948265e-11;
+
+// 2/π, and π/2 split in three parts of 33 bits, each with a tail.  The product
+// of one of the parts by an integer less than 2²⁰ is exact.
+constexpr double two_over_π = 6.36619772367581382433e-01;
+constexpr double π_over_2_1 = 1.57079632673412561417e+00;
+constexpr double π_over_2_1_tail = 6.07710050650619224932e-11;
+constexpr double π_over_2_2 = 6.07710050630396597660e-11;
+constexpr double π_over_2_2_tail = 2.02226624879595063154e-21;
+constexpr double π_over_2_3 = 2.02226624871116645580e-21;
+constexpr double π_over_2_3_tail = 8.47842766036889956997e-32;
+
+// Adding and subtracting this constant rounds a double of magnitude less than
+// 2⁵¹ to the nearest integer.
+constexpr double rounder = 0x1.8p52;
+
+// Beyond this bound the reduction is not accurate.
+constexpr double reduction_limit = 0x1.0p19 * 1.57079632679489661923;
+// Below this bound sin x = x and cos x = 1 to the last bit.
+constexpr double tiny = 0x1.0p-27;
+
+// Returns the biased exponent of |x|.
+FORCE_INLINE(inline) std::int64_t Exponent(double const x) {
+  std::int64_t bits;
+  std::memcpy(&bits, &x, sizeof(x));
+  return (bits >> 52) & 0x7FF;
+}
+
+// |x + y| is in [-π/4, π/4], |y| is small compared to |x|.
+FORCE_INLINE(inline) double SinKernel(double const x, double const y) {
+  PRINCIPIA_NO_FP_CONTRACT
+  double const z = x * x;
+  double const v = z * x;
+  // r = S2 + z * (S3 + z * (S4 + z * (S5 + z * S6))).
+  double const z_S6 = z * S6;
+  double const z_r5 = z * (S5 + z_S6);
+  double const z_r4 = z * (S4 + z_r5);
+  double const z_r3 = z * (S3 + z_r4);
+  double const r = S2 + z_r3;
+  // x - ((z * (0.5 * y - v * r) - y) - v * S1).
+  double const half_y = 0.5 * y;
+  double const v_r = v * r;
+  double const z_u = z * (half_y - v_r);
+  double const v_S1 = v * S1;
+  return x - ((z_u - y) - v_S1);
+}
+
+FORCE_INLINE(inline) double CosKernel(double const x, double const y) {
+  PRINCIPIA_NO_FP_CONTRACT
+  double const z = x * x;
+  double const z² = z * z;
+  // r = z * (C1 + z * (C2 + z * C3)) + z⁴ * (C4 + z * (C5 + z * C6)).
+  double const z_C3 = z * C3;
+  double const z_r2 = z * (C2 + z_C3);
+  double const low = z * (C1 + z_r2);
+  double const z_C6 = z * C6;
+  double const z_r5 = z * (C5 + z_C6);
+  double const z⁴ = z² * z²;
+  double const high = z⁴ * (C4 + z_r5);
+  double const r = low + high;
+  // w + (((1 - w) - z / 2) + (z * r - x * y)).
+  double const half_z = 0.5 * z;
+  double const w = 1.0 - half_z;
+  double const z_r = z * r;
+  double const x_y = x * y;
+  return w + (((1.0 - w) - half_z) + (z_r - x_y));
+}
+
+// Computes sin x and cos x for |x| ≤ |reduction_limit|, without branches.  Has
+// no undefined behaviour for other arguments.
+FORCE_INLINE(inline) void SinCosInRange(double const x,
+                                        double& sin,
+                                        double& cos) {
+  // Argument reduction: x = n π/2 + y₀ + y₁, where n is the integer nearest to
+  // 2x/π.  The first part of π/2 is subtracted exactly.  If this results in a
+  // cancellation of more than 16 bits, the second part is subtracted, and
+  // similarly for the third part beyond 49 bits.  All the steps are computed
+  // and the right one is selected.
+  PRINCIPIA_NO_FP_CONTRACT
+  double const x_two_over_π = x * two_over_π;
+  double const t = x_two_over_π + rounder;
+  double const n = t - rounder;
+  std::int64_t t_bits;
+  std::memcpy(&t_bits, &t, sizeof(t));
+  // The low bits of the significand of |t| are those of |n|.
+  std::int64_t const quadrant = t_bits & 0b11;
+
+  double const n_π_over_2_1 = n * π_over_2_1;
+  double const r1 = x - n_π_over_2_1;
+  double const w1 = n * π_over_2_1_tail;
+  double const y1 = r1 - w1;
+
+  double const n_π_over_2_2 = n * π_over_2_2;
+  double const r2 = r1 - n_π_over_2_2;
+  double const n_π_over_2_2_tail = n * π_over_2_2_tail;
+  double const w2 = n_π_over_2_2_tail - ((r1 - r2) - n_π_over_2_2);
+  double const y2 = r2 - w2;
+
+  double const n_π_over_2_3 = n * π_over_2_3;
+  double const r3 = r2 - n_π_over_2_3;
+  double const n_π_over_2_3_tail = n * π_over_2_3_tail;
+  double const w3 = n_π_over_2_3_tail - ((r2 - r3) - n_π_over_2_3);
+  double const y3 = r3 - w3;
+
+  std::int64_t const exponent = Exponent(x);
+  bool const second_step = exponent - Exponent(y1) > 16;
+  bool const third_step = second_step & (exponent - Exponent(y2) > 49);
+  double const r = third_step ? r3 : second_step ? r2 : r1;
+  double const w = third_step ? w3 : second_step ? w2 : w1;
+  double const y₀ = third_step ? y3 : second_step ? y2 : y1;
+  double const y₁ = (r - y₀) - w;
+
+  double const s = SinKernel(y₀, y₁);
+  double const c = CosKernel(y₀, y₁);
+
+  // sin(n π/2 + y) is s, c, -s, -c for n ≡ 0, 1, 2, 3 (mod 4), and cos is sin
+  // with the quadrant incremented.
+  double const sin_magnitude = (quadrant & 0b01) == 0 ? s : c;
+  double const cos_magnitude = (quadrant & 0b01) == 0 ? c : s;
+  double const signed_sin =
+      (quadrant & 0b10) == 0 ? sin_magnitude : -sin_magnitude;
+  double const signed_cos =
+      ((quadrant + 1) & 0b10) == 0 ? cos_magnitude : -cos_magnitude;
+
+  // The reduction does not preserve the sign of zero.
+  bool const is_tiny = std::abs(x) < tiny;
+  sin = is_tiny ? x : signed_sin;
+  cos = is_tiny ? 1.0 : signed_cos;
+}
+
+inline double ReproducibleSin(double const x) {
+  double sin;
+  double cos;
+  ReproducibleSinCos(x, sin, cos);
+  return sin;
+}
+
+inline double ReproducibleCos(double const x) {
+  double sin;
+  double cos;
+  ReproducibleSinCos(x, sin, cos);
+  return cos;
+}
+
+inline void ReproducibleSinCos(double const x, double& sin, double& cos) {
+  if (std::abs(x) <= reduction_limit) {
+    SinCosInRange(x, sin, cos);
+  } else {
+    sin = std::sin(x);
+    cos = std::cos(x);
+  }
+}
+
+inline void ReproducibleSinCos(std::vector<double> const& x,
+                               not_null<std::vector<double>*> const sin,
+                               not_null<std::vector<double>*> const cos) {
+  std::int64_t const size = x.size();
+  sin->resize(size);
+  cos->resize(size);
+  double const* const xs = x.data();
+  double* const sins = sin->data();
+  double* const coss = cos->data();
+  std::int64_t number_out_of_range = 0;
+  // This loop has no branches.  The results for the arguments that are out of
+  // range are meaningless and are fixed afterwards.
+  for (std::int64_t i = 0; i < size; ++i) {
+    number_out_of_range += !(std::abs(xs[i]) <= reduction_limit);
+    SinCosInRange(xs[i], sins[i], coss[i]);
+  }
+  if (number_out_of_range > 0) {
+    for (std::int64_t i = 0; i < size; ++i) {
+      if (!(std::abs(xs[i]) <= reduction_limit)) {
+        sins[i] = std::sin(xs[i]);
+        coss[i] = std::cos(xs[i]);
+      }
+    }
+  }
+}
+
+}  // namespace internal_sin_cos
+}  // namespace numerics
+}  // namespace principia
@@ -0,0 +1,114 @@
+﻿
+#include "numerics/sin_cos.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "quantities/numbers.hpp"
+#include "testing_utilities/almost_equals.hpp"
+
+namespace principia {
+namespace numerics {
+
+using testing_utilities::AlmostEquals;
+using ::testing::Eq;
+using ::testing::IsNan;
+
+class SinCosTest : public ::testing::Test {
+ protected:
+#if defined(_DEBUG)
+  static constexpr int iterations_ = 1e5;
+#else
+  static constexpr int iterations_ = 1e7;
+#endif
+
+  // Checks that our results are within 1 ULP of those of the C runtime library,
+  // which is nearly correctly rounded.
+  static void CheckAgainstLibm(double const bound) {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<> distribution(-bound, bound);
+    for (int i = 0; i < iterations_; ++i) {
+      double const x = distribution(random);
+      double sin;
+      double cos;
+      ReproducibleSinCos(x, sin, cos);
+      EXPECT_THAT(sin, AlmostEquals(std::sin(x), 0, 1)) << x;
+      EXPECT_THAT(cos, AlmostEquals(std::cos(x), 0, 1)) << x;
+    }
+  }
+};
+
+TEST_F(SinCosTest, SpecialValues) {
+  EXPECT_THAT(ReproducibleSin(0.0), AlmostEquals(0.0, 0));
+  EXPECT_TRUE(std::signbit(ReproducibleSin(-0.0)));
+  EXPECT_THAT(ReproducibleCos(0.0), AlmostEquals(1.0, 0));
+  EXPECT_THAT(ReproducibleCos(-0.0), AlmostEquals(1.0, 0));
+  EXPECT_THAT(ReproducibleSin(π / 2), AlmostEquals(1.0, 0));
+  EXPECT_THAT(ReproducibleCos(π), AlmostEquals(-1.0, 0));
+  EXPECT_THAT(ReproducibleSin(-π / 2), AlmostEquals(-1.0, 0));
+  EXPECT_THAT(ReproducibleSin(1e-300), AlmostEquals(1e-300, 0));
+  EXPECT_THAT(ReproducibleSin(std::numeric_limits<double>::quiet_NaN()), IsNan());
+  EXPECT_THAT(ReproducibleCos(std::numeric_limits<double>::infinity()), IsNan());
+}
+
+TEST_F(SinCosTest, Small) {
+  CheckAgainstLibm(π / 4);
+}
+
+TEST_F(SinCosTest, Medium) {
+  CheckAgainstLibm(1e3);
+}
+
+TEST_F(SinCosTest, Large) {
+  CheckAgainstLibm(8e5);
+}
+
+// The reduction must not lose accuracy near the multiples of π/2, where there
+// is catastrophic cancellation.
+TEST_F(SinCosTest, NearMultiplesOfπOver2) {
+  for (int k = 1; k < 1 << 19; k += 97) {
+    double const x = k * (π / 2);
+    for (double const y :
+         {std::nextafter(x, 0.0), x, std::nextafter(x, 2 * x)}) {
+      EXPECT_THAT(ReproducibleSin(y), AlmostEquals(std::sin(y), 0, 1)) << y;
+      EXPECT_THAT(ReproducibleCos(y), AlmostEquals(std::cos(y), 0, 1)) << y;
+    }
+  }
+}
+
+// Beyond the accurate reduction we use the C runtime library.
+TEST_F(SinCosTest, VeryLarge) {
+  EXPECT_THAT(ReproducibleSin(1e300), Eq(std::sin(1e300)));
+  EXPECT_THAT(ReproducibleCos(1e300), Eq(std::cos(1e300)));
+}
+
+TEST_F(SinCosTest, Batch) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1e4, 1e4);
+  std::vector<double> x;
+  for (int i = 0; i < 1000; ++i) {
+    x.push_back(distribution(random));
+  }
+  x.push_back(-0.0);
+  x.push_back(1e300);
+  x.push_back(std::numeric_limits<double>::quiet_NaN());
+  std::vector<double> sin;
+  std::vector<double> cos;
+  ReproducibleSinCos(x, &sin, &cos);
+  ASSERT_THAT(sin.size(), Eq(x.size()));
+  ASSERT_THAT(cos.size(), Eq(x.size()));
+  for (int i = 0; i < x.size(); ++i) {
+    double expected_sin;
+    double expected_cos;
+    ReproducibleSinCos(x[i], expected_sin, expected_cos);
+    EXPECT_THAT(sin[i], AlmostEquals(expected_sin, 0)) << x[i];
+    EXPECT_THAT(cos[i], AlmostEquals(expected_cos, 0)) << x[i];
+  }
+}
+
+}  // namespace numerics
+}  // namespace principia
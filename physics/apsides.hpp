@@ -1,10 +1,15 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 
 #include "base/constant_function.hpp"
+#include "geometry/named_quantities.hpp"
+#include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/trajectory.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
 
 namespace principia {
 namespace physics {
@@ -12,7 +17,100 @@ namespace internal_apsides {
 
 using base::ConstantFunction;
 using base::Identically;
+using geometry::Instant;
 using geometry::Vector;
+using quantities::Length;
+using quantities::Speed;
+using quantities::Square;
+using quantities::Variation;
+
+// Detects the apsides with respect to |reference| of a trajectory whose points
+// are given one at a time, in increasing order of time, e.g., as they are
+// produced by an integrator.  An apsis is detected as soon as the point that
+// follows it is appended.
+template<typename Frame>
+class ApsidesDetector {
+ public:
+  explicit ApsidesDetector(Trajectory<Frame> const& reference);
+
+  ApsidesDetector(ApsidesDetector const&) = delete;
+  ApsidesDetector(ApsidesDetector&&) = delete;
+  ApsidesDetector& operator=(ApsidesDetector const&) = delete;
+  ApsidesDetector& operator=(ApsidesDetector&&) = delete;
+
+  // |time| must be after the time of any point previously appended.  Points
+  // before the domain of |reference| are ignored.  Points after it are not
+  // processed and don't change |last_time|, so that they may be appended again
+  // once |reference| has been prolonged.
+  void Append(Instant const& time,
+              DegreesOfFreedom<Frame> const& degrees_of_freedom);
+
+  // Appends the points of [begin, end[ that are after the last point
+  // previously appended.  |end| must be the end of its trajectory.  The cost
+  // is proportional to the number of new points, not to the size of the
+  // range.
+  void Extend(typename DiscreteTrajectory<Frame>::Iterator begin,
+              typename DiscreteTrajectory<Frame>::Iterator end);
+
+  // Drops the apsides strictly before |time|.
+  void ForgetBefore(Instant const& time);
+
+  Trajectory<Frame> const& reference() const;
+
+  // The time of the last point processed or ignored, if any.
+  std::optional<Instant> const& last_time() const;
+
+  DiscreteTrajectory<Frame> const& apoapsides() const;
+  DiscreteTrajectory<Frame> const& periapsides() const;
+
+ private:
+  Trajectory<Frame> const& reference_;
+  std::optional<Instant> last_time_;
+
+  // The last point in the domain of |reference_|.
+  std::optional<Instant> previous_time_;
+  std::optional<DegreesOfFreedom<Frame>> previous_degrees_of_freedom_;
+  std::optional<Square<Length>> previous_squared_distance_;
+  std::optional<Variation<Square<Length>>>
+      previous_squared_distance_derivative_;
+
+  DiscreteTrajectory<Frame> apoapsides_;
+  DiscreteTrajectory<Frame> periapsides_;
+};
+
+// Detects the crossings with the xy plane of a trajectory whose points are
+// given one at a time, in increasing order of time.  See |ComputeNodes| for
+// the meaning of |north| and |predicate|.
+template<typename Frame, typename Predicate = ConstantFunction<bool>>
+class NodesDetector {
+ public:
+  explicit NodesDetector(Vector<double, Frame> const& north,
+                         Predicate predicate = Identically(true));
+
+  NodesDetector(NodesDetector const&) = delete;
+  NodesDetector(NodesDetector&&) = delete;
+  NodesDetector& operator=(NodesDetector const&) = delete;
+  NodesDetector& operator=(NodesDetector&&) = delete;
+
+  // |time| must be after the time of any point previously appended.
+  void Append(Instant const& time,
+              DegreesOfFreedom<Frame> const& degrees_of_freedom);
+
+  DiscreteTrajectory<Frame> const& ascending() const;
+  DiscreteTrajectory<Frame> const& descending() const;
+
+ private:
+  Vector<double, Frame> const north_;
+  Predicate predicate_;
+
+  std::optional<Instant> previous_time_;
+  std::optional<DegreesOfFreedom<Frame>> previous_degrees_of_freedom_;
+  std::optional<Length> previous_z_;
+  std::optional<Speed> previous_z_speed_;
+
+  DiscreteTrajectory<Frame> ascending_;
+  DiscreteTrajectory<Frame> descending_;
+};
 
 // Computes the apsides with respect to |reference| for the discrete trajectory
 // segment given by |begin| and |end|.  Appends to the given trajectories one
@@ -51,8 +149,10 @@ void ComputeApsides(Trajectory<Frame> const& trajectory1,
 
 }  // namespace internal_apsides
 
+using internal_apsides::ApsidesDetector;
 using internal_apsides::ComputeApsides;
 using internal_apsides::ComputeNodes;
+using internal_apsides::NodesDetector;
 
 }  // namespace physics
 }  // namespace principia
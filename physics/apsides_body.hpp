@@ -4,6 +4,8 @@
 #include "physics/apsides.hpp"
 
 #include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "base/array.hpp"
@@ -15,180 +17,289 @@ namespace internal_apsides {
 
 using base::BoundedArray;
 using geometry::Barycentre;
-using geometry::Instant;
 using geometry::Position;
 using geometry::Sign;
 using numerics::Bisect;
 using numerics::Hermite3;
-using quantities::Length;
-using quantities::Speed;
-using quantities::Square;
-using quantities::Variation;
 
 template<typename Frame>
-void ComputeApsides(Trajectory<Frame> const& reference,
-                    typename DiscreteTrajectory<Frame>::Iterator const begin,
-                    typename DiscreteTrajectory<Frame>::Iterator const end,
-                    DiscreteTrajectory<Frame>& apoapsides,
-                    DiscreteTrajectory<Frame>& periapsides) {
-  std::optional<Instant> previous_time;
-  std::optional<DegreesOfFreedom<Frame>> previous_degrees_of_freedom;
-  std::optional<Square<Length>> previous_squared_distance;
-  std::optional<Variation<Square<Length>>>
-      previous_squared_distance_derivative;
-
-  Instant const t_min = reference.t_min();
-  Instant const t_max = reference.t_max();
-  for (auto it = begin; it != end; ++it) {
-    Instant const& time = it.time();
-    if (time < t_min) {
-      continue;
+ApsidesDetector<Frame>::ApsidesDetector(Trajectory<Frame> const& reference)
+    : reference_(reference) {}
+
+template<typename Frame>
+void ApsidesDetector<Frame>::Append(
+    Instant const& time,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+  if (last_time_) {
+    CHECK_LT(*last_time_, time);
+  }
+  // A point after the domain of |reference_| is not processed, and may be
+  // appended again once |reference_| has been prolonged.
+  if (time > reference_.t_max()) {
+    return;
+  }
+  last_time_ = time;
+  if (time < reference_.t_min()) {
+    return;
+  }
+
+  DegreesOfFreedom<Frame> const body_degrees_of_freedom =
+      reference_.EvaluateDegreesOfFreedom(time);
+  RelativeDegreesOfFreedom<Frame> const relative =
+      degrees_of_freedom - body_degrees_of_freedom;
+  Square<Length> const squared_distance = relative.displacement().Norm²();
+  // This is the derivative of |squared_distance|.
+  Variation<Square<Length>> const squared_distance_derivative =
+      2.0 * InnerProduct(relative.displacement(), relative.velocity());
+
+  if (previous_squared_distance_derivative_ &&
+      Sign(squared_distance_derivative) !=
+          Sign(*previous_squared_distance_derivative_)) {
+    CHECK(previous_time_ &&
+          previous_degrees_of_freedom_ &&
+          previous_squared_distance_);
+
+    // The derivative of |squared_distance| changed sign.  Construct a Hermite
+    // approximation of |squared_distance| and find its extrema.
+    Hermite3<Instant, Square<Length>> const
+        squared_distance_approximation(
+            {*previous_time_, time},
+            {*previous_squared_distance_, squared_distance},
+            {*previous_squared_distance_derivative_,
+             squared_distance_derivative});
+    BoundedArray<Instant, 2> const extrema =
+        squared_distance_approximation.FindExtrema();
+
+    // Now look at the extrema and check that exactly one is in the required
+    // time interval.  This is normally the case, but it can fail due to
+    // ill-conditioning.
+    Instant apsis_time;
+    int valid_extrema = 0;
+    for (auto const& extremum : extrema) {
+      if (extremum >= *previous_time_ && extremum <= time) {
+        apsis_time = extremum;
+        ++valid_extrema;
+      }
     }
-    if (time > t_max) {
-      break;
+    if (valid_extrema != 1) {
+      // Something went wrong when finding the extrema of
+      // |squared_distance_approximation|. Use a linear interpolation of
+      // |squared_distance_derivative| instead.
+      apsis_time = Barycentre<Instant, Variation<Square<Length>>>(
+          {time, *previous_time_},
+          {*previous_squared_distance_derivative_,
+           -squared_distance_derivative});
     }
-    DegreesOfFreedom<Frame> const degrees_of_freedom = it.degrees_of_freedom();
-    DegreesOfFreedom<Frame> const body_degrees_of_freedom =
-        reference.EvaluateDegreesOfFreedom(time);
-    RelativeDegreesOfFreedom<Frame> const relative =
-        degrees_of_freedom - body_degrees_of_freedom;
-    Square<Length> const squared_distance = relative.displacement().Norm²();
-    // This is the derivative of |squared_distance|.
-    Variation<Square<Length>> const squared_distance_derivative =
-        2.0 * InnerProduct(relative.displacement(), relative.velocity());
-
-    if (previous_squared_distance_derivative &&
-        Sign(squared_distance_derivative) !=
-            Sign(*previous_squared_distance_derivative)) {
-      CHECK(previous_time &&
-            previous_degrees_of_freedom &&
-            previous_squared_distance);
-
-      // The derivative of |squared_distance| changed sign.  Construct a Hermite
-      // approximation of |squared_distance| and find its extrema.
-      Hermite3<Instant, Square<Length>> const
-          squared_distance_approximation(
-              {*previous_time, time},
-              {*previous_squared_distance, squared_distance},
-              {*previous_squared_distance_derivative,
-               squared_distance_derivative});
-      BoundedArray<Instant, 2> const extrema =
-          squared_distance_approximation.FindExtrema();
-
-      // Now look at the extrema and check that exactly one is in the required
-      // time interval.  This is normally the case, but it can fail due to
-      // ill-conditioning.
-      Instant apsis_time;
-      int valid_extrema = 0;
-      for (auto const& extremum : extrema) {
-        if (extremum >= *previous_time && extremum <= time) {
-          apsis_time = extremum;
-          ++valid_extrema;
-        }
-      }
-      if (valid_extrema != 1) {
-        // Something went wrong when finding the extrema of
-        // |squared_distance_approximation|. Use a linear interpolation of
-        // |squared_distance_derivative| instead.
-        apsis_time = Barycentre<Instant, Variation<Square<Length>>>(
-            {time, *previous_time},
-            {*previous_squared_distance_derivative,
-             -squared_distance_derivative});
-      }
 
-      // Now that we know the time of the apsis, use a Hermite approximation to
-      // derive its degrees of freedom.  Note that an extremum of
-      // |squared_distance_approximation| is in general not an extremum for
-      // |position_approximation|: the distance computed using the latter is a
-      // 6th-degree polynomial.  However, approximating this polynomial using a
-      // 3rd-degree polynomial would yield |squared_distance_approximation|, so
-      // we shouldn't be far from the truth.
-      DegreesOfFreedom<Frame> const apsis_degrees_of_freedom =
-          begin.trajectory()->EvaluateDegreesOfFreedom(apsis_time);
-      if (Sign(squared_distance_derivative).Negative()) {
-        apoapsides.Append(apsis_time, apsis_degrees_of_freedom);
-      } else {
-        periapsides.Append(apsis_time, apsis_degrees_of_freedom);
-      }
+    // Now that we know the time of the apsis, use a Hermite approximation to
+    // derive its degrees of freedom.  Note that an extremum of
+    // |squared_distance_approximation| is in general not an extremum for
+    // |position_approximation|: the distance computed using the latter is a
+    // 6th-degree polynomial.  However, approximating this polynomial using a
+    // 3rd-degree polynomial would yield |squared_distance_approximation|, so
+    // we shouldn't be far from the truth.
+    Hermite3<Instant, Position<Frame>> const position_approximation(
+        {*previous_time_, time},
+        {previous_degrees_of_freedom_->position(),
+         degrees_of_freedom.position()},
+        {previous_degrees_of_freedom_->velocity(),
+         degrees_of_freedom.velocity()});
+    DegreesOfFreedom<Frame> const apsis_degrees_of_freedom(
+        position_approximation.Evaluate(apsis_time),
+        position_approximation.EvaluateDerivative(apsis_time));
+    if (Sign(squared_distance_derivative).Negative()) {
+      apoapsides_.Append(apsis_time, apsis_degrees_of_freedom);
+    } else {
+      periapsides_.Append(apsis_time, apsis_degrees_of_freedom);
     }
+  }
 
-    previous_time = time;
-    previous_degrees_of_freedom = degrees_of_freedom;
-    previous_squared_distance = squared_distance;
-    previous_squared_distance_derivative = squared_distance_derivative;
+  previous_time_ = time;
+  previous_degrees_of_freedom_ = degrees_of_freedom;
+  previous_squared_distance_ = squared_distance;
+  previous_squared_distance_derivative_ = squared_distance_derivative;
+}
+
+template<typename Frame>
+void ApsidesDetector<Frame>::Extend(
+    typename DiscreteTrajectory<Frame>::Iterator const begin,
+    typename DiscreteTrajectory<Frame>::Iterator const end) {
+  auto it = begin;
+  // Resume after the last point appended instead of scanning again the points
+  // that were already processed.
+  if (last_time_ && it != end && it.time() <= *last_time_) {
+    it = end.trajectory()->LowerBound(*last_time_);
+    if (it != end && it.time() == *last_time_) {
+      ++it;
+    }
+  }
+  // The points after the domain of |reference_| are not processed, no need to
+  // look at them.
+  for (; it != end && it.time() <= reference_.t_max(); ++it) {
+    Append(it.time(), it.degrees_of_freedom());
   }
 }
 
+template<typename Frame>
+void ApsidesDetector<Frame>::ForgetBefore(Instant const& time) {
+  apoapsides_.ForgetBefore(time);
+  periapsides_.ForgetBefore(time);
+}
+
+template<typename Frame>
+Trajectory<Frame> const& ApsidesDetector<Frame>::reference() const {
+  return reference_;
+}
+
+template<typename Frame>
+std::optional<Instant> const& ApsidesDetector<Frame>::last_time() const {
+  return last_time_;
+}
+
+template<typename Frame>
+DiscreteTrajectory<Frame> const& ApsidesDetector<Frame>::apoapsides() const {
+  return apoapsides_;
+}
+
+template<typename Frame>
+DiscreteTrajectory<Frame> const& ApsidesDetector<Frame>::periapsides() const {
+  return periapsides_;
+}
+
 template<typename Frame, typename Predicate>
-void ComputeNodes(typename DiscreteTrajectory<Frame>::Iterator begin,
-                  typename DiscreteTrajectory<Frame>::Iterator end,
-                  Vector<double, Frame> const& north,
-                  DiscreteTrajectory<Frame>& ascending,
-                  DiscreteTrajectory<Frame>& descending,
-                  Predicate predicate) {
+NodesDetector<Frame, Predicate>::NodesDetector(
+    Vector<double, Frame> const& north,
+    Predicate predicate)
+    : north_(north),
+      predicate_(std::move(predicate)) {
   static_assert(
-      std::is_convertible<decltype(predicate(
+      std::is_convertible<decltype(predicate_(
                               std::declval<DegreesOfFreedom<Frame>>())),
                           bool>::value,
       "|predicate| must be a predicate on |DegreesOfFreedom<Frame>|");
+}
 
-  std::optional<Instant> previous_time;
-  std::optional<Length> previous_z;
-  std::optional<Speed> previous_z_speed;
+template<typename Frame, typename Predicate>
+void NodesDetector<Frame, Predicate>::Append(
+    Instant const& time,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+  Length const z =
+      (degrees_of_freedom.position() - Frame::origin).coordinates().z;
+  Speed const z_speed = degrees_of_freedom.velocity().coordinates().z;
 
-  for (auto it = begin; it != end; ++it) {
-    Instant const time = it.time();
-    DegreesOfFreedom<Frame> const& degrees_of_freedom = it.degrees_of_freedom();
-    Length const z =
-        (degrees_of_freedom.position() - Frame::origin).coordinates().z;
-    Speed const z_speed = degrees_of_freedom.velocity().coordinates().z;
-
-    if (previous_z && Sign(z) != Sign(*previous_z)) {
-      CHECK(previous_time && previous_z_speed);
-
-      // |z| changed sign.  Construct a Hermite approximation of |z| and find
-      // its zeros.
-      Hermite3<Instant, Length> const z_approximation(
-          {*previous_time, time},
-          {*previous_z, z},
-          {*previous_z_speed, z_speed});
-
-      Instant node_time;
-      if (Sign(z_approximation.Evaluate(*previous_time)) ==
-          Sign(z_approximation.Evaluate(time))) {
-        // The Hermite approximation is poorly conditioned, let's use a linear
-        // approximation
-        node_time = Barycentre<Instant, Length>({*previous_time, time},
-                                                {z, -*previous_z});
+  if (previous_z_ && Sign(z) != Sign(*previous_z_)) {
+    CHECK(previous_time_ && previous_degrees_of_freedom_ && previous_z_speed_);
+
+    // |z| changed sign.  Construct a Hermite approximation of |z| and find
+    // its zeros.
+    Hermite3<Instant, Length> const z_approximation(
+        {*previous_time_, time},
+        {*previous_z_, z},
+        {*previous_z_speed_, z_speed});
+
+    Instant node_time;
+    if (Sign(z_approximation.Evaluate(*previous_time_)) ==
+        Sign(z_approximation.Evaluate(time))) {
+      // The Hermite approximation is poorly conditioned, let's use a linear
+      // approximation
+      node_time = Barycentre<Instant, Length>({*previous_time_, time},
+                                              {z, -*previous_z_});
+    } else {
+      // The normal case, find the intersection with z = 0 using bisection.
+      // TODO(egg): Bisection on a polynomial seems daft; we should have
+      // Newton's method.
+      node_time = Bisect(
+          [&z_approximation](Instant const& t) {
+            return z_approximation.Evaluate(t);
+          },
+          *previous_time_,
+          time);
+    }
+
+    Hermite3<Instant, Position<Frame>> const position_approximation(
+        {*previous_time_, time},
+        {previous_degrees_of_freedom_->position(),
+         degrees_of_freedom.position()},
+        {previous_degrees_of_freedom_->velocity(),
+         degrees_of_freedom.velocity()});
+    DegreesOfFreedom<Frame> const node_degrees_of_freedom(
+        position_approximation.Evaluate(node_time),
+        position_approximation.EvaluateDerivative(node_time));
+    if (predicate_(node_degrees_of_freedom)) {
+      if (Sign(InnerProduct(north_, Vector<double, Frame>({0, 0, 1}))) ==
+          Sign(z_speed)) {
+        // |north| is up and we are going up, or |north| is down and we are
+        // going down.
+        ascending_.Append(node_time, node_degrees_of_freedom);
       } else {
-        // The normal case, find the intersection with z = 0 using bisection.
-        // TODO(egg): Bisection on a polynomial seems daft; we should have
-        // Newton's method.
-        node_time = Bisect(
-            [&z_approximation](Instant const& t) {
-              return z_approximation.Evaluate(t);
-            },
-            *previous_time,
-            time);
+        descending_.Append(node_time, node_degrees_of_freedom);
       }
+    }
+  }
 
-      DegreesOfFreedom<Frame> const node_degrees_of_freedom =
-          begin.trajectory()->EvaluateDegreesOfFreedom(node_time);
-      if (predicate(node_degrees_of_freedom)) {
-        if (Sign(InnerProduct(north, Vector<double, Frame>({0, 0, 1}))) ==
-            Sign(z_speed)) {
-          // |north| is up and we are going up, or |north| is down and we are
-          // going down.
-          ascending.Append(node_time, node_degrees_of_freedom);
-        } else {
-          descending.Append(node_time, node_degrees_of_freedom);
-        }
-      }
+  previous_time_ = time;
+  previous_degrees_of_freedom_ = degrees_of_freedom;
+  previous_z_ = z;
+  previous_z_speed_ = z_speed;
+}
+
+template<typename Frame, typename Predicate>
+DiscreteTrajectory<Frame> const&
+NodesDetector<Frame, Predicate>::ascending() const {
+  return ascending_;
+}
+
+template<typename Frame, typename Predicate>
+DiscreteTrajectory<Frame> const&
+NodesDetector<Frame, Predicate>::descending() const {
+  return descending_;
+}
+
+template<typename Frame>
+void ComputeApsides(Trajectory<Frame> const& reference,
+                    typename DiscreteTrajectory<Frame>::Iterator const begin,
+                    typename DiscreteTrajectory<Frame>::Iterator const end,
+                    DiscreteTrajectory<Frame>& apoapsides,
+                    DiscreteTrajectory<Frame>& periapsides) {
+  ApsidesDetector<Frame> detector(reference);
+  for (auto it = begin; it != end; ++it) {
+    if (it.time() > reference.t_max()) {
+      break;
     }
+    detector.Append(it.time(), it.degrees_of_freedom());
+  }
+  for (auto it = detector.apoapsides().Begin();
+       it != detector.apoapsides().End();
+       ++it) {
+    apoapsides.Append(it.time(), it.degrees_of_freedom());
+  }
+  for (auto it = detector.periapsides().Begin();
+       it != detector.periapsides().End();
+       ++it) {
+    periapsides.Append(it.time(), it.degrees_of_freedom());
+  }
+}
 
-    previous_time = time;
-    previous_z = z;
-    previous_z_speed = z_speed;
+template<typename Frame, typename Predicate>
+void ComputeNodes(typename DiscreteTrajectory<Frame>::Iterator begin,
+                  typename DiscreteTrajectory<Frame>::Iterator end,
+                  Vector<double, Frame> const& north,
+                  DiscreteTrajectory<Frame>& ascending,
+                  DiscreteTrajectory<Frame>& descending,
+                  Predicate predicate) {
+  NodesDetector<Frame, Predicate> detector(north, std::move(predicate));
+  for (auto it = begin; it != end; ++it) {
+    detector.Append(it.time(), it.degrees_of_freedom());
+  }
+  for (auto it = detector.ascending().Begin();
+       it != detector.ascending().End();
+       ++it) {
+    ascending.Append(it.time(), it.degrees_of_freedom());
+  }
+  for (auto it = detector.descending().Begin();
+       it != detector.descending().End();
+       ++it) {
+    descending.Append(it.time(), it.degrees_of_freedom());
   }
 }
 
@@ -272,6 +272,176 @@ TEST_F(ApsidesTest, ComputeNodes) {
   }
 }
 
+TEST_F(ApsidesTest, Detectors) {
+  Instant const t0;
+  GravitationalParameter const μ = SolarGravitationalParameter;
+  auto const b = new MassiveBody(μ);
+
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<World>> initial_state;
+  bodies.emplace_back(std::unique_ptr<MassiveBody const>(b));
+  initial_state.emplace_back(World::origin, Velocity<World>());
+
+  Ephemeris<World> ephemeris(
+      std::move(bodies),
+      initial_state,
+      t0,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Metre,
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<World>::FixedStepParameters(
+          SymmetricLinearMultistepIntegrator<QuinlanTremaine1990Order12,
+                                             Position<World>>(),
+          10 * Minute));
+
+  KeplerianElements<World> elements;
+  elements.eccentricity = 0.25;
+  elements.semimajor_axis = 1 * AstronomicalUnit;
+  elements.inclination = 10 * Degree;
+  elements.longitude_of_ascending_node = 42 * Degree;
+  elements.argument_of_periapsis = 100 * Degree;
+  elements.mean_anomaly = 0 * Degree;
+  KeplerOrbit<World> const orbit{
+      *ephemeris.bodies()[0], MasslessBody{}, elements, t0};
+
+  DiscreteTrajectory<World> trajectory;
+  trajectory.Append(t0, initial_state[0] + orbit.StateVectors(t0));
+
+  // Feed the detectors after each year of integration, the way the
+  // prognosticator does.
+  Vector<double, World> const north({0, 0, 1});
+  ApsidesDetector<World> apsides_detector(*ephemeris.trajectory(b));
+  NodesDetector<World> nodes_detector(north);
+  for (int year = 1; year <= 10; ++year) {
+    std::optional<Instant> const last_time = apsides_detector.last_time();
+    ephemeris.FlowWithAdaptiveStep(
+        &trajectory,
+        Ephemeris<World>::NoIntrinsicAcceleration,
+        t0 + year * JulianYear,
+        Ephemeris<World>::AdaptiveStepParameters(
+            EmbeddedExplicitRungeKuttaNyströmIntegrator<
+                DormandالمكاوىPrince1986RKN434FM,
+                Position<World>>(),
+            std::numeric_limits<std::int64_t>::max(),
+            1e-3 * Metre,
+            1e-3 * Metre / Second),
+        Ephemeris<World>::unlimited_max_ephemeris_steps,
+        /*last_point_only=*/false);
+    apsides_detector.Extend(trajectory.Begin(), trajectory.End());
+    for (auto it = trajectory.Begin(); it != trajectory.End(); ++it) {
+      if (!last_time || it.time() > *last_time) {
+        nodes_detector.Append(it.time(), it.degrees_of_freedom());
+      }
+    }
+    EXPECT_EQ(trajectory.last().time(), *apsides_detector.last_time());
+  }
+
+  DiscreteTrajectory<World> apoapsides;
+  DiscreteTrajectory<World> periapsides;
+  ComputeApsides(*ephemeris.trajectory(b),
+                 trajectory.Begin(),
+                 trajectory.End(),
+                 apoapsides,
+                 periapsides);
+  DiscreteTrajectory<World> ascending_nodes;
+  DiscreteTrajectory<World> descending_nodes;
+  ComputeNodes(trajectory.Begin(),
+               trajectory.End(),
+               north,
+               ascending_nodes,
+               descending_nodes);
+
+  // The incremental detection yields the same results as the batch one.
+  auto const expect_same = [](DiscreteTrajectory<World> const& expected,
+                              DiscreteTrajectory<World> const& actual) {
+    EXPECT_EQ(expected.Size(), actual.Size());
+    for (auto expected_it = expected.Begin(), actual_it = actual.Begin();
+         expected_it != expected.End() && actual_it != actual.End();
+         ++expected_it, ++actual_it) {
+      EXPECT_THAT(actual_it.time(), Eq(expected_it.time()));
+      EXPECT_THAT(actual_it.degrees_of_freedom(),
+                  Eq(expected_it.degrees_of_freedom()));
+    }
+  };
+  EXPECT_FALSE(apoapsides.Empty());
+  EXPECT_FALSE(periapsides.Empty());
+  expect_same(apoapsides, apsides_detector.apoapsides());
+  expect_same(periapsides, apsides_detector.periapsides());
+  expect_same(ascending_nodes, nodes_detector.ascending());
+  expect_same(descending_nodes, nodes_detector.descending());
+
+  // Forgetting drops the early apsides only.
+  Instant const cutoff = t0 + 5 * JulianYear;
+  apsides_detector.ForgetBefore(cutoff);
+  EXPECT_LE(cutoff, apsides_detector.apoapsides().Begin().time());
+  EXPECT_LE(cutoff, apsides_detector.periapsides().Begin().time());
+  EXPECT_EQ(apoapsides.last().time(),
+            apsides_detector.apoapsides().last().time());
+}
+
+// The points after the domain of the reference are processed once it has been
+// prolonged.
+TEST_F(ApsidesTest, DetectorBeyondReference) {
+  Instant const t0;
+  GravitationalParameter const μ = SolarGravitationalParameter;
+  auto const b = new MassiveBody(μ);
+
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<World>> initial_state;
+  bodies.emplace_back(std::unique_ptr<MassiveBody const>(b));
+  initial_state.emplace_back(World::origin, Velocity<World>());
+
+  Ephemeris<World> ephemeris(
+      std::move(bodies),
+      initial_state,
+      t0,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Metre,
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<World>::FixedStepParameters(
+          SymmetricLinearMultistepIntegrator<QuinlanTremaine1990Order12,
+                                             Position<World>>(),
+          10 * Minute));
+
+  KeplerianElements<World> elements;
+  elements.eccentricity = 0.25;
+  elements.semimajor_axis = 1 * AstronomicalUnit;
+  elements.inclination = 10 * Degree;
+  elements.longitude_of_ascending_node = 42 * Degree;
+  elements.argument_of_periapsis = 100 * Degree;
+  elements.mean_anomaly = 0 * Degree;
+  KeplerOrbit<World> const orbit{
+      *ephemeris.bodies()[0], MasslessBody{}, elements, t0};
+
+  // Three years of a Keplerian orbit, sampled every ten days.
+  DiscreteTrajectory<World> trajectory;
+  for (int i = 0; i <= 3 * 36; ++i) {
+    Instant const t = t0 + i * JulianYear / 36;
+    trajectory.Append(t, initial_state[0] + orbit.StateVectors(t));
+  }
+
+  ApsidesDetector<World> apsides_detector(*ephemeris.trajectory(b));
+  ephemeris.Prolong(t0 + 1 * JulianYear);
+  apsides_detector.Extend(trajectory.Begin(), trajectory.End());
+  ASSERT_TRUE(apsides_detector.last_time().has_value());
+  EXPECT_LE(*apsides_detector.last_time(), ephemeris.trajectory(b)->t_max());
+  EXPECT_LT(*apsides_detector.last_time(), trajectory.last().time());
+
+  ephemeris.Prolong(trajectory.last().time());
+  apsides_detector.Extend(trajectory.Begin(), trajectory.End());
+  EXPECT_EQ(trajectory.last().time(), *apsides_detector.last_time());
+
+  DiscreteTrajectory<World> apoapsides;
+  DiscreteTrajectory<World> periapsides;
+  ComputeApsides(*ephemeris.trajectory(b),
+                 trajectory.Begin(),
+                 trajectory.End(),
+                 apoapsides,
+                 periapsides);
+  EXPECT_FALSE(apoapsides.Empty());
+  EXPECT_FALSE(periapsides.Empty());
+  EXPECT_EQ(apoapsides.Size(), apsides_detector.apoapsides().Size());
+  EXPECT_EQ(periapsides.Size(), apsides_detector.periapsides().Size());
+}
+
 #endif
 
 }  // namespace internal_apsides
@@ -0,0 +1,89 @@
+﻿
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "geometry/named_quantities.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_barnes_hut_tree {
+
+using geometry::Position;
+using geometry::Vector;
+using quantities::Acceleration;
+using quantities::GravitationalParameter;
+using quantities::Length;
+
+// An octree used to approximate the mutual attraction of a large number of
+// point masses in O(N log N), see Barnes and Hut (1986), "A hierarchical
+// O(N log N) force-calculation algorithm".  A cell is replaced by a point mass
+// at its barycentre when it is seen from a body at a distance larger than
+// |side / opening_angle + δ|, where |δ| is the distance between the barycentre
+// and the centre of the cell; this is the criterion of Salmon and Warren
+// (1994), which guards against barycentres far from the centre of their cell.
+// The error is controlled by the |opening_angle|; an |opening_angle| of 0
+// yields the direct sum.
+template<typename Frame>
+class BarnesHutTree final {
+ public:
+  // The tree keeps a reference to |gravitational_parameters|, which must
+  // outlive it and have the same size as |positions|.
+  BarnesHutTree(
+      std::vector<Position<Frame>> positions,
+      std::vector<GravitationalParameter> const& gravitational_parameters,
+      double opening_angle);
+
+  // Returns the acceleration exerted on the body with index |b| by all the
+  // other bodies of the tree.
+  Vector<Acceleration, Frame> AccelerationOn(int b) const;
+
+ private:
+  struct Cell final {
+    // The centre of the cube covered by this cell and half of its side.
+    Position<Frame> centre;
+    Length half_side;
+    GravitationalParameter gravitational_parameter;
+    Position<Frame> barycentre;
+    // The distance beyond which this cell may be replaced by a point mass.
+    Length opening_distance;
+    // The bodies in this cell are |order_[begin]|...|order_[end - 1]|.
+    int begin;
+    int end;
+    bool is_leaf;
+    // Indices in |cells_|, or -1 if the corresponding octant is empty.
+    std::array<int, 8> children;
+  };
+
+  // Appends to |cells_| a cell for the bodies |order_[begin]|...
+  // |order_[end - 1]|, and recursively its children.  Returns the index of the
+  // new cell.
+  int AddCell(Position<Frame> const& centre,
+              Length const& half_side,
+              int begin,
+              int end,
+              int depth);
+
+  std::vector<Position<Frame>> const positions_;
+  std::vector<GravitationalParameter> const& gravitational_parameters_;
+  double const opening_angle_;
+
+  // A permutation of the bodies such that each cell covers a contiguous range.
+  std::vector<int> order_;
+  // The inverse of |order_|.
+  std::vector<int> rank_;
+  // The root is at index 0.
+  std::vector<Cell> cells_;
+};
+
+}  // namespace internal_barnes_hut_tree
+
+using internal_barnes_hut_tree::BarnesHutTree;
+
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/barnes_hut_tree_body.hpp"
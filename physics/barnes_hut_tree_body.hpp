@@ -0,0 +1,211 @@
+﻿
+#pragma once
+
+#include "physics/barnes_hut_tree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "geometry/barycentre_calculator.hpp"
+#include "geometry/r3_element.hpp"
+#include "glog/logging.h"
+#include "quantities/elementary_functions.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_barnes_hut_tree {
+
+using geometry::BarycentreCalculator;
+using geometry::Displacement;
+using geometry::R3Element;
+using quantities::Exponentiation;
+using quantities::Infinity;
+using quantities::Sqrt;
+using quantities::Square;
+
+// Beyond this depth, cells are not split anymore.  This only matters for
+// bodies that are (nearly) coincident.
+constexpr int max_depth = 64;
+
+// The traversal in |AccelerationOn| is depth-first: when a cell is popped, its
+// at most 8 children are pushed, so the stack never holds more than 7 siblings
+// of each ancestor of the current cell in addition to the 8 children of the
+// cell itself.  This bound lets the stack live in a fixed-size array, which
+// avoids an allocation for each body on each evaluation.
+constexpr int max_traversal_stack_size = 7 * max_depth + 8;
+
+template<typename Frame>
+BarnesHutTree<Frame>::BarnesHutTree(
+    std::vector<Position<Frame>> positions,
+    std::vector<GravitationalParameter> const& gravitational_parameters,
+    double const opening_angle)
+    : positions_(std::move(positions)),
+      gravitational_parameters_(gravitational_parameters),
+      opening_angle_(opening_angle),
+      order_(positions_.size()),
+      rank_(positions_.size()) {
+  CHECK_EQ(positions_.size(), gravitational_parameters_.size());
+  CHECK_LE(0, opening_angle_);
+  if (positions_.empty()) {
+    return;
+  }
+  std::iota(order_.begin(), order_.end(), 0);
+
+  // The root is the smallest cube centred on the bounding box of the bodies.
+  R3Element<Length> min = (positions_.front() - Frame::origin).coordinates();
+  R3Element<Length> max = min;
+  for (auto const& position : positions_) {
+    R3Element<Length> const q = (position - Frame::origin).coordinates();
+    for (int i = 0; i < 3; ++i) {
+      min[i] = std::min(min[i], q[i]);
+      max[i] = std::max(max[i], q[i]);
+    }
+  }
+  R3Element<Length> const extent = max - min;
+  Length const half_side =
+      std::max({extent.x, extent.y, extent.z}) / 2;
+  Position<Frame> const centre =
+      Frame::origin + Displacement<Frame>((min + max) / 2);
+
+  cells_.reserve(2 * positions_.size());
+  AddCell(centre, half_side, /*begin=*/0, /*end=*/positions_.size(), 0);
+
+  for (int i = 0; i < order_.size(); ++i) {
+    rank_[order_[i]] = i;
+  }
+}
+
+template<typename Frame>
+Vector<Acceleration, Frame> BarnesHutTree<Frame>::AccelerationOn(
+    int const b) const {
+  Position<Frame> const& position_of_b = positions_[b];
+  int const rank_of_b = rank_[b];
+  Vector<Acceleration, Frame> acceleration;
+
+  auto const add_attraction = [&acceleration, &position_of_b](
+                                  Position<Frame> const& position,
+                                  GravitationalParameter const& μ) {
+    // A vector from |b| to the attracting mass.
+    Displacement<Frame> const Δq = position - position_of_b;
+    Square<Length> const Δq² = Δq.Norm²();
+    Exponentiation<Length, -3> const one_over_Δq³ = Sqrt(Δq²) / (Δq² * Δq²);
+    acceleration += Δq * (μ * one_over_Δq³);
+  };
+
+  std::array<int, max_traversal_stack_size> stack;
+  int stack_size = 0;
+  if (!cells_.empty()) {
+    stack[stack_size++] = 0;
+  }
+  while (stack_size > 0) {
+    Cell const& cell = cells_[stack[--stack_size]];
+    bool const contains_b = cell.begin <= rank_of_b && rank_of_b < cell.end;
+    if (!contains_b &&
+        (cell.barycentre - position_of_b).Norm²() >
+            cell.opening_distance * cell.opening_distance) {
+      add_attraction(cell.barycentre, cell.gravitational_parameter);
+    } else if (cell.is_leaf) {
+      for (int i = cell.begin; i < cell.end; ++i) {
+        if (i != rank_of_b) {
+          int const b2 = order_[i];
+          add_attraction(positions_[b2], gravitational_parameters_[b2]);
+        }
+      }
+    } else {
+      for (int const child : cell.children) {
+        if (child >= 0) {
+          DCHECK_LT(stack_size, max_traversal_stack_size);
+          stack[stack_size++] = child;
+        }
+      }
+    }
+  }
+  return acceleration;
+}
+
+template<typename Frame>
+int BarnesHutTree<Frame>::AddCell(Position<Frame> const& centre,
+                                  Length const& half_side,
+                                  int const begin,
+                                  int const end,
+                                  int const depth) {
+  int const index = cells_.size();
+  cells_.emplace_back();
+  {
+    Cell& cell = cells_.back();
+    cell.centre = centre;
+    cell.half_side = half_side;
+    cell.begin = begin;
+    cell.end = end;
+    cell.is_leaf = true;
+    cell.children.fill(-1);
+
+    BarycentreCalculator<Position<Frame>, GravitationalParameter> calculator;
+    for (int i = begin; i < end; ++i) {
+      calculator.Add(positions_[order_[i]],
+                     gravitational_parameters_[order_[i]]);
+    }
+    cell.gravitational_parameter = calculator.weight();
+    cell.barycentre = calculator.Get();
+    cell.opening_distance =
+        opening_angle_ == 0
+            ? Infinity<Length>()
+            : 2 * half_side / opening_angle_ +
+                  (cell.barycentre - centre).Norm();
+  }
+
+  if (end - begin <= 1 || depth == max_depth) {
+    return index;
+  }
+
+  // Split the bodies into octants.  The octant with index |o| is on the
+  // positive side of the centre along the axes given by the bits of |o|.
+  auto const below = [this, &centre](int const axis) {
+    return [this, &centre, axis](int const b) {
+      return (positions_[b] - centre).coordinates()[axis] < Length();
+    };
+  };
+  std::array<int, 9> bounds;
+  bounds[0] = begin;
+  bounds[8] = end;
+  auto const partition = [this, &bounds](int const lower,
+                                         int const upper,
+                                         auto const& predicate) {
+    bounds[(lower + upper) / 2] =
+        std::partition(order_.begin() + bounds[lower],
+                       order_.begin() + bounds[upper],
+                       predicate) - order_.begin();
+  };
+  partition(0, 8, below(0));
+  partition(0, 4, below(1));
+  partition(4, 8, below(1));
+  partition(0, 2, below(2));
+  partition(2, 4, below(2));
+  partition(4, 6, below(2));
+  partition(6, 8, below(2));
+
+  cells_[index].is_leaf = false;
+  Length const quarter_side = half_side / 2;
+  for (int o = 0; o < 8; ++o) {
+    if (bounds[o] < bounds[o + 1]) {
+      R3Element<Length> const offset((o & 4) ? quarter_side : -quarter_side,
+                                     (o & 2) ? quarter_side : -quarter_side,
+                                     (o & 1) ? quarter_side : -quarter_side);
+      int const child = AddCell(centre + Displacement<Frame>(offset),
+                                quarter_side,
+                                bounds[o],
+                                bounds[o + 1],
+                                depth + 1);
+      // |cells_| may have been reallocated.
+      cells_[index].children[o] = child;
+    }
+  }
+  return index;
+}
+
+}  // namespace internal_barnes_hut_tree
+}  // namespace physics
+}  // namespace principia
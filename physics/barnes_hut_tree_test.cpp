@@ -0,0 +1,106 @@
+﻿
+#include "physics/barnes_hut_tree.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "geometry/frame.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "quantities/astronomy.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/numerics.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_barnes_hut_tree {
+
+using geometry::Displacement;
+using geometry::Frame;
+using quantities::Pow;
+using quantities::astronomy::AstronomicalUnit;
+using quantities::si::Metre;
+using quantities::si::Second;
+using testing_utilities::RelativeError;
+using ::testing::Eq;
+using ::testing::Lt;
+
+class BarnesHutTreeTest : public ::testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      serialization::Frame::TEST,
+                      /*frame_is_inertial=*/true>;
+
+  // A flattened cloud of |n| bodies of comparable masses, reminiscent of an
+  // asteroid belt.
+  void MakeBodies(int const n) {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> distribution(-1, 1);
+    for (int i = 0; i < n; ++i) {
+      positions_.push_back(
+          World::origin +
+          Displacement<World>({distribution(random) * AstronomicalUnit,
+                               distribution(random) * AstronomicalUnit,
+                               0.1 * distribution(random) * AstronomicalUnit}));
+      gravitational_parameters_.push_back(
+          (1 + 0.5 * distribution(random)) * Pow<3>(Metre) / Pow<2>(Second));
+    }
+  }
+
+  Vector<Acceleration, World> DirectSum(int const b) const {
+    Vector<Acceleration, World> acceleration;
+    for (int b2 = 0; b2 < positions_.size(); ++b2) {
+      if (b2 != b) {
+        Displacement<World> const Δq = positions_[b2] - positions_[b];
+        acceleration += gravitational_parameters_[b2] * Δq /
+                        Pow<3>(Δq.Norm());
+      }
+    }
+    return acceleration;
+  }
+
+  std::vector<Position<World>> positions_;
+  std::vector<GravitationalParameter> gravitational_parameters_;
+};
+
+TEST_F(BarnesHutTreeTest, SingleBody) {
+  MakeBodies(1);
+  BarnesHutTree<World> const tree(
+      positions_, gravitational_parameters_, /*opening_angle=*/0.5);
+  EXPECT_THAT(tree.AccelerationOn(0), Eq(Vector<Acceleration, World>()));
+}
+
+TEST_F(BarnesHutTreeTest, DirectSum) {
+  MakeBodies(1000);
+  BarnesHutTree<World> const tree(
+      positions_, gravitational_parameters_, /*opening_angle=*/0);
+  for (int b = 0; b < positions_.size(); ++b) {
+    // Not bitwise identical because the order of the summation differs.
+    EXPECT_THAT(RelativeError(DirectSum(b), tree.AccelerationOn(b)),
+                Lt(1e-14)) << b;
+  }
+}
+
+TEST_F(BarnesHutTreeTest, OpeningAngle) {
+  MakeBodies(1000);
+  auto const max_relative_error = [this](double const opening_angle) {
+    BarnesHutTree<World> const tree(
+        positions_, gravitational_parameters_, opening_angle);
+    double result = 0;
+    for (int b = 0; b < positions_.size(); ++b) {
+      result = std::max(result,
+                        RelativeError(DirectSum(b), tree.AccelerationOn(b)));
+    }
+    return result;
+  };
+  // The worst errors are for the bodies near the centre of the cloud, where
+  // the attractions nearly cancel out.
+  EXPECT_THAT(max_relative_error(0.3), Lt(2.5e-2));
+  EXPECT_THAT(max_relative_error(0.5), Lt(7e-2));
+}
+
+}  // namespace internal_barnes_hut_tree
+}  // namespace physics
+}  // namespace principia
@@ -9,6 +9,8 @@
 #ifndef PRINCIPIA_PHYSICS_BARYCENTRIC_ROTATING_DYNAMIC_FRAME_HPP_
 #define PRINCIPIA_PHYSICS_BARYCENTRIC_ROTATING_DYNAMIC_FRAME_HPP_
 
+#include <vector>
+
 #include "base/not_null.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/named_quantities.hpp"
@@ -55,6 +57,12 @@ class BarycentricRotatingDynamicFrame
 
   RigidMotion<InertialFrame, ThisFrame> ToThisFrameAtTime(
       Instant const& t) const override;
+  std::vector<DegreesOfFreedom<ThisFrame>> ToThisFrameAtTimes(
+      std::vector<Instant> const& times,
+      std::vector<DegreesOfFreedom<InertialFrame>> const& degrees_of_freedom)
+      const override;
+  std::vector<RigidMotion<InertialFrame, ThisFrame>> MotionsToThisFrameAtTimes(
+      std::vector<Instant> const& times) const override;
 
   void WriteToMessage(
       not_null<serialization::DynamicFrame*> message) const override;
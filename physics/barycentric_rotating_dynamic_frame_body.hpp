@@ -98,6 +98,84 @@ BarycentricRotatingDynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTime(
              barycentre_degrees_of_freedom.velocity());
 }
 
+template<typename InertialFrame, typename ThisFrame>
+std::vector<DegreesOfFreedom<ThisFrame>>
+BarycentricRotatingDynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTimes(
+    std::vector<Instant> const& times,
+    std::vector<DegreesOfFreedom<InertialFrame>> const& degrees_of_freedom)
+    const {
+  CHECK_EQ(times.size(), degrees_of_freedom.size());
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      primary_degrees_of_freedom =
+          primary_trajectory_->EvaluateAllDegreesOfFreedom(times);
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      secondary_degrees_of_freedom =
+          secondary_trajectory_->EvaluateAllDegreesOfFreedom(times);
+
+  std::vector<DegreesOfFreedom<ThisFrame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    DegreesOfFreedom<InertialFrame> const barycentre_degrees_of_freedom =
+        Barycentre<DegreesOfFreedom<InertialFrame>, GravitationalParameter>(
+            {primary_degrees_of_freedom[i],
+             secondary_degrees_of_freedom[i]},
+            {primary_->gravitational_parameter(),
+             secondary_->gravitational_parameter()});
+
+    Rotation<InertialFrame, ThisFrame> rotation =
+            Rotation<InertialFrame, ThisFrame>::Identity();
+    AngularVelocity<InertialFrame> angular_velocity;
+    ComputeAngularDegreesOfFreedom(primary_degrees_of_freedom[i],
+                                   secondary_degrees_of_freedom[i],
+                                   rotation,
+                                   angular_velocity);
+    result.push_back(this->ApplyMotion(barycentre_degrees_of_freedom,
+                                       rotation,
+                                       angular_velocity,
+                                       degrees_of_freedom[i]));
+  }
+  return result;
+}
+
+template<typename InertialFrame, typename ThisFrame>
+std::vector<RigidMotion<InertialFrame, ThisFrame>>
+BarycentricRotatingDynamicFrame<InertialFrame, ThisFrame>::
+    MotionsToThisFrameAtTimes(std::vector<Instant> const& times) const {
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      primary_degrees_of_freedom =
+          primary_trajectory_->EvaluateAllDegreesOfFreedom(times);
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      secondary_degrees_of_freedom =
+          secondary_trajectory_->EvaluateAllDegreesOfFreedom(times);
+
+  std::vector<RigidMotion<InertialFrame, ThisFrame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    DegreesOfFreedom<InertialFrame> const barycentre_degrees_of_freedom =
+        Barycentre<DegreesOfFreedom<InertialFrame>, GravitationalParameter>(
+            {primary_degrees_of_freedom[i],
+             secondary_degrees_of_freedom[i]},
+            {primary_->gravitational_parameter(),
+             secondary_->gravitational_parameter()});
+
+    Rotation<InertialFrame, ThisFrame> rotation =
+            Rotation<InertialFrame, ThisFrame>::Identity();
+    AngularVelocity<InertialFrame> angular_velocity;
+    ComputeAngularDegreesOfFreedom(primary_degrees_of_freedom[i],
+                                   secondary_degrees_of_freedom[i],
+                                   rotation,
+                                   angular_velocity);
+    result.emplace_back(
+        RigidTransformation<InertialFrame, ThisFrame>(
+            barycentre_degrees_of_freedom.position(),
+            ThisFrame::origin,
+            rotation.Forget()),
+        angular_velocity,
+        barycentre_degrees_of_freedom.velocity());
+  }
+  return result;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 void BarycentricRotatingDynamicFrame<InertialFrame, ThisFrame>::
 WriteToMessage(not_null<serialization::DynamicFrame*> const message) const {
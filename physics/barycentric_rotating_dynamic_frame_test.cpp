@@ -2,6 +2,7 @@
 #include "physics/barycentric_rotating_dynamic_frame.hpp"
 
 #include <memory>
+#include <vector>
 
 #include "astronomy/frames.hpp"
 #include "geometry/barycentre_calculator.hpp"
@@ -204,6 +205,39 @@ TEST_F(BarycentricRotatingDynamicFrameTest, Inverse) {
   }
 }
 
+TEST_F(BarycentricRotatingDynamicFrameTest, ToThisFrameAtTimes) {
+  int const steps = 100;
+  std::vector<Instant> times;
+  std::vector<DegreesOfFreedom<ICRS>> degrees_of_freedom;
+  for (Instant t = t0_; t < t0_ + 1 * period_; t += period_ / steps) {
+    times.push_back(t);
+    degrees_of_freedom.push_back(
+        solar_system_.trajectory(*ephemeris_, small)
+            .EvaluateDegreesOfFreedom(t + period_ / (2 * steps)));
+  }
+  auto const degrees_of_freedom_in_big_small =
+      big_small_frame_->ToThisFrameAtTimes(times, degrees_of_freedom);
+  auto const motions = big_small_frame_->MotionsToThisFrameAtTimes(times);
+  ASSERT_EQ(times.size(), degrees_of_freedom_in_big_small.size());
+  ASSERT_EQ(times.size(), motions.size());
+  for (int i = 0; i < times.size(); ++i) {
+    DegreesOfFreedom<BigSmallFrame> const expected =
+        big_small_frame_->ToThisFrameAtTime(times[i])(degrees_of_freedom[i]);
+    EXPECT_THAT(AbsoluteError(degrees_of_freedom_in_big_small[i].position(),
+                              expected.position()),
+                Lt(1.0e-11 * Metre));
+    EXPECT_THAT(AbsoluteError(degrees_of_freedom_in_big_small[i].velocity(),
+                              expected.velocity()),
+                Lt(1.0e-11 * Metre / Second));
+    DegreesOfFreedom<BigSmallFrame> const actual =
+        motions[i](degrees_of_freedom[i]);
+    EXPECT_THAT(AbsoluteError(actual.position(), expected.position()),
+                Lt(1.0e-11 * Metre));
+    EXPECT_THAT(AbsoluteError(actual.velocity(), expected.velocity()),
+                Lt(1.0e-11 * Metre / Second));
+  }
+}
+
 // Two bodies in rotation with their barycentre at rest.  The test point is at
 // the origin and in motion.  The acceleration is purely due to Coriolis.
 TEST_F(BarycentricRotatingDynamicFrameTest, CoriolisAcceleration) {
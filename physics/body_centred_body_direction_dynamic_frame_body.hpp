@@ -118,6 +118,71 @@ BodyCentredBodyDirectionDynamicFrame<InertialFrame, ThisFrame>::
              primary_degrees_of_freedom.velocity());
 }
 
+template<typename InertialFrame, typename ThisFrame>
+std::vector<DegreesOfFreedom<ThisFrame>>
+BodyCentredBodyDirectionDynamicFrame<InertialFrame, ThisFrame>::
+    ToThisFrameAtTimes(
+        std::vector<Instant> const& times,
+        std::vector<DegreesOfFreedom<InertialFrame>> const& degrees_of_freedom)
+        const {
+  CHECK_EQ(times.size(), degrees_of_freedom.size());
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      primary_degrees_of_freedom =
+          primary_trajectory_().EvaluateAllDegreesOfFreedom(times);
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      secondary_degrees_of_freedom =
+          secondary_trajectory_->EvaluateAllDegreesOfFreedom(times);
+
+  std::vector<DegreesOfFreedom<ThisFrame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    Rotation<InertialFrame, ThisFrame> rotation =
+        Rotation<InertialFrame, ThisFrame>::Identity();
+    AngularVelocity<InertialFrame> angular_velocity;
+    ComputeAngularDegreesOfFreedom(primary_degrees_of_freedom[i],
+                                   secondary_degrees_of_freedom[i],
+                                   rotation,
+                                   angular_velocity);
+    result.push_back(this->ApplyMotion(primary_degrees_of_freedom[i],
+                                       rotation,
+                                       angular_velocity,
+                                       degrees_of_freedom[i]));
+  }
+  return result;
+}
+
+template<typename InertialFrame, typename ThisFrame>
+std::vector<RigidMotion<InertialFrame, ThisFrame>>
+BodyCentredBodyDirectionDynamicFrame<InertialFrame, ThisFrame>::
+    MotionsToThisFrameAtTimes(std::vector<Instant> const& times) const {
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      primary_degrees_of_freedom =
+          primary_trajectory_().EvaluateAllDegreesOfFreedom(times);
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      secondary_degrees_of_freedom =
+          secondary_trajectory_->EvaluateAllDegreesOfFreedom(times);
+
+  std::vector<RigidMotion<InertialFrame, ThisFrame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    Rotation<InertialFrame, ThisFrame> rotation =
+        Rotation<InertialFrame, ThisFrame>::Identity();
+    AngularVelocity<InertialFrame> angular_velocity;
+    ComputeAngularDegreesOfFreedom(primary_degrees_of_freedom[i],
+                                   secondary_degrees_of_freedom[i],
+                                   rotation,
+                                   angular_velocity);
+    result.emplace_back(
+        RigidTransformation<InertialFrame, ThisFrame>(
+            primary_degrees_of_freedom[i].position(),
+            ThisFrame::origin,
+            rotation.Forget()),
+        angular_velocity,
+        primary_degrees_of_freedom[i].velocity());
+  }
+  return result;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 void BodyCentredBodyDirectionDynamicFrame<InertialFrame, ThisFrame>::
 WriteToMessage(not_null<serialization::DynamicFrame*> const message) const {
@@ -79,6 +79,51 @@ BodyCentredNonRotatingDynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTime(
              centre_degrees_of_freedom.velocity());
 }
 
+template<typename InertialFrame, typename ThisFrame>
+std::vector<DegreesOfFreedom<ThisFrame>>
+BodyCentredNonRotatingDynamicFrame<InertialFrame, ThisFrame>::
+    ToThisFrameAtTimes(
+        std::vector<Instant> const& times,
+        std::vector<DegreesOfFreedom<InertialFrame>> const& degrees_of_freedom)
+        const {
+  CHECK_EQ(times.size(), degrees_of_freedom.size());
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      centre_degrees_of_freedom =
+          centre_trajectory_->EvaluateAllDegreesOfFreedom(times);
+
+  std::vector<DegreesOfFreedom<ThisFrame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    result.push_back(this->ApplyMotion(centre_degrees_of_freedom[i],
+                                       orthogonal_map_,
+                                       AngularVelocity<InertialFrame>(),
+                                       degrees_of_freedom[i]));
+  }
+  return result;
+}
+
+template<typename InertialFrame, typename ThisFrame>
+std::vector<RigidMotion<InertialFrame, ThisFrame>>
+BodyCentredNonRotatingDynamicFrame<InertialFrame, ThisFrame>::
+    MotionsToThisFrameAtTimes(std::vector<Instant> const& times) const {
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      centre_degrees_of_freedom =
+          centre_trajectory_->EvaluateAllDegreesOfFreedom(times);
+
+  std::vector<RigidMotion<InertialFrame, ThisFrame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    result.emplace_back(
+        RigidTransformation<InertialFrame, ThisFrame>(
+            centre_degrees_of_freedom[i].position(),
+            ThisFrame::origin,
+            orthogonal_map_),
+        AngularVelocity<InertialFrame>(),
+        centre_degrees_of_freedom[i].velocity());
+  }
+  return result;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 void BodyCentredNonRotatingDynamicFrame<InertialFrame, ThisFrame>::
 WriteToMessage(not_null<serialization::DynamicFrame*> const message) const {
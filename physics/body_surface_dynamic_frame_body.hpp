@@ -63,6 +63,58 @@ BodySurfaceDynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTime(
              centre_degrees_of_freedom.velocity());
 }
 
+template<typename InertialFrame, typename ThisFrame>
+std::vector<DegreesOfFreedom<ThisFrame>>
+BodySurfaceDynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTimes(
+    std::vector<Instant> const& times,
+    std::vector<DegreesOfFreedom<InertialFrame>> const& degrees_of_freedom)
+    const {
+  CHECK_EQ(times.size(), degrees_of_freedom.size());
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      centre_degrees_of_freedom =
+          centre_trajectory_->EvaluateAllDegreesOfFreedom(times);
+  std::vector<Rotation<InertialFrame, ThisFrame>> const rotations =
+      centre_->template ToSurfaceFrame<ThisFrame>(times);
+  AngularVelocity<InertialFrame> const angular_velocity =
+      centre_->angular_velocity();
+
+  std::vector<DegreesOfFreedom<ThisFrame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    result.push_back(this->ApplyMotion(centre_degrees_of_freedom[i],
+                                       rotations[i],
+                                       angular_velocity,
+                                       degrees_of_freedom[i]));
+  }
+  return result;
+}
+
+template<typename InertialFrame, typename ThisFrame>
+std::vector<RigidMotion<InertialFrame, ThisFrame>>
+BodySurfaceDynamicFrame<InertialFrame, ThisFrame>::MotionsToThisFrameAtTimes(
+    std::vector<Instant> const& times) const {
+  std::vector<DegreesOfFreedom<InertialFrame>> const
+      centre_degrees_of_freedom =
+          centre_trajectory_->EvaluateAllDegreesOfFreedom(times);
+  std::vector<Rotation<InertialFrame, ThisFrame>> const rotations =
+      centre_->template ToSurfaceFrame<ThisFrame>(times);
+  AngularVelocity<InertialFrame> const angular_velocity =
+      centre_->angular_velocity();
+
+  std::vector<RigidMotion<InertialFrame, ThisFrame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    result.emplace_back(
+        RigidTransformation<InertialFrame, ThisFrame>(
+            centre_degrees_of_freedom[i].position(),
+            ThisFrame::origin,
+            rotations[i].Forget()),
+        angular_velocity,
+        centre_degrees_of_freedom[i].velocity());
+  }
+  return result;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 void BodySurfaceDynamicFrame<InertialFrame, ThisFrame>::
 WriteToMessage(not_null<serialization::DynamicFrame*> const message) const {
@@ -1,11 +1,14 @@
 ﻿
 #include "physics/body.hpp"
 
+#include <vector>
+
 #include "astronomy/epoch.hpp"
 #include "astronomy/frames.hpp"
 #include "astronomy/time_scales.hpp"
 #include "geometry/named_quantities.hpp"
 #include "geometry/r3_element.hpp"
+#include "geometry/rotation.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "integrators/symmetric_linear_multistep_integrator.hpp"
@@ -31,13 +34,16 @@ using astronomy::J2000;
 using geometry::AngleBetween;
 using geometry::AngularVelocity;
 using geometry::Bivector;
+using geometry::DefinesFrame;
 using geometry::Displacement;
+using geometry::EulerAngles;
 using geometry::Frame;
 using geometry::Instant;
 using geometry::Normalize;
 using geometry::OrientedAngleBetween;
 using geometry::Position;
 using geometry::RadiusLatitudeLongitude;
+using geometry::Rotation;
 using geometry::SphericalCoordinates;
 using geometry::Vector;
 using integrators::SymmetricLinearMultistepIntegrator;
@@ -347,6 +353,38 @@ TEST_F(BodyTest, AllFrames) {
   TestRotatingBody<serialization::Frame::TestTag, serialization::Frame::TO>();
 }
 
+TEST_F(BodyTest, SurfaceFrames) {
+  struct SurfaceFrame;
+  std::vector<Instant> times;
+  for (int i = 0; i < 100; ++i) {
+    times.push_back(Instant() + i * 1.7 * Second);
+  }
+  auto const from_surface_frame =
+      rotating_body_.FromSurfaceFrame<SurfaceFrame>(times);
+  auto const to_surface_frame =
+      rotating_body_.ToSurfaceFrame<SurfaceFrame>(times);
+  ASSERT_EQ(times.size(), from_surface_frame.size());
+  ASSERT_EQ(times.size(), to_surface_frame.size());
+  for (int i = 0; i < times.size(); ++i) {
+    Instant const& t = times[i];
+    // The batch computation is identical to the scalar one, which is identical
+    // to the definition in terms of Euler angles.
+    EXPECT_EQ(rotating_body_.FromSurfaceFrame<SurfaceFrame>(t).quaternion(),
+              from_surface_frame[i].quaternion());
+    EXPECT_EQ(rotating_body_.ToSurfaceFrame<SurfaceFrame>(t).quaternion(),
+              to_surface_frame[i].quaternion());
+    EXPECT_EQ((Rotation<SurfaceFrame, World>(
+                  π / 2 * Radian + right_ascension_of_pole_,
+                  π / 2 * Radian - declination_of_pole_,
+                  rotating_body_.AngleAt(t),
+                  EulerAngles::ZXZ,
+                  DefinesFrame<SurfaceFrame>{}).quaternion()),
+              from_surface_frame[i].quaternion());
+    EXPECT_THAT(from_surface_frame[i](Vector<double, SurfaceFrame>({0, 0, 1})),
+                AlmostEquals(rotating_body_.polar_axis(), 0, 8));
+  }
+}
+
 #if !defined(_DEBUG)
 
 // Check that the rotation of the Earth gives the right solar noon.
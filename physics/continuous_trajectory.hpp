@@ -87,6 +87,13 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(
       Instant const& time) const override EXCLUDES(lock_);
 
+  // These functions take the lock only once and benefit from the lookup cache
+  // if the |times| are sorted.
+  std::vector<Position<Frame>> EvaluatePositions(
+      std::vector<Instant> const& times) const override EXCLUDES(lock_);
+  std::vector<DegreesOfFreedom<Frame>> EvaluateAllDegreesOfFreedom(
+      std::vector<Instant> const& times) const override EXCLUDES(lock_);
+
   // End of the implementation of the interface.
 
   void WriteToMessage(not_null<serialization::ContinuousTrajectory*> message)
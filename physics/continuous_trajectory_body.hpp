@@ -199,8 +199,50 @@ DegreesOfFreedom<Frame> ContinuousTrajectory<Frame>::EvaluateDegreesOfFreedom(
   auto const it = FindPolynomialForInstant(time);
   CHECK(it != polynomials_.end());
   auto const& polynomial = it->polynomial;
-  return DegreesOfFreedom<Frame>(polynomial->Evaluate(time) + Frame::origin,
-                                 polynomial->EvaluateDerivative(time));
+  Displacement<Frame> displacement;
+  Velocity<Frame> velocity;
+  polynomial->EvaluateWithDerivative(time, displacement, velocity);
+  return DegreesOfFreedom<Frame>(displacement + Frame::origin, velocity);
+}
+
+template<typename Frame>
+std::vector<Position<Frame>> ContinuousTrajectory<Frame>::EvaluatePositions(
+    std::vector<Instant> const& times) const {
+  std::vector<Position<Frame>> positions;
+  positions.reserve(times.size());
+  absl::ReaderMutexLock l(&lock_);
+  Instant const t_min = t_min_locked();
+  Instant const t_max = t_max_locked();
+  for (Instant const& time : times) {
+    CHECK_LE(t_min, time);
+    CHECK_GE(t_max, time);
+    auto const it = FindPolynomialForInstant(time);
+    CHECK(it != polynomials_.end());
+    positions.push_back(it->polynomial->Evaluate(time) + Frame::origin);
+  }
+  return positions;
+}
+
+template<typename Frame>
+std::vector<DegreesOfFreedom<Frame>>
+ContinuousTrajectory<Frame>::EvaluateAllDegreesOfFreedom(
+    std::vector<Instant> const& times) const {
+  std::vector<DegreesOfFreedom<Frame>> degrees_of_freedom;
+  degrees_of_freedom.reserve(times.size());
+  absl::ReaderMutexLock l(&lock_);
+  Instant const t_min = t_min_locked();
+  Instant const t_max = t_max_locked();
+  Displacement<Frame> displacement;
+  Velocity<Frame> velocity;
+  for (Instant const& time : times) {
+    CHECK_LE(t_min, time);
+    CHECK_GE(t_max, time);
+    auto const it = FindPolynomialForInstant(time);
+    CHECK(it != polynomials_.end());
+    it->polynomial->EvaluateWithDerivative(time, displacement, velocity);
+    degrees_of_freedom.emplace_back(displacement + Frame::origin, velocity);
+  }
+  return degrees_of_freedom;
 }
 
 template<typename Frame>
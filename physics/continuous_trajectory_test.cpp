@@ -430,6 +430,23 @@ TEST_F(ContinuousTrajectoryTest, Polynomial) {
               DegreesOfFreedom<World>(trajectory->EvaluatePosition(time),
                                       trajectory->EvaluateVelocity(time)));
   }
+
+  std::vector<Instant> times;
+  for (Instant time = trajectory->t_min();
+       time <= trajectory->t_max();
+       time += step / number_of_substeps) {
+    times.push_back(time);
+  }
+  auto const positions = trajectory->EvaluatePositions(times);
+  auto const degrees_of_freedom =
+      trajectory->EvaluateAllDegreesOfFreedom(times);
+  ASSERT_EQ(times.size(), positions.size());
+  ASSERT_EQ(times.size(), degrees_of_freedom.size());
+  for (int i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(trajectory->EvaluatePosition(times[i]), positions[i]);
+    EXPECT_EQ(trajectory->EvaluateDegreesOfFreedom(times[i]),
+              degrees_of_freedom[i]);
+  }
 }
 
 // An approximation to the trajectory of Io.
@@ -6,6 +6,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "base/not_constructible.hpp"
@@ -250,6 +251,14 @@ class DiscreteTrajectory : public Forkable<DiscreteTrajectory<Frame>,
       serialization::DiscreteTrajectory const& message,
       std::vector<DiscreteTrajectory<Frame>**> const& forks);
 
+  // Losslessly compresses |timeline_| into |bytes|.  Each double is stored as
+  // its residual with respect to an extrapolation from the previous points,
+  // which is small because the timeline is smooth.
+  void CompressTimeline(not_null<std::string*> bytes) const;
+
+  // Appends the points compressed by |CompressTimeline| to this trajectory.
+  void AppendCompressedTimeline(std::string const& bytes);
+
   // Returns the Hermite interpolation for the left-open, right-closed
   // trajectory segment containing the given |time|, or, if |time| is |t_min()|,
   // returns a first-degree polynomial which should be evaluated only at
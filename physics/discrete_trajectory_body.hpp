@@ -4,14 +4,20 @@
 #include "physics/discrete_trajectory.hpp"
 
 #include <algorithm>
+#include <array>
 #include <list>
 #include <map>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "astronomy/epoch.hpp"
+#include "base/macros.hpp"
+#include "base/xor_compression.hpp"
 #include "geometry/named_quantities.hpp"
 #include "glog/logging.h"
 #include "numerics/fit_hermite_spline.hpp"
+#include "quantities/si.hpp"
 
 namespace principia {
 namespace physics {
@@ -55,7 +61,96 @@ namespace internal_discrete_trajectory {
 using astronomy::InfiniteFuture;
 using astronomy::InfinitePast;
 using base::make_not_null_unique;
+using base::XorCompressor;
+using base::XorDecompressor;
+using geometry::Displacement;
 using numerics::FitHermiteSpline;
+using quantities::si::Metre;
+using quantities::si::Second;
+
+// Extrapolates the doubles representing a point of a timeline from the
+// previous two points, for use by the compression of the timeline.  The time
+// is extrapolated linearly, the positions and velocities assuming a constant
+// acceleration.  The extrapolation must be reproducible for the decompression
+// to be lossless, so each arithmetic operation is a separate statement and
+// contraction into FMAs is turned off, as in numerics/sin_cos_body.hpp.
+class TimelineExtrapolator {
+ public:
+  // The time in seconds and the coordinates of the position and velocity in SI
+  // units.
+  struct Point {
+    double time;
+    std::array<double, 3> position;
+    std::array<double, 3> velocity;
+  };
+
+  double Time() const;
+  // |time| is the actual time of the point being extrapolated.
+  double PositionCoordinate(int i, double time) const;
+  double VelocityCoordinate(int i, double time) const;
+
+  void Append(Point const& point);
+
+ private:
+  std::optional<Point> second_to_last_;
+  std::optional<Point> last_;
+};
+
+inline double TimelineExtrapolator::Time() const {
+  PRINCIPIA_NO_FP_CONTRACT
+  if (!last_.has_value()) {
+    return 0;
+  } else if (!second_to_last_.has_value()) {
+    return last_->time;
+  } else {
+    double const Δt = last_->time - second_to_last_->time;
+    return last_->time + Δt;
+  }
+}
+
+inline double TimelineExtrapolator::PositionCoordinate(
+    int const i,
+    double const time) const {
+  PRINCIPIA_NO_FP_CONTRACT
+  if (!last_.has_value()) {
+    return 0;
+  }
+  double const Δt = time - last_->time;
+  double mean_velocity = last_->velocity[i];
+  if (second_to_last_.has_value()) {
+    double const Δv = last_->velocity[i] - second_to_last_->velocity[i];
+    double const previous_Δt = last_->time - second_to_last_->time;
+    double const acceleration = Δv / previous_Δt;
+    double const velocity_change = acceleration * Δt;
+    double const half_velocity_change = 0.5 * velocity_change;
+    mean_velocity = mean_velocity + half_velocity_change;
+  }
+  double const displacement = mean_velocity * Δt;
+  return last_->position[i] + displacement;
+}
+
+inline double TimelineExtrapolator::VelocityCoordinate(
+    int const i,
+    double const time) const {
+  PRINCIPIA_NO_FP_CONTRACT
+  if (!last_.has_value()) {
+    return 0;
+  } else if (!second_to_last_.has_value()) {
+    return last_->velocity[i];
+  } else {
+    double const Δt = time - last_->time;
+    double const Δv = last_->velocity[i] - second_to_last_->velocity[i];
+    double const previous_Δt = last_->time - second_to_last_->time;
+    double const acceleration = Δv / previous_Δt;
+    double const velocity_change = acceleration * Δt;
+    return last_->velocity[i] + velocity_change;
+  }
+}
+
+inline void TimelineExtrapolator::Append(Point const& point) {
+  second_to_last_ = last_;
+  last_ = point;
+}
 
 template<typename Frame>
 typename DiscreteTrajectory<Frame>::Iterator
@@ -496,13 +591,8 @@ void DiscreteTrajectory<Frame>::WriteSubTreeToMessage(
     not_null<serialization::DiscreteTrajectory*> const message,
     std::vector<DiscreteTrajectory<Frame>*>& forks) const {
   Forkable<DiscreteTrajectory, Iterator>::WriteSubTreeToMessage(message, forks);
-  for (auto const& pair : timeline_) {
-    Instant const& instant = pair.first;
-    DegreesOfFreedom<Frame> const& degrees_of_freedom = pair.second;
-    auto const instantaneous_degrees_of_freedom = message->add_timeline();
-    instant.WriteToMessage(instantaneous_degrees_of_freedom->mutable_instant());
-    degrees_of_freedom.WriteToMessage(
-        instantaneous_degrees_of_freedom->mutable_degrees_of_freedom());
+  if (!timeline_.empty()) {
+    CompressTimeline(message->mutable_compressed_timeline());
   }
   if (downsampling_.has_value()) {
     downsampling_->WriteToMessage(message->mutable_downsampling(), timeline_);
@@ -513,12 +603,17 @@ template<typename Frame>
 void DiscreteTrajectory<Frame>::FillSubTreeFromMessage(
     serialization::DiscreteTrajectory const& message,
     std::vector<DiscreteTrajectory<Frame>**> const& forks) {
-  for (auto timeline_it = message.timeline().begin();
-       timeline_it != message.timeline().end();
-       ++timeline_it) {
-    Append(Instant::ReadFromMessage(timeline_it->instant()),
-           DegreesOfFreedom<Frame>::ReadFromMessage(
-               timeline_it->degrees_of_freedom()));
+  bool const is_pre_fermat = !message.has_compressed_timeline();
+  if (is_pre_fermat) {
+    for (auto timeline_it = message.timeline().begin();
+         timeline_it != message.timeline().end();
+         ++timeline_it) {
+      Append(Instant::ReadFromMessage(timeline_it->instant()),
+             DegreesOfFreedom<Frame>::ReadFromMessage(
+                 timeline_it->degrees_of_freedom()));
+    }
+  } else {
+    AppendCompressedTimeline(message.compressed_timeline());
   }
   if (message.has_downsampling()) {
     CHECK(this->is_root());
@@ -529,6 +624,63 @@ void DiscreteTrajectory<Frame>::FillSubTreeFromMessage(
                                                                  forks);
 }
 
+template<typename Frame>
+void DiscreteTrajectory<Frame>::CompressTimeline(
+    not_null<std::string*> const bytes) const {
+  XorCompressor compressor(bytes);
+  TimelineExtrapolator extrapolator;
+  for (auto const& pair : timeline_) {
+    Instant const& time = pair.first;
+    DegreesOfFreedom<Frame> const& degrees_of_freedom = pair.second;
+    auto const q =
+        (degrees_of_freedom.position() - Frame::origin).coordinates() / Metre;
+    auto const v =
+        degrees_of_freedom.velocity().coordinates() / (Metre / Second);
+    TimelineExtrapolator::Point const point{(time - Instant()) / Second,
+                                            {q.x, q.y, q.z},
+                                            {v.x, v.y, v.z}};
+    compressor.Append(extrapolator.Time(), point.time);
+    for (int i = 0; i < 3; ++i) {
+      compressor.Append(extrapolator.PositionCoordinate(i, point.time),
+                        point.position[i]);
+    }
+    for (int i = 0; i < 3; ++i) {
+      compressor.Append(extrapolator.VelocityCoordinate(i, point.time),
+                        point.velocity[i]);
+    }
+    extrapolator.Append(point);
+  }
+}
+
+template<typename Frame>
+void DiscreteTrajectory<Frame>::AppendCompressedTimeline(
+    std::string const& bytes) {
+  XorDecompressor decompressor(bytes);
+  TimelineExtrapolator extrapolator;
+  // Each point is a group of 7 values, so |exhausted| is reliable here.
+  while (!decompressor.exhausted()) {
+    TimelineExtrapolator::Point point;
+    point.time = decompressor.Next(extrapolator.Time());
+    for (int i = 0; i < 3; ++i) {
+      point.position[i] =
+          decompressor.Next(extrapolator.PositionCoordinate(i, point.time));
+    }
+    for (int i = 0; i < 3; ++i) {
+      point.velocity[i] =
+          decompressor.Next(extrapolator.VelocityCoordinate(i, point.time));
+    }
+    extrapolator.Append(point);
+    Append(Instant() + point.time * Second,
+           DegreesOfFreedom<Frame>(
+               Frame::origin + Displacement<Frame>({point.position[0] * Metre,
+                                                    point.position[1] * Metre,
+                                                    point.position[2] * Metre}),
+               Velocity<Frame>({point.velocity[0] * (Metre / Second),
+                                point.velocity[1] * (Metre / Second),
+                                point.velocity[2] * (Metre / Second)})));
+  }
+}
+
 template<typename Frame>
 Hermite3<Instant, Position<Frame>> DiscreteTrajectory<Frame>::GetInterpolation(
     Instant const& time) const {
@@ -6,6 +6,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "geometry/frame.hpp"
@@ -724,55 +725,86 @@ TEST_F(DiscreteTrajectoryTest, TrajectorySerializationSuccess) {
                                            deserialized_fork2});
   EXPECT_THAT(reference_message, EqualsProto(message));
   EXPECT_THAT(message.children_size(), Eq(2));
-  EXPECT_THAT(message.timeline_size(), Eq(3));
-  EXPECT_THAT(Instant::ReadFromMessage(message.timeline(0).instant()), Eq(t1_));
-  EXPECT_THAT(Instant::ReadFromMessage(message.timeline(1).instant()), Eq(t2_));
-  EXPECT_THAT(Instant::ReadFromMessage(message.timeline(2).instant()), Eq(t3_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.timeline(0).degrees_of_freedom()), Eq(d1_));
-  EXPECT_THAT(
-        DegreesOfFreedom<World>::ReadFromMessage(
-            message.timeline(1).degrees_of_freedom()), Eq(d2_));
-  EXPECT_THAT(
-        DegreesOfFreedom<World>::ReadFromMessage(
-            message.timeline(2).degrees_of_freedom()), Eq(d3_));
+  EXPECT_THAT(message.timeline_size(), Eq(0));
+  EXPECT_TRUE(message.has_compressed_timeline());
   EXPECT_THAT(message.children(0).trajectories_size(), Eq(2));
   EXPECT_THAT(message.children(0).trajectories(0).children_size(), Eq(0));
-  EXPECT_THAT(message.children(0).trajectories(0).timeline_size(), Eq(1));
-  EXPECT_THAT(
-      Instant::ReadFromMessage(
-          message.children(0).trajectories(0).timeline(0).instant()), Eq(t3_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.children(0).trajectories(0).timeline(0).degrees_of_freedom()),
-      Eq(d3_));
   EXPECT_THAT(message.children(0).trajectories(1).children_size(), Eq(0));
-  EXPECT_THAT(message.children(0).trajectories(1).timeline_size(), Eq(2));
-  EXPECT_THAT(
-      Instant::ReadFromMessage(
-          message.children(0).trajectories(1).timeline(0).instant()), Eq(t3_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.children(0).trajectories(1).timeline(0).degrees_of_freedom()),
-      Eq(d3_));
-  EXPECT_THAT(
-      Instant::ReadFromMessage(
-          message.children(0).trajectories(1).timeline(1).instant()), Eq(t4_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.children(0).trajectories(1).timeline(1).degrees_of_freedom()),
-      Eq(d4_));
   EXPECT_THAT(message.children(1).trajectories_size(), Eq(1));
   EXPECT_THAT(message.children(1).trajectories(0).children_size(), Eq(0));
-  EXPECT_THAT(message.children(1).trajectories(0).timeline_size(), Eq(1));
-  EXPECT_THAT(
-      Instant::ReadFromMessage(
-          message.children(1).trajectories(0).timeline(0).instant()), Eq(t4_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.children(1).trajectories(0).timeline(0).degrees_of_freedom()),
-      Eq(d4_));
+
+  auto const points = [](DiscreteTrajectory<World> const& trajectory) {
+    std::vector<std::pair<Instant, DegreesOfFreedom<World>>> result;
+    for (auto it = trajectory.Begin(); it != trajectory.End(); ++it) {
+      result.emplace_back(it.time(), it.degrees_of_freedom());
+    }
+    return result;
+  };
+  EXPECT_THAT(points(*deserialized_trajectory),
+              ElementsAre(Pair(t1_, d1_), Pair(t2_, d2_), Pair(t3_, d3_)));
+  EXPECT_THAT(points(*deserialized_fork1),
+              ElementsAre(Pair(t1_, d1_), Pair(t2_, d2_), Pair(t3_, d3_)));
+  EXPECT_THAT(points(*deserialized_fork2),
+              ElementsAre(Pair(t1_, d1_),
+                          Pair(t2_, d2_),
+                          Pair(t3_, d3_),
+                          Pair(t4_, d4_)));
+  EXPECT_THAT(points(*deserialized_fork3),
+              ElementsAre(Pair(t1_, d1_),
+                          Pair(t2_, d2_),
+                          Pair(t3_, d3_),
+                          Pair(t4_, d4_)));
+}
+
+TEST_F(DiscreteTrajectoryTest, CompressedTimeline) {
+  DiscreteTrajectory<World> circle;
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Speed const v = ω * r / Radian;
+  for (auto t = DoublePrecision<Instant>(t0_);
+       t.value <= t0_ + 10 * Second;
+       t.Increment(10 * Milli(Second))) {
+    circle.Append(
+        t.value,
+        {World::origin + Displacement<World>{{r * Cos(ω * (t.value - t0_)),
+                                              r * Sin(ω * (t.value - t0_)),
+                                              0 * Metre}},
+         Velocity<World>{{-v * Sin(ω * (t.value - t0_)),
+                          v * Cos(ω * (t.value - t0_)),
+                          0 * Metre / Second}}});
+  }
+
+  serialization::DiscreteTrajectory compressed_message;
+  circle.WriteToMessage(&compressed_message, /*forks=*/{});
+  EXPECT_THAT(compressed_message.timeline_size(), Eq(0));
+
+  // The serialization used before compression.
+  serialization::DiscreteTrajectory uncompressed_message = compressed_message;
+  uncompressed_message.clear_compressed_timeline();
+  for (auto it = circle.Begin(); it != circle.End(); ++it) {
+    auto const instantaneous_degrees_of_freedom =
+        uncompressed_message.add_timeline();
+    it.time().WriteToMessage(
+        instantaneous_degrees_of_freedom->mutable_instant());
+    it.degrees_of_freedom().WriteToMessage(
+        instantaneous_degrees_of_freedom->mutable_degrees_of_freedom());
+  }
+  EXPECT_THAT(compressed_message.ByteSizeLong(),
+              Lt(uncompressed_message.ByteSizeLong() / 3));
+
+  // Both serializations are read exactly.
+  for (auto const* const message :
+       {&compressed_message, &uncompressed_message}) {
+    auto const deserialized_circle =
+        DiscreteTrajectory<World>::ReadFromMessage(*message, /*forks=*/{});
+    EXPECT_THAT(deserialized_circle->Size(), Eq(circle.Size()));
+    for (auto it1 = circle.Begin(), it2 = deserialized_circle->Begin();
+         it1 != circle.End();
+         ++it1, ++it2) {
+      EXPECT_THAT(it2.time(), Eq(it1.time()));
+      EXPECT_THAT(it2.degrees_of_freedom(), Eq(it1.degrees_of_freedom()));
+    }
+  }
 }
 
 TEST_F(DiscreteTrajectoryDeathTest, LastError) {
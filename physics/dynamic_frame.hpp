@@ -2,6 +2,8 @@
 #ifndef PRINCIPIA_PHYSICS_DYNAMIC_FRAME_HPP_
 #define PRINCIPIA_PHYSICS_DYNAMIC_FRAME_HPP_
 
+#include <vector>
+
 #include "geometry/frame.hpp"
 #include "geometry/rotation.hpp"
 #include "physics/ephemeris.hpp"
@@ -14,6 +16,7 @@ namespace physics {
 namespace internal_dynamic_frame {
 
 using base::not_null;
+using geometry::AngularVelocity;
 using geometry::Instant;
 using geometry::Position;
 using geometry::Rotation;
@@ -49,6 +52,23 @@ class DynamicFrame {
   virtual RigidMotion<ThisFrame, InertialFrame> FromThisFrameAtTime(
       Instant const& t) const;
 
+  // Returns the degrees of freedom in |ThisFrame| of the points whose
+  // |degrees_of_freedom| in |InertialFrame| are given at the corresponding
+  // |times|.  The vectors must have the same size and the results are in the
+  // same order.  Implementations evaluate the motion of |ThisFrame| once per
+  // time and are faster if the |times| are sorted.  The default implementation
+  // calls |ToThisFrameAtTime|.
+  virtual std::vector<DegreesOfFreedom<ThisFrame>> ToThisFrameAtTimes(
+      std::vector<Instant> const& times,
+      std::vector<DegreesOfFreedom<InertialFrame>> const& degrees_of_freedom)
+      const;
+
+  // Returns the results of |ToThisFrameAtTime| for all the |times|, in the same
+  // order.  Implementations are faster if the |times| are sorted.  The default
+  // implementation calls |ToThisFrameAtTime|.
+  virtual std::vector<RigidMotion<InertialFrame, ThisFrame>>
+  MotionsToThisFrameAtTimes(std::vector<Instant> const& times) const;
+
   // The acceleration due to the non-inertial motion of |ThisFrame| and gravity.
   // A particle in free fall follows a trajectory whose second derivative
   // is |GeometricAcceleration|.
@@ -71,6 +91,20 @@ class DynamicFrame {
       ReadFromMessage(serialization::DynamicFrame const& message,
                       not_null<Ephemeris<InertialFrame> const*> ephemeris);
 
+ protected:
+  // Returns the degrees of freedom in |ThisFrame| of the point with the given
+  // |degrees_of_freedom| in |InertialFrame|, for a frame whose origin has the
+  // degrees of freedom |origin| in |InertialFrame|, whose basis is the image
+  // of that of |InertialFrame| by |rotation|, and which rotates at
+  // |angular_velocity|.  This is the action of the corresponding
+  // |RigidMotion|, without constructing and inverting a |RigidTransformation|.
+  template<typename Map>
+  static DegreesOfFreedom<ThisFrame> ApplyMotion(
+      DegreesOfFreedom<InertialFrame> const& origin,
+      Map const& rotation,
+      AngularVelocity<InertialFrame> const& angular_velocity,
+      DegreesOfFreedom<InertialFrame> const& degrees_of_freedom);
+
  private:
   virtual Vector<Acceleration, InertialFrame> GravitationalAcceleration(
       Instant const& t,
@@ -13,7 +13,6 @@ namespace principia {
 namespace physics {
 namespace internal_dynamic_frame {
 
-using geometry::AngularVelocity;
 using geometry::Bivector;
 using geometry::Displacement;
 using geometry::InnerProduct;
@@ -40,6 +39,33 @@ DynamicFrame<InertialFrame, ThisFrame>::FromThisFrameAtTime(
   return ToThisFrameAtTime(t).Inverse();
 }
 
+template<typename InertialFrame, typename ThisFrame>
+std::vector<DegreesOfFreedom<ThisFrame>>
+DynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTimes(
+    std::vector<Instant> const& times,
+    std::vector<DegreesOfFreedom<InertialFrame>> const& degrees_of_freedom)
+    const {
+  CHECK_EQ(times.size(), degrees_of_freedom.size());
+  std::vector<DegreesOfFreedom<ThisFrame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    result.push_back(ToThisFrameAtTime(times[i])(degrees_of_freedom[i]));
+  }
+  return result;
+}
+
+template<typename InertialFrame, typename ThisFrame>
+std::vector<RigidMotion<InertialFrame, ThisFrame>>
+DynamicFrame<InertialFrame, ThisFrame>::MotionsToThisFrameAtTimes(
+    std::vector<Instant> const& times) const {
+  std::vector<RigidMotion<InertialFrame, ThisFrame>> result;
+  result.reserve(times.size());
+  for (Instant const& t : times) {
+    result.push_back(ToThisFrameAtTime(t));
+  }
+  return result;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 Vector<Acceleration, ThisFrame>
 DynamicFrame<InertialFrame, ThisFrame>::GeometricAcceleration(
@@ -101,6 +127,20 @@ DynamicFrame<InertialFrame, ThisFrame>::FrenetFrame(
   return Rotation<Frenet<ThisFrame>, ThisFrame>(tangent, normal, binormal);
 }
 
+template<typename InertialFrame, typename ThisFrame>
+template<typename Map>
+DegreesOfFreedom<ThisFrame> DynamicFrame<InertialFrame, ThisFrame>::ApplyMotion(
+    DegreesOfFreedom<InertialFrame> const& origin,
+    Map const& rotation,
+    AngularVelocity<InertialFrame> const& angular_velocity,
+    DegreesOfFreedom<InertialFrame> const& degrees_of_freedom) {
+  Displacement<InertialFrame> const r =
+      degrees_of_freedom.position() - origin.position();
+  return {ThisFrame::origin + rotation(r),
+          rotation(degrees_of_freedom.velocity() - origin.velocity() -
+                   angular_velocity * r / Radian)};
+}
+
 template<typename InertialFrame, typename ThisFrame>
 not_null<std::unique_ptr<DynamicFrame<InertialFrame, ThisFrame>>>
 DynamicFrame<InertialFrame, ThisFrame>::ReadFromMessage(
@@ -1,10 +1,12 @@
 ﻿
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <limits>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "absl/synchronization/mutex.h"
@@ -15,6 +17,9 @@
 #include "google/protobuf/repeated_field.h"
 #include "integrators/integrators.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
+#include "numerics/double_precision.hpp"
+#include "numerics/hermite3.hpp"
+#include "physics/barnes_hut_tree.hpp"
 #include "physics/checkpointer.hpp"
 #include "physics/continuous_trajectory.hpp"
 #include "physics/degrees_of_freedom.hpp"
@@ -38,12 +43,16 @@ using geometry::Instant;
 using geometry::Position;
 using geometry::Vector;
 using integrators::AdaptiveStepSizeIntegrator;
+using integrators::CompensatedSummation;
 using integrators::ExplicitSecondOrderOrdinaryDifferentialEquation;
 using integrators::FixedStepSizeIntegrator;
 using integrators::IntegrationProblem;
 using integrators::Integrator;
 using integrators::SpecialSecondOrderDifferentialEquation;
+using numerics::DoublePrecision;
+using numerics::Hermite3;
 using quantities::Acceleration;
+using quantities::GravitationalParameter;
 using quantities::Length;
 using quantities::Speed;
 using quantities::Time;
@@ -71,12 +80,23 @@ class Ephemeris {
     std::int64_t max_steps() const;
     Length length_integration_tolerance() const;
     Speed speed_integration_tolerance() const;
+    CompensatedSummation compensated_summation() const;
 
     void set_max_steps(std::int64_t max_steps);
     void set_length_integration_tolerance(
         Length const& length_integration_tolerance);
     void set_speed_integration_tolerance(
         Speed const& speed_integration_tolerance);
+    // Short integrations, e.g., burns that are recomputed frequently, may turn
+    // off compensated summation for speed.  The default is
+    // |CompensatedSummation::Full|.
+    void set_compensated_summation(
+        CompensatedSummation compensated_summation);
+    // If |cancelled| is not null, it is checked before each evaluation of the
+    // right-hand side, and once it is true the integration stops with
+    // |Error::CANCELLED|.  |cancelled| must outlive the integrations that use
+    // these parameters.  This setting is not serialized.
+    void set_cancelled(std::atomic_bool const* cancelled);
 
     void WriteToMessage(
         not_null<serialization::Ephemeris::AdaptiveStepParameters*> const
@@ -90,6 +110,8 @@ class Ephemeris {
     std::int64_t max_steps_;
     Length length_integration_tolerance_;
     Speed speed_integration_tolerance_;
+    CompensatedSummation compensated_summation_ = CompensatedSummation::Full;
+    std::atomic_bool const* cancelled_ = nullptr;
     friend class Ephemeris<Frame>;
   };
 
@@ -119,8 +141,17 @@ class Ephemeris {
 
   class PHYSICS_DLL AccuracyParameters final {
    public:
+    // If |far_field_opening_angle| is positive, the spherical bodies whose
+    // gravitational parameter is below |light_body_gravitational_parameter|
+    // are light bodies: their mutual attraction is approximated by a
+    // |BarnesHutTree| with that opening angle.  All the interactions involving
+    // the other bodies, including the geopotentials, are computed exactly.
     AccuracyParameters(Length const& fitting_tolerance,
-                       double geopotential_tolerance);
+                       double geopotential_tolerance,
+                       double far_field_opening_angle = 0,
+                       GravitationalParameter const&
+                           light_body_gravitational_parameter =
+                               GravitationalParameter());
 
     void WriteToMessage(
         not_null<serialization::Ephemeris::AccuracyParameters*> const
@@ -129,8 +160,12 @@ class Ephemeris {
         serialization::Ephemeris::AccuracyParameters const& message);
 
    private:
+    bool is_light_body(MassiveBody const& body) const;
+
     Length fitting_tolerance_;
     double geopotential_tolerance_ = 0;
+    double far_field_opening_angle_ = 0;
+    GravitationalParameter light_body_gravitational_parameter_;
     friend class Ephemeris<Frame>;
   };
 
@@ -155,13 +190,37 @@ class Ephemeris {
     friend class Ephemeris<Frame>;
   };
 
+  // Describes a subsystem of the bodies, typically a planet and its moons,
+  // which is integrated hierarchically.  The |bodies|, designated by name, are
+  // integrated relative to their barycentre, with a step |substeps| times
+  // smaller than that of the ephemeris, under the effect of their mutual
+  // attraction and of the tidal forces exerted by the other bodies.  The other
+  // bodies see the subsystem as a point mass at its barycentre.
+  class PHYSICS_DLL SubsystemParameters final {
+   public:
+    SubsystemParameters(std::vector<std::string> const& bodies, int substeps);
+
+    void WriteToMessage(
+        not_null<serialization::Ephemeris::SubsystemParameters*> message)
+        const;
+    static SubsystemParameters ReadFromMessage(
+        serialization::Ephemeris::SubsystemParameters const& message);
+
+   private:
+    std::vector<std::string> bodies_;
+    int substeps_;
+    friend class Ephemeris<Frame>;
+  };
+
   // Constructs an Ephemeris that owns the |bodies|.  The elements of vectors
-  // |bodies| and |initial_state| correspond to one another.
+  // |bodies| and |initial_state| correspond to one another.  A body may belong
+  // to at most one of the |subsystem_parameters|.
   Ephemeris(std::vector<not_null<std::unique_ptr<MassiveBody const>>>&& bodies,
             std::vector<DegreesOfFreedom<Frame>> const& initial_state,
             Instant const& initial_time,
             AccuracyParameters const& accuracy_parameters,
-            FixedStepParameters const& fixed_step_parameters);
+            FixedStepParameters const& fixed_step_parameters,
+            std::vector<SubsystemParameters> const& subsystem_parameters = {});
 
   virtual ~Ephemeris() = default;
 
@@ -204,6 +263,20 @@ class Ephemeris {
       IntrinsicAccelerations const& intrinsic_accelerations,
       FixedStepParameters const& parameters);
 
+  // Same as above, but for massless bodies that don't have trajectories, e.g.,
+  // the elements of a |MasslessSwarm|: the bodies start from |initial_state| at
+  // |initial_time|, and the state after each step is passed to
+  // |append_state|.
+  virtual not_null<
+      std::unique_ptr<typename Integrator<NewtonianMotionEquation>::Instance>>
+  NewInstance(
+      std::vector<DegreesOfFreedom<Frame>> const& initial_state,
+      Instant const& initial_time,
+      IntrinsicAccelerations const& intrinsic_accelerations,
+      typename Integrator<NewtonianMotionEquation>::AppendState const&
+          append_state,
+      FixedStepParameters const& parameters);
+
   // Integrates, until exactly |t| (except for timeouts or singularities), the
   // |trajectory| followed by a massless body in the gravitational potential
   // described by |*this|.  If |t > t_max()|, calls |Prolong(t)| beforehand.
@@ -259,6 +332,20 @@ class Ephemeris {
       not_null<MassiveBody const*> body,
       Instant const& t) const EXCLUDES(lock_);
 
+  // Integrates the motion of the massive bodies from their degrees of freedom
+  // at |t_initial| on this ephemeris until |t_final| in double-double
+  // arithmetic, using the symplectic Runge-Kutta-Nyström |Method| with steps
+  // no longer than |step|.  Returns the positions of the bodies at |t_final|,
+  // in the order of |bodies()|.  All pairs of bodies interact directly, and the
+  // effects of the geopotentials, which are small, are computed in double
+  // precision.  This is orders of magnitude slower than |Prolong| and is meant
+  // to compute reference solutions for error analysis.
+  template<typename Method>
+  std::vector<DoublePrecision<Position<Frame>>> ComputeReferencePositions(
+      Instant const& t_initial,
+      Instant const& t_final,
+      Time const& step) const EXCLUDES(lock_);
+
   // Computes the apsides of the relative trajectory of |body1| and |body2}.
   // Appends to the given trajectories two point for each apsis, one for |body1|
   // and one for |body2|.  The times of |apoapsides1| and |apoapsideds2| are
@@ -309,6 +396,61 @@ class Ephemeris {
                          Frame>::NewtonianMotionEquation> const& integrator);
 
  private:
+  // Bodies whose motion is integrated by the same integrator instance.  The
+  // oblate bodies precede the spherical bodies, and the light bodies come last
+  // among the spherical bodies.  The system state is indexed in the same order.
+  struct IntegratedSystem {
+    std::vector<not_null<MassiveBody const*>> bodies;
+    // The trajectories where the states of the |bodies| are appended.
+    std::vector<not_null<ContinuousTrajectory<Frame>*>> trajectories;
+    // Only has entries for the oblate bodies, at the same indices as |bodies|.
+    std::vector<Geopotential<Frame>> geopotentials;
+    int number_of_oblate_bodies = 0;
+    int number_of_spherical_bodies = 0;
+    // The light bodies are counted in |number_of_spherical_bodies|.
+    int number_of_light_bodies = 0;
+    // The gravitational parameters of the light bodies, in the order of
+    // |bodies|.
+    std::vector<GravitationalParameter> light_body_gravitational_parameters;
+  };
+
+  // A subsystem described by |SubsystemParameters|.
+  struct Subsystem {
+    int substeps;
+    // The positions of the bodies in the |instance| are relative to the
+    // barycentre of the subsystem, i.e., they are those of
+    // |Frame::origin + (q - barycentre)|.  None of these bodies are light.
+    IntegratedSystem system;
+    // A spherical body having the total gravitational parameter of the
+    // subsystem, which stands for it in the |outer_system_|.
+    std::unique_ptr<MassiveBody const> barycentre;
+    // The index of the |barycentre| in the |outer_system_|.
+    int barycentre_index;
+    std::unique_ptr<ContinuousTrajectory<Frame>> barycentre_trajectory;
+    std::unique_ptr<typename Integrator<NewtonianMotionEquation>::Instance>
+        instance;
+  };
+
+  // Inserts the |body| in the |system| according to its kind.  The |body| is
+  // a light body if |may_be_light| is true and the |accuracy_parameters_| say
+  // so.
+  void Insert(not_null<MassiveBody const*> body,
+              bool may_be_light,
+              IntegratedSystem& system) const;
+
+  // Sets the |trajectories| of the |outer_system_| and of the |subsystems_|
+  // from the trajectories of the bodies and of the barycentres.
+  void BindTrajectories();
+
+  // The equation integrated by the |instance| of the given |subsystem|.
+  NewtonianMotionEquation SubsystemEquation(int subsystem);
+
+  // Sets |outer_motion_| to the uniform motion of the outer bodies from
+  // |outer_state_|.  This is only correct at the time of |outer_state_|, where
+  // the instances of the subsystems may evaluate their equations before the
+  // first step.
+  void ResetOuterMotion() REQUIRES(lock_);
+
   // Checkpointing support.
   void WriteToCheckpoint(not_null<serialization::Ephemeris*> message);
   bool ReadFromCheckpoint(serialization::Ephemeris const& message);
@@ -316,9 +458,14 @@ class Ephemeris {
       SHARED_LOCKS_REQUIRED(lock_);
 
   // Callbacks for the integrators.
+  // Also integrates the subsystems up to the time of the |state|.
   void AppendMassiveBodiesState(
       typename NewtonianMotionEquation::SystemState const& state)
       REQUIRES(lock_);
+  void AppendSubsystemState(
+      int subsystem,
+      typename NewtonianMotionEquation::SystemState const& state)
+      REQUIRES(lock_);
   static void AppendMasslessBodiesState(
       typename NewtonianMotionEquation::SystemState const& state,
       std::vector<not_null<DiscreteTrajectory<Frame>*>> const& trajectories);
@@ -351,20 +498,34 @@ class Ephemeris {
       std::vector<Geopotential<Frame>> const& geopotentials);
 
   // Computes the accelerations due to one body, |body1| (with index |b1| in the
-  // |bodies_| and |trajectories_| arrays) on massless bodies at the given
-  // |positions|.  The template parameter specifies what we know about the
+  // |geopotentials1| array, located at |position1|) on massless bodies at the
+  // given |positions|.  The template parameter specifies what we know about the
   // massive body, and therefore what forces apply.
   template<bool body1_is_oblate>
-  Error ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
+  static Error ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
       Instant const& t,
       MassiveBody const& body1,
       std::size_t const b1,
+      Position<Frame> const& position1,
+      std::vector<Geopotential<Frame>> const& geopotentials1,
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations);
+
+  // Computes the accelerations between all the massive bodies of the |system|.
+  // The mutual attraction of the light bodies is approximated as specified by
+  // the |accuracy_parameters_|.
+  void ComputeMassiveBodiesGravitationalAccelerations(
+      IntegratedSystem const& system,
+      Instant const& t,
       std::vector<Position<Frame>> const& positions,
       std::vector<Vector<Acceleration, Frame>>& accelerations) const
       REQUIRES_SHARED(lock_);
 
-  // Computes the accelerations between all the massive bodies in |bodies_|.
-  void ComputeMassiveBodiesGravitationalAccelerations(
+  // Computes the accelerations of the bodies of the given |subsystem|, at the
+  // given |positions| relative to its barycentre: their mutual attraction, and
+  // the tidal forces exerted by the other bodies of the |outer_system_|.
+  void ComputeSubsystemGravitationalAccelerations(
+      int subsystem,
       Instant const& t,
       std::vector<Position<Frame>> const& positions,
       std::vector<Vector<Acceleration, Frame>>& accelerations) const
@@ -380,6 +541,19 @@ class Ephemeris {
       std::vector<Vector<Acceleration, Frame>>& accelerations) const
       EXCLUDES(lock_);
 
+  // Stores in |centres| the indices in |bodies_| of the bodies which dominate
+  // the motion of massless bodies at the given |positions|, i.e., those for
+  // which μ / d³ is largest.  These are the centres of the Keplerian motions
+  // for integrators that split them from the perturbations.
+  void SelectKeplerianCentres(Instant const& t,
+                              std::vector<Position<Frame>> const& positions,
+                              std::vector<int>& centres) const EXCLUDES(lock_);
+
+  // Returns the motion at time |t| of the body at index |centre| in |bodies_|.
+  typename NewtonianMotionEquation::Centre ComputeKeplerianCentre(
+      Instant const& t,
+      int centre) const EXCLUDES(lock_);
+
   // Flows the given ODE with an adaptive step integrator.
   template<typename ODE>
   Status FlowODEWithAdaptiveStep(
@@ -403,8 +577,8 @@ class Ephemeris {
   // The indices of bodies in |unowned_bodies_|.
   std::map<not_null<MassiveBody const*>, int> unowned_bodies_indices_;
 
-  // The oblate bodies precede the spherical bodies in this vector.  The system
-  // state is indexed in the same order.
+  // The oblate bodies precede the spherical bodies in this vector, and the
+  // light bodies come last among the spherical bodies.
   std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies_;
 
   // Only has entries for the oblate bodies, at the same indices as |bodies_|.
@@ -419,9 +593,21 @@ class Ephemeris {
 
   AccuracyParameters const accuracy_parameters_;
   FixedStepParameters const fixed_step_parameters_;
+  std::vector<SubsystemParameters> const subsystem_parameters_;
 
   int number_of_oblate_bodies_ = 0;
   int number_of_spherical_bodies_ = 0;
+  // The light bodies are counted in |number_of_spherical_bodies_|.
+  int number_of_light_bodies_ = 0;
+
+  // The bodies integrated by the |instance_|: the bodies that are not part of
+  // a subsystem, and the barycentres of the subsystems.  If there are no
+  // subsystems, the bodies are in the same order as in |bodies_|.
+  IntegratedSystem outer_system_;
+
+  // The subsystems, in the order of the |subsystem_parameters_|.  Their
+  // |instance|s are protected by |lock_|.
+  std::vector<Subsystem> subsystems_;
 
   not_null<
       std::unique_ptr<Checkpointer<serialization::Ephemeris>>> checkpointer_;
@@ -438,6 +624,13 @@ class Ephemeris {
 
   Status last_severe_integration_status_ GUARDED_BY(lock_);
 
+  // The last state of the |outer_system_| appended by the |instance_|, and the
+  // interpolation of the motion of its bodies over the last step, which is used
+  // to integrate the subsystems.  Only maintained if there are subsystems.
+  typename NewtonianMotionEquation::SystemState outer_state_ GUARDED_BY(lock_);
+  std::vector<Hermite3<Instant, Position<Frame>>> outer_motion_
+      GUARDED_BY(lock_);
+
   friend class Guard;
 };
 
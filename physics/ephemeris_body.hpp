@@ -4,21 +4,27 @@
 #include "physics/ephemeris.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <functional>
 #include <limits>
 #include <optional>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "astronomy/epoch.hpp"
 #include "base/macros.hpp"
 #include "base/map_util.hpp"
 #include "base/not_null.hpp"
+#include "geometry/barycentre_calculator.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/r3_element.hpp"
 #include "integrators/integrators.hpp"
+#include "integrators/methods.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
 #include "numerics/hermite3.hpp"
+#include "numerics/root_finders.hpp"
 #include "physics/continuous_trajectory.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
@@ -35,6 +41,7 @@ using base::Error;
 using base::FindOrDie;
 using base::make_not_null_unique;
 using geometry::Barycentre;
+using geometry::BarycentreCalculator;
 using geometry::Displacement;
 using geometry::InnerProduct;
 using geometry::Position;
@@ -76,6 +83,36 @@ inline Status const CollisionDetected() {
   return Status(Error::OUT_OF_RANGE, "Collision detected");
 }
 
+inline serialization::Ephemeris::AdaptiveStepParameters::CompensatedSummation
+CompensatedSummationToMessage(
+    CompensatedSummation const compensated_summation) {
+  switch (compensated_summation) {
+    case CompensatedSummation::Full:
+      return serialization::Ephemeris::AdaptiveStepParameters::FULL;
+    case CompensatedSummation::TimeOnly:
+      return serialization::Ephemeris::AdaptiveStepParameters::TIME_ONLY;
+    case CompensatedSummation::None:
+      return serialization::Ephemeris::AdaptiveStepParameters::NONE;
+  }
+  LOG(FATAL) << "Unexpected summation policy";
+  base::noreturn();
+}
+
+inline CompensatedSummation CompensatedSummationFromMessage(
+    serialization::Ephemeris::AdaptiveStepParameters::CompensatedSummation const
+        message) {
+  switch (message) {
+    case serialization::Ephemeris::AdaptiveStepParameters::FULL:
+      return CompensatedSummation::Full;
+    case serialization::Ephemeris::AdaptiveStepParameters::TIME_ONLY:
+      return CompensatedSummation::TimeOnly;
+    case serialization::Ephemeris::AdaptiveStepParameters::NONE:
+      return CompensatedSummation::None;
+  }
+  LOG(FATAL) << "Unexpected summation policy " << message;
+  base::noreturn();
+}
+
 template<typename Frame>
 template<typename ODE>
 Ephemeris<Frame>::ODEAdaptiveStepParameters<ODE>::ODEAdaptiveStepParameters(
@@ -120,6 +157,14 @@ speed_integration_tolerance() const {
   return speed_integration_tolerance_;
 }
 
+template<typename Frame>
+template<typename ODE>
+CompensatedSummation
+Ephemeris<Frame>::ODEAdaptiveStepParameters<ODE>::compensated_summation()
+    const {
+  return compensated_summation_;
+}
+
 template<typename Frame>
 template<typename ODE>
 void Ephemeris<Frame>::ODEAdaptiveStepParameters<ODE>::set_max_steps(
@@ -142,6 +187,20 @@ set_speed_integration_tolerance(Speed const& speed_integration_tolerance) {
   speed_integration_tolerance_ = speed_integration_tolerance;
 }
 
+template<typename Frame>
+template<typename ODE>
+void Ephemeris<Frame>::ODEAdaptiveStepParameters<ODE>::
+set_compensated_summation(CompensatedSummation const compensated_summation) {
+  compensated_summation_ = compensated_summation;
+}
+
+template<typename Frame>
+template<typename ODE>
+void Ephemeris<Frame>::ODEAdaptiveStepParameters<ODE>::set_cancelled(
+    std::atomic_bool const* const cancelled) {
+  cancelled_ = cancelled;
+}
+
 template<typename Frame>
 template<typename ODE>
 void Ephemeris<Frame>::ODEAdaptiveStepParameters<ODE>::WriteToMessage(
@@ -153,6 +212,8 @@ void Ephemeris<Frame>::ODEAdaptiveStepParameters<ODE>::WriteToMessage(
       message->mutable_length_integration_tolerance());
   speed_integration_tolerance_.WriteToMessage(
       message->mutable_speed_integration_tolerance());
+  message->set_compensated_summation(
+      CompensatedSummationToMessage(compensated_summation_));
 }
 
 template<typename Frame>
@@ -160,19 +221,38 @@ template<typename ODE>
 typename Ephemeris<Frame>::template ODEAdaptiveStepParameters<ODE>
 Ephemeris<Frame>::ODEAdaptiveStepParameters<ODE>::ReadFromMessage(
     serialization::Ephemeris::AdaptiveStepParameters const& message) {
-  return ODEAdaptiveStepParameters(
+  ODEAdaptiveStepParameters parameters(
       AdaptiveStepSizeIntegrator<ODE>::ReadFromMessage(message.integrator()),
       message.max_steps(),
       Length::ReadFromMessage(message.length_integration_tolerance()),
       Speed::ReadFromMessage(message.speed_integration_tolerance()));
+  // Pre-Fermat saves always used compensated summation.
+  if (message.has_compensated_summation()) {
+    parameters.set_compensated_summation(
+        CompensatedSummationFromMessage(message.compensated_summation()));
+  }
+  return parameters;
 }
 
 template<typename Frame>
 Ephemeris<Frame>::AccuracyParameters::AccuracyParameters(
     Length const& fitting_tolerance,
-    double const geopotential_tolerance)
+    double const geopotential_tolerance,
+    double const far_field_opening_angle,
+    GravitationalParameter const& light_body_gravitational_parameter)
     : fitting_tolerance_(fitting_tolerance),
-      geopotential_tolerance_(geopotential_tolerance) {}
+      geopotential_tolerance_(geopotential_tolerance),
+      far_field_opening_angle_(far_field_opening_angle),
+      light_body_gravitational_parameter_(light_body_gravitational_parameter) {
+  CHECK_LE(0, far_field_opening_angle_);
+}
+
+template<typename Frame>
+bool Ephemeris<Frame>::AccuracyParameters::is_light_body(
+    MassiveBody const& body) const {
+  return far_field_opening_angle_ > 0 && !body.is_oblate() &&
+         body.gravitational_parameter() < light_body_gravitational_parameter_;
+}
 
 template<typename Frame>
 void Ephemeris<Frame>::AccuracyParameters::WriteToMessage(
@@ -180,15 +260,30 @@ void Ephemeris<Frame>::AccuracyParameters::WriteToMessage(
     const {
   fitting_tolerance_.WriteToMessage(message->mutable_fitting_tolerance());
   message->set_geopotential_tolerance(geopotential_tolerance_);
+  if (far_field_opening_angle_ > 0) {
+    message->set_far_field_opening_angle(far_field_opening_angle_);
+    light_body_gravitational_parameter_.WriteToMessage(
+        message->mutable_light_body_gravitational_parameter());
+  }
 }
 
 template<typename Frame>
 typename Ephemeris<Frame>::AccuracyParameters
 Ephemeris<Frame>::AccuracyParameters::ReadFromMessage(
     serialization::Ephemeris::AccuracyParameters const& message) {
-  return AccuracyParameters(
-      Length::ReadFromMessage(message.fitting_tolerance()),
-      message.geopotential_tolerance());
+  bool const is_pre_fermat = !message.has_far_field_opening_angle();
+  if (is_pre_fermat) {
+    return AccuracyParameters(
+        Length::ReadFromMessage(message.fitting_tolerance()),
+        message.geopotential_tolerance());
+  } else {
+    return AccuracyParameters(
+        Length::ReadFromMessage(message.fitting_tolerance()),
+        message.geopotential_tolerance(),
+        message.far_field_opening_angle(),
+        GravitationalParameter::ReadFromMessage(
+            message.light_body_gravitational_parameter()));
+  }
 }
 
 template<typename Frame>
@@ -223,15 +318,46 @@ Ephemeris<Frame>::FixedStepParameters::ReadFromMessage(
       Time::ReadFromMessage(message.step()));
 }
 
+template<typename Frame>
+Ephemeris<Frame>::SubsystemParameters::SubsystemParameters(
+    std::vector<std::string> const& bodies,
+    int const substeps)
+    : bodies_(bodies),
+      substeps_(substeps) {
+  CHECK(!bodies_.empty());
+  CHECK_LE(1, substeps_);
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::SubsystemParameters::WriteToMessage(
+    not_null<serialization::Ephemeris::SubsystemParameters*> const message)
+    const {
+  for (std::string const& body : bodies_) {
+    message->add_body(body);
+  }
+  message->set_substeps(substeps_);
+}
+
+template<typename Frame>
+typename Ephemeris<Frame>::SubsystemParameters
+Ephemeris<Frame>::SubsystemParameters::ReadFromMessage(
+    serialization::Ephemeris::SubsystemParameters const& message) {
+  return SubsystemParameters(
+      std::vector<std::string>(message.body().begin(), message.body().end()),
+      message.substeps());
+}
+
 template<typename Frame>
 Ephemeris<Frame>::Ephemeris(
     std::vector<not_null<std::unique_ptr<MassiveBody const>>>&& bodies,
     std::vector<DegreesOfFreedom<Frame>> const& initial_state,
     Instant const& initial_time,
     AccuracyParameters const& accuracy_parameters,
-    FixedStepParameters const& fixed_step_parameters)
+    FixedStepParameters const& fixed_step_parameters,
+    std::vector<SubsystemParameters> const& subsystem_parameters)
     : accuracy_parameters_(accuracy_parameters),
       fixed_step_parameters_(fixed_step_parameters),
+      subsystem_parameters_(subsystem_parameters),
       checkpointer_(
           make_not_null_unique<Checkpointer<serialization::Ephemeris>>(
               /*reader=*/
@@ -246,31 +372,44 @@ Ephemeris<Frame>::Ephemeris(
   CHECK(!bodies.empty());
   CHECK_EQ(bodies.size(), initial_state.size());
 
-  IntegrationProblem<NewtonianMotionEquation> problem;
-  problem.equation.compute_acceleration = [this](
-      Instant const& t,
-      std::vector<Position<Frame>> const& positions,
-      std::vector<Vector<Acceleration, Frame>>& accelerations) {
-    ComputeMassiveBodiesGravitationalAccelerations(t,
-                                                   positions,
-                                                   accelerations);
-    return Status::OK;
-  };
-
-  typename NewtonianMotionEquation::SystemState& state = problem.initial_state;
-  state.time = DoublePrecision<Instant>(initial_time);
+  // The subsystem to which each body belongs, if any.
+  std::map<std::string, int> subsystem_of_body;
+  for (int k = 0; k < subsystem_parameters_.size(); ++k) {
+    for (std::string const& name : subsystem_parameters_[k].bodies_) {
+      bool const inserted = subsystem_of_body.emplace(name, k).second;
+      CHECK(inserted) << name << " belongs to several subsystems";
+    }
+  }
+  subsystems_.resize(subsystem_parameters_.size());
 
+  std::map<not_null<MassiveBody const*>, DegreesOfFreedom<Frame>>
+      initial_degrees_of_freedom;
   for (int i = 0; i < bodies.size(); ++i) {
     auto& body = bodies[i];
     DegreesOfFreedom<Frame> const& degrees_of_freedom = initial_state[i];
 
     unowned_bodies_.emplace_back(body.get());
     unowned_bodies_indices_.emplace(body.get(), i);
+    initial_degrees_of_freedom.emplace(body.get(), degrees_of_freedom);
+
+    // The trajectories of the bodies of a subsystem are appended at each step
+    // of the subsystem.
+    Time step = fixed_step_parameters_.step_;
+    auto const it = subsystem_of_body.find(body->name());
+    if (it == subsystem_of_body.end()) {
+      Insert(body.get(), /*may_be_light=*/true, outer_system_);
+    } else {
+      Subsystem& subsystem = subsystems_[it->second];
+      subsystem.substeps = subsystem_parameters_[it->second].substeps_;
+      step /= subsystem.substeps;
+      Insert(body.get(), /*may_be_light=*/false, subsystem.system);
+      subsystem_of_body.erase(it);
+    }
 
     auto const inserted = bodies_to_trajectories_.emplace(
                               body.get(),
                               std::make_unique<ContinuousTrajectory<Frame>>(
-                                  fixed_step_parameters_.step_,
+                                  step,
                                   accuracy_parameters_.fitting_tolerance_));
     CHECK(inserted.second);
     ContinuousTrajectory<Frame>* const trajectory =
@@ -285,22 +424,105 @@ Ephemeris<Frame>::Ephemeris(
       // Inserting at the beginning of the vectors is O(N).
       bodies_.insert(bodies_.begin(), std::move(body));
       trajectories_.insert(trajectories_.begin(), trajectory);
-      state.positions.emplace(state.positions.begin(),
-                              degrees_of_freedom.position());
-      state.velocities.emplace(state.velocities.begin(),
-                               degrees_of_freedom.velocity());
       ++number_of_oblate_bodies_;
-    } else {
+    } else if (accuracy_parameters_.is_light_body(*body)) {
       // Inserting at the end of the vectors is O(1).
       bodies_.push_back(std::move(body));
       trajectories_.push_back(trajectory);
-      state.positions.emplace_back(degrees_of_freedom.position());
-      state.velocities.emplace_back(degrees_of_freedom.velocity());
       ++number_of_spherical_bodies_;
+      ++number_of_light_bodies_;
+    } else {
+      // Inserting before the light bodies, i.e., at the end of the vectors if
+      // there are no light bodies.
+      int const b = bodies_.size() - number_of_light_bodies_;
+      bodies_.insert(bodies_.begin() + b, std::move(body));
+      trajectories_.insert(trajectories_.begin() + b, trajectory);
+      ++number_of_spherical_bodies_;
+    }
+  }
+  CHECK(subsystem_of_body.empty())
+      << "No body named " << subsystem_of_body.begin()->first;
+
+  // Each subsystem is represented in the |outer_system_| by a body located at
+  // its barycentre.
+  for (int k = 0; k < subsystems_.size(); ++k) {
+    Subsystem& subsystem = subsystems_[k];
+    BarycentreCalculator<DegreesOfFreedom<Frame>, GravitationalParameter>
+        calculator;
+    for (auto const body : subsystem.system.bodies) {
+      calculator.Add(FindOrDie(initial_degrees_of_freedom, body),
+                     body->gravitational_parameter());
+    }
+    DegreesOfFreedom<Frame> const barycentre = calculator.Get();
+    subsystem.barycentre = std::make_unique<MassiveBody const>(
+        MassiveBody::Parameters(
+            "Barycentre of " + subsystem_parameters_[k].bodies_.front(),
+            calculator.weight()));
+    subsystem.barycentre_trajectory =
+        std::make_unique<ContinuousTrajectory<Frame>>(
+            fixed_step_parameters_.step_,
+            accuracy_parameters_.fitting_tolerance_);
+    CHECK_OK(subsystem.barycentre_trajectory->Append(initial_time, barycentre));
+    initial_degrees_of_freedom.emplace(subsystem.barycentre.get(), barycentre);
+    Insert(subsystem.barycentre.get(), /*may_be_light=*/false, outer_system_);
+  }
+  for (Subsystem& subsystem : subsystems_) {
+    subsystem.barycentre_index =
+        std::find(outer_system_.bodies.begin(),
+                  outer_system_.bodies.end(),
+                  subsystem.barycentre.get()) - outer_system_.bodies.begin();
+  }
+  BindTrajectories();
+
+  absl::MutexLock l(&lock_);  // For locking checks.
+
+  IntegrationProblem<NewtonianMotionEquation> problem;
+  problem.equation.compute_acceleration = [this](
+      Instant const& t,
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) {
+    ComputeMassiveBodiesGravitationalAccelerations(outer_system_,
+                                                   t,
+                                                   positions,
+                                                   accelerations);
+    return Status::OK;
+  };
+
+  typename NewtonianMotionEquation::SystemState& state = problem.initial_state;
+  state.time = DoublePrecision<Instant>(initial_time);
+  for (auto const body : outer_system_.bodies) {
+    DegreesOfFreedom<Frame> const& degrees_of_freedom =
+        FindOrDie(initial_degrees_of_freedom, body);
+    state.positions.emplace_back(degrees_of_freedom.position());
+    state.velocities.emplace_back(degrees_of_freedom.velocity());
+  }
+  outer_state_ = state;
+  ResetOuterMotion();
+
+  // The bodies of a subsystem are integrated relative to its barycentre.
+  for (int k = 0; k < subsystems_.size(); ++k) {
+    Subsystem& subsystem = subsystems_[k];
+    DegreesOfFreedom<Frame> const& barycentre =
+        FindOrDie(initial_degrees_of_freedom, subsystem.barycentre.get());
+    IntegrationProblem<NewtonianMotionEquation> subsystem_problem;
+    subsystem_problem.equation = SubsystemEquation(k);
+    subsystem_problem.initial_state.time =
+        DoublePrecision<Instant>(initial_time);
+    for (auto const body : subsystem.system.bodies) {
+      RelativeDegreesOfFreedom<Frame> const relative =
+          FindOrDie(initial_degrees_of_freedom, body) - barycentre;
+      subsystem_problem.initial_state.positions.emplace_back(
+          Frame::origin + relative.displacement());
+      subsystem_problem.initial_state.velocities.emplace_back(
+          relative.velocity());
     }
+    subsystem.instance = fixed_step_parameters_.integrator_->NewInstance(
+        subsystem_problem,
+        /*append_state=*/std::bind(
+            &Ephemeris::AppendSubsystemState, this, k, _1),
+        fixed_step_parameters_.step_ / subsystem.substeps);
   }
 
-  absl::ReaderMutexLock l(&lock_);  // For locking checks.
   instance_ = fixed_step_parameters_.integrator_->NewInstance(
       problem,
       /*append_state=*/std::bind(
@@ -368,6 +590,9 @@ bool Ephemeris<Frame>::EventuallyForgetBefore(Instant const& t) {
       ContinuousTrajectory<Frame>& trajectory = *pair.second;
       trajectory.ForgetBefore(t);
     }
+    for (auto const& subsystem : subsystems_) {
+      subsystem.barycentre_trajectory->ForgetBefore(t);
+    }
     checkpointer_->ForgetBefore(t);
   };
 
@@ -409,6 +634,36 @@ Ephemeris<Frame>::NewInstance(
     std::vector<not_null<DiscreteTrajectory<Frame>*>> const& trajectories,
     IntrinsicAccelerations const& intrinsic_accelerations,
     FixedStepParameters const& parameters) {
+  CHECK(!trajectories.empty());
+  Instant const trajectory_last_time = (*trajectories.begin())->last().time();
+  std::vector<DegreesOfFreedom<Frame>> initial_state;
+  initial_state.reserve(trajectories.size());
+  for (auto const& trajectory : trajectories) {
+    auto const trajectory_last = trajectory->last();
+    CHECK_EQ(trajectory_last.time(), trajectory_last_time);
+    initial_state.push_back(trajectory_last.degrees_of_freedom());
+  }
+
+  auto const append_state =
+      std::bind(&Ephemeris::AppendMasslessBodiesState, _1, trajectories);
+
+  return NewInstance(initial_state,
+                     trajectory_last_time,
+                     intrinsic_accelerations,
+                     append_state,
+                     parameters);
+}
+
+template<typename Frame>
+not_null<std::unique_ptr<typename Integrator<
+    typename Ephemeris<Frame>::NewtonianMotionEquation>::Instance>>
+Ephemeris<Frame>::NewInstance(
+    std::vector<DegreesOfFreedom<Frame>> const& initial_state,
+    Instant const& initial_time,
+    IntrinsicAccelerations const& intrinsic_accelerations,
+    typename Integrator<NewtonianMotionEquation>::AppendState const&
+        append_state,
+    FixedStepParameters const& parameters) {
   IntegrationProblem<NewtonianMotionEquation> problem;
 
   problem.equation.compute_acceleration =
@@ -430,26 +685,23 @@ Ephemeris<Frame>::NewInstance(
     return error == Error::OK ? Status::OK :
                     CollisionDetected();
   };
-
-  CHECK(!trajectories.empty());
-  Instant const trajectory_last_time = (*trajectories.begin())->last().time();
-  problem.initial_state.time = DoublePrecision<Instant>(trajectory_last_time);
-  for (auto const& trajectory : trajectories) {
-    auto const trajectory_last = trajectory->last();
-    auto const last_degrees_of_freedom = trajectory_last.degrees_of_freedom();
-    CHECK_EQ(trajectory_last.time(), trajectory_last_time);
+  problem.equation.select_centres =
+      std::bind(&Ephemeris::SelectKeplerianCentres, this, _1, _2, _3);
+  problem.equation.compute_centre =
+      std::bind(&Ephemeris::ComputeKeplerianCentre, this, _1, _2);
+
+  CHECK(!initial_state.empty());
+  problem.initial_state.time = DoublePrecision<Instant>(initial_time);
+  for (auto const& degrees_of_freedom : initial_state) {
     problem.initial_state.positions.emplace_back(
-        last_degrees_of_freedom.position());
+        degrees_of_freedom.position());
     problem.initial_state.velocities.emplace_back(
-        last_degrees_of_freedom.velocity());
+        degrees_of_freedom.velocity());
   }
 
-  auto const append_state =
-      std::bind(&Ephemeris::AppendMasslessBodiesState, _1, trajectories);
-
   // The construction of the instance may evaluate the degrees of freedom of the
   // bodies.
-  Prolong(trajectory_last_time + parameters.step_);
+  Prolong(initial_time + parameters.step_);
 
   return parameters.integrator_->NewInstance(
       problem, append_state, parameters.step_);
@@ -463,10 +715,15 @@ Status Ephemeris<Frame>::FlowWithAdaptiveStep(
     AdaptiveStepParameters const& parameters,
     std::int64_t const max_ephemeris_steps,
     bool const last_point_only) {
-  auto compute_acceleration = [this, &intrinsic_acceleration](
+  auto compute_acceleration = [this,
+                               cancelled = parameters.cancelled_,
+                               &intrinsic_acceleration](
       Instant const& t,
       std::vector<Position<Frame>> const& positions,
       std::vector<Vector<Acceleration, Frame>>& accelerations) {
+    if (cancelled != nullptr && *cancelled) {
+      return Status::CANCELLED;
+    }
     Error const error =
         ComputeMasslessBodiesGravitationalAccelerations(t,
                                                         positions,
@@ -496,11 +753,14 @@ Status Ephemeris<Frame>::FlowWithAdaptiveStep(
     std::int64_t max_ephemeris_steps,
     bool last_point_only) {
   auto compute_acceleration =
-      [this, &intrinsic_acceleration](
+      [this, cancelled = parameters.cancelled_, &intrinsic_acceleration](
           Instant const& t,
           std::vector<Position<Frame>> const& positions,
           std::vector<Velocity<Frame>> const& velocities,
           std::vector<Vector<Acceleration, Frame>>& accelerations) {
+        if (cancelled != nullptr && *cancelled) {
+          return Status::CANCELLED;
+        }
         Error const error =
             ComputeMasslessBodiesGravitationalAccelerations(t,
                                                             positions,
@@ -637,6 +897,189 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationOnMassiveBody(
   return accelerations[b1];
 }
 
+template<typename Frame>
+template<typename Method>
+std::vector<DoublePrecision<Position<Frame>>>
+Ephemeris<Frame>::ComputeReferencePositions(Instant const& t_initial,
+                                            Instant const& t_final,
+                                            Time const& step) const {
+  static_assert(
+      std::is_base_of<integrators::methods::SymplecticRungeKuttaNyström,
+                      Method>::value,
+      "Method must be derived from SymplecticRungeKuttaNyström");
+  CHECK_LE(t_initial, t_final);
+  CHECK_LT(Time(), step);
+  int const number_of_bodies = bodies_.size();
+
+  // The state is represented by the double-double coordinates of the bodies.
+  using Coordinates = std::array<DoublePrecision<Length>, 3>;
+  using VelocityCoordinates = std::array<DoublePrecision<Speed>, 3>;
+  using AccelerationCoordinates = std::array<DoublePrecision<Acceleration>, 3>;
+  std::vector<Coordinates> q(number_of_bodies);
+  std::vector<VelocityCoordinates> v(number_of_bodies);
+  std::vector<AccelerationCoordinates> accelerations(number_of_bodies);
+  {
+    absl::ReaderMutexLock l(&lock_);
+    for (int b = 0; b < number_of_bodies; ++b) {
+      DegreesOfFreedom<Frame> const degrees_of_freedom =
+          trajectories_[b]->EvaluateDegreesOfFreedom(t_initial);
+      R3Element<Length> const position =
+          (degrees_of_freedom.position() - Frame::origin).coordinates();
+      R3Element<Speed> const velocity =
+          degrees_of_freedom.velocity().coordinates();
+      for (int i = 0; i < 3; ++i) {
+        q[b][i] = DoublePrecision<Length>(position[i]);
+        v[b][i] = DoublePrecision<Speed>(velocity[i]);
+      }
+    }
+  }
+
+  // The coefficients of the |Method| are only given in double precision.  We
+  // normalize them so that their sums are 1 in double-double, as otherwise the
+  // method would not even be consistent at that precision.
+  std::array<DoublePrecision<double>, Method::stages> a;
+  std::array<DoublePrecision<double>, Method::stages> b;
+  std::array<double, Method::stages> c;
+  DoublePrecision<double> Σa;
+  DoublePrecision<double> Σb;
+  for (int i = 0; i < Method::stages; ++i) {
+    a[i] = DoublePrecision<double>(Method::a[i]);
+    b[i] = DoublePrecision<double>(Method::b[i]);
+    Σa += a[i];
+    Σb += b[i];
+  }
+  c[0] = 0;
+  for (int i = 0; i < Method::stages; ++i) {
+    a[i] = a[i] / Σa;
+    b[i] = b[i] / Σb;
+    if (i > 0) {
+      c[i] = c[i - 1] + a[i - 1].value;
+    }
+  }
+
+  auto const compute_accelerations = [this, number_of_bodies, &q](
+      Instant const& t,
+      std::vector<AccelerationCoordinates>& accelerations) {
+    accelerations.assign(number_of_bodies, AccelerationCoordinates());
+    for (int b1 = 0; b1 < number_of_bodies; ++b1) {
+      MassiveBody const& body1 = *bodies_[b1];
+      DoublePrecision<GravitationalParameter> const μ1(
+          body1.gravitational_parameter());
+      for (int b2 = b1 + 1; b2 < number_of_bodies; ++b2) {
+        MassiveBody const& body2 = *bodies_[b2];
+        DoublePrecision<GravitationalParameter> const μ2(
+            body2.gravitational_parameter());
+
+        // A vector from the center of |b2| to the center of |b1|.
+        Coordinates Δq;
+        for (int i = 0; i < 3; ++i) {
+          Δq[i] = q[b1][i] - q[b2][i];
+        }
+        DoublePrecision<Square<Length>> const Δq² =
+            Δq[0] * Δq[0] + Δq[1] * Δq[1] + Δq[2] * Δq[2];
+        DoublePrecision<Length> const Δq_norm = Sqrt(Δq²);
+        DoublePrecision<Exponentiation<Length, -3>> const one_over_Δq³ =
+            Δq_norm / (Δq² * Δq²);
+        auto const μ1_over_Δq³ = μ1 * one_over_Δq³;
+        auto const μ2_over_Δq³ = μ2 * one_over_Δq³;
+        for (int i = 0; i < 3; ++i) {
+          accelerations[b2][i] += Δq[i] * μ1_over_Δq³;
+          accelerations[b1][i] -= Δq[i] * μ2_over_Δq³;
+        }
+
+        if (body1.is_oblate() || body2.is_oblate()) {
+          Displacement<Frame> const rounded_Δq(
+              {Δq[0].value, Δq[1].value, Δq[2].value});
+          Vector<Acceleration, Frame> acceleration_on_b1;
+          Vector<Acceleration, Frame> acceleration_on_b2;
+          if (body1.is_oblate()) {
+            Vector<Quotient<Acceleration,
+                            GravitationalParameter>, Frame> const
+                degree_2_zonal_effect1 =
+                    geopotentials_[b1].GeneralSphericalHarmonicsAcceleration(
+                        t,
+                        -rounded_Δq,
+                        Δq_norm.value,
+                        Δq².value,
+                        one_over_Δq³.value);
+            acceleration_on_b1 -=
+                body2.gravitational_parameter() * degree_2_zonal_effect1;
+            acceleration_on_b2 +=
+                body1.gravitational_parameter() * degree_2_zonal_effect1;
+          }
+          if (body2.is_oblate()) {
+            Vector<Quotient<Acceleration,
+                            GravitationalParameter>, Frame> const
+                degree_2_zonal_effect2 =
+                    geopotentials_[b2].GeneralSphericalHarmonicsAcceleration(
+                        t,
+                        rounded_Δq,
+                        Δq_norm.value,
+                        Δq².value,
+                        one_over_Δq³.value);
+            acceleration_on_b1 +=
+                body2.gravitational_parameter() * degree_2_zonal_effect2;
+            acceleration_on_b2 -=
+                body1.gravitational_parameter() * degree_2_zonal_effect2;
+          }
+          for (int i = 0; i < 3; ++i) {
+            accelerations[b1][i] += DoublePrecision<Acceleration>(
+                acceleration_on_b1.coordinates()[i]);
+            accelerations[b2][i] += DoublePrecision<Acceleration>(
+                acceleration_on_b2.coordinates()[i]);
+          }
+        }
+      }
+    }
+  };
+
+  // The step is adjusted so that the integration ends exactly at |t_final|.
+  Time const duration = t_final - t_initial;
+  std::int64_t const steps =
+      std::max<std::int64_t>(1, std::ceil(duration / step));
+  DoublePrecision<Time> const h =
+      DoublePrecision<Time>(duration) /
+      DoublePrecision<double>(static_cast<double>(steps));
+  for (std::int64_t n = 0; n < steps; ++n) {
+    for (int i = 0; i < Method::stages; ++i) {
+      if (b[i].value != 0) {
+        compute_accelerations(t_initial + (n + c[i]) * h.value, accelerations);
+        DoublePrecision<Time> const b_h = h * b[i];
+        for (int k = 0; k < number_of_bodies; ++k) {
+          for (int j = 0; j < 3; ++j) {
+            v[k][j] += b_h * accelerations[k][j];
+          }
+        }
+      }
+      if (a[i].value != 0) {
+        DoublePrecision<Time> const a_h = h * a[i];
+        for (int k = 0; k < number_of_bodies; ++k) {
+          for (int j = 0; j < 3; ++j) {
+            q[k][j] += a_h * v[k][j];
+          }
+        }
+      }
+    }
+  }
+
+  // The oblate bodies come first in |bodies_|, so its order may differ from
+  // that of |bodies()|.
+  std::vector<DoublePrecision<Position<Frame>>> positions(number_of_bodies);
+  for (int b = 0; b < number_of_bodies; ++b) {
+    Coordinates const& coordinates = q[b];
+    auto& position =
+        positions[FindOrDie(unowned_bodies_indices_, bodies_[b].get())];
+    position.value =
+        Frame::origin + Displacement<Frame>({coordinates[0].value,
+                                             coordinates[1].value,
+                                             coordinates[2].value});
+    position.error = Displacement<Frame>({coordinates[0].error,
+                                          coordinates[1].error,
+                                          coordinates[2].error});
+  }
+  return positions;
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::ComputeApsides(not_null<MassiveBody const*> const body1,
                                       not_null<MassiveBody const*> const body2,
@@ -730,7 +1173,7 @@ void Ephemeris<Frame>::WriteToMessage(
     unowned_body->WriteToMessage(message->add_body());
   }
   // The trajectories are serialized in the order resulting from the separation
-  // between oblate and spherical bodies.
+  // between oblate, spherical and light bodies.
   for (auto const& trajectory : trajectories_) {
     trajectory->WriteToMessage(message->add_trajectory());
   }
@@ -738,6 +1181,13 @@ void Ephemeris<Frame>::WriteToMessage(
       message->mutable_fixed_step_parameters());
   accuracy_parameters_.WriteToMessage(
       message->mutable_accuracy_parameters());
+  for (auto const& parameters : subsystem_parameters_) {
+    parameters.WriteToMessage(message->add_subsystem_parameters());
+  }
+  for (auto const& subsystem : subsystems_) {
+    subsystem.barycentre_trajectory->WriteToMessage(
+        message->add_barycentre_trajectory());
+  }
   LOG(INFO) << NAMED(message->SpaceUsed());
   LOG(INFO) << NAMED(message->ByteSize());
 }
@@ -762,6 +1212,11 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
   }
   FixedStepParameters const fixed_step_parameters =
       FixedStepParameters::ReadFromMessage(message.fixed_step_parameters());
+  std::vector<SubsystemParameters> subsystem_parameters;
+  for (auto const& parameters : message.subsystem_parameters()) {
+    subsystem_parameters.push_back(
+        SubsystemParameters::ReadFromMessage(parameters));
+  }
 
   // Dummy initial state and time.  We'll overwrite them later.
   std::vector<DegreesOfFreedom<Frame>> const initial_state(
@@ -773,7 +1228,8 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
                        initial_state,
                        initial_time,
                        accuracy_parameters,
-                       fixed_step_parameters);
+                       fixed_step_parameters,
+                       subsystem_parameters);
 
   int index = 0;
   ephemeris->bodies_to_trajectories_.clear();
@@ -788,6 +1244,13 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
         body, std::move(deserialized_trajectory));
     ++index;
   }
+  CHECK_EQ(ephemeris->subsystems_.size(), message.barycentre_trajectory_size());
+  for (int k = 0; k < ephemeris->subsystems_.size(); ++k) {
+    ephemeris->subsystems_[k].barycentre_trajectory =
+        ContinuousTrajectory<Frame>::ReadFromMessage(
+            message.barycentre_trajectory(k));
+  }
+  ephemeris->BindTrajectories();
 
   Instant checkpoint_time;
   if (is_pre_fatou) {
@@ -854,10 +1317,98 @@ Ephemeris<Frame>::Ephemeris(
               /*reader=*/nullptr, /*writer=*/nullptr)),
       protector_(make_not_null_unique<Protector>()) {}
 
+template<typename Frame>
+void Ephemeris<Frame>::Insert(not_null<MassiveBody const*> const body,
+                              bool const may_be_light,
+                              IntegratedSystem& system) const {
+  if (body->is_oblate()) {
+    // Inserting at the beginning of the vectors is O(N).
+    system.geopotentials.emplace(
+        system.geopotentials.cbegin(),
+        dynamic_cast_not_null<OblateBody<Frame> const*>(body),
+        accuracy_parameters_.geopotential_tolerance_);
+    system.bodies.insert(system.bodies.begin(), body);
+    ++system.number_of_oblate_bodies;
+  } else if (may_be_light && accuracy_parameters_.is_light_body(*body)) {
+    // Inserting at the end of the vectors is O(1).
+    system.light_body_gravitational_parameters.push_back(
+        body->gravitational_parameter());
+    system.bodies.push_back(body);
+    ++system.number_of_spherical_bodies;
+    ++system.number_of_light_bodies;
+  } else {
+    // Inserting before the light bodies, i.e., at the end of the vectors if
+    // there are no light bodies.
+    int const b = system.bodies.size() - system.number_of_light_bodies;
+    system.bodies.insert(system.bodies.begin() + b, body);
+    ++system.number_of_spherical_bodies;
+  }
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::BindTrajectories() {
+  std::map<not_null<MassiveBody const*>, not_null<ContinuousTrajectory<Frame>*>>
+      trajectories;
+  for (auto const& pair : bodies_to_trajectories_) {
+    trajectories.emplace(pair.first, pair.second.get());
+  }
+  for (auto const& subsystem : subsystems_) {
+    trajectories.emplace(subsystem.barycentre.get(),
+                         subsystem.barycentre_trajectory.get());
+  }
+  auto const bind = [&trajectories](IntegratedSystem& system) {
+    system.trajectories.clear();
+    for (auto const body : system.bodies) {
+      system.trajectories.push_back(FindOrDie(trajectories, body));
+    }
+  };
+  bind(outer_system_);
+  for (auto& subsystem : subsystems_) {
+    bind(subsystem.system);
+  }
+}
+
+template<typename Frame>
+typename Ephemeris<Frame>::NewtonianMotionEquation
+Ephemeris<Frame>::SubsystemEquation(int const subsystem) {
+  NewtonianMotionEquation equation;
+  equation.compute_acceleration = [this, subsystem](
+      Instant const& t,
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) {
+    ComputeSubsystemGravitationalAccelerations(subsystem,
+                                               t,
+                                               positions,
+                                               accelerations);
+    return Status::OK;
+  };
+  return equation;
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::ResetOuterMotion() {
+  outer_motion_.clear();
+  if (subsystems_.empty()) {
+    return;
+  }
+  Instant const& t = outer_state_.time.value;
+  Time const& h = fixed_step_parameters_.step_;
+  for (int i = 0; i < outer_state_.positions.size(); ++i) {
+    Position<Frame> const& q = outer_state_.positions[i].value;
+    Velocity<Frame> const& v = outer_state_.velocities[i].value;
+    outer_motion_.emplace_back(std::make_pair(t, t + h),
+                               std::make_pair(q, q + v * h),
+                               std::make_pair(v, v));
+  }
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::WriteToCheckpoint(
     not_null<serialization::Ephemeris*> message) {
   instance_->WriteToMessage(message->mutable_instance());
+  for (auto const& subsystem : subsystems_) {
+    subsystem.instance->WriteToMessage(message->add_subsystem_instance());
+  }
 }
 
 template<typename Frame>
@@ -870,9 +1421,10 @@ bool Ephemeris<Frame>::ReadFromCheckpoint(
       Instant const& t,
       std::vector<Position<Frame>> const& positions,
       std::vector<Vector<Acceleration, Frame>>& accelerations) {
-    ComputeMassiveBodiesGravitationalAccelerations(t,
-                                                    positions,
-                                                    accelerations);
+    ComputeMassiveBodiesGravitationalAccelerations(outer_system_,
+                                                   t,
+                                                   positions,
+                                                   accelerations);
     return Status::OK;
   };
 
@@ -882,6 +1434,19 @@ bool Ephemeris<Frame>::ReadFromCheckpoint(
           equation,
           /*append_state=*/
           std::bind(&Ephemeris::AppendMassiveBodiesState, this, _1));
+  outer_state_ = instance_->state();
+  ResetOuterMotion();
+
+  CHECK_EQ(subsystems_.size(), message.subsystem_instance_size());
+  for (int k = 0; k < subsystems_.size(); ++k) {
+    subsystems_[k].instance =
+        FixedStepSizeIntegrator<NewtonianMotionEquation>::Instance::
+            ReadFromMessage(
+                message.subsystem_instance(k),
+                SubsystemEquation(k),
+                /*append_state=*/
+                std::bind(&Ephemeris::AppendSubsystemState, this, k, _1));
+  }
   return true;
 }
 
@@ -892,6 +1457,10 @@ void Ephemeris<Frame>::CreateCheckpointIfNeeded(Instant const& time) const {
     for (auto const& trajectory : trajectories_) {
       trajectory->checkpointer().CreateUnconditionally(time);
     }
+    for (auto const& subsystem : subsystems_) {
+      subsystem.barycentre_trajectory->checkpointer().CreateUnconditionally(
+          time);
+    }
   }
 }
 
@@ -901,8 +1470,8 @@ void Ephemeris<Frame>::AppendMassiveBodiesState(
   lock_.AssertHeld();
   Instant const time = state.time.value;
   int index = 0;
-  for (int i = 0; i < trajectories_.size(); ++i) {
-    auto const& trajectory = trajectories_[i];
+  for (int i = 0; i < outer_system_.trajectories.size(); ++i) {
+    auto const& trajectory = outer_system_.trajectories[i];
     auto const status = trajectory->Append(
         time,
         DegreesOfFreedom<Frame>(state.positions[index].value,
@@ -912,7 +1481,8 @@ void Ephemeris<Frame>::AppendMassiveBodiesState(
     if (!status.ok()) {
       last_severe_integration_status_ =
           Status(status.error(),
-                 "Error extending trajectory for " + bodies_[i]->name() + ". " +
+                 "Error extending trajectory for " +
+                     outer_system_.bodies[i]->name() + ". " +
                      status.message());
       LOG(ERROR) << "New Apocalypse: " << last_severe_integration_status_;
     }
@@ -920,9 +1490,62 @@ void Ephemeris<Frame>::AppendMassiveBodiesState(
     ++index;
   }
 
+  if (!subsystems_.empty()) {
+    // Interpolate the motion of the outer bodies over the step that was just
+    // completed, and bring the subsystems to the end of that step.  This keeps
+    // all the instances in sync for checkpointing.
+    outer_motion_.clear();
+    for (int i = 0; i < state.positions.size(); ++i) {
+      outer_motion_.emplace_back(
+          std::make_pair(outer_state_.time.value, time),
+          std::make_pair(outer_state_.positions[i].value,
+                         state.positions[i].value),
+          std::make_pair(outer_state_.velocities[i].value,
+                         state.velocities[i].value));
+    }
+    outer_state_ = state;
+    for (auto const& subsystem : subsystems_) {
+      // Solving up to half a substep past |time| ensures that the subsystem
+      // performs exactly |substeps| steps notwithstanding rounding.
+      subsystem.instance->Solve(
+          time + 0.5 * fixed_step_parameters_.step_ / subsystem.substeps);
+    }
+  }
+
   CreateCheckpointIfNeeded(time);
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::AppendSubsystemState(
+    int const subsystem,
+    typename NewtonianMotionEquation::SystemState const& state) {
+  lock_.AssertHeld();
+  IntegratedSystem const& system = subsystems_[subsystem].system;
+  Instant const time = state.time.value;
+  auto const& barycentre_motion =
+      outer_motion_[subsystems_[subsystem].barycentre_index];
+  Position<Frame> const barycentre_position = barycentre_motion.Evaluate(time);
+  Velocity<Frame> const barycentre_velocity =
+      barycentre_motion.EvaluateDerivative(time);
+  for (int i = 0; i < system.trajectories.size(); ++i) {
+    auto const& trajectory = system.trajectories[i];
+    auto const status = trajectory->Append(
+        time,
+        DegreesOfFreedom<Frame>(
+            barycentre_position + (state.positions[i].value - Frame::origin),
+            barycentre_velocity + state.velocities[i].value));
+
+    // Handle the apocalypse.
+    if (!status.ok()) {
+      last_severe_integration_status_ =
+          Status(status.error(),
+                 "Error extending trajectory for " +
+                     system.bodies[i]->name() + ". " + status.message());
+      LOG(ERROR) << "New Apocalypse: " << last_severe_integration_status_;
+    }
+  }
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::AppendMasslessBodiesState(
     typename NewtonianMotionEquation::SystemState const& state,
@@ -1031,16 +1654,20 @@ ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
     Instant const& t,
     MassiveBody const& body1,
     std::size_t const b1,
+    Position<Frame> const& position1,
+    std::vector<Geopotential<Frame>> const& geopotentials1,
     std::vector<Position<Frame>> const& positions,
-    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
-  lock_.AssertReaderHeld();
+    std::vector<Vector<Acceleration, Frame>>& accelerations) {
   GravitationalParameter const& μ1 = body1.gravitational_parameter();
-  auto const& trajectory1 = *trajectories_[b1];
-  Position<Frame> const position1 = trajectory1.EvaluatePosition(t);
   Length const body1_collision_radius =
       mean_radius_tolerance * body1.mean_radius();
   Error error = Error::OK;
 
+  // The orientation of |body1| is the same for all the massless bodies, so
+  // only compute it once, and only if some massless body is close enough for
+  // it to be used.
+  std::optional<typename Geopotential<Frame>::Orientation> orientation1;
+
   for (std::size_t b2 = 0; b2 < positions.size(); ++b2) {
     // A vector from the center of |b2| to the center of |b1|.
     Displacement<Frame> const Δq = position1 - positions[b2];
@@ -1055,11 +1682,19 @@ ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
     accelerations[b2] += Δq * μ1_over_Δq³;
 
     if (body1_is_oblate) {
+      Geopotential<Frame> const& geopotential1 = geopotentials1[b1];
+      // Beyond the sectoral threshold the geopotential is zonal and the
+      // orientation is not used, see |Geopotential::AllDegrees::Acceleration|.
+      if (!orientation1.has_value() &&
+          Δq_norm <= geopotential1.sectoral_damping().outer_threshold()) {
+        orientation1 = geopotential1.OrientationAt(t);
+      }
       Vector<Quotient<Acceleration,
                       GravitationalParameter>, Frame> const
           degree_2_zonal_effect1 =
-              geopotentials_[b1].GeneralSphericalHarmonicsAcceleration(
-                  t,
+              geopotential1.GeneralSphericalHarmonicsAcceleration(
+                  orientation1.value_or(
+                      typename Geopotential<Frame>::Orientation{}),
                   -Δq,
                   Δq_norm,
                   Δq²,
@@ -1072,47 +1707,125 @@ ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
 
 template<typename Frame>
 void Ephemeris<Frame>::ComputeMassiveBodiesGravitationalAccelerations(
+    IntegratedSystem const& system,
     Instant const& t,
     std::vector<Position<Frame>> const& positions,
     std::vector<Vector<Acceleration, Frame>>& accelerations) const {
   lock_.AssertReaderHeld();
   accelerations.assign(accelerations.size(), Vector<Acceleration, Frame>());
 
-  for (std::size_t b1 = 0; b1 < number_of_oblate_bodies_; ++b1) {
-    MassiveBody const& body1 = *bodies_[b1];
+  int const number_of_oblate_bodies = system.number_of_oblate_bodies;
+  int const number_of_spherical_bodies = system.number_of_spherical_bodies;
+  int const number_of_light_bodies = system.number_of_light_bodies;
+
+  for (std::size_t b1 = 0; b1 < number_of_oblate_bodies; ++b1) {
+    MassiveBody const& body1 = *system.bodies[b1];
     ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies<
         /*body1_is_oblate=*/true,
         /*body2_is_oblate=*/true>(
         t,
         body1, b1,
-        /*bodies2=*/bodies_,
+        /*bodies2=*/system.bodies,
         /*b2_begin=*/b1 + 1,
-        /*b2_end=*/number_of_oblate_bodies_,
-        positions, accelerations, geopotentials_);
+        /*b2_end=*/number_of_oblate_bodies,
+        positions, accelerations, system.geopotentials);
     ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies<
         /*body1_is_oblate=*/true,
         /*body2_is_oblate=*/false>(
         t,
         body1, b1,
-        /*bodies2=*/bodies_,
-        /*b2_begin=*/number_of_oblate_bodies_,
-        /*b2_end=*/number_of_oblate_bodies_ + number_of_spherical_bodies_,
-        positions, accelerations, geopotentials_);
+        /*bodies2=*/system.bodies,
+        /*b2_begin=*/number_of_oblate_bodies,
+        /*b2_end=*/number_of_oblate_bodies + number_of_spherical_bodies,
+        positions, accelerations, system.geopotentials);
   }
-  for (std::size_t b1 = number_of_oblate_bodies_;
-       b1 < number_of_oblate_bodies_ +
-            number_of_spherical_bodies_;
+  // The attraction between pairs of light bodies is not computed here, see
+  // below.
+  for (std::size_t b1 = number_of_oblate_bodies;
+       b1 < number_of_oblate_bodies +
+            number_of_spherical_bodies -
+            number_of_light_bodies;
        ++b1) {
-    MassiveBody const& body1 = *bodies_[b1];
+    MassiveBody const& body1 = *system.bodies[b1];
     ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies<
         /*body1_is_oblate=*/false,
         /*body2_is_oblate=*/false>(
         t,
         body1, b1,
-        /*bodies2=*/bodies_,
+        /*bodies2=*/system.bodies,
         /*b2_begin=*/b1 + 1,
-        /*b2_end=*/number_of_oblate_bodies_ + number_of_spherical_bodies_,
-        positions, accelerations, geopotentials_);
+        /*b2_end=*/number_of_oblate_bodies + number_of_spherical_bodies,
+        positions, accelerations, system.geopotentials);
+  }
+
+  if (number_of_light_bodies > 0) {
+    std::size_t const first_light_body =
+        number_of_oblate_bodies + number_of_spherical_bodies -
+        number_of_light_bodies;
+    BarnesHutTree<Frame> const tree(
+        std::vector<Position<Frame>>(positions.begin() + first_light_body,
+                                     positions.end()),
+        system.light_body_gravitational_parameters,
+        accuracy_parameters_.far_field_opening_angle_);
+    for (int b = 0; b < number_of_light_bodies; ++b) {
+      accelerations[first_light_body + b] += tree.AccelerationOn(b);
+    }
+  }
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::ComputeSubsystemGravitationalAccelerations(
+    int const subsystem,
+    Instant const& t,
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  lock_.AssertReaderHeld();
+  Subsystem const& s = subsystems_[subsystem];
+  ComputeMassiveBodiesGravitationalAccelerations(
+      s.system, t, positions, accelerations);
+
+  // The tidal acceleration exerted by an outer body is the difference between
+  // its accelerations of a body of the subsystem and of the barycentre, which
+  // is placed last in |absolute_positions|.
+  Position<Frame> const barycentre =
+      outer_motion_[s.barycentre_index].Evaluate(t);
+  std::vector<Position<Frame>> absolute_positions;
+  absolute_positions.reserve(positions.size() + 1);
+  for (auto const& position : positions) {
+    absolute_positions.push_back(barycentre + (position - Frame::origin));
+  }
+  absolute_positions.push_back(barycentre);
+  std::vector<Vector<Acceleration, Frame>> outer_accelerations(
+      absolute_positions.size());
+
+  // Collisions are not detected between massive bodies, so the error is
+  // ignored.
+  for (int b1 = 0; b1 < outer_system_.bodies.size(); ++b1) {
+    if (b1 == s.barycentre_index) {
+      continue;
+    }
+    MassiveBody const& body1 = *outer_system_.bodies[b1];
+    Position<Frame> const position1 = outer_motion_[b1].Evaluate(t);
+    if (b1 < outer_system_.number_of_oblate_bodies) {
+      ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies<
+          /*body1_is_oblate=*/true>(
+          t,
+          body1, b1, position1, outer_system_.geopotentials,
+          absolute_positions,
+          outer_accelerations);
+    } else {
+      ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies<
+          /*body1_is_oblate=*/false>(
+          t,
+          body1, b1, position1, outer_system_.geopotentials,
+          absolute_positions,
+          outer_accelerations);
+    }
+  }
+  Vector<Acceleration, Frame> const& barycentre_acceleration =
+      outer_accelerations.back();
+  for (int i = 0; i < positions.size(); ++i) {
+    accelerations[i] += outer_accelerations[i] - barycentre_acceleration;
   }
 }
 
@@ -1133,6 +1846,8 @@ Error Ephemeris<Frame>::ComputeMasslessBodiesGravitationalAccelerations(
                  /*body1_is_oblate=*/true>(
                  t,
                  body1, b1,
+                 trajectories_[b1]->EvaluatePosition(t),
+                 geopotentials_,
                  positions,
                  accelerations);
   }
@@ -1145,12 +1860,64 @@ Error Ephemeris<Frame>::ComputeMasslessBodiesGravitationalAccelerations(
                  /*body1_is_oblate=*/false>(
                  t,
                  body1, b1,
+                 trajectories_[b1]->EvaluatePosition(t),
+                 geopotentials_,
                  positions,
                  accelerations);
   }
   return error;
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::SelectKeplerianCentres(
+    Instant const& t,
+    std::vector<Position<Frame>> const& positions,
+    std::vector<int>& centres) const {
+  CHECK_EQ(positions.size(), centres.size());
+  std::vector<Position<Frame>> body_positions;
+  body_positions.reserve(bodies_.size());
+  {
+    absl::ReaderMutexLock l(&lock_);
+    for (auto const& trajectory : trajectories_) {
+      body_positions.push_back(trajectory->EvaluatePosition(t));
+    }
+  }
+  for (int i = 0; i < positions.size(); ++i) {
+    Quotient<GravitationalParameter, Exponentiation<Length, 3>>
+        largest_μ_over_d³;
+    centres[i] = -1;
+    for (int b = 0; b < bodies_.size(); ++b) {
+      Length const d = (positions[i] - body_positions[b]).Norm();
+      auto const μ_over_d³ =
+          bodies_[b]->gravitational_parameter() / (d * d * d);
+      if (μ_over_d³ > largest_μ_over_d³) {
+        largest_μ_over_d³ = μ_over_d³;
+        centres[i] = b;
+      }
+    }
+  }
+}
+
+template<typename Frame>
+typename Ephemeris<Frame>::NewtonianMotionEquation::Centre
+Ephemeris<Frame>::ComputeKeplerianCentre(Instant const& t,
+                                         int const centre) const {
+  MassiveBody const& body = *bodies_[centre];
+  Position<Frame> position;
+  Velocity<Frame> velocity;
+  {
+    absl::ReaderMutexLock l(&lock_);
+    DegreesOfFreedom<Frame> const degrees_of_freedom =
+        trajectories_[centre]->EvaluateDegreesOfFreedom(t);
+    position = degrees_of_freedom.position();
+    velocity = degrees_of_freedom.velocity();
+  }
+  return {body.gravitational_parameter(),
+          position,
+          velocity,
+          ComputeGravitationalAccelerationOnMassiveBody(&body, t)};
+}
+
 template<typename Frame>
 template<typename ODE>
 Status Ephemeris<Frame>::FlowODEWithAdaptiveStep(
@@ -1192,7 +1959,8 @@ Status Ephemeris<Frame>::FlowODEWithAdaptiveStep(
           /*first_time_step=*/t_final - problem.initial_state.time.value,
           /*safety_factor=*/0.9,
           parameters.max_steps_,
-          /*last_step_is_exact=*/true);
+          /*last_step_is_exact=*/true,
+          parameters.compensated_summation_);
   CHECK_GT(integrator_parameters.first_time_step, 0 * Second)
       << "Flow back to the future: " << t_final
       << " <= " << problem.initial_state.time.value;
@@ -1,10 +1,12 @@
 ﻿
 #include "physics/ephemeris.hpp"
 
+#include <atomic>
 #include <limits>
 #include <map>
 #include <optional>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "astronomy/frames.hpp"
@@ -49,15 +51,18 @@ using geometry::Displacement;
 using geometry::Frame;
 using geometry::Rotation;
 using geometry::Velocity;
+using integrators::CompensatedSummation;
 using integrators::EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator;
 using integrators::EmbeddedExplicitRungeKuttaNyströmIntegrator;
 using integrators::SymmetricLinearMultistepIntegrator;
 using integrators::SymplecticRungeKuttaNyströmIntegrator;
+using integrators::methods::BlanesMoan2002SRKN14A;
 using integrators::methods::DormandالمكاوىPrince1986RKN434FM;
 using integrators::methods::Fine1987RKNG34;
 using integrators::methods::McLachlanAtela1992Order4Optimal;
 using integrators::methods::McLachlanAtela1992Order5Optimal;
 using integrators::methods::Quinlan1999Order8A;
+using numerics::DoublePrecision;
 using quantities::Abs;
 using quantities::ArcTan;
 using quantities::Area;
@@ -70,6 +75,8 @@ using quantities::astronomy::JulianYear;
 using quantities::astronomy::SolarGravitationalParameter;
 using quantities::astronomy::TerrestrialEquatorialRadius;
 using quantities::astronomy::TerrestrialPolarRadius;
+using quantities::si::Centi;
+using quantities::si::Day;
 using quantities::si::Hour;
 using quantities::si::Kilo;
 using quantities::si::Kilogram;
@@ -101,21 +108,15 @@ char constexpr small_name[] = "Small";
 
 }  // namespace
 
-class EphemerisTest : public testing::TestWithParam<FixedStepSizeIntegrator<
-                          Ephemeris<ICRS>::NewtonianMotionEquation> const*> {
+class EphemerisTestBase : public testing::Test {
  protected:
-  EphemerisTest()
+  EphemerisTestBase()
       : solar_system_(
             SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
             SOLUTION_DIR / "astronomy" /
                 "sol_initial_state_jd_2433282_500000000.proto.txt"),
         t0_(solar_system_.epoch()) {}
 
-  FixedStepSizeIntegrator<Ephemeris<ICRS>::NewtonianMotionEquation> const&
-  integrator() {
-    return *GetParam();
-  }
-
   void SetUpEarthMoonSystem(
       std::vector<not_null<std::unique_ptr<MassiveBody const>>>& bodies,
       std::vector<DegreesOfFreedom<ICRS>>& initial_state,
@@ -163,6 +164,20 @@ class EphemerisTest : public testing::TestWithParam<FixedStepSizeIntegrator<
   Instant t0_;
 };
 
+class EphemerisTest
+    : public EphemerisTestBase,
+      public testing::WithParamInterface<FixedStepSizeIntegrator<
+          Ephemeris<ICRS>::NewtonianMotionEquation> const*> {
+ protected:
+  FixedStepSizeIntegrator<Ephemeris<ICRS>::NewtonianMotionEquation> const&
+  integrator() {
+    return *GetParam();
+  }
+};
+
+// The reference positions don't depend on the integrator of the ephemeris.
+using EphemerisReferenceTest = EphemerisTestBase;
+
 TEST_P(EphemerisTest, ProlongSpecialCases) {
   std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
   std::vector<DegreesOfFreedom<ICRS>> initial_state;
@@ -253,6 +268,65 @@ TEST_P(EphemerisTest, FlowWithAdaptiveStepSpecialCase) {
       /*last_point_only=*/false));
 }
 
+// Checks that an integration stops as soon as it is cancelled.
+TEST_P(EphemerisTest, FlowWithAdaptiveStepCancelled) {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<ICRS>> initial_state;
+  Position<ICRS> centre_of_mass;
+  Time period;
+  SetUpEarthMoonSystem(bodies, initial_state, centre_of_mass, period);
+
+  Position<ICRS> const earth_position = initial_state[0].position();
+
+  Ephemeris<ICRS> ephemeris(
+      std::move(bodies),
+      initial_state,
+      t0_,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/5 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<ICRS>::FixedStepParameters(integrator(), period / 100));
+
+  DiscreteTrajectory<ICRS> trajectory;
+  trajectory.Append(
+      t0_,
+      DegreesOfFreedom<ICRS>(
+          earth_position +
+              Displacement<ICRS>({0 * Metre, 1e9 * Metre, 0 * Metre}),
+          Velocity<ICRS>({1e3 * Metre / Second,
+                          1e3 * Metre / Second,
+                          1e3 * Metre / Second})));
+
+  // Cancel the integration at the 10th evaluation of the right-hand side.
+  std::atomic_bool cancelled = false;
+  int evaluations = 0;
+  auto const intrinsic_acceleration = [&cancelled, &evaluations](
+                                          Instant const& t) {
+    if (++evaluations == 10) {
+      cancelled = true;
+    }
+    return Vector<Acceleration, ICRS>();
+  };
+  Ephemeris<ICRS>::AdaptiveStepParameters parameters(
+      EmbeddedExplicitRungeKuttaNyströmIntegrator<
+          DormandالمكاوىPrince1986RKN434FM,
+          Position<ICRS>>(),
+      max_steps,
+      1e-9 * Metre,
+      2.6e-15 * Metre / Second);
+  parameters.set_cancelled(&cancelled);
+
+  EXPECT_THAT(ephemeris.FlowWithAdaptiveStep(
+                  &trajectory,
+                  intrinsic_acceleration,
+                  t0_ + period,
+                  parameters,
+                  Ephemeris<ICRS>::unlimited_max_ephemeris_steps,
+                  /*last_point_only=*/false),
+              StatusIs(Error::CANCELLED));
+  EXPECT_EQ(10, evaluations);
+  EXPECT_LT(trajectory.last().time(), t0_ + period);
+}
+
 // The canonical Earth-Moon system, tuned to produce circular orbits.
 TEST_P(EphemerisTest, EarthMoon) {
   std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
@@ -304,6 +378,48 @@ TEST_P(EphemerisTest, EarthMoon) {
   EXPECT_THAT(Abs(moon_positions[100].coordinates().x), Lt(2 * Metre));
 }
 
+TEST_F(EphemerisReferenceTest, EarthMoon) {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<ICRS>> initial_state;
+  Position<ICRS> centre_of_mass;
+  Time period;
+  SetUpEarthMoonSystem(bodies, initial_state, centre_of_mass, period);
+
+  Ephemeris<ICRS> ephemeris(
+      std::move(bodies),
+      initial_state,
+      t0_,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/5 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<ICRS>::FixedStepParameters(
+          SymplecticRungeKuttaNyströmIntegrator<McLachlanAtela1992Order5Optimal,
+                                                Position<ICRS>>(),
+          period / 100));
+  ephemeris.Prolong(t0_);
+
+  std::vector<DoublePrecision<Position<ICRS>>> const positions =
+      ephemeris.ComputeReferencePositions<BlanesMoan2002SRKN14A>(
+          t0_, t0_ + period, period / 1000);
+  std::vector<DoublePrecision<Position<ICRS>>> const refined_positions =
+      ephemeris.ComputeReferencePositions<BlanesMoan2002SRKN14A>(
+          t0_, t0_ + period, period / 2000);
+  ASSERT_THAT(positions.size(), Eq(2));
+  ASSERT_THAT(refined_positions.size(), Eq(2));
+  for (int b = 0; b < 2; ++b) {
+    // The orbit is circular, so the bodies return to their initial positions,
+    // up to the fitting error of the initial state.
+    EXPECT_THAT(
+        (positions[b] -
+         DoublePrecision<Position<ICRS>>(initial_state[b].position()))
+            .value.Norm(),
+        Lt(1 * Milli(Metre)));
+    // The reference integration has converged well beyond the accuracy of the
+    // double-precision integration.
+    EXPECT_THAT((positions[b] - refined_positions[b]).value.Norm(),
+                Lt(1e-8 * Metre));
+  }
+}
+
 // Test the behavior of EventuallyForgetBefore on the Earth-Moon system.
 TEST_P(EphemerisTest, EventuallyForgetBefore) {
   std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
@@ -712,6 +828,107 @@ TEST_P(EphemerisTest, Serialization) {
   EXPECT_THAT(message, EqualsProto(second_message));
 }
 
+TEST_P(EphemerisTest, AdaptiveStepParametersSerialization) {
+  Ephemeris<ICRS>::AdaptiveStepParameters parameters(
+      EmbeddedExplicitRungeKuttaNyströmIntegrator<
+          DormandالمكاوىPrince1986RKN434FM,
+          Position<ICRS>>(),
+      /*max_steps=*/100,
+      /*length_integration_tolerance=*/1 * Milli(Metre),
+      /*speed_integration_tolerance=*/1 * Milli(Metre) / Second);
+  parameters.set_compensated_summation(CompensatedSummation::TimeOnly);
+
+  serialization::Ephemeris::AdaptiveStepParameters message;
+  parameters.WriteToMessage(&message);
+  EXPECT_EQ(serialization::Ephemeris::AdaptiveStepParameters::TIME_ONLY,
+            message.compensated_summation());
+  EXPECT_EQ(CompensatedSummation::TimeOnly,
+            Ephemeris<ICRS>::AdaptiveStepParameters::ReadFromMessage(message)
+                .compensated_summation());
+
+  // Compatibility: the parameters of older saves use compensated summation.
+  message.clear_compensated_summation();
+  EXPECT_EQ(CompensatedSummation::Full,
+            Ephemeris<ICRS>::AdaptiveStepParameters::ReadFromMessage(message)
+                .compensated_summation());
+}
+
+// The Galilean moons integrated as a subsystem with a step much shorter than
+// that of the rest of the solar system.
+TEST_P(EphemerisTest, Subsystems) {
+  std::set<std::string> const jovian_system_names =
+      {"Jupiter", "Io", "Europa", "Ganymede", "Callisto"};
+  SolarSystem<ICRS> solar_system = solar_system_;
+  for (std::string const& name : solar_system_.names()) {
+    if (name != "Sun" && jovian_system_names.count(name) == 0) {
+      solar_system.RemoveMassiveBody(name);
+    }
+  }
+  std::vector<DegreesOfFreedom<ICRS>> initial_state;
+  for (std::string const& name : solar_system.names()) {
+    initial_state.push_back(solar_system.degrees_of_freedom(name));
+  }
+
+  auto const make_ephemeris =
+      [&initial_state, &solar_system, this](
+          Time const& step,
+          std::vector<Ephemeris<ICRS>::SubsystemParameters> const&
+              subsystem_parameters) {
+        return std::make_unique<Ephemeris<ICRS>>(
+            solar_system.MakeAllMassiveBodies(),
+            initial_state,
+            solar_system.epoch(),
+            /*accuracy_parameters=*/
+            Ephemeris<ICRS>::AccuracyParameters(
+                /*fitting_tolerance=*/5 * Milli(Metre),
+                /*geopotential_tolerance=*/0x1p-24),
+            Ephemeris<ICRS>::FixedStepParameters(integrator(), step),
+            subsystem_parameters);
+      };
+  auto const reference = make_ephemeris(10 * Minute, {});
+  auto const flat = make_ephemeris(4 * Hour, {});
+  auto const hierarchical = make_ephemeris(
+      4 * Hour,
+      {Ephemeris<ICRS>::SubsystemParameters(
+           std::vector<std::string>(jovian_system_names.begin(),
+                                    jovian_system_names.end()),
+           /*substeps=*/24)});
+
+  Instant const t_final = solar_system.epoch() + 30 * Day;
+  reference->Prolong(t_final);
+  flat->Prolong(t_final);
+  hierarchical->Prolong(t_final);
+
+  auto const error = [&solar_system, t_final, &reference](
+                         Ephemeris<ICRS> const& ephemeris,
+                         std::string const& name) {
+    return (solar_system.trajectory(ephemeris, name).EvaluatePosition(t_final) -
+            solar_system.trajectory(*reference, name).EvaluatePosition(
+                t_final)).Norm();
+  };
+  // With a step of 4 h, Io is lost unless it is part of a subsystem.
+  EXPECT_THAT(error(*flat, "Io"), Gt(10'000 * Kilo(Metre)));
+  for (std::string const& name : solar_system.names()) {
+    EXPECT_THAT(error(*hierarchical, name), Lt(5 * Centi(Metre))) << name;
+  }
+
+  // The subsystem and its checkpoints survive serialization.
+  serialization::Ephemeris message;
+  hierarchical->WriteToMessage(&message);
+  EXPECT_EQ(1, message.subsystem_parameters_size());
+  EXPECT_EQ(1, message.barycentre_trajectory_size());
+  auto const hierarchical_read = Ephemeris<ICRS>::ReadFromMessage(message);
+  Instant const t_further = t_final + 10 * Day;
+  hierarchical->Prolong(t_further);
+  hierarchical_read->Prolong(t_further);
+  for (std::string const& name : solar_system.names()) {
+    EXPECT_EQ(solar_system.trajectory(*hierarchical, name)
+                  .EvaluateDegreesOfFreedom(t_further),
+              solar_system.trajectory(*hierarchical_read, name)
+                  .EvaluateDegreesOfFreedom(t_further)) << name;
+  }
+}
+
 // The gravitational acceleration on an elephant located at the pole.
 TEST_P(EphemerisTest, ComputeGravitationalAccelerationMasslessBody) {
   Time const duration = 1 * Second;
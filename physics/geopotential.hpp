@@ -79,6 +79,16 @@ class Geopotential {
   Geopotential(not_null<OblateBody<Frame> const*> body,
                double tolerance);
 
+  // The axes of the surface frame of the body at some instant.  Computing them
+  // involves trigonometry, so when the acceleration is evaluated at many points
+  // at the same instant they should be computed once and reused.
+  struct Orientation {
+    Vector<double, Frame> x̂;
+    Vector<double, Frame> ŷ;
+  };
+
+  Orientation OrientationAt(Instant const& t) const;
+
   Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
   SphericalHarmonicsAcceleration(
       Instant const& t,
@@ -94,6 +104,15 @@ class Geopotential {
       Square<Length> const& r²,
       Exponentiation<Length, -3> const& one_over_r³) const;
 
+  // Same as above, with the orientation of the body at |t| precomputed.
+  Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
+  GeneralSphericalHarmonicsAcceleration(
+      Orientation const& orientation,
+      Displacement<Frame> const& r,
+      Length const& r_norm,
+      Square<Length> const& r²,
+      Exponentiation<Length, -3> const& one_over_r³) const;
+
   std::vector<HarmonicDamping> const& degree_damping() const;
   HarmonicDamping const& sectoral_damping() const;
 
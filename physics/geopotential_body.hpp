@@ -148,7 +148,7 @@ template<typename Frame>
 template<int... degrees>
 struct Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>> {
   static auto Acceleration(Geopotential<Frame> const& geopotential,
-                           Instant const& t,
+                           Orientation const& orientation,
                            Displacement<Frame> const& r,
                            Length const& r_norm,
                            Square<Length> const& r²,
@@ -395,7 +395,7 @@ template<typename Frame>
 template<int... degrees>
 auto Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>>::
 Acceleration(Geopotential<Frame> const& geopotential,
-             Instant const& t,
+             Orientation const& orientation,
              Displacement<Frame> const& r,
              Length const& r_norm,
              Square<Length> const& r²,
@@ -437,10 +437,8 @@ Acceleration(Geopotential<Frame> const& geopotential,
     x̂ = body.equatorial();
     ŷ = body.biequatorial();
   } else {
-    auto const from_surface_frame =
-      body.template FromSurfaceFrame<SurfaceFrame>(t);
-    x̂ = from_surface_frame(x_);
-    ŷ = from_surface_frame(y_);
+    x̂ = orientation.x̂;
+    ŷ = orientation.ŷ;
   }
 
   Length const x = InnerProduct(r, x̂);
@@ -584,7 +582,7 @@ Geopotential<Frame>::SphericalHarmonicsAcceleration(
 #define PRINCIPIA_CASE_SPHERICAL_HARMONICS(d)                                  \
   case (d):                                                                    \
     return AllDegrees<std::make_integer_sequence<int, (d + 1)>>::Acceleration( \
-        *this, t, r, r_norm, r², one_over_r³)
+        *this, orientation, r, r_norm, r², one_over_r³)
 
 template<typename Frame>
 Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
@@ -594,6 +592,24 @@ Geopotential<Frame>::GeneralSphericalHarmonicsAcceleration(
     Length const& r_norm,
     Square<Length> const& r²,
     Exponentiation<Length, -3> const& one_over_r³) const {
+  // Don't compute the orientation if it is not going to be used, see
+  // |AllDegrees::Acceleration|.
+  bool const is_zonal =
+      body_->is_zonal() || r_norm > sectoral_damping_.outer_threshold();
+  return GeneralSphericalHarmonicsAcceleration(
+      is_zonal ? Orientation{body_->equatorial(), body_->biequatorial()}
+               : OrientationAt(t),
+      r, r_norm, r², one_over_r³);
+}
+
+template<typename Frame>
+Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
+Geopotential<Frame>::GeneralSphericalHarmonicsAcceleration(
+    Orientation const& orientation,
+    Displacement<Frame> const& r,
+    Length const& r_norm,
+    Square<Length> const& r²,
+    Exponentiation<Length, -3> const& one_over_r³) const {
   if (r_norm != r_norm) {
     // Short-circuit NaN, to avoid having to deal with an unordered
     // |r_norm| when finding the partition point below.
@@ -675,6 +691,18 @@ Geopotential<Frame>::GeneralSphericalHarmonicsAcceleration(
 
 #undef PRINCIPIA_CASE_SPHERICAL_HARMONICS
 
+template<typename Frame>
+auto Geopotential<Frame>::OrientationAt(Instant const& t) const
+    -> Orientation {
+  // In the zonal case the rotation of the body is of no importance.
+  if (body_->is_zonal()) {
+    return {body_->equatorial(), body_->biequatorial()};
+  }
+  auto const from_surface_frame =
+      body_->template FromSurfaceFrame<SurfaceFrame>(t);
+  return {from_surface_frame(x_), from_surface_frame(y_)};
+}
+
 template<typename Frame>
 std::vector<HarmonicDamping> const& Geopotential<Frame>::degree_damping()
     const {
@@ -244,6 +244,44 @@ TEST_F(GeopotentialTest, C22S22) {
   }
 }
 
+// The precomputed orientation gives the same results as the computation at a
+// given time.
+TEST_F(GeopotentialTest, Orientation) {
+  serialization::OblateBody::Geopotential message;
+  {
+    auto* const degree2 = message.add_row();
+    degree2->set_degree(2);
+    auto* const order0 = degree2->add_column();
+    order0->set_order(0);
+    order0->set_cos(-6 / LegendreNormalizationFactor[2][0]);
+    order0->set_sin(0);
+    auto* const order2 = degree2->add_column();
+    order2->set_order(2);
+    order2->set_cos(10 / LegendreNormalizationFactor[2][2]);
+    order2->set_sin(-13 / LegendreNormalizationFactor[2][2]);
+  }
+  OblateBody<World> const body =
+      OblateBody<World>(massive_body_parameters_,
+                        rotating_body_parameters_,
+                        OblateBody<World>::Parameters::ReadFromMessage(
+                            message, 1 * Metre));
+  Geopotential<World> const geopotential(&body, /*tolerance=*/0);
+
+  Instant const t = Instant() + 17 * Second;
+  auto const orientation = geopotential.OrientationAt(t);
+  for (auto const& r :
+       {Displacement<World>({30 * Metre, 40 * Metre, 0 * Metre}),
+        Displacement<World>({-3 * Metre, 7 * Metre, 5 * Metre}),
+        Displacement<World>({2 * Metre, 0 * Metre, -9 * Metre})}) {
+    auto const r² = r.Norm²();
+    auto const r_norm = Sqrt(r²);
+    auto const one_over_r³ = r_norm / (r² * r²);
+    EXPECT_EQ(GeneralSphericalHarmonicsAcceleration(geopotential, t, r),
+              geopotential.GeneralSphericalHarmonicsAcceleration(
+                  orientation, r, r_norm, r², one_over_r³));
+  }
+}
+
 TEST_F(GeopotentialTest, J3) {
   serialization::OblateBody::Geopotential message;
   {
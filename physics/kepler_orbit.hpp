@@ -4,7 +4,9 @@
 #include <optional>
 #include <ostream>
 #include <string>
+#include <vector>
 
+#include "geometry/rotation.hpp"
 #include "physics/body.hpp"
 #include "physics/degrees_of_freedom.hpp"
 
@@ -14,6 +16,7 @@ namespace internal_kepler_orbit {
 
 using base::not_null;
 using geometry::Instant;
+using geometry::Rotation;
 using quantities::Angle;
 using quantities::AngularFrequency;
 using quantities::GravitationalParameter;
@@ -105,6 +108,10 @@ class KeplerOrbit final {
 
   // The |DegreesOfFreedom| of the secondary minus those of the primary.
   RelativeDegreesOfFreedom<Frame> StateVectors(Instant const& t) const;
+  // Same as above for many times.  This is faster than calling the above
+  // method repeatedly as the orientation of the orbit is only computed once.
+  std::vector<RelativeDegreesOfFreedom<Frame>> StateVectors(
+      std::vector<Instant> const& times) const;
 
   // All |optional|s are filled in the result.
   KeplerianElements<Frame> const& elements_at_epoch() const;
@@ -129,6 +136,21 @@ class KeplerOrbit final {
   // minimally specified.  Fills section III.
   static void CompleteAnomalies(KeplerianElements<Frame>& elements);
 
+  // The true anomalies corresponding to the given mean anomalies.
+  static Angle EllipticTrueAnomaly(Angle const& mean_anomaly, double e);
+  static Angle HyperbolicTrueAnomaly(Angle const& hyperbolic_mean_anomaly,
+                                     double e);
+
+  // A frame where the periapsis is along the x axis and the orbit is in the
+  // xy plane.
+  struct OrbitPlane;
+
+  Rotation<OrbitPlane, Frame> FromOrbitPlane() const;
+  Angle TrueAnomaly(Instant const& t) const;
+  RelativeDegreesOfFreedom<Frame> StateVectors(
+      Angle const& true_anomaly,
+      Rotation<OrbitPlane, Frame> const& from_orbit_plane) const;
+
   GravitationalParameter const gravitational_parameter_;
   KeplerianElements<Frame> elements_at_epoch_;
   Instant const epoch_;
@@ -4,10 +4,12 @@
 #include "physics/kepler_orbit.hpp"
 
 #include <string>
+#include <vector>
 
+#include "base/macros.hpp"
 #include "base/optional_serialization.hpp"
 #include "geometry/rotation.hpp"
-#include "numerics/root_finders.hpp"
+#include "numerics/kepler_equation.hpp"
 #include "quantities/elementary_functions.hpp"
 
 namespace principia {
@@ -23,12 +25,12 @@ using geometry::EulerAngles;
 using geometry::InnerProduct;
 using geometry::Normalize;
 using geometry::OrientedAngleBetween;
-using geometry::Rotation;
 using geometry::Sign;
 using geometry::Vector;
 using geometry::Velocity;
 using geometry::Wedge;
-using numerics::Bisect;
+using numerics::SolveHyperbolicKeplerEquation;
+using numerics::SolveKeplerEquation;
 using quantities::Abs;
 using quantities::ArcCos;
 using quantities::ArcCosh;
@@ -41,6 +43,7 @@ using quantities::DebugString;
 using quantities::NaN;
 using quantities::Pow;
 using quantities::Sin;
+using quantities::SinCos;
 using quantities::Sinh;
 using quantities::SpecificAngularMomentum;
 using quantities::SpecificEnergy;
@@ -234,55 +237,87 @@ KeplerOrbit<Frame>::KeplerOrbit(
 template<typename Frame>
 RelativeDegreesOfFreedom<Frame>
 KeplerOrbit<Frame>::StateVectors(Instant const& t) const {
-  GravitationalParameter const& μ = gravitational_parameter_;
+  return StateVectors(TrueAnomaly(t), FromOrbitPlane());
+}
+
+template<typename Frame>
+std::vector<RelativeDegreesOfFreedom<Frame>> KeplerOrbit<Frame>::StateVectors(
+    std::vector<Instant> const& times) const {
+  auto const from_orbit_plane = FromOrbitPlane();
+  std::vector<RelativeDegreesOfFreedom<Frame>> result;
+  result.reserve(times.size());
+  for (Instant const& t : times) {
+    result.push_back(StateVectors(TrueAnomaly(t), from_orbit_plane));
+  }
+  return result;
+}
+
+template<typename Frame>
+KeplerianElements<Frame> const& KeplerOrbit<Frame>::elements_at_epoch() const {
+  return elements_at_epoch_;
+}
+
+template<typename Frame>
+Rotation<typename KeplerOrbit<Frame>::OrbitPlane, Frame>
+KeplerOrbit<Frame>::FromOrbitPlane() const {
+  return Rotation<OrbitPlane, Frame>(
+      elements_at_epoch_.longitude_of_ascending_node,
+      elements_at_epoch_.inclination,
+      *elements_at_epoch_.argument_of_periapsis,
+      EulerAngles::ZXZ,
+      DefinesFrame<OrbitPlane>{});
+}
+
+template<typename Frame>
+Angle KeplerOrbit<Frame>::TrueAnomaly(Instant const& t) const {
   double const& e = *elements_at_epoch_.eccentricity;
-  Angle const& i = elements_at_epoch_.inclination;
-  Angle const& Ω = elements_at_epoch_.longitude_of_ascending_node;
-  Angle const& ω = *elements_at_epoch_.argument_of_periapsis;
-  Length const& ℓ = *elements_at_epoch_.semilatus_rectum;
-  SpecificEnergy const& ε = *elements_at_epoch_.specific_energy;
-  KeplerianElements<Frame> elements = elements_at_epoch_;
-  elements.true_anomaly.reset();
-  elements.mean_anomaly.reset();
-  elements.hyperbolic_mean_anomaly.reset();
   if (e < 1) {
     // Elliptic case.
-    elements.mean_anomaly = *elements_at_epoch_.mean_anomaly +
-                            *elements_at_epoch_.mean_motion * (t - epoch_);
+    return EllipticTrueAnomaly(
+        *elements_at_epoch_.mean_anomaly +
+            *elements_at_epoch_.mean_motion * (t - epoch_),
+        e);
   } else if (e == 1) {
     // Parabolic case.
     LOG(FATAL) << "not yet implemented";
+    base::noreturn();
   } else {
     // Hyperbolic case.
-    elements.hyperbolic_mean_anomaly =
+    return HyperbolicTrueAnomaly(
         *elements_at_epoch_.hyperbolic_mean_anomaly +
-        *elements_at_epoch_.hyperbolic_mean_motion * (t - epoch_);
+            *elements_at_epoch_.hyperbolic_mean_motion * (t - epoch_),
+        e);
   }
-  CompleteAnomalies(elements);
-  Angle const& ν = *elements.true_anomaly;
-  struct OrbitPlane;
-  Rotation<OrbitPlane, Frame> const from_orbit_plane(
-      Ω, i, ω,
-      EulerAngles::ZXZ,
-      DefinesFrame<OrbitPlane>{});
-  Length const r = ℓ / (1 + e * Cos(ν));
+}
+
+template<typename Frame>
+RelativeDegreesOfFreedom<Frame> KeplerOrbit<Frame>::StateVectors(
+    Angle const& true_anomaly,
+    Rotation<OrbitPlane, Frame> const& from_orbit_plane) const {
+  GravitationalParameter const& μ = gravitational_parameter_;
+  double const& e = *elements_at_epoch_.eccentricity;
+  Length const& ℓ = *elements_at_epoch_.semilatus_rectum;
+  SpecificEnergy const& ε = *elements_at_epoch_.specific_energy;
+  Angle const& ν = true_anomaly;
+  double sin_ν;
+  double cos_ν;
+  SinCos(ν, sin_ν, cos_ν);
+  Length const r = ℓ / (1 + e * cos_ν);
   Displacement<Frame> const displacement =
-      r * from_orbit_plane(Vector<double, OrbitPlane>({Cos(ν), Sin(ν), 0}));
+      r * from_orbit_plane(Vector<double, OrbitPlane>({cos_ν, sin_ν, 0}));
   // Flight path angle.
-  Angle const φ = ArcTan(e * Sin(ν), 1 + e * Cos(ν));
+  Angle const φ = ArcTan(e * sin_ν, 1 + e * cos_ν);
+  double sin_ν_minus_φ;
+  double cos_ν_minus_φ;
+  SinCos(ν - φ, sin_ν_minus_φ, cos_ν_minus_φ);
   // The norm comes from the vis-viva equation.
   Velocity<Frame> const velocity =
       Sqrt(2 * (ε + μ / r)) *
       from_orbit_plane(Vector<double, OrbitPlane>(
-          {-Sin(ν - φ), Cos(ν - φ), 0}));
+          {-sin_ν_minus_φ, cos_ν_minus_φ, 0}));
   return {displacement, velocity};
 }
 
-template<typename Frame>
-KeplerianElements<Frame> const& KeplerOrbit<Frame>::elements_at_epoch() const {
-  return elements_at_epoch_;
-}
-
 template<typename Frame>
 void KeplerOrbit<Frame>::CompleteConicParametersByCategory(
     KeplerianElements<Frame>& elements,
@@ -644,37 +679,36 @@ void KeplerOrbit<Frame>::CompleteAnomalies(KeplerianElements<Frame>& elements) {
     hyperbolic_mean_anomaly = e * Sinh(hyperbolic_eccentric_anomaly) * Radian -
                               hyperbolic_eccentric_anomaly;
   } else if (mean_anomaly) {
-    auto const kepler_equation =
-        [e, mean_anomaly](Angle const& eccentric_anomaly) -> Angle {
-      return *mean_anomaly -
-             (eccentric_anomaly - e * Sin(eccentric_anomaly) * Radian);
-    };
-    Angle const eccentric_anomaly = e == 0 ? *mean_anomaly
-                                           : Bisect(kepler_equation,
-                                                    *mean_anomaly - e * Radian,
-                                                    *mean_anomaly + e * Radian);
-    true_anomaly = 2 * ArcTan(Sqrt(1 + e) * Sin(eccentric_anomaly / 2),
-                              Sqrt(1 - e) * Cos(eccentric_anomaly / 2));
+    // The mean anomaly does not determine the position on a hyperbola.
+    true_anomaly =
+        e < 1 ? EllipticTrueAnomaly(*mean_anomaly, e) : NaN<Angle>();
     hyperbolic_mean_anomaly = NaN<Angle>();
   } else if (hyperbolic_mean_anomaly) {
-    auto const hyperbolic_kepler_equation =
-        [e, hyperbolic_mean_anomaly](
-            Angle const& hyperbolic_eccentric_anomaly) -> Angle {
-      return *hyperbolic_mean_anomaly -
-             (e * Sinh(hyperbolic_eccentric_anomaly) * Radian -
-              hyperbolic_eccentric_anomaly);
-    };
-    Angle const hyperbolic_eccentric_anomaly =
-        Bisect(hyperbolic_kepler_equation,
-               0 * Radian,
-               *hyperbolic_mean_anomaly / (e - 1));
-    true_anomaly =
-        2 * ArcTan(Sqrt(e + 1) * Sinh(hyperbolic_eccentric_anomaly / 2),
-                   Sqrt(e - 1) * Cosh(hyperbolic_eccentric_anomaly / 2));
+    // Nor does the hyperbolic mean anomaly on an ellipse.
+    true_anomaly = e > 1 ? HyperbolicTrueAnomaly(*hyperbolic_mean_anomaly, e)
+                         : NaN<Angle>();
     mean_anomaly = -NaN<Angle>();
   }
 }
 
+template<typename Frame>
+Angle KeplerOrbit<Frame>::EllipticTrueAnomaly(Angle const& mean_anomaly,
+                                              double const e) {
+  Angle const eccentric_anomaly = SolveKeplerEquation(mean_anomaly, e);
+  return 2 * ArcTan(Sqrt(1 + e) * Sin(eccentric_anomaly / 2),
+                    Sqrt(1 - e) * Cos(eccentric_anomaly / 2));
+}
+
+template<typename Frame>
+Angle KeplerOrbit<Frame>::HyperbolicTrueAnomaly(
+    Angle const& hyperbolic_mean_anomaly,
+    double const e) {
+  Angle const hyperbolic_eccentric_anomaly =
+      SolveHyperbolicKeplerEquation(hyperbolic_mean_anomaly, e);
+  return 2 * ArcTan(Sqrt(e + 1) * Sinh(hyperbolic_eccentric_anomaly / 2),
+                    Sqrt(e - 1) * Cosh(hyperbolic_eccentric_anomaly / 2));
+}
+
 }  // namespace internal_kepler_orbit
 }  // namespace physics
 }  // namespace principia
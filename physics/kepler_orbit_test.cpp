@@ -1,6 +1,8 @@
 ﻿
 #include "physics/kepler_orbit.hpp"
 
+#include <vector>
+
 #include "astronomy/epoch.hpp"
 #include "astronomy/frames.hpp"
 #include "astronomy/time_scales.hpp"
@@ -482,6 +484,27 @@ TEST_F(KeplerOrbitTest, HyperbolicMeanAnomalyToTrueAnomaly) {
               AlmostEquals(*SimpleHyperbola().mean_anomaly, 0));
 }
 
+TEST_F(KeplerOrbitTest, StateVectorsAtManyTimes) {
+  for (auto const& elements : {SimpleEllipse(), SimpleHyperbola()}) {
+    KeplerianElements<ICRS> partial_elements;
+    partial_elements.semilatus_rectum = elements.semilatus_rectum;
+    partial_elements.periapsis_distance = elements.periapsis_distance;
+    partial_elements.argument_of_periapsis.emplace();
+    partial_elements.true_anomaly = elements.true_anomaly;
+    KeplerOrbit<ICRS> const orbit(
+        body_, MasslessBody{}, partial_elements, J2000);
+    std::vector<Instant> times;
+    for (int i = -50; i <= 50; ++i) {
+      times.push_back(J2000 + i * JulianYear / 10);
+    }
+    auto const state_vectors = orbit.StateVectors(times);
+    ASSERT_EQ(times.size(), state_vectors.size());
+    for (int i = 0; i < times.size(); ++i) {
+      EXPECT_THAT(state_vectors[i], Eq(orbit.StateVectors(times[i])));
+    }
+  }
+}
+
 TEST_F(KeplerOrbitTest, OrientationFromLongitudeOfPeriapsis) {
   KeplerianElements<ICRS> elements;
   elements.eccentricity = 0;
@@ -0,0 +1,95 @@
+﻿
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "base/status.hpp"
+#include "geometry/named_quantities.hpp"
+#include "integrators/integrators.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/ephemeris.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_massless_swarm {
+
+using base::not_null;
+using base::Status;
+using geometry::Instant;
+using integrators::Integrator;
+
+// A swarm of massless bodies, e.g., the fragments of a debris cloud or the
+// samples of a Monte Carlo dispersion analysis, integrated with a fixed-step
+// integrator in the gravitational potential described by an |Ephemeris|.  No
+// trajectories are recorded: the bodies are split in chunks which are
+// integrated in parallel, each by a single integrator instance, and their
+// states may be sampled by an |Observer| as the integration proceeds.
+template<typename Frame>
+class MasslessSwarm final {
+ public:
+  // Called after each step of a chunk with the current time and the degrees of
+  // freedom of the bodies with indices |first|, ...,
+  // |first + degrees_of_freedom.size() - 1|.  May be called concurrently for
+  // different chunks.
+  using Observer = std::function<void(
+      Instant const& t,
+      int first,
+      std::vector<DegreesOfFreedom<Frame>> const& degrees_of_freedom)>;
+
+  static constexpr int default_chunk_size = 256;
+
+  // The bodies start from |initial_state| at |initial_time|.
+  MasslessSwarm(
+      not_null<Ephemeris<Frame>*> ephemeris,
+      std::vector<DegreesOfFreedom<Frame>> const& initial_state,
+      Instant const& initial_time,
+      typename Ephemeris<Frame>::FixedStepParameters const& parameters,
+      Observer observer = nullptr,
+      int chunk_size = default_chunk_size);
+
+  // The instances refer to |this|.
+  MasslessSwarm(MasslessSwarm const&) = delete;
+  MasslessSwarm(MasslessSwarm&&) = delete;
+  MasslessSwarm& operator=(MasslessSwarm const&) = delete;
+  MasslessSwarm& operator=(MasslessSwarm&&) = delete;
+
+  // Integrates the swarm until at most |t|, see
+  // |Ephemeris::FlowWithFixedStep|.  Returns the first error encountered.  If
+  // a body collides with a massive body, the integration of its chunk stops at
+  // the collision, but the other chunks proceed.
+  Status Flow(Instant const& t);
+
+  // The last time reached by all the bodies.
+  Instant time() const;
+
+  // The degrees of freedom of the bodies at the last time reached by their
+  // chunk, in the order of the |initial_state|.
+  std::vector<DegreesOfFreedom<Frame>> degrees_of_freedom() const;
+
+ private:
+  using NewtonianMotionEquation =
+      typename Ephemeris<Frame>::NewtonianMotionEquation;
+  using Instance = typename Integrator<NewtonianMotionEquation>::Instance;
+
+  static void AppendDegreesOfFreedom(
+      typename NewtonianMotionEquation::SystemState const& state,
+      std::vector<DegreesOfFreedom<Frame>>& degrees_of_freedom);
+
+  not_null<Ephemeris<Frame>*> const ephemeris_;
+  Observer const observer_;
+  // The chunk with index |i| is made of the bodies starting at
+  // |i * chunk_size|.
+  std::vector<not_null<std::unique_ptr<Instance>>> instances_;
+};
+
+}  // namespace internal_massless_swarm
+
+using internal_massless_swarm::MasslessSwarm;
+
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/massless_swarm_body.hpp"
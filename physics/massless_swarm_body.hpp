@@ -0,0 +1,101 @@
+﻿
+#pragma once
+
+#include "physics/massless_swarm.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/bundle.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace physics {
+namespace internal_massless_swarm {
+
+using base::Bundle;
+
+template<typename Frame>
+MasslessSwarm<Frame>::MasslessSwarm(
+    not_null<Ephemeris<Frame>*> const ephemeris,
+    std::vector<DegreesOfFreedom<Frame>> const& initial_state,
+    Instant const& initial_time,
+    typename Ephemeris<Frame>::FixedStepParameters const& parameters,
+    Observer observer,
+    int const chunk_size)
+    : ephemeris_(ephemeris),
+      observer_(std::move(observer)) {
+  CHECK_LT(0, chunk_size);
+  CHECK(!initial_state.empty());
+  for (int first = 0; first < initial_state.size(); first += chunk_size) {
+    int const end =
+        std::min(first + chunk_size, static_cast<int>(initial_state.size()));
+    typename Integrator<NewtonianMotionEquation>::AppendState append_state;
+    if (observer_ == nullptr) {
+      append_state =
+          [](typename NewtonianMotionEquation::SystemState const& state) {};
+    } else {
+      append_state = [this, first](
+          typename NewtonianMotionEquation::SystemState const& state) {
+        std::vector<DegreesOfFreedom<Frame>> degrees_of_freedom;
+        AppendDegreesOfFreedom(state, degrees_of_freedom);
+        observer_(state.time.value, first, degrees_of_freedom);
+      };
+    }
+    instances_.push_back(ephemeris_->NewInstance(
+        std::vector<DegreesOfFreedom<Frame>>(initial_state.begin() + first,
+                                             initial_state.begin() + end),
+        initial_time,
+        Ephemeris<Frame>::NoIntrinsicAccelerations,
+        append_state,
+        parameters));
+  }
+}
+
+template<typename Frame>
+Status MasslessSwarm<Frame>::Flow(Instant const& t) {
+  // Prolong once and for all, so that the chunks don't contend for the lock of
+  // the ephemeris.
+  ephemeris_->Prolong(t);
+  Bundle bundle;
+  for (auto const& instance : instances_) {
+    Instance* const chunk_instance = instance.get();
+    bundle.Add([this, chunk_instance, t]() {
+      return ephemeris_->FlowWithFixedStep(t, *chunk_instance);
+    });
+  }
+  return bundle.Join();
+}
+
+template<typename Frame>
+Instant MasslessSwarm<Frame>::time() const {
+  Instant result = instances_.front()->time().value;
+  for (auto const& instance : instances_) {
+    result = std::min(result, instance->time().value);
+  }
+  return result;
+}
+
+template<typename Frame>
+std::vector<DegreesOfFreedom<Frame>> MasslessSwarm<Frame>::degrees_of_freedom()
+    const {
+  std::vector<DegreesOfFreedom<Frame>> result;
+  for (auto const& instance : instances_) {
+    AppendDegreesOfFreedom(instance->state(), result);
+  }
+  return result;
+}
+
+template<typename Frame>
+void MasslessSwarm<Frame>::AppendDegreesOfFreedom(
+    typename NewtonianMotionEquation::SystemState const& state,
+    std::vector<DegreesOfFreedom<Frame>>& degrees_of_freedom) {
+  for (int i = 0; i < state.positions.size(); ++i) {
+    degrees_of_freedom.emplace_back(state.positions[i].value,
+                                    state.velocities[i].value);
+  }
+}
+
+}  // namespace internal_massless_swarm
+}  // namespace physics
+}  // namespace principia
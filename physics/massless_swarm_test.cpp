@@ -0,0 +1,137 @@
+﻿
+#include "physics/massless_swarm.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "astronomy/frames.hpp"
+#include "geometry/frame.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "integrators/methods.hpp"
+#include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/massive_body.hpp"
+#include "quantities/astronomy.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/matchers.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_massless_swarm {
+
+using astronomy::ICRS;
+using base::make_not_null_unique;
+using geometry::Displacement;
+using geometry::Position;
+using geometry::Velocity;
+using integrators::SymplecticRungeKuttaNyströmIntegrator;
+using integrators::methods::McLachlanAtela1992Order5Optimal;
+using quantities::Length;
+using quantities::Speed;
+using quantities::Sqrt;
+using quantities::astronomy::AstronomicalUnit;
+using quantities::astronomy::JulianYear;
+using quantities::astronomy::SolarGravitationalParameter;
+using quantities::si::Hour;
+using quantities::si::Metre;
+using ::testing::Eq;
+
+class MasslessSwarmTest : public ::testing::Test {
+ protected:
+  MasslessSwarmTest()
+      : fixed_step_parameters_(
+            SymplecticRungeKuttaNyströmIntegrator<
+                McLachlanAtela1992Order5Optimal,
+                Position<ICRS>>(),
+            /*step=*/1 * Hour) {
+    std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+    bodies.emplace_back(
+        make_not_null_unique<MassiveBody>(SolarGravitationalParameter));
+    ephemeris_ = std::make_unique<Ephemeris<ICRS>>(
+        std::move(bodies),
+        std::vector<DegreesOfFreedom<ICRS>>{
+            {ICRS::origin, Velocity<ICRS>()}},
+        t0_,
+        Ephemeris<ICRS>::AccuracyParameters(
+            /*fitting_tolerance=*/1 * Metre,
+            /*geopotential_tolerance=*/0),
+        fixed_step_parameters_);
+
+    // Circular orbits at various distances from the Sun.
+    for (int i = 0; i < number_of_bodies; ++i) {
+      Length const r = (1 + 0.01 * i) * AstronomicalUnit;
+      Speed const v = Sqrt(SolarGravitationalParameter / r);
+      initial_state_.emplace_back(
+          ICRS::origin + Displacement<ICRS>({r, 0 * Metre, 0 * Metre}),
+          Velocity<ICRS>({0 * v, v, 0 * v}));
+    }
+  }
+
+  static constexpr int number_of_bodies = 100;
+  Instant const t0_;
+  Ephemeris<ICRS>::FixedStepParameters const fixed_step_parameters_;
+  std::unique_ptr<Ephemeris<ICRS>> ephemeris_;
+  std::vector<DegreesOfFreedom<ICRS>> initial_state_;
+};
+
+// The swarm yields the same results as the integration of the trajectories.
+TEST_F(MasslessSwarmTest, Trajectories) {
+  std::vector<std::unique_ptr<DiscreteTrajectory<ICRS>>> trajectories;
+  std::vector<not_null<DiscreteTrajectory<ICRS>*>> unowned_trajectories;
+  for (auto const& degrees_of_freedom : initial_state_) {
+    trajectories.push_back(std::make_unique<DiscreteTrajectory<ICRS>>());
+    trajectories.back()->Append(t0_, degrees_of_freedom);
+    unowned_trajectories.push_back(trajectories.back().get());
+  }
+  auto const instance =
+      ephemeris_->NewInstance(unowned_trajectories,
+                              Ephemeris<ICRS>::NoIntrinsicAccelerations,
+                              fixed_step_parameters_);
+  EXPECT_OK(ephemeris_->FlowWithFixedStep(t0_ + 0.1 * JulianYear, *instance));
+
+  MasslessSwarm<ICRS> swarm(ephemeris_.get(),
+                            initial_state_,
+                            t0_,
+                            fixed_step_parameters_,
+                            /*observer=*/nullptr,
+                            /*chunk_size=*/7);
+  EXPECT_OK(swarm.Flow(t0_ + 0.1 * JulianYear));
+  EXPECT_THAT(swarm.time(), Eq(trajectories.front()->last().time()));
+
+  auto const degrees_of_freedom = swarm.degrees_of_freedom();
+  ASSERT_THAT(degrees_of_freedom.size(), Eq(number_of_bodies));
+  for (int i = 0; i < number_of_bodies; ++i) {
+    EXPECT_THAT(degrees_of_freedom[i],
+                Eq(trajectories[i]->last().degrees_of_freedom())) << i;
+  }
+}
+
+TEST_F(MasslessSwarmTest, Observer) {
+  std::atomic_int observed_steps = 0;
+  std::atomic_int observed_bodies = 0;
+  MasslessSwarm<ICRS> swarm(
+      ephemeris_.get(),
+      initial_state_,
+      t0_,
+      fixed_step_parameters_,
+      [&observed_steps, &observed_bodies](
+          Instant const& t,
+          int const first,
+          std::vector<DegreesOfFreedom<ICRS>> const& degrees_of_freedom) {
+        EXPECT_THAT(first % 30, Eq(0));
+        ++observed_steps;
+        observed_bodies += degrees_of_freedom.size();
+      },
+      /*chunk_size=*/30);
+  EXPECT_OK(swarm.Flow(t0_ + 10 * Hour));
+  // 4 chunks, 10 steps each.
+  EXPECT_THAT(observed_steps, Eq(40));
+  EXPECT_THAT(observed_bodies, Eq(10 * number_of_bodies));
+}
+
+}  // namespace internal_massless_swarm
+}  // namespace physics
+}  // namespace principia
@@ -18,6 +18,16 @@ class MockContinuousTrajectory : public ContinuousTrajectory<Frame> {
   MOCK_CONST_METHOD1_T(EvaluatePosition, Position<Frame>(Instant const& time));
   MOCK_CONST_METHOD1_T(EvaluateDegreesOfFreedom,
                        DegreesOfFreedom<Frame>(Instant const& time));
+
+  // The batch evaluations go through the mocked functions above.
+  std::vector<Position<Frame>> EvaluatePositions(
+      std::vector<Instant> const& times) const override {
+    return Trajectory<Frame>::EvaluatePositions(times);
+  }
+  std::vector<DegreesOfFreedom<Frame>> EvaluateAllDegreesOfFreedom(
+      std::vector<Instant> const& times) const override {
+    return Trajectory<Frame>::EvaluateAllDegreesOfFreedom(times);
+  }
 };
 
 }  // namespace internal_continuous_trajectory
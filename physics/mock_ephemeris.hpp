@@ -47,6 +47,16 @@ class MockEphemeris : public Ephemeris<Frame> {
           std::vector<not_null<DiscreteTrajectory<Frame>*>> const& trajectories,
           IntrinsicAccelerations const& intrinsic_accelerations,
           FixedStepParameters const& parameters));
+  MOCK_METHOD5_T(
+      NewInstance,
+      not_null<std::unique_ptr<
+          typename Integrator<NewtonianMotionEquation>::Instance>>(
+          std::vector<DegreesOfFreedom<Frame>> const& initial_state,
+          Instant const& initial_time,
+          IntrinsicAccelerations const& intrinsic_accelerations,
+          typename Integrator<NewtonianMotionEquation>::AppendState const&
+              append_state,
+          FixedStepParameters const& parameters));
   MOCK_METHOD6_T(
       FlowWithAdaptiveStep,
       Status(not_null<DiscreteTrajectory<Frame>*> trajectory,
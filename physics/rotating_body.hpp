@@ -10,7 +10,11 @@
 #include <vector>
 
 #include "geometry/grassmann.hpp"
+#include "geometry/quaternion.hpp"
+#include "geometry/r3_element.hpp"
 #include "geometry/rotation.hpp"
+#include "numerics/sin_cos.hpp"
+#include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 
@@ -20,14 +24,15 @@ namespace internal_rotating_body {
 
 using base::not_null;
 using geometry::AngularVelocity;
-using geometry::DefinesFrame;
-using geometry::EulerAngles;
+using geometry::BasisVector;
 using geometry::Instant;
+using geometry::Quaternion;
 using geometry::Rotation;
 using geometry::Vector;
 using quantities::Angle;
 using quantities::AngularFrequency;
 using quantities::Length;
+using quantities::SinCos;
 using quantities::si::Radian;
 
 template<typename Frame>
@@ -114,6 +119,15 @@ class RotatingBody : public MassiveBody {
   template<typename SurfaceFrame>
   Rotation<Frame, SurfaceFrame> ToSurfaceFrame(Instant const& t) const;
 
+  // Same as above for many instants.  The trigonometric functions are evaluated
+  // in a batch, and the results are identical to those of the functions above.
+  template<typename SurfaceFrame>
+  std::vector<Rotation<SurfaceFrame, Frame>> FromSurfaceFrame(
+      std::vector<Instant> const& times) const;
+  template<typename SurfaceFrame>
+  std::vector<Rotation<Frame, SurfaceFrame>> ToSurfaceFrame(
+      std::vector<Instant> const& times) const;
+
   // Returns the rotation at time |t|.
   Rotation<Frame, Frame> RotationAt(Instant const& t) const;
 
@@ -139,6 +153,11 @@ class RotatingBody : public MassiveBody {
   Vector<double, Frame> const biequatorial_;
   Vector<double, Frame> const equatorial_;
   AngularVelocity<Frame> const angular_velocity_;
+  // The rotation from the surface frame when the angle of the prime meridian
+  // is 0, i.e., the product of the first two factors of the Euler angles
+  // (ZXZ) of |FromSurfaceFrame|.  The third factor is the only one that depends
+  // on time.
+  Quaternion const equator_orientation_;
 };
 
 // Define template member functions even when importing: these are not
@@ -148,12 +167,14 @@ template<typename Frame>
 template<typename SurfaceFrame>
 Rotation<SurfaceFrame, Frame> RotatingBody<Frame>::FromSurfaceFrame(
     Instant const& t) const {
+  // Same computation as |AngleAxis|, multiplied in the same order as in the
+  // constructor from Euler angles.
+  double sin_half_angle;
+  double cos_half_angle;
+  SinCos(0.5 * AngleAt(t), sin_half_angle, cos_half_angle);
   return Rotation<SurfaceFrame, Frame>(
-      π / 2 * Radian + right_ascension_of_pole(),
-      π / 2 * Radian - declination_of_pole(),
-      AngleAt(t),
-      EulerAngles::ZXZ,
-      DefinesFrame<SurfaceFrame>{});
+      equator_orientation_ *
+      Quaternion(cos_half_angle, sin_half_angle * BasisVector(2)));
 }
 
 template<typename Frame>
@@ -163,6 +184,43 @@ Rotation<Frame, SurfaceFrame> RotatingBody<Frame>::ToSurfaceFrame(
   return FromSurfaceFrame<SurfaceFrame>(t).Inverse();
 }
 
+template<typename Frame>
+template<typename SurfaceFrame>
+std::vector<Rotation<SurfaceFrame, Frame>>
+RotatingBody<Frame>::FromSurfaceFrame(std::vector<Instant> const& times) const {
+  std::vector<double> half_angles;
+  half_angles.reserve(times.size());
+  for (Instant const& t : times) {
+    half_angles.push_back(0.5 * AngleAt(t) / Radian);
+  }
+  std::vector<double> sin_half_angles;
+  std::vector<double> cos_half_angles;
+  numerics::ReproducibleSinCos(half_angles,
+                               &sin_half_angles,
+                               &cos_half_angles);
+
+  std::vector<Rotation<SurfaceFrame, Frame>> result;
+  result.reserve(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    result.emplace_back(
+        equator_orientation_ *
+        Quaternion(cos_half_angles[i], sin_half_angles[i] * BasisVector(2)));
+  }
+  return result;
+}
+
+template<typename Frame>
+template<typename SurfaceFrame>
+std::vector<Rotation<Frame, SurfaceFrame>>
+RotatingBody<Frame>::ToSurfaceFrame(std::vector<Instant> const& times) const {
+  std::vector<Rotation<Frame, SurfaceFrame>> result;
+  result.reserve(times.size());
+  for (auto const& from_surface_frame : FromSurfaceFrame<SurfaceFrame>(times)) {
+    result.push_back(from_surface_frame.Inverse());
+  }
+  return result;
+}
+
 }  // namespace internal_rotating_body
 
 using internal_rotating_body::RotatingBody;
@@ -17,9 +17,8 @@ namespace principia {
 namespace physics {
 namespace internal_rotating_body {
 
+using geometry::AngleAxis;
 using geometry::Cross;
-using geometry::DefinesFrame;
-using geometry::EulerAngles;
 using geometry::Exp;
 using geometry::NormalizeOrZero;
 using geometry::RadiusLatitudeLongitude;
@@ -62,7 +61,12 @@ RotatingBody<Frame>::RotatingBody(
                             parameters.right_ascension_of_pole_).ToCartesian()),
       equatorial_(Wedge(biequatorial_, polar_axis_).coordinates()),
       angular_velocity_(polar_axis_.coordinates() *
-                        parameters.angular_frequency_) {}
+                        parameters.angular_frequency_),
+      equator_orientation_(
+          AngleAxis(π / 2 * Radian + parameters.right_ascension_of_pole_,
+                    BasisVector(2)) *
+          AngleAxis(π / 2 * Radian - parameters.declination_of_pole_,
+                    BasisVector(0))) {}
 
 template<typename Frame>
 Length RotatingBody<Frame>::mean_radius() const {
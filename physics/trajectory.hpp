@@ -1,6 +1,8 @@
 ﻿
 #pragma once
 
+#include <vector>
+
 #include "base/not_null.hpp"
 #include "geometry/named_quantities.hpp"
 #include "physics/degrees_of_freedom.hpp"
@@ -31,6 +33,15 @@ class Trajectory {
   virtual Velocity<Frame> EvaluateVelocity(Instant const& time) const = 0;
   virtual DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(
       Instant const& time) const = 0;
+
+  // Evaluates the trajectory at each of the given |times|, which must all be
+  // in [t_min(), t_max()].  The results are in the same order as the |times|.
+  // Implementations are faster if the |times| are sorted.  The default
+  // implementations call the single-time functions above.
+  virtual std::vector<Position<Frame>> EvaluatePositions(
+      std::vector<Instant> const& times) const;
+  virtual std::vector<DegreesOfFreedom<Frame>> EvaluateAllDegreesOfFreedom(
+      std::vector<Instant> const& times) const;
 };
 
 }  // namespace internal_trajectory
@@ -39,3 +50,5 @@ using internal_trajectory::Trajectory;
 
 }  // namespace physics
 }  // namespace principia
+
+#include "physics/trajectory_body.hpp"
@@ -0,0 +1,37 @@
+﻿
+#pragma once
+
+#include "physics/trajectory.hpp"
+
+#include <vector>
+
+namespace principia {
+namespace physics {
+namespace internal_trajectory {
+
+template<typename Frame>
+std::vector<Position<Frame>> Trajectory<Frame>::EvaluatePositions(
+    std::vector<Instant> const& times) const {
+  std::vector<Position<Frame>> positions;
+  positions.reserve(times.size());
+  for (Instant const& time : times) {
+    positions.push_back(EvaluatePosition(time));
+  }
+  return positions;
+}
+
+template<typename Frame>
+std::vector<DegreesOfFreedom<Frame>>
+Trajectory<Frame>::EvaluateAllDegreesOfFreedom(
+    std::vector<Instant> const& times) const {
+  std::vector<DegreesOfFreedom<Frame>> degrees_of_freedom;
+  degrees_of_freedom.reserve(times.size());
+  for (Instant const& time : times) {
+    degrees_of_freedom.push_back(EvaluateDegreesOfFreedom(time));
+  }
+  return degrees_of_freedom;
+}
+
+}  // namespace internal_trajectory
+}  // namespace physics
+}  // namespace principia
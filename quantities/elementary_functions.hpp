@@ -35,8 +35,12 @@ CubeRoot<Q> Cbrt(Q const& x);
 template<int exponent, typename Q>
 constexpr Exponentiation<Q, exponent> Pow(Q const& x);
 
+// Sin and Cos are computed by |numerics::ReproducibleSinCos|, and are thus
+// reproducible across platforms.  The other functions use the C runtime library.
 double Sin(Angle const& α);
 double Cos(Angle const& α);
+// Computes both lines at once, sharing the argument reduction.
+void SinCos(Angle const& α, double& sin, double& cos);
 double Tan(Angle const& α);
 
 Angle ArcSin(double x);
@@ -73,6 +77,7 @@ using internal_elementary_functions::FusedMultiplyAdd;
 using internal_elementary_functions::Mod;
 using internal_elementary_functions::Pow;
 using internal_elementary_functions::Sin;
+using internal_elementary_functions::SinCos;
 using internal_elementary_functions::Sinh;
 using internal_elementary_functions::Sqrt;
 using internal_elementary_functions::Tan;
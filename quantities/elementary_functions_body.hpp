@@ -10,6 +10,7 @@
 
 #include "quantities/si.hpp"
 #include "numerics/cbrt.hpp"
+#include "numerics/sin_cos.hpp"
 
 namespace principia {
 namespace quantities {
@@ -104,11 +105,15 @@ constexpr Exponentiation<Q, exponent> Pow(Q const& x) {
 }
 
 inline double Sin(Angle const& α) {
-  return std::sin(α / si::Radian);
+  return numerics::ReproducibleSin(α / si::Radian);
 }
 
 inline double Cos(Angle const& α) {
-  return std::cos(α / si::Radian);
+  return numerics::ReproducibleCos(α / si::Radian);
+}
+
+inline void SinCos(Angle const& α, double& sin, double& cos) {
+  numerics::ReproducibleSinCos(α / si::Radian, sin, cos);
 }
 
 inline double Tan(Angle const& α) {
@@ -44,12 +44,14 @@ struct ExponentiationGenerator<double, n> : not_constructible {
   using Type = double;
 };
 
-template<typename Q, int n, typename>
-struct NthRootGenerator : not_constructible {
+// The primary template is not defined, so that |NthRoot| of a type that is not
+// a quantity is a substitution failure.  This makes it possible to overload
+// functions like |Sqrt| for other types.
+template<typename D, int n>
+struct NthRootGenerator<Quantity<D>, n> : not_constructible {
   using Type =
       typename Collapse<
-          Quantity<typename DimensionsNthRootGenerator<
-                                typename Q::Dimensions, n>::Type>>::Type;
+          Quantity<typename DimensionsNthRootGenerator<D, n>::Type>>::Type;
 };
 
 // NOTE(phl): We use |is_arithmetic| here, not |double|, to make it possible to